@@ -0,0 +1,78 @@
+// キーフレームアニメーションのサンプリング速度を測る。
+// 10000 トラック（各チャンネル 30 キー）のクリップを 60fps で 10 秒ぶん再生し、
+// カーソルを使う AnimationSampler と二分探索の SampleTrack を比べる。
+//
+// ビルド例（リポジトリのルートで）:
+//   g++ -std=c++20 -O2 -ISource Benchmark/AnimationSamplingBenchmark.cpp Source/Animation/*.cpp Source/Quaternion/Quaternion.cpp Source/Math/CpuFeatures.cpp
+#include "Animation/AnimationSampler.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr size_t kTrackCount = 10000;
+constexpr int kKeyCount = 30;
+constexpr float kDuration = 1.0f;
+constexpr int kFrameCount = 600;
+constexpr float kFrameTime = 1.0f / 60.0f;
+
+AnimationClip MakeClip() {
+	std::mt19937 rng(12345);
+	std::uniform_real_distribution<float> dist(-1.0f, 1.0f);
+
+	AnimationClip clip;
+	clip.duration = kDuration;
+	clip.tracks.resize(kTrackCount);
+	for (AnimationTrack& track : clip.tracks) {
+		for (int k = 0; k < kKeyCount; ++k) {
+			const float time = kDuration * static_cast<float>(k) / static_cast<float>(kKeyCount - 1);
+			track.translate.AddKey(time, Vector3{dist(rng), dist(rng), dist(rng)});
+			track.rotate.AddKey(time, Quaternion::Normalize(Quaternion(dist(rng), dist(rng), dist(rng), dist(rng))));
+			track.scale.AddKey(time, Vector3{1.0f + 0.1f * dist(rng), 1.0f + 0.1f * dist(rng), 1.0f + 0.1f * dist(rng)});
+		}
+	}
+	return clip;
+}
+
+template <typename Function> double MeasureMicrosecondsPerFrame(Function&& sampleFrame) {
+	// 1 周ぶん空回ししてから計測する
+	for (int frame = 0; frame < 60; ++frame) {
+		sampleFrame(WrapAnimationTime(frame * kFrameTime, kDuration));
+	}
+	const auto start = std::chrono::steady_clock::now();
+	for (int frame = 0; frame < kFrameCount; ++frame) {
+		sampleFrame(WrapAnimationTime(frame * kFrameTime, kDuration));
+	}
+	const auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::micro>(end - start).count() / kFrameCount;
+}
+
+} // namespace
+
+int main() {
+	const AnimationClip clip = MakeClip();
+	std::vector<TransformPose> pose(clip.tracks.size());
+	float checksum = 0.0f;
+
+	AnimationSampler sampler(&clip);
+	const double cursorExact = MeasureMicrosecondsPerFrame([&](float time) { sampler.Sample(time, pose); });
+	checksum += pose[0].translate.x;
+	const double cursorFast = MeasureMicrosecondsPerFrame([&](float time) { sampler.Sample(time, pose, SlerpMode::Fast); });
+	checksum += pose[0].translate.x;
+
+	const double binarySearch = MeasureMicrosecondsPerFrame([&](float time) {
+		for (size_t i = 0; i < clip.tracks.size(); ++i) {
+			pose[i] = SampleTrack(clip.tracks[i], time);
+		}
+	});
+	checksum += pose[0].translate.x;
+
+	std::printf("tracks: %zu, keys/channel: %d\n", kTrackCount, kKeyCount);
+	std::printf("cursor  (exact slerp): %9.1f us/frame  %6.1f ns/track\n", cursorExact, cursorExact * 1000.0 / kTrackCount);
+	std::printf("cursor  (fast slerp) : %9.1f us/frame  %6.1f ns/track\n", cursorFast, cursorFast * 1000.0 / kTrackCount);
+	std::printf("binary search        : %9.1f us/frame  %6.1f ns/track\n", binarySearch, binarySearch * 1000.0 / kTrackCount);
+	std::printf("(checksum %f)\n", checksum);
+	return 0;
+}
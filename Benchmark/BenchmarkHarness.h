@@ -0,0 +1,458 @@
+#pragma once
+// マイクロベンチマーク用の小さな計測器（ヘッダーのみ）。
+//
+// Runner::Run(name, opsPerCall, body) は body を空回しして（ウォームアップ）1 回の時間を見積もり、
+// 1 サンプルが sampleMilliseconds 程度になる回数ずつ sampleCount 回測る。
+// サンプルの中央値と MAD（中央値からの差の中央値）を出すので、割り込みなどで外れた回に引きずられない。
+//
+// 1 op あたりの時間、タイムスタンプカウンタ（rdtsc）のカウント数、毎秒の op 数を出す。
+// rdtsc は基準周波数で数えるので、ターボ中のコアのサイクル数とは一致しない。
+// Linux で --perf を付けると perf_event_open でコアのサイクル数・命令数・分岐予測ミス・キャッシュミスも数える
+// （権限がなければ警告を出して無しで続ける）。
+// --json で結果を 1 行 1 ベンチマークの JSON に書き出し、--baseline で前回の JSON と比べた増減を表に出す。
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Bench {
+
+//==================================
+// 最適化の抑止
+//==================================
+
+// value を計算したことにして、コンパイラに消させない
+template <typename T> inline void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	const volatile char* bytes = reinterpret_cast<const volatile char*>(&value);
+	(void)bytes[0];
+	_ReadWriteBarrier();
+#endif
+}
+
+// それまでのメモリへの書き込みを読まれたことにする
+inline void ClobberMemory() {
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : : "memory");
+#else
+	_ReadWriteBarrier();
+#endif
+}
+
+//==================================
+// タイムスタンプ
+//==================================
+
+inline uint64_t ReadTimestamp() {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+// 1 秒あたりのタイムスタンプのカウント数を steady_clock と比べて求める
+inline double MeasureTimestampFrequency() {
+	const auto start = std::chrono::steady_clock::now();
+	const uint64_t startTicks = ReadTimestamp();
+	while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(50)) {
+	}
+	const uint64_t ticks = ReadTimestamp() - startTicks;
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return static_cast<double>(ticks) / seconds;
+}
+
+//==================================
+// ハードウェアカウンタ（Linux の perf_event_open）
+//==================================
+
+class PerfCounters {
+
+public:
+	enum Counter {
+		kCycles,
+		kInstructions,
+		kBranchMisses,
+		kCacheMisses,
+		kCounterCount,
+	};
+
+	PerfCounters() = default;
+	PerfCounters(const PerfCounters&) = delete;
+	PerfCounters& operator=(const PerfCounters&) = delete;
+	~PerfCounters() { Close(); }
+
+	// サイクル数と命令数が数えられれば true（残り 2 つは開けなくても続ける）
+	bool Open() {
+#if defined(__linux__)
+		const uint64_t configs[kCounterCount] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES};
+		for (int i = 0; i < kCounterCount; ++i) {
+			perf_event_attr attr;
+			std::memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.config = configs[i];
+			attr.disabled = leader_ < 0 ? 1 : 0;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_GROUP;
+			const int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader_, 0));
+			if (fd < 0) {
+				if (i < kBranchMisses) {
+					Close();
+					return false;
+				}
+				continue;
+			}
+			if (leader_ < 0) {
+				leader_ = fd;
+			}
+			fds_[i] = fd;
+			order_[openCount_++] = i;
+		}
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	bool IsOpen() const { return leader_ >= 0; }
+	bool Has(Counter counter) const { return fds_[counter] >= 0; }
+
+	void Start() {
+#if defined(__linux__)
+		ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+		ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+	}
+
+	// 開けなかったカウンタは 0
+	void Stop(uint64_t (&values)[kCounterCount]) {
+		std::fill(std::begin(values), std::end(values), uint64_t{0});
+#if defined(__linux__)
+		ioctl(leader_, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+		uint64_t buffer[1 + kCounterCount] = {};
+		if (read(leader_, buffer, sizeof(buffer)) > 0) {
+			for (uint64_t i = 0; i < buffer[0] && i < static_cast<uint64_t>(openCount_); ++i) {
+				values[order_[i]] = buffer[1 + i];
+			}
+		}
+#endif
+	}
+
+private:
+	void Close() {
+#if defined(__linux__)
+		for (int& fd : fds_) {
+			if (fd >= 0) {
+				close(fd);
+			}
+			fd = -1;
+		}
+#endif
+		leader_ = -1;
+		openCount_ = 0;
+	}
+
+	int fds_[kCounterCount] = {-1, -1, -1, -1};
+	int order_[kCounterCount] = {};
+	int openCount_ = 0;
+	int leader_ = -1;
+};
+
+//==================================
+// 設定と結果
+//==================================
+
+struct Options {
+	double warmupMilliseconds = 30.0;
+	double sampleMilliseconds = 4.0;
+	int sampleCount = 21;
+	bool perfCounters = false;
+	std::string filter;       // 名前にこの文字列を含むものだけ測る
+	std::string jsonPath;     // 空でなければ結果を書き出す
+	std::string baselinePath; // 空でなければ比べる
+
+	// 引数を読む。わからない引数があれば使い方を出して false を返す
+	bool Parse(int argc, char** argv) {
+		for (int i = 1; i < argc; ++i) {
+			const std::string arg = argv[i];
+			const bool hasValue = i + 1 < argc;
+			if (arg == "--perf") {
+				perfCounters = true;
+			} else if (arg == "--quick") {
+				warmupMilliseconds = 5.0;
+				sampleMilliseconds = 1.0;
+				sampleCount = 7;
+			} else if (arg == "--filter" && hasValue) {
+				filter = argv[++i];
+			} else if (arg == "--json" && hasValue) {
+				jsonPath = argv[++i];
+			} else if (arg == "--baseline" && hasValue) {
+				baselinePath = argv[++i];
+			} else if (arg == "--samples" && hasValue) {
+				sampleCount = (std::max)(1, std::atoi(argv[++i]));
+			} else {
+				std::fprintf(stderr, "usage: %s [--filter text] [--json out.json] [--baseline old.json] [--samples n] [--quick] [--perf]\n", argv[0]);
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+struct Result {
+	std::string name;
+	size_t opsPerCall = 1;
+	uint64_t callsPerSample = 0;
+	int sampleCount = 0;
+
+	// 1 op あたり（サンプルの中央値など）
+	double medianNanoseconds = 0.0;
+	double madNanoseconds = 0.0;
+	double minNanoseconds = 0.0;
+	double meanNanoseconds = 0.0;
+	double timestampTicks = 0.0;
+	double opsPerSecond = 0.0;
+
+	// --perf で数えられた場合だけ（1 op あたりの中央値、数えられなければ負）
+	double cycles = -1.0;
+	double instructions = -1.0;
+	double branchMisses = -1.0;
+	double cacheMisses = -1.0;
+};
+
+inline double Median(std::vector<double> values) {
+	if (values.empty()) {
+		return 0.0;
+	}
+	std::sort(values.begin(), values.end());
+	const size_t half = values.size() / 2;
+	return values.size() % 2 != 0 ? values[half] : 0.5 * (values[half - 1] + values[half]);
+}
+
+//==================================
+// 計測
+//==================================
+
+class Runner {
+
+public:
+	explicit Runner(const Options& options) : options_(options), timestampFrequency_(MeasureTimestampFrequency()) {
+		if (options_.perfCounters && !perf_.Open()) {
+			std::fprintf(stderr, "perf_event_open is not available; hardware counters are disabled\n");
+		}
+		if (!options_.baselinePath.empty()) {
+			baseline_ = LoadBaseline(options_.baselinePath);
+		}
+	}
+
+	// true なら表を出さない（結果は Results() で読む）
+	void SetQuiet(bool quiet) { quiet_ = quiet; }
+
+	// JSON の先頭に書く環境の情報（SIMD の段階など）
+	void AddContext(const std::string& key, const std::string& value) { context_.emplace_back(key, value); }
+
+	// body は 1 回の呼び出しで opsPerCall 回ぶんの処理をすること
+	template <typename Function> void Run(const std::string& name, size_t opsPerCall, Function&& body) {
+		if (!options_.filter.empty() && name.find(options_.filter) == std::string::npos) {
+			return;
+		}
+		if (results_.empty() && !quiet_) {
+			PrintHeader();
+		}
+
+		// ウォームアップしながら 1 回の時間を見積もる
+		using Clock = std::chrono::steady_clock;
+		const auto warmupStart = Clock::now();
+		uint64_t warmupCalls = 0;
+		double warmupSeconds = 0.0;
+		do {
+			body();
+			++warmupCalls;
+			warmupSeconds = std::chrono::duration<double>(Clock::now() - warmupStart).count();
+		} while (warmupSeconds * 1000.0 < options_.warmupMilliseconds);
+		const double secondsPerCall = warmupSeconds / static_cast<double>(warmupCalls);
+		const uint64_t calls = (std::max)(uint64_t{1}, static_cast<uint64_t>(options_.sampleMilliseconds * 1e-3 / secondsPerCall));
+
+		std::vector<double> nanoseconds, ticks;
+		std::vector<double> counters[PerfCounters::kCounterCount];
+		const double ops = static_cast<double>(calls) * static_cast<double>(opsPerCall);
+		for (int sample = 0; sample < options_.sampleCount; ++sample) {
+			if (perf_.IsOpen()) {
+				perf_.Start();
+			}
+			const auto start = Clock::now();
+			const uint64_t startTicks = ReadTimestamp();
+			for (uint64_t call = 0; call < calls; ++call) {
+				body();
+			}
+			const uint64_t endTicks = ReadTimestamp();
+			const auto end = Clock::now();
+			if (perf_.IsOpen()) {
+				uint64_t values[PerfCounters::kCounterCount];
+				perf_.Stop(values);
+				for (int i = 0; i < PerfCounters::kCounterCount; ++i) {
+					counters[i].push_back(static_cast<double>(values[i]) / ops);
+				}
+			}
+			nanoseconds.push_back(std::chrono::duration<double, std::nano>(end - start).count() / ops);
+			ticks.push_back(static_cast<double>(endTicks - startTicks) / ops);
+		}
+
+		Result result;
+		result.name = name;
+		result.opsPerCall = opsPerCall;
+		result.callsPerSample = calls;
+		result.sampleCount = options_.sampleCount;
+		result.medianNanoseconds = Median(nanoseconds);
+		std::vector<double> deviations;
+		for (const double value : nanoseconds) {
+			deviations.push_back(std::fabs(value - result.medianNanoseconds));
+		}
+		result.madNanoseconds = Median(deviations);
+		result.minNanoseconds = *std::min_element(nanoseconds.begin(), nanoseconds.end());
+		double sum = 0.0;
+		for (const double value : nanoseconds) {
+			sum += value;
+		}
+		result.meanNanoseconds = sum / static_cast<double>(nanoseconds.size());
+		result.timestampTicks = Median(ticks);
+		result.opsPerSecond = result.medianNanoseconds > 0.0 ? 1e9 / result.medianNanoseconds : 0.0;
+		if (perf_.IsOpen()) {
+			double* const targets[PerfCounters::kCounterCount] = {&result.cycles, &result.instructions, &result.branchMisses, &result.cacheMisses};
+			for (int i = 0; i < PerfCounters::kCounterCount; ++i) {
+				if (perf_.Has(static_cast<PerfCounters::Counter>(i))) {
+					*targets[i] = Median(counters[i]);
+				}
+			}
+		}
+		if (!quiet_) {
+			PrintRow(result);
+		}
+		results_.push_back(std::move(result));
+	}
+
+	const std::vector<Result>& Results() const { return results_; }
+
+	// 1 行に 1 ベンチマークずつ書く（行単位で diff を取りやすくするため）
+	bool WriteJson(const std::string& path) const {
+		std::FILE* file = std::fopen(path.c_str(), "w");
+		if (!file) {
+			return false;
+		}
+		std::fprintf(file, "{\n  \"context\": {");
+		std::fprintf(file, "\"timestampGHz\": %.4f", timestampFrequency_ * 1e-9);
+		for (const auto& [key, value] : context_) {
+			std::fprintf(file, ", \"%s\": \"%s\"", key.c_str(), value.c_str());
+		}
+		std::fprintf(file, "},\n  \"benchmarks\": [\n");
+		for (size_t i = 0; i < results_.size(); ++i) {
+			const Result& r = results_[i];
+			std::fprintf(file,
+			             "    {\"name\": \"%s\", \"medianNs\": %.6g, \"madNs\": %.6g, \"minNs\": %.6g, \"meanNs\": %.6g, \"ticksPerOp\": %.6g, \"opsPerSecond\": %.6g, "
+			             "\"opsPerCall\": %zu, \"callsPerSample\": %llu, \"samples\": %d",
+			             r.name.c_str(), r.medianNanoseconds, r.madNanoseconds, r.minNanoseconds, r.meanNanoseconds, r.timestampTicks, r.opsPerSecond, r.opsPerCall,
+			             static_cast<unsigned long long>(r.callsPerSample), r.sampleCount);
+			if (r.cycles >= 0.0) {
+				std::fprintf(file, ", \"cyclesPerOp\": %.6g, \"instructionsPerOp\": %.6g", r.cycles, r.instructions);
+			}
+			if (r.branchMisses >= 0.0) {
+				std::fprintf(file, ", \"branchMissesPerOp\": %.6g", r.branchMisses);
+			}
+			if (r.cacheMisses >= 0.0) {
+				std::fprintf(file, ", \"cacheMissesPerOp\": %.6g", r.cacheMisses);
+			}
+			std::fprintf(file, "}%s\n", i + 1 < results_.size() ? "," : "");
+		}
+		std::fprintf(file, "  ]\n}\n");
+		std::fclose(file);
+		return true;
+	}
+
+private:
+	// WriteJson が書いた形式だけを読む（名前と中央値）
+	static std::map<std::string, double> LoadBaseline(const std::string& path) {
+		std::map<std::string, double> baseline;
+		std::ifstream file(path);
+		if (!file) {
+			std::fprintf(stderr, "cannot open baseline %s\n", path.c_str());
+			return baseline;
+		}
+		const std::string nameKey = "\"name\": \"";
+		const std::string medianKey = "\"medianNs\": ";
+		std::string line;
+		while (std::getline(file, line)) {
+			const size_t name = line.find(nameKey);
+			const size_t median = line.find(medianKey);
+			if (name == std::string::npos || median == std::string::npos) {
+				continue;
+			}
+			const size_t nameBegin = name + nameKey.size();
+			const size_t nameEnd = line.find('"', nameBegin);
+			baseline[line.substr(nameBegin, nameEnd - nameBegin)] = std::atof(line.c_str() + median + medianKey.size());
+		}
+		return baseline;
+	}
+
+	void PrintHeader() const {
+		std::printf("%-40s %10s %7s %10s %10s %10s", "benchmark", "ns/op", "mad%", "min ns", "ticks/op", "Mops/s");
+		if (perf_.IsOpen()) {
+			std::printf(" %9s %9s %6s", "cycles/op", "instr/op", "IPC");
+		}
+		if (!baseline_.empty()) {
+			std::printf(" %9s", "vs base");
+		}
+		std::printf("\n");
+	}
+
+	void PrintRow(const Result& r) const {
+		const double madPercent = r.medianNanoseconds > 0.0 ? 100.0 * r.madNanoseconds / r.medianNanoseconds : 0.0;
+		std::printf("%-40s %10.3f %6.1f%% %10.3f %10.2f %10.1f", r.name.c_str(), r.medianNanoseconds, madPercent, r.minNanoseconds, r.timestampTicks, r.opsPerSecond * 1e-6);
+		if (perf_.IsOpen()) {
+			std::printf(" %9.2f %9.2f %6.2f", r.cycles, r.instructions, r.cycles > 0.0 ? r.instructions / r.cycles : 0.0);
+		}
+		if (!baseline_.empty()) {
+			const auto found = baseline_.find(r.name);
+			if (found != baseline_.end() && found->second > 0.0) {
+				std::printf(" %+8.1f%%", 100.0 * (r.medianNanoseconds / found->second - 1.0));
+			} else {
+				std::printf(" %9s", "new");
+			}
+		}
+		std::printf("\n");
+	}
+
+	Options options_;
+	double timestampFrequency_;
+	PerfCounters perf_;
+	std::vector<std::pair<std::string, std::string>> context_;
+	std::map<std::string, double> baseline_;
+	std::vector<Result> results_;
+	bool quiet_ = false;
+};
+
+} // namespace Bench
@@ -0,0 +1,160 @@
+// DynamicAABBTree の構築と問い合わせの速度を測る。
+// 100000 個の箱を 1 辺 1000 の空間に散らし、挿入・Rebuild・移動と、
+// AABB / 球 / レイの問い合わせを全件を調べる場合と比べる。
+//
+// ビルド例（リポジトリのルートで）:
+//   g++ -std=c++20 -O2 -ISource -pthread Benchmark/DynamicAABBTreeBenchmark.cpp Source/Collision/*.cpp Source/Job/*.cpp Source/Profiler/Profiler.cpp Source/Math/CpuFeatures.cpp Source/Math/Math3D.cpp Source/Math/MatrixKernels.cpp
+#include "Collision/Collision.h"
+#include "Collision/DynamicAABBTree.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr size_t kObjectCount = 100000;
+constexpr int kQueryCount = 1000;
+constexpr float kWorldHalfSize = 500.0f;
+
+std::mt19937 rng(12345);
+
+float Random(float min, float max) { return std::uniform_real_distribution<float>(min, max)(rng); }
+
+Vector3 RandomPoint() { return {Random(-kWorldHalfSize, kWorldHalfSize), Random(-kWorldHalfSize, kWorldHalfSize), Random(-kWorldHalfSize, kWorldHalfSize)}; }
+
+AABB MakeBox(const Vector3& center, float extent) {
+	AABB aabb;
+	aabb.min = {center.x - extent, center.y - extent, center.z - extent};
+	aabb.max = {center.x + extent, center.y + extent, center.z + extent};
+	return aabb;
+}
+
+template <typename Function> double MeasureMilliseconds(Function&& function) {
+	const auto start = std::chrono::steady_clock::now();
+	function();
+	const auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+} // namespace
+
+int main() {
+	std::vector<Vector3> centers(kObjectCount);
+	std::vector<float> extents(kObjectCount);
+	std::vector<AABB> boxes(kObjectCount);
+	for (size_t i = 0; i < kObjectCount; ++i) {
+		centers[i] = RandomPoint();
+		extents[i] = Random(0.5f, 3.0f);
+		boxes[i] = MakeBox(centers[i], extents[i]);
+	}
+
+	std::vector<AABB> queryBoxes(kQueryCount);
+	std::vector<Sphere> querySpheres(kQueryCount);
+	std::vector<Ray> queryRays(kQueryCount);
+	for (int q = 0; q < kQueryCount; ++q) {
+		queryBoxes[q] = MakeBox(RandomPoint(), 20.0f);
+		querySpheres[q].center = RandomPoint();
+		querySpheres[q].radius = 20.0f;
+		queryRays[q].origin = RandomPoint();
+		queryRays[q].diff = {Random(-1.0f, 1.0f), Random(-1.0f, 1.0f), Random(-1.0f, 1.0f)};
+	}
+
+	DynamicAABBTree tree;
+	std::vector<int32_t> proxies(kObjectCount);
+	const double insertMs = MeasureMilliseconds([&] {
+		for (size_t i = 0; i < kObjectCount; ++i) {
+			proxies[i] = tree.Insert(boxes[i], static_cast<uint32_t>(i));
+		}
+	});
+	std::printf("objects: %zu\n", kObjectCount);
+	std::printf("insert            : %9.2f ms  (height %d, area ratio %.1f)\n", insertMs, tree.GetHeight(), tree.GetAreaRatio());
+
+	// 少しずつ動かす（太い AABB に収まる間は組み替えない）
+	size_t reinsertCount = 0;
+	const double moveMs = MeasureMilliseconds([&] {
+		for (size_t i = 0; i < kObjectCount; ++i) {
+			const Vector3 displacement = {Random(-0.05f, 0.05f), Random(-0.05f, 0.05f), Random(-0.05f, 0.05f)};
+			centers[i] = {centers[i].x + displacement.x, centers[i].y + displacement.y, centers[i].z + displacement.z};
+			boxes[i] = MakeBox(centers[i], extents[i]);
+			reinsertCount += tree.Move(proxies[i], boxes[i], displacement) ? 1 : 0;
+		}
+	});
+	std::printf("move (small)      : %9.2f ms  (%zu reinserted)\n", moveMs, reinsertCount);
+
+	const double rebuildMs = MeasureMilliseconds([&] { tree.Rebuild(); });
+	std::printf("rebuild (SAH)     : %9.2f ms  (height %d, area ratio %.1f)\n", rebuildMs, tree.GetHeight(), tree.GetAreaRatio());
+
+	DynamicAABBTree::Settings settings = tree.GetSettings();
+	settings.updateMode = DynamicAABBTree::UpdateMode::Refit;
+	tree.SetSettings(settings);
+	const double refitMs = MeasureMilliseconds([&] {
+		for (size_t i = 0; i < kObjectCount; ++i) {
+			tree.Move(proxies[i], boxes[i]);
+		}
+		tree.Refit();
+	});
+	std::printf("move + refit      : %9.2f ms\n", refitMs);
+
+	// 問い合わせ（木と全件走査の結果の数を並べて表示する）
+	size_t treeHits = 0;
+	size_t bruteHits = 0;
+	const double treeBoxMs = MeasureMilliseconds([&] {
+		for (const AABB& query : queryBoxes) {
+			tree.QueryAABB(query, [&](int32_t proxy) {
+				treeHits += IsCollision(query, boxes[tree.GetUserData(proxy)]) ? 1 : 0;
+				return true;
+			});
+		}
+	});
+	const double bruteBoxMs = MeasureMilliseconds([&] {
+		for (const AABB& query : queryBoxes) {
+			for (const AABB& box : boxes) {
+				bruteHits += IsCollision(query, box) ? 1 : 0;
+			}
+		}
+	});
+	std::printf("aabb query        : %9.3f us/query  brute force %9.3f us/query  (hits %zu / %zu)\n", treeBoxMs * 1000.0 / kQueryCount, bruteBoxMs * 1000.0 / kQueryCount, treeHits,
+	            bruteHits);
+
+	treeHits = 0;
+	bruteHits = 0;
+	const double treeSphereMs = MeasureMilliseconds([&] {
+		for (const Sphere& query : querySpheres) {
+			tree.QuerySphere(query, [&](int32_t proxy) {
+				treeHits += IsCollision(query, boxes[tree.GetUserData(proxy)]) ? 1 : 0;
+				return true;
+			});
+		}
+	});
+	const double bruteSphereMs = MeasureMilliseconds([&] {
+		for (const Sphere& query : querySpheres) {
+			for (const AABB& box : boxes) {
+				bruteHits += IsCollision(query, box) ? 1 : 0;
+			}
+		}
+	});
+	std::printf("sphere query      : %9.3f us/query  brute force %9.3f us/query  (hits %zu / %zu)\n", treeSphereMs * 1000.0 / kQueryCount, bruteSphereMs * 1000.0 / kQueryCount,
+	            treeHits, bruteHits);
+
+	treeHits = 0;
+	bruteHits = 0;
+	const double treeRayMs = MeasureMilliseconds([&] {
+		for (const Ray& query : queryRays) {
+			tree.RayCast(query, [&](int32_t proxy, float maxT) {
+				treeHits += IsCollision(boxes[tree.GetUserData(proxy)], query) ? 1 : 0;
+				return maxT;
+			});
+		}
+	});
+	const double bruteRayMs = MeasureMilliseconds([&] {
+		for (const Ray& query : queryRays) {
+			for (const AABB& box : boxes) {
+				bruteHits += IsCollision(box, query) ? 1 : 0;
+			}
+		}
+	});
+	std::printf("ray cast (all hits): %8.3f us/query  brute force %9.3f us/query  (hits %zu / %zu)\n", treeRayMs * 1000.0 / kQueryCount, bruteRayMs * 1000.0 / kQueryCount, treeHits,
+	            bruteHits);
+	return 0;
+}
@@ -0,0 +1,97 @@
+// 視錐台カリングの時間を測る。
+// 100k 個の球と AABB を広い空間にばらまき、カメラを少しずつ回しながら Frustum::Cull を呼ぶ。
+// SIMD の段階ごとに、平面の連続性のキャッシュの有無と、複数スレッドでの分割を比べる。
+//
+// ビルド例（リポジトリのルートで）:
+//   g++ -std=c++20 -O2 -ISource -pthread Benchmark/FrustumCullingBenchmark.cpp Source/Collision/*.cpp Source/Job/*.cpp Source/Profiler/Profiler.cpp Source/Math/CpuFeatures.cpp Source/Math/Math3D.cpp Source/Math/MatrixKernels.cpp
+#include "Collision/Frustum.h"
+#include "Math/CpuFeatures.h"
+#include "Math/Math3D.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr size_t kObjectCount = 100000;
+constexpr int kFrameCount = 100;
+constexpr float kWorldSize = 200.0f;
+
+struct Scene {
+	SphereBatch spheres;
+	AABBBatch aabbs;
+};
+
+Scene MakeScene() {
+	std::mt19937 rng(12345);
+	std::uniform_real_distribution<float> position(-kWorldSize, kWorldSize);
+	std::uniform_real_distribution<float> size(0.2f, 2.0f);
+	Scene scene;
+	for (size_t i = 0; i < kObjectCount; ++i) {
+		Sphere sphere;
+		sphere.center = {position(rng), position(rng), position(rng)};
+		sphere.radius = size(rng);
+		scene.spheres.Add(sphere);
+
+		AABB aabb;
+		const Vector3 center = {position(rng), position(rng), position(rng)};
+		const Vector3 extent = {size(rng), size(rng), size(rng)};
+		aabb.min = center - extent;
+		aabb.max = center + extent;
+		scene.aabbs.Add(aabb);
+	}
+	return scene;
+}
+
+// 原点に立って y 軸まわりに回るカメラ
+Frustum MakeFrustum(int frame) {
+	const Matrix4x4 camera = MakeAffineMatrix({1.0f, 1.0f, 1.0f}, {0.0f, 0.01f * static_cast<float>(frame), 0.0f}, {0.0f, 0.0f, 0.0f});
+	const Matrix4x4 projection = MakePerspectiveFovMatrix(0.8f, 16.0f / 9.0f, 0.1f, 150.0f);
+	return Frustum(Multiply(Inverse(camera), projection));
+}
+
+// 1 フレームあたりの平均時間（ミリ秒）
+template <typename Cull> double Measure(Cull&& cull, size_t& visibleCount) {
+	visibleCount = 0;
+	cull(MakeFrustum(0));
+	const auto start = std::chrono::steady_clock::now();
+	for (int frame = 0; frame < kFrameCount; ++frame) {
+		visibleCount += cull(MakeFrustum(frame));
+	}
+	const auto end = std::chrono::steady_clock::now();
+	visibleCount /= kFrameCount;
+	return std::chrono::duration<double, std::milli>(end - start).count() / kFrameCount;
+}
+
+} // namespace
+
+int main() {
+	const Scene scene = MakeScene();
+	std::vector<uint32_t> visible;
+	std::vector<uint8_t> cache(kObjectCount);
+
+	std::printf("%-8s %-7s %12s %12s %12s %10s\n", "level", "shape", "plain", "cached", "cached mt", "visible");
+	for (const SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2}) {
+		SetSimdLevelOverride(level);
+		if (GetSimdLevel() != level) {
+			continue;
+		}
+		size_t visibleCount = 0;
+		const SphereSoA spheres = scene.spheres.View();
+		const double spherePlain = Measure([&](const Frustum& frustum) { return frustum.Cull(spheres, kObjectCount, visible); }, visibleCount);
+		std::fill(cache.begin(), cache.end(), uint8_t{0});
+		const double sphereCached = Measure([&](const Frustum& frustum) { return frustum.Cull(spheres, kObjectCount, visible, cache.data()); }, visibleCount);
+		const double sphereCachedMt = Measure([&](const Frustum& frustum) { return frustum.Cull(spheres, kObjectCount, visible, cache.data(), true); }, visibleCount);
+		std::printf("%-8s %-7s %9.3f ms %9.3f ms %9.3f ms %10zu\n", ToString(level), "sphere", spherePlain, sphereCached, sphereCachedMt, visibleCount);
+
+		const AABBSoA aabbs = scene.aabbs.View();
+		const double aabbPlain = Measure([&](const Frustum& frustum) { return frustum.Cull(aabbs, kObjectCount, visible); }, visibleCount);
+		std::fill(cache.begin(), cache.end(), uint8_t{0});
+		const double aabbCached = Measure([&](const Frustum& frustum) { return frustum.Cull(aabbs, kObjectCount, visible, cache.data()); }, visibleCount);
+		const double aabbCachedMt = Measure([&](const Frustum& frustum) { return frustum.Cull(aabbs, kObjectCount, visible, cache.data(), true); }, visibleCount);
+		std::printf("%-8s %-7s %9.3f ms %9.3f ms %9.3f ms %10zu\n", ToString(level), "aabb", aabbPlain, aabbCached, aabbCachedMt, visibleCount);
+	}
+	ClearSimdLevelOverride();
+	return 0;
+}
@@ -0,0 +1,163 @@
+// 衝突判定の速度を組み合わせごとに測る（1 秒あたりの判定数）。
+// 4096 個の図形に対して 1 つの図形を当てる 1 対 多の判定を繰り返し、
+// IsCollision を 1 つずつ呼ぶ場合と、TestCollisions の各 SIMD 段階を比べる。
+// "batch" 列は SIMD を切った TestCollisions（SoA からの読み出しと hits の書き込みを含む）。
+//
+// ビルド例（リポジトリのルートで）:
+//   g++ -std=c++20 -O2 -ISource -pthread Benchmark/IntersectionBenchmark.cpp Source/Collision/*.cpp Source/Job/*.cpp Source/Profiler/Profiler.cpp Source/Math/CpuFeatures.cpp Source/Math/Math3D.cpp Source/Math/MatrixKernels.cpp
+#include "Collision/CollisionBatch.h"
+#include "Math/Math3D.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr size_t kTargetCount = 4096;
+constexpr int kQueryCount = 256;
+
+std::mt19937 rng(12345);
+
+float Random(float min, float max) { return std::uniform_real_distribution<float>(min, max)(rng); }
+
+Vector3 RandomVector(float range) { return {Random(-range, range), Random(-range, range), Random(-range, range)}; }
+
+// 対象の図形（AoS と SoA の両方）
+struct Scene {
+	std::vector<Sphere> spheres;
+	std::vector<AABB> aabbs;
+	std::vector<Triangle> triangles;
+	std::vector<Capsule> capsules;
+	SphereBatch sphereBatch;
+	AABBBatch aabbBatch;
+	TriangleBatch triangleBatch;
+	CapsuleBatch capsuleBatch;
+};
+
+Scene MakeScene() {
+	Scene scene;
+	for (size_t i = 0; i < kTargetCount; ++i) {
+		Sphere sphere;
+		sphere.center = RandomVector(20.0f);
+		sphere.radius = Random(0.2f, 1.5f);
+		scene.spheres.push_back(sphere);
+		scene.sphereBatch.Add(sphere);
+
+		AABB aabb;
+		const Vector3 center = RandomVector(20.0f);
+		const Vector3 extent = {Random(0.2f, 1.5f), Random(0.2f, 1.5f), Random(0.2f, 1.5f)};
+		aabb.min = center - extent;
+		aabb.max = center + extent;
+		scene.aabbs.push_back(aabb);
+		scene.aabbBatch.Add(aabb);
+
+		Triangle triangle;
+		const Vector3 anchor = RandomVector(20.0f);
+		for (Vector3& vertex : triangle.vertices) {
+			vertex = anchor + RandomVector(2.0f);
+		}
+		scene.triangles.push_back(triangle);
+		scene.triangleBatch.Add(triangle);
+
+		Capsule capsule;
+		capsule.segment.origin = RandomVector(20.0f);
+		capsule.segment.diff = RandomVector(2.0f);
+		capsule.radius = Random(0.2f, 1.0f);
+		scene.capsules.push_back(capsule);
+		scene.capsuleBatch.Add(capsule);
+	}
+	return scene;
+}
+
+// 1 回の呼び出しで kTargetCount 回判定する関数を測り、百万回/秒を返す
+template <typename Function> double MeasureMegaTestsPerSecond(Function&& testAll) {
+	size_t checksum = 0;
+	for (int q = 0; q < 8; ++q) {
+		checksum += testAll(q);
+	}
+	const auto start = std::chrono::steady_clock::now();
+	for (int q = 0; q < kQueryCount; ++q) {
+		checksum += testAll(q);
+	}
+	const auto end = std::chrono::steady_clock::now();
+	const double seconds = std::chrono::duration<double>(end - start).count();
+	// 最適化で消されないよう結果を使う
+	if (checksum == static_cast<size_t>(-1)) {
+		std::printf("!");
+	}
+	return static_cast<double>(kTargetCount) * kQueryCount / seconds * 1.0e-6;
+}
+
+// 1 つずつ IsCollision を呼ぶ場合
+template <typename Query, typename Target> double MeasureScalar(const std::vector<Query>& queries, const std::vector<Target>& targets) {
+	return MeasureMegaTestsPerSecond([&](int q) {
+		size_t hitCount = 0;
+		for (const Target& target : targets) {
+			hitCount += IsCollision(queries[q % queries.size()], target) ? 1 : 0;
+		}
+		return hitCount;
+	});
+}
+
+template <typename Query, typename TargetSoA> void Report(const char* name, const std::vector<Query>& queries, double scalar, const TargetSoA& targets) {
+	std::vector<uint8_t> hits(kTargetCount);
+	double batch[3] = {};
+	const SimdLevel levels[3] = {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2};
+	for (int l = 0; l < 3; ++l) {
+		SetSimdLevelOverride(levels[l]);
+		batch[l] = MeasureMegaTestsPerSecond([&](int q) { return TestCollisions(queries[q % queries.size()], targets, kTargetCount, hits.data()); });
+	}
+	ClearSimdLevelOverride();
+	std::printf("%-18s %10.1f %10.1f %10.1f %10.1f\n", name, scalar, batch[0], batch[1], batch[2]);
+}
+
+} // namespace
+
+int main() {
+	const Scene scene = MakeScene();
+
+	std::vector<Sphere> sphereQueries;
+	std::vector<AABB> aabbQueries;
+	std::vector<Plane> planeQueries;
+	std::vector<Ray> rayQueries;
+	std::vector<Segment> segmentQueries;
+	std::vector<Capsule> capsuleQueries;
+	for (int q = 0; q < kQueryCount; ++q) {
+		sphereQueries.push_back(scene.spheres[q]);
+		aabbQueries.push_back(scene.aabbs[q]);
+		capsuleQueries.push_back(scene.capsules[q]);
+
+		Plane plane;
+		plane.normal = Normalize(RandomVector(1.0f));
+		plane.distance = Random(-10.0f, 10.0f);
+		planeQueries.push_back(plane);
+
+		Segment segment;
+		segment.origin = RandomVector(20.0f);
+		segment.diff = RandomVector(20.0f);
+		segmentQueries.push_back(segment);
+		rayQueries.push_back({segment.origin, segment.diff});
+	}
+
+	std::printf("target count: %zu  (million tests / sec, simd: %s)\n", kTargetCount, ToString(GetSimdLevel()));
+	std::printf("%-18s %10s %10s %10s %10s\n", "pair", "scalar", "batch", "batch sse2", "batch avx2");
+	Report("sphere/sphere", sphereQueries, MeasureScalar(sphereQueries, scene.spheres), scene.sphereBatch.View());
+	Report("sphere/aabb", sphereQueries, MeasureScalar(sphereQueries, scene.aabbs), scene.aabbBatch.View());
+	Report("aabb/sphere", aabbQueries, MeasureScalar(aabbQueries, scene.spheres), scene.sphereBatch.View());
+	Report("aabb/aabb", aabbQueries, MeasureScalar(aabbQueries, scene.aabbs), scene.aabbBatch.View());
+	Report("plane/sphere", planeQueries, MeasureScalar(planeQueries, scene.spheres), scene.sphereBatch.View());
+	Report("plane/aabb", planeQueries, MeasureScalar(planeQueries, scene.aabbs), scene.aabbBatch.View());
+	Report("ray/aabb", rayQueries, MeasureScalar(rayQueries, scene.aabbs), scene.aabbBatch.View());
+	Report("segment/aabb", segmentQueries, MeasureScalar(segmentQueries, scene.aabbs), scene.aabbBatch.View());
+	Report("ray/triangle", rayQueries, MeasureScalar(rayQueries, scene.triangles), scene.triangleBatch.View());
+	Report("segment/triangle", segmentQueries, MeasureScalar(segmentQueries, scene.triangles), scene.triangleBatch.View());
+	Report("sphere/capsule", sphereQueries, MeasureScalar(sphereQueries, scene.capsules), scene.capsuleBatch.View());
+	Report("capsule/capsule", capsuleQueries, MeasureScalar(capsuleQueries, scene.capsules), scene.capsuleBatch.View());
+
+	// 一括版の無い組み合わせはスカラーのみ
+	std::printf("%-18s %10.1f\n", "sphere/triangle", MeasureScalar(sphereQueries, scene.triangles));
+	std::printf("%-18s %10.1f\n", "aabb/triangle", MeasureScalar(aabbQueries, scene.triangles));
+	std::printf("%-18s %10.1f\n", "plane/capsule", MeasureScalar(planeQueries, scene.capsules));
+	return 0;
+}
@@ -0,0 +1,955 @@
+// float の数学関数を double の参照実装と比べ、誤差（ULP）と速度を並べて出す。
+// 近似版や SIMD 版（SlerpFast、MakeAffineMatrices など）を呼び出し元ごとに採用してよいかを判断するためのもの。
+//
+// 各関数を乱数の入力と、壊れやすい入力（特異に近い行列、正反対の Quaternion、長さ 0 や極端な大きさのベクトル、
+// 0 や π に近い角度など）で評価する。参照は同じ式を double で計算したもので、
+// 成分ごとの誤差を「max(|参照値|, 出力の大きさ)」における float の ULP で数える。
+// 出力の大きさはベクトルなら長さ、行列なら行の長さ、内積や積なら各項の絶対値の和で、
+// 打ち消しで 0 に近くなった成分の相対誤差が跳ね上がらないようにしている。
+// 関数が約束どおり特別な値（単位行列、零ベクトルなど）を返した入力は誤差に含めず「reject」に数える。
+//
+// 最後に SlerpFast と double の Slerp の回転角の差を、2 つの回転の差と t を細かく振って調べ、
+// Quaternion.h に書いた上限（全体 1e-3 rad、90 度以内 1e-4 rad）を超えたら終了コード 1 を返す。
+// --filter Quaternion/SlerpFast でこの掃引だけを実行できる。
+// 同じく Decompose の往復（正の拡大縮小、鏡映、0 に近い拡大縮小）と、バッチ版が 1 つずつの版と一致するかを調べ、
+// 外れたら終了コード 1 を返す（--filter Quaternion/Decompose）。
+//
+// 速度は乱数の入力 1024 個に対する 1 回あたりの時間（BenchmarkHarness.h の中央値）。
+// --filter で関数名を絞り、--json で結果を書き出す。--quick で速度の計測を短くする。
+//
+// ビルド例（リポジトリのルートで）:
+//   g++ -std=c++20 -O2 -ISource Benchmark/MathAccuracyBenchmark.cpp Source/Math/CpuFeatures.cpp Source/Math/Math3D.cpp Source/Math/MatrixKernels.cpp Source/Quaternion/Quaternion.cpp
+#include "BenchmarkHarness.h"
+#include "Math/CpuFeatures.h"
+#include "Math/Math3D.h"
+#include "Quaternion/Quaternion.h"
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr size_t kSampleCount = 1 << 15;
+constexpr size_t kTimingBatch = 1024;
+constexpr double kPi = 3.14159265358979323846;
+
+//==================================
+// double の参照型
+//==================================
+
+struct Vec3d {
+	double x, y, z;
+};
+
+struct Mat4d {
+	double m[4][4];
+};
+
+struct Quatd {
+	double x, y, z, w;
+};
+
+Vec3d ToDouble(const Vector3& v) { return {v.x, v.y, v.z}; }
+Quatd ToDouble(const Quaternion& q) { return {q.x, q.y, q.z, q.w}; }
+Mat4d ToDouble(const Matrix4x4& m) {
+	Mat4d r;
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			r.m[i][j] = m.m[i][j];
+		}
+	}
+	return r;
+}
+
+double LengthOf(const Vec3d& v) { return std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z); }
+double NormOf(const Quatd& q) { return std::sqrt(q.x * q.x + q.y * q.y + q.z * q.z + q.w * q.w); }
+double RowLength(const Mat4d& m, int row) { return std::sqrt(m.m[row][0] * m.m[row][0] + m.m[row][1] * m.m[row][1] + m.m[row][2] * m.m[row][2] + m.m[row][3] * m.m[row][3]); }
+
+bool IsIdentity(const Matrix4x4& m) {
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			if (m.m[i][j] != (i == j ? 1.0f : 0.0f)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+//==================================
+// 誤差の集計
+//==================================
+
+// |got - ref| を max(|ref|, scale) における float の ULP で数える
+double UlpError(float got, double ref, double scale) {
+	if (!std::isfinite(got)) {
+		return INFINITY;
+	}
+	int exponent = 0;
+	std::frexp((std::max)(std::fabs(ref), scale), &exponent);
+	const double ulp = std::ldexp(1.0, (std::max)(exponent - 24, -149));
+	return std::fabs(static_cast<double>(got) - ref) / ulp;
+}
+
+struct ErrorStats {
+	double maxUlp = 0.0;
+	double sumUlp = 0.0;
+	size_t count = 0;
+	size_t nonFinite = 0;
+	size_t rejected = 0;
+
+	void Add(float got, double ref, double scale) {
+		const double ulp = UlpError(got, ref, scale);
+		if (!std::isfinite(ulp)) {
+			++nonFinite;
+			return;
+		}
+		maxUlp = (std::max)(maxUlp, ulp);
+		sumUlp += ulp;
+		++count;
+	}
+	void Add(const Vector3& got, const Vec3d& ref, double scale) {
+		Add(got.x, ref.x, scale);
+		Add(got.y, ref.y, scale);
+		Add(got.z, ref.z, scale);
+	}
+	// 成分ごとに別の大きさ（各項の絶対値の和など）を使う
+	void Add(const Vector3& got, const Vec3d& ref, const Vec3d& scale) {
+		Add(got.x, ref.x, scale.x);
+		Add(got.y, ref.y, scale.y);
+		Add(got.z, ref.z, scale.z);
+	}
+	void Add(const Quaternion& got, const Quatd& ref, double scale) {
+		Add(got.x, ref.x, scale);
+		Add(got.y, ref.y, scale);
+		Add(got.z, ref.z, scale);
+		Add(got.w, ref.w, scale);
+	}
+	// 行ごとに参照の行の長さを大きさにする
+	void Add(const Matrix4x4& got, const Mat4d& ref) {
+		for (int i = 0; i < 4; ++i) {
+			const double scale = RowLength(ref, i);
+			for (int j = 0; j < 4; ++j) {
+				Add(got.m[i][j], ref.m[i][j], scale);
+			}
+		}
+	}
+	void Add(const Matrix4x4& got, const Mat4d& ref, const Mat4d& scale) {
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				Add(got.m[i][j], ref.m[i][j], scale.m[i][j]);
+			}
+		}
+	}
+	// q と -q は同じ回転なので、参照に近い方の符号で比べる
+	void AddRotation(const Quaternion& got, const Quatd& ref) {
+		const double dot = got.x * ref.x + got.y * ref.y + got.z * ref.z + got.w * ref.w;
+		const double sign = dot < 0.0 ? -1.0 : 1.0;
+		Add(got, {sign * ref.x, sign * ref.y, sign * ref.z, sign * ref.w}, NormOf(ref));
+	}
+};
+
+//==================================
+// 参照実装（double）
+//==================================
+
+Vec3d NormalizeRef(const Vec3d& v) {
+	const double length = LengthOf(v);
+	return length == 0.0 ? Vec3d{0.0, 0.0, 0.0} : Vec3d{v.x / length, v.y / length, v.z / length};
+}
+
+Vec3d CrossRef(const Vec3d& a, const Vec3d& b) { return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x}; }
+
+// 各項の絶対値の和（打ち消しのある計算の誤差の目安）
+Vec3d CrossScale(const Vec3d& a, const Vec3d& b) {
+	return {std::fabs(a.y * b.z) + std::fabs(a.z * b.y), std::fabs(a.z * b.x) + std::fabs(a.x * b.z), std::fabs(a.x * b.y) + std::fabs(a.y * b.x)};
+}
+
+void MultiplyRef(const Mat4d& a, const Mat4d& b, Mat4d& out, Mat4d& scale) {
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			out.m[i][j] = 0.0;
+			scale.m[i][j] = 0.0;
+			for (int k = 0; k < 4; ++k) {
+				out.m[i][j] += a.m[i][k] * b.m[k][j];
+				scale.m[i][j] += std::fabs(a.m[i][k] * b.m[k][j]);
+			}
+		}
+	}
+}
+
+// 部分ピボット選択の掃き出し法
+bool InverseRef(const Mat4d& in, Mat4d& out) {
+	double a[4][8];
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			a[i][j] = in.m[i][j];
+			a[i][j + 4] = i == j ? 1.0 : 0.0;
+		}
+	}
+	for (int column = 0; column < 4; ++column) {
+		int pivot = column;
+		for (int row = column + 1; row < 4; ++row) {
+			if (std::fabs(a[row][column]) > std::fabs(a[pivot][column])) {
+				pivot = row;
+			}
+		}
+		if (a[pivot][column] == 0.0) {
+			return false;
+		}
+		for (int j = 0; j < 8; ++j) {
+			std::swap(a[column][j], a[pivot][j]);
+		}
+		const double inv = 1.0 / a[column][column];
+		for (int j = 0; j < 8; ++j) {
+			a[column][j] *= inv;
+		}
+		for (int row = 0; row < 4; ++row) {
+			if (row == column) {
+				continue;
+			}
+			const double factor = a[row][column];
+			for (int j = 0; j < 8; ++j) {
+				a[row][j] -= factor * a[column][j];
+			}
+		}
+	}
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			out.m[i][j] = a[i][j + 4];
+		}
+	}
+	return true;
+}
+
+Mat4d MakeAffineRef(const Transform& t) {
+	const double sx = std::sin(static_cast<double>(t.rotation.x)), cx = std::cos(static_cast<double>(t.rotation.x));
+	const double sy = std::sin(static_cast<double>(t.rotation.y)), cy = std::cos(static_cast<double>(t.rotation.y));
+	const double sz = std::sin(static_cast<double>(t.rotation.z)), cz = std::cos(static_cast<double>(t.rotation.z));
+	const double s[3] = {t.scale.x, t.scale.y, t.scale.z};
+	return {{
+	    {s[0] * cy * cz, s[0] * cy * sz, -s[0] * sy, 0.0},
+	    {s[1] * (sx * sy * cz - cx * sz), s[1] * (sx * sy * sz + cx * cz), s[1] * sx * cy, 0.0},
+	    {s[2] * (cx * sy * cz + sx * sz), s[2] * (cx * sy * sz - sx * cz), s[2] * cx * cy, 0.0},
+	    {t.translation.x, t.translation.y, t.translation.z, 1.0},
+	}};
+}
+
+// Math3D の MakeRotateAxisAngle と同じ向き（sin の符号を反転した形）
+Mat4d MakeRotateAxisAngleRef(const Vec3d& a, double angle) {
+	const double c = std::cos(angle);
+	const double s = -std::sin(angle);
+	const double k = 1.0 - c;
+	return {{
+	    {c + a.x * a.x * k, a.x * a.y * k - a.z * s, a.x * a.z * k + a.y * s, 0.0},
+	    {a.y * a.x * k + a.z * s, c + a.y * a.y * k, a.y * a.z * k - a.x * s, 0.0},
+	    {a.z * a.x * k - a.y * s, a.z * a.y * k + a.x * s, c + a.z * a.z * k, 0.0},
+	    {0.0, 0.0, 0.0, 1.0},
+	}};
+}
+
+Quatd MultiplyRef(const Quatd& l, const Quatd& r) {
+	return {
+	    l.w * r.x + l.x * r.w + l.y * r.z - l.z * r.y,
+	    l.w * r.y - l.x * r.z + l.y * r.w + l.z * r.x,
+	    l.w * r.z + l.x * r.y - l.y * r.x + l.z * r.w,
+	    l.w * r.w - l.x * r.x - l.y * r.y - l.z * r.z,
+	};
+}
+
+Quatd NormalizeRef(const Quatd& q) {
+	const double n = NormOf(q);
+	return {q.x / n, q.y / n, q.z / n, q.w / n};
+}
+
+Vec3d RotateRef(const Vec3d& v, const Quatd& qIn) {
+	const Quatd q = NormalizeRef(qIn);
+	const Quatd p = MultiplyRef(MultiplyRef(q, {v.x, v.y, v.z, 0.0}), {-q.x, -q.y, -q.z, q.w});
+	return {p.x, p.y, p.z};
+}
+
+Mat4d MakeRotateMatrixRef(const Quatd& qIn) {
+	const Quatd q = NormalizeRef(qIn);
+	const double x = q.x, y = q.y, z = q.z, w = q.w;
+	return {{
+	    {1.0 - 2.0 * (y * y + z * z), 2.0 * (x * y + w * z), 2.0 * (x * z - w * y), 0.0},
+	    {2.0 * (x * y - w * z), 1.0 - 2.0 * (x * x + z * z), 2.0 * (y * z + w * x), 0.0},
+	    {2.0 * (x * z + w * y), 2.0 * (y * z - w * x), 1.0 - 2.0 * (x * x + y * y), 0.0},
+	    {0.0, 0.0, 0.0, 1.0},
+	}};
+}
+
+// Quaternion::Slerp と同じく短い経路を選び、ほぼ同じ向きなら線形補間する。
+// 回転の差がちょうど 180 度だと内積の符号が丸めで変わり、どちらの経路も正しいので、
+// 反転するかどうかは float 版と同じ式（float の内積の符号）で決める
+Quatd SlerpRef(const Quaternion& q0In, const Quaternion& q1In, double t) {
+	const bool flip = q0In.x * q1In.x + q0In.y * q1In.y + q0In.z * q1In.z + q0In.w * q1In.w < 0.0f;
+	Quatd q0 = ToDouble(q0In);
+	const Quatd q1 = ToDouble(q1In);
+	if (flip) {
+		q0 = {-q0.x, -q0.y, -q0.z, -q0.w};
+	}
+	const double dot = (std::min)(std::fabs(q0.x * q1.x + q0.y * q1.y + q0.z * q1.z + q0.w * q1.w), 1.0);
+	const double theta = std::acos(dot);
+	const double sinTheta = std::sin(theta);
+	double s0 = 1.0 - t;
+	double s1 = t;
+	if (sinTheta > 1e-12) {
+		s0 = std::sin((1.0 - t) * theta) / sinTheta;
+		s1 = std::sin(t * theta) / sinTheta;
+	}
+	return {s0 * q0.x + s1 * q1.x, s0 * q0.y + s1 * q1.y, s0 * q0.z + s1 * q1.z, s0 * q0.w + s1 * q1.w};
+}
+
+// 2 つの Quaternion が表す回転の角度の差（rad）
+double RotationAngle(const Quatd& a, const Quatd& b) {
+	const double dot = std::fabs(a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w) / (NormOf(a) * NormOf(b));
+	return 2.0 * std::acos((std::min)(dot, 1.0));
+}
+
+//==================================
+// 入力
+//==================================
+
+class Random {
+
+public:
+	float Uniform(float min, float max) { return std::uniform_real_distribution<float>(min, max)(rng_); }
+	// 10^minExponent 〜 10^maxExponent の大きさで符号も乱数
+	float LogUniform(float minExponent, float maxExponent) {
+		const float value = std::pow(10.0f, Uniform(minExponent, maxExponent));
+		return rng_() % 2 != 0 ? value : -value;
+	}
+	Vector3 InBox(float extent) { return {Uniform(-extent, extent), Uniform(-extent, extent), Uniform(-extent, extent)}; }
+	Vector3 WithMagnitude(float minExponent, float maxExponent) { return {LogUniform(minExponent, maxExponent), LogUniform(minExponent, maxExponent), LogUniform(minExponent, maxExponent)}; }
+	Vector3 UnitVector() {
+		Vector3 v;
+		do {
+			v = InBox(1.0f);
+		} while (Dot(v, v) < 1e-4f || Dot(v, v) > 1.0f);
+		return Normalize(v);
+	}
+	Quaternion UnitQuaternion() {
+		Quaternion q;
+		float n;
+		do {
+			q = Quaternion(Uniform(-1, 1), Uniform(-1, 1), Uniform(-1, 1), Uniform(-1, 1));
+			n = Quaternion::Norm(q);
+		} while (n < 1e-2f || n > 1.0f);
+		return Quaternion::Normalize(q);
+	}
+	Matrix4x4 Matrix() {
+		Matrix4x4 m;
+		for (auto& row : m.m) {
+			for (float& value : row) {
+				value = Uniform(-1.0f, 1.0f);
+			}
+		}
+		return m;
+	}
+	Transform RandomTransform(float angleRange) {
+		return {
+		    {Uniform(0.1f, 10.0f), Uniform(0.1f, 10.0f), Uniform(0.1f, 10.0f)},
+		    {Uniform(-angleRange, angleRange), Uniform(-angleRange, angleRange), Uniform(-angleRange, angleRange)},
+		    InBox(100.0f),
+		};
+	}
+	uint32_t Next() { return rng_(); }
+
+private:
+	std::mt19937 rng_{12345};
+};
+
+//==================================
+// 結果の表
+//==================================
+
+struct Row {
+	std::string routine;
+	std::string inputs;
+	ErrorStats stats;
+	double nanoseconds = -1.0; // 関数ごとに最初の行（乱数の入力）だけ
+};
+
+class Report {
+
+public:
+	Report(const Bench::Options& options, Bench::Runner& runner) : options_(options), runner_(runner) {}
+
+	bool Wants(const std::string& routine) const { return options_.filter.empty() || routine.find(options_.filter) != std::string::npos; }
+
+	// generate(random) で入力を作り、check(input, stats) で誤差を足す
+	template <typename Input, typename Generate, typename Check> void Evaluate(const std::string& routine, const std::string& inputs, Generate&& generate, Check&& check) {
+		if (!Wants(routine)) {
+			return;
+		}
+		Row row{routine, inputs, {}, -1.0};
+		for (size_t i = 0; i < kSampleCount; ++i) {
+			const Input input = generate(random_);
+			check(input, row.stats);
+		}
+		Print(row);
+		rows_.push_back(row);
+	}
+
+	// その関数の最初の行（乱数の入力）に速度を付ける
+	template <typename Input, typename Generate, typename Body> void Time(const std::string& routine, Generate&& generate, Body&& body) {
+		if (!Wants(routine)) {
+			return;
+		}
+		std::vector<Input> inputs;
+		for (size_t i = 0; i < kTimingBatch; ++i) {
+			inputs.push_back(generate(random_));
+		}
+		runner_.Run(routine, kTimingBatch, [&] {
+			for (const Input& input : inputs) {
+				Bench::DoNotOptimize(body(input));
+			}
+		});
+		const double nanoseconds = runner_.Results().back().medianNanoseconds;
+		for (Row& row : rows_) {
+			if (row.routine == routine) {
+				row.nanoseconds = nanoseconds;
+				break;
+			}
+		}
+		std::printf("%-40s %-26s %47s %10.2f ns\n", routine.c_str(), "(speed, random inputs)", "", nanoseconds);
+	}
+
+	void PrintHeader() const { std::printf("%-40s %-26s %8s %12s %10s %6s %6s %13s\n", "routine", "inputs", "samples", "max ulp", "mean ulp", "inf", "reject", "time/op"); }
+
+	bool WriteJson(const std::string& path) const {
+		std::FILE* file = std::fopen(path.c_str(), "w");
+		if (!file) {
+			return false;
+		}
+		std::fprintf(file, "{\n  \"context\": {\"simd\": \"%s\"},\n  \"accuracy\": [\n", ToString(GetSimdLevel()));
+		for (size_t i = 0; i < rows_.size(); ++i) {
+			const Row& r = rows_[i];
+			std::fprintf(file, "    {\"routine\": \"%s\", \"inputs\": \"%s\", \"samples\": %zu, \"maxUlp\": %.6g, \"meanUlp\": %.6g, \"nonFinite\": %zu, \"rejected\": %zu", r.routine.c_str(), r.inputs.c_str(),
+			             r.stats.count, r.stats.maxUlp, Mean(r.stats), r.stats.nonFinite, r.stats.rejected);
+			if (r.nanoseconds >= 0.0) {
+				std::fprintf(file, ", \"medianNs\": %.6g", r.nanoseconds);
+			}
+			std::fprintf(file, "}%s\n", i + 1 < rows_.size() ? "," : "");
+		}
+		std::fprintf(file, "  ]\n}\n");
+		std::fclose(file);
+		return true;
+	}
+
+	Random& GetRandom() { return random_; }
+
+private:
+	static double Mean(const ErrorStats& stats) { return stats.count == 0 ? 0.0 : stats.sumUlp / static_cast<double>(stats.count); }
+
+	void Print(const Row& row) const {
+		std::printf("%-40s %-26s %8zu %12.2f %10.3f %6zu %6zu\n", row.routine.c_str(), row.inputs.c_str(), row.stats.count, row.stats.maxUlp, Mean(row.stats), row.stats.nonFinite, row.stats.rejected);
+	}
+
+	const Bench::Options& options_;
+	Bench::Runner& runner_;
+	Random random_;
+	std::vector<Row> rows_;
+};
+
+//==================================
+// Vector3
+//==================================
+
+void CheckVector3(Report& report) {
+	struct Pair {
+		Vector3 a, b;
+	};
+	const auto random = [](Random& r) { return r.InBox(10.0f); };
+	const auto tiny = [](Random& r) { return r.WithMagnitude(-25.0f, -18.0f); };
+	const auto huge = [](Random& r) { return r.WithMagnitude(17.0f, 19.5f); };
+
+	const auto length = [](const Vector3& v, ErrorStats& stats) { stats.Add(Length(v), LengthOf(ToDouble(v)), 0.0); };
+	report.Evaluate<Vector3>("Vector3/Length", "random [-10, 10]", random, length);
+	report.Evaluate<Vector3>("Vector3/Length", "tiny (1e-25..1e-18)", tiny, length);
+	report.Evaluate<Vector3>("Vector3/Length", "huge (1e17..3e19)", huge, length);
+	report.Time<Vector3>("Vector3/Length", random, [](const Vector3& v) { return Length(v); });
+
+	// 長さが 0 に丸められた場合は零ベクトルを返す約束なので reject に数える
+	const auto normalize = [](const Vector3& v, ErrorStats& stats) {
+		const Vector3 got = Normalize(v);
+		if (Length(v) == 0.0f && got.x == 0.0f && got.y == 0.0f && got.z == 0.0f && (v.x != 0.0f || v.y != 0.0f || v.z != 0.0f)) {
+			++stats.rejected;
+			return;
+		}
+		stats.Add(got, NormalizeRef(ToDouble(v)), 1.0);
+	};
+	report.Evaluate<Vector3>("Vector3/Normalize", "random [-10, 10]", random, normalize);
+	report.Evaluate<Vector3>("Vector3/Normalize", "zero length", [](Random&) { return Vector3{0.0f, 0.0f, 0.0f}; }, normalize);
+	report.Evaluate<Vector3>("Vector3/Normalize", "tiny (1e-25..1e-18)", tiny, normalize);
+	report.Evaluate<Vector3>("Vector3/Normalize", "huge (1e17..3e19)", huge, normalize);
+	report.Time<Vector3>("Vector3/Normalize", random, [](const Vector3& v) { return Normalize(v); });
+
+	const auto randomPair = [](Random& r) { return Pair{r.InBox(10.0f), r.InBox(10.0f)}; };
+	// ほぼ平行（外積と、直交方向の内積で打ち消しが起きる）
+	const auto parallelPair = [](Random& r) {
+		const Vector3 a = r.InBox(10.0f);
+		return Pair{a, Multiply(a, r.Uniform(-2.0f, 2.0f)) + r.InBox(1e-4f)};
+	};
+	const auto dot = [](const Pair& p, ErrorStats& stats) {
+		const Vec3d a = ToDouble(p.a), b = ToDouble(p.b);
+		stats.Add(Dot(p.a, p.b), a.x * b.x + a.y * b.y + a.z * b.z, std::fabs(a.x * b.x) + std::fabs(a.y * b.y) + std::fabs(a.z * b.z));
+	};
+	report.Evaluate<Pair>("Vector3/Dot", "random [-10, 10]", randomPair, dot);
+	report.Evaluate<Pair>("Vector3/Dot", "nearly parallel", parallelPair, dot);
+	report.Time<Pair>("Vector3/Dot", randomPair, [](const Pair& p) { return Dot(p.a, p.b); });
+
+	const auto cross = [](const Pair& p, ErrorStats& stats) {
+		const Vec3d a = ToDouble(p.a), b = ToDouble(p.b);
+		stats.Add(Cross(p.a, p.b), CrossRef(a, b), CrossScale(a, b));
+	};
+	report.Evaluate<Pair>("Vector3/Cross", "random [-10, 10]", randomPair, cross);
+	report.Evaluate<Pair>("Vector3/Cross", "nearly parallel", parallelPair, cross);
+	report.Time<Pair>("Vector3/Cross", randomPair, [](const Pair& p) { return Cross(p.a, p.b); });
+
+	struct PointMatrix {
+		Vector3 point;
+		Matrix4x4 matrix;
+	};
+	const auto transformInput = [](Random& r) {
+		const Transform t = r.RandomTransform(3.14f);
+		return PointMatrix{r.InBox(100.0f), MakeAffineMatrix(t.scale, t.rotation, t.translation)};
+	};
+	report.Evaluate<PointMatrix>("Vector3/Vector3Transform", "random affine", transformInput, [](const PointMatrix& in, ErrorStats& stats) {
+		const Vec3d p = ToDouble(in.point);
+		const Mat4d m = ToDouble(in.matrix);
+		double out[4], scale[4];
+		for (int j = 0; j < 4; ++j) {
+			out[j] = p.x * m.m[0][j] + p.y * m.m[1][j] + p.z * m.m[2][j] + m.m[3][j];
+			scale[j] = std::fabs(p.x * m.m[0][j]) + std::fabs(p.y * m.m[1][j]) + std::fabs(p.z * m.m[2][j]) + std::fabs(m.m[3][j]);
+		}
+		// w で割る分の誤差は scale / |w| 程度に広がる
+		stats.Add(Vector3Transform(in.point, in.matrix), {out[0] / out[3], out[1] / out[3], out[2] / out[3]}, Vec3d{scale[0] / std::fabs(out[3]), scale[1] / std::fabs(out[3]), scale[2] / std::fabs(out[3])});
+	});
+	report.Time<PointMatrix>("Vector3/Vector3Transform", transformInput, [](const PointMatrix& in) { return Vector3Transform(in.point, in.matrix); });
+}
+
+//==================================
+// Matrix4x4
+//==================================
+
+void CheckMatrix(Report& report) {
+	struct Pair {
+		Matrix4x4 a, b;
+	};
+	const auto randomPair = [](Random& r) { return Pair{r.Matrix(), r.Matrix()}; };
+	report.Evaluate<Pair>("Matrix4x4/Multiply", "random [-1, 1]", randomPair, [](const Pair& p, ErrorStats& stats) {
+		Mat4d ref, scale;
+		MultiplyRef(ToDouble(p.a), ToDouble(p.b), ref, scale);
+		stats.Add(Multiply(p.a, p.b), ref, scale);
+	});
+	report.Time<Pair>("Matrix4x4/Multiply", randomPair, [](const Pair& p) { return Multiply(p.a, p.b); });
+
+	const auto random = [](Random& r) { return r.Matrix(); };
+	const auto affine = [](Random& r) {
+		const Transform t = r.RandomTransform(3.14f);
+		return MakeAffineMatrix(t.scale, t.rotation, t.translation);
+	};
+	// 4 行目を他の行の線形結合に近づける（条件数はおよそ 1e3〜1e5）
+	const auto nearSingular = [](Random& r) {
+		Matrix4x4 m = r.Matrix();
+		const float a = r.Uniform(-1.0f, 1.0f), b = r.Uniform(-1.0f, 1.0f);
+		const float noise = std::pow(10.0f, r.Uniform(-5.0f, -3.0f));
+		for (int j = 0; j < 4; ++j) {
+			m.m[3][j] = a * m.m[0][j] + b * m.m[1][j] + noise * r.Uniform(-1.0f, 1.0f);
+		}
+		return m;
+	};
+	// 特異と判定して単位行列を返したものは reject に数える
+	const auto inverse = [](auto&& function) {
+		return [function](const Matrix4x4& m, ErrorStats& stats) {
+			Mat4d ref;
+			const Matrix4x4 got = function(m);
+			if (!InverseRef(ToDouble(m), ref) || IsIdentity(got)) {
+				++stats.rejected;
+				return;
+			}
+			stats.Add(got, ref);
+		};
+	};
+	const auto general = inverse([](const Matrix4x4& m) { return Inverse(m); });
+	report.Evaluate<Matrix4x4>("Matrix4x4/Inverse", "random [-1, 1]", random, general);
+	report.Evaluate<Matrix4x4>("Matrix4x4/Inverse", "affine", affine, general);
+	report.Evaluate<Matrix4x4>("Matrix4x4/Inverse", "near singular", nearSingular, general);
+	report.Time<Matrix4x4>("Matrix4x4/Inverse", random, [](const Matrix4x4& m) { return Inverse(m); });
+	report.Evaluate<Matrix4x4>("Matrix4x4/InverseAffine", "affine", affine, inverse([](const Matrix4x4& m) { return InverseAffine(m); }));
+	report.Time<Matrix4x4>("Matrix4x4/InverseAffine", affine, [](const Matrix4x4& m) { return InverseAffine(m); });
+
+	const auto transform = [](float angleRange) { return [angleRange](Random& r) { return r.RandomTransform(angleRange); }; };
+	const auto affineExact = [](const Transform& t, ErrorStats& stats) { stats.Add(MakeAffineMatrix(t.scale, t.rotation, t.translation), MakeAffineRef(t)); };
+	report.Evaluate<Transform>("Matrix4x4/MakeAffineMatrix", "angles [-pi, pi]", transform(3.14f), affineExact);
+	report.Evaluate<Transform>("Matrix4x4/MakeAffineMatrix", "angles [-1000, 1000]", transform(1000.0f), affineExact);
+	report.Time<Transform>("Matrix4x4/MakeAffineMatrix", transform(3.14f), [](const Transform& t) { return MakeAffineMatrix(t.scale, t.rotation, t.translation); });
+
+	// SIMD 版は 4 個ずつ作るので、4 個まとめて評価する
+	struct Transforms4 {
+		Transform t[4];
+	};
+	const auto transform4 = [](float angleRange) {
+		return [angleRange](Random& r) {
+			Transforms4 in;
+			for (Transform& t : in.t) {
+				t = r.RandomTransform(angleRange);
+			}
+			return in;
+		};
+	};
+	const auto affineBatch = [](const Transforms4& in, ErrorStats& stats) {
+		Matrix4x4 out[4];
+		MakeAffineMatrices(in.t, out, 4);
+		for (int i = 0; i < 4; ++i) {
+			stats.Add(out[i], MakeAffineRef(in.t[i]));
+		}
+	};
+	report.Evaluate<Transforms4>("Matrix4x4/MakeAffineMatrices (x4)", "angles [-pi, pi]", transform4(3.14f), affineBatch);
+	report.Evaluate<Transforms4>("Matrix4x4/MakeAffineMatrices (x4)", "angles [-1000, 1000]", transform4(1000.0f), affineBatch);
+	report.Time<Transforms4>("Matrix4x4/MakeAffineMatrices (x4)", transform4(3.14f), [](const Transforms4& in) {
+		Matrix4x4 out[4];
+		MakeAffineMatrices(in.t, out, 4);
+		return out[3];
+	});
+
+	struct AxisAngle {
+		Vector3 axis;
+		float angle;
+	};
+	const auto axisAngle = [](float minAngle, float maxAngle) {
+		return [minAngle, maxAngle](Random& r) {
+			const float angle = r.Uniform(minAngle, maxAngle);
+			return AxisAngle{r.UnitVector(), r.Next() % 2 != 0 ? angle : -angle};
+		};
+	};
+	const auto rotateAxisAngle = [](const AxisAngle& in, ErrorStats& stats) { stats.Add(MakeRotateAxisAngle(in.axis, in.angle), MakeRotateAxisAngleRef(ToDouble(in.axis), in.angle)); };
+	report.Evaluate<AxisAngle>("Matrix4x4/MakeRotateAxisAngle", "angles [-pi, pi]", axisAngle(0.0f, 3.14159f), rotateAxisAngle);
+	report.Evaluate<AxisAngle>("Matrix4x4/MakeRotateAxisAngle", "near 0 (< 1e-3)", axisAngle(0.0f, 1e-3f), rotateAxisAngle);
+	report.Evaluate<AxisAngle>("Matrix4x4/MakeRotateAxisAngle", "near pi", axisAngle(3.1405f, 3.1425f), rotateAxisAngle);
+	report.Evaluate<AxisAngle>("Matrix4x4/MakeRotateAxisAngle", "large (100..10000)", axisAngle(100.0f, 10000.0f), rotateAxisAngle);
+	report.Time<AxisAngle>("Matrix4x4/MakeRotateAxisAngle", axisAngle(0.0f, 3.14159f), [](const AxisAngle& in) { return MakeRotateAxisAngle(in.axis, in.angle); });
+}
+
+//==================================
+// Quaternion
+//==================================
+
+void CheckQuaternion(Report& report) {
+	const auto random = [](Random& r) { return Quaternion(r.Uniform(-2, 2), r.Uniform(-2, 2), r.Uniform(-2, 2), r.Uniform(-2, 2)); };
+	const auto tiny = [](Random& r) { return Quaternion(r.LogUniform(-6.5f, -5.0f), r.LogUniform(-6.5f, -5.0f), r.LogUniform(-6.5f, -5.0f), r.LogUniform(-6.5f, -5.0f)); };
+	// 長さが kEps（1e-6）を下回ると単位Quaternionを返す約束なので reject に数える
+	const auto normalize = [](const Quaternion& q, ErrorStats& stats) {
+		if (Quaternion::Norm(q) < 1.0e-6f) {
+			++stats.rejected;
+			return;
+		}
+		stats.Add(Quaternion::Normalize(q), NormalizeRef(ToDouble(q)), 1.0);
+	};
+	report.Evaluate<Quaternion>("Quaternion/Normalize", "random [-2, 2]", random, normalize);
+	report.Evaluate<Quaternion>("Quaternion/Normalize", "tiny (3e-7..1e-5)", tiny, normalize);
+	report.Time<Quaternion>("Quaternion/Normalize", random, [](const Quaternion& q) { return Quaternion::Normalize(q); });
+
+	struct Pair {
+		Quaternion a, b;
+	};
+	const auto unitPair = [](Random& r) { return Pair{r.UnitQuaternion(), r.UnitQuaternion()}; };
+	report.Evaluate<Pair>("Quaternion/Multiply", "unit", unitPair, [](const Pair& p, ErrorStats& stats) { stats.Add(Quaternion::Muyltiply(p.a, p.b), MultiplyRef(ToDouble(p.a), ToDouble(p.b)), 1.0); });
+	report.Time<Pair>("Quaternion/Multiply", unitPair, [](const Pair& p) { return Quaternion::Muyltiply(p.a, p.b); });
+
+	struct VectorRotation {
+		Vector3 v;
+		Quaternion q;
+	};
+	const auto vectorRotation = [](Random& r) { return VectorRotation{r.InBox(10.0f), r.UnitQuaternion()}; };
+	const auto rotate = [](const VectorRotation& in, ErrorStats& stats) { stats.Add(Quaternion::RottateVector(in.v, in.q), RotateRef(ToDouble(in.v), ToDouble(in.q)), LengthOf(ToDouble(in.v))); };
+	report.Evaluate<VectorRotation>("Quaternion/RottateVector", "unit", vectorRotation, rotate);
+	report.Time<VectorRotation>("Quaternion/RottateVector", vectorRotation, [](const VectorRotation& in) { return Quaternion::RottateVector(in.v, in.q); });
+	report.Evaluate<VectorRotation>("Quaternion/RotateVectorNormalized", "unit", vectorRotation,
+	                                [](const VectorRotation& in, ErrorStats& stats) { stats.Add(Quaternion::RotateVectorNormalized(in.v, in.q), RotateRef(ToDouble(in.v), ToDouble(in.q)), LengthOf(ToDouble(in.v))); });
+	report.Time<VectorRotation>("Quaternion/RotateVectorNormalized", vectorRotation, [](const VectorRotation& in) { return Quaternion::RotateVectorNormalized(in.v, in.q); });
+
+	const auto unit = [](Random& r) { return r.UnitQuaternion(); };
+	report.Evaluate<Quaternion>("Quaternion/MakeRotateMatrix", "unit", unit, [](const Quaternion& q, ErrorStats& stats) { stats.Add(Quaternion::MakeRotateMatrix(q), MakeRotateMatrixRef(ToDouble(q))); });
+	report.Time<Quaternion>("Quaternion/MakeRotateMatrix", unit, [](const Quaternion& q) { return Quaternion::MakeRotateMatrix(q); });
+
+	// 参照は元の Quaternion（行列への丸めの誤差も含む）
+	const auto fromMatrix = [](const Quaternion& q, ErrorStats& stats) {
+		const Mat4d ref = MakeRotateMatrixRef(ToDouble(q));
+		Matrix4x4 m;
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				m.m[i][j] = static_cast<float>(ref.m[i][j]);
+			}
+		}
+		stats.AddRotation(Quaternion::FromRotationMatrix(m), NormalizeRef(ToDouble(q)));
+	};
+	// 180 度に近い回転（w が 0 に近い）
+	const auto nearHalfTurn = [](Random& r) {
+		const Vector3 axis = r.UnitVector();
+		const float w = r.Uniform(-1e-3f, 1e-3f);
+		const float s = std::sqrt(1.0f - w * w);
+		return Quaternion(axis.x * s, axis.y * s, axis.z * s, w);
+	};
+	report.Evaluate<Quaternion>("Quaternion/FromRotationMatrix", "unit", unit, fromMatrix);
+	report.Evaluate<Quaternion>("Quaternion/FromRotationMatrix", "near 180 degrees", nearHalfTurn, fromMatrix);
+	report.Time<Matrix4x4>("Quaternion/FromRotationMatrix", [](Random& r) { return Quaternion::MakeRotateMatrix(r.UnitQuaternion()); }, [](const Matrix4x4& m) { return Quaternion::FromRotationMatrix(m); });
+
+	struct SlerpInput {
+		Quaternion q0, q1;
+		float t;
+	};
+	const auto slerpRandom = [](Random& r) { return SlerpInput{r.UnitQuaternion(), r.UnitQuaternion(), r.Uniform(0.0f, 1.0f)}; };
+	const auto slerpClose = [](Random& r) {
+		const Quaternion q0 = r.UnitQuaternion();
+		const Quaternion q1 = Quaternion::Normalize(Quaternion(q0.x + r.Uniform(-1e-4f, 1e-4f), q0.y + r.Uniform(-1e-4f, 1e-4f), q0.z + r.Uniform(-1e-4f, 1e-4f), q0.w + r.Uniform(-1e-4f, 1e-4f)));
+		return SlerpInput{q0, q1, r.Uniform(0.0f, 1.0f)};
+	};
+	const auto slerpAntipodal = [](Random& r) {
+		const Quaternion q0 = r.UnitQuaternion();
+		return SlerpInput{q0, Quaternion(-q0.x, -q0.y, -q0.z, -q0.w), r.Uniform(0.0f, 1.0f)};
+	};
+	const auto slerpNearAntipodal = [slerpClose](Random& r) {
+		SlerpInput in = slerpClose(r);
+		in.q1 = Quaternion(-in.q1.x, -in.q1.y, -in.q1.z, -in.q1.w);
+		return in;
+	};
+	// 4 次元で直交（回転の差が 180 度、内積がほぼ 0）
+	const auto slerpOrthogonal = [](Random& r) {
+		const Quaternion q0 = r.UnitQuaternion();
+		return SlerpInput{q0, Quaternion(q0.w, -q0.z, q0.y, -q0.x), r.Uniform(0.0f, 1.0f)};
+	};
+	const auto slerp = [](auto&& function) {
+		return [function](const SlerpInput& in, ErrorStats& stats) { stats.AddRotation(function(in.q0, in.q1, in.t), SlerpRef(in.q0, in.q1, in.t)); };
+	};
+	for (const auto& [routine, check] : {
+	         std::pair<std::string, std::function<void(const SlerpInput&, ErrorStats&)>>{"Quaternion/Slerp", slerp([](const Quaternion& a, const Quaternion& b, float t) { return Quaternion::Slerp(a, b, t); })},
+	         std::pair<std::string, std::function<void(const SlerpInput&, ErrorStats&)>>{"Quaternion/SlerpFast", slerp([](const Quaternion& a, const Quaternion& b, float t) { return Quaternion::SlerpFast(a, b, t); })},
+	     }) {
+		report.Evaluate<SlerpInput>(routine, "unit", slerpRandom, check);
+		report.Evaluate<SlerpInput>(routine, "nearly identical", slerpClose, check);
+		report.Evaluate<SlerpInput>(routine, "antipodal (q1 = -q0)", slerpAntipodal, check);
+		report.Evaluate<SlerpInput>(routine, "nearly antipodal", slerpNearAntipodal, check);
+		report.Evaluate<SlerpInput>(routine, "orthogonal (180 degrees)", slerpOrthogonal, check);
+	}
+	report.Time<SlerpInput>("Quaternion/Slerp", slerpRandom, [](const SlerpInput& in) { return Quaternion::Slerp(in.q0, in.q1, in.t); });
+	report.Time<SlerpInput>("Quaternion/SlerpFast", slerpRandom, [](const SlerpInput& in) { return Quaternion::SlerpFast(in.q0, in.q1, in.t); });
+}
+
+//==================================
+// SlerpFast の回転角の誤差
+//==================================
+
+// 2 つの回転の差を 0〜180 度、t を 0〜1 で振り、double の Slerp との回転角の差の最大を求める。
+// Quaternion.h に書いた上限を超えたら false
+bool CheckSlerpFastBound(Random& random) {
+	// 実測の最大（7.8e-4 / 7.3e-5）に、演算順やコンパイラの違いの分の余裕を持たせた値
+	constexpr double kBound = 1.0e-3;
+	constexpr double kBoundWithin90 = 1.0e-4;
+	constexpr int kAngleSteps = 720;
+	constexpr int kTSteps = 256;
+	constexpr int kAxisCount = 8;
+
+	double maxError = 0.0;
+	double maxErrorWithin90 = 0.0;
+	double worstDegrees = 0.0;
+	double worstT = 0.0;
+	for (int axisIndex = 0; axisIndex < kAxisCount; ++axisIndex) {
+		const Quaternion q0 = random.UnitQuaternion();
+		const Vector3 axis = random.UnitVector();
+		for (int a = 0; a <= kAngleSteps; ++a) {
+			const double degrees = 180.0 * a / kAngleSteps;
+			const Quaternion delta = Quaternion::MakeRotateAxisAngleQuaternion(axis, static_cast<float>(degrees * kPi / 180.0));
+			const Quaternion q1 = Quaternion::Muyltiply(q0, delta);
+			for (int i = 0; i <= kTSteps; ++i) {
+				const float t = static_cast<float>(i) / kTSteps;
+				const double error = RotationAngle(ToDouble(Quaternion::SlerpFast(q0, q1, t)), SlerpRef(q0, q1, t));
+				if (error > maxError) {
+					maxError = error;
+					worstDegrees = degrees;
+					worstT = t;
+				}
+				if (degrees <= 90.0) {
+					maxErrorWithin90 = (std::max)(maxErrorWithin90, error);
+				}
+			}
+		}
+	}
+	const bool ok = maxError <= kBound && maxErrorWithin90 <= kBoundWithin90;
+	std::printf("\nSlerpFast angular error vs double Slerp (%d axes x %d angles x %d t)\n", kAxisCount, kAngleSteps + 1, kTSteps + 1);
+	std::printf("  all angles : max %.3e rad (bound %.1e) at %.2f degrees, t = %.3f\n", maxError, kBound, worstDegrees, worstT);
+	std::printf("  <= 90 deg  : max %.3e rad (bound %.1e)\n", maxErrorWithin90, kBoundWithin90);
+	std::printf("  %s\n", ok ? "within documented bounds" : "EXCEEDS documented bounds");
+	return ok;
+}
+
+//==================================
+// Decompose の往復
+//==================================
+
+// Decompose の結果から行列を組み直す（MakeAffineMatrix と同じ並び：行 i が scale[i] 倍の回転の行、行 3 が平行移動）
+Matrix4x4 Recompose(const Vector3& scale, const Quaternion& rotation, const Vector3& translate) {
+	Matrix4x4 m = Quaternion::MakeRotateMatrix(rotation);
+	const float s[3] = {scale.x, scale.y, scale.z};
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 3; ++j) {
+			m.m[i][j] *= s[i];
+		}
+	}
+	m.m[3][0] = translate.x;
+	m.m[3][1] = translate.y;
+	m.m[3][2] = translate.z;
+	return m;
+}
+
+bool SameBits(float a, float b) { return std::memcmp(&a, &b, sizeof(float)) == 0; }
+bool SameBits(const Vector3& a, const Vector3& b) { return SameBits(a.x, b.x) && SameBits(a.y, b.y) && SameBits(a.z, b.z); }
+bool SameBits(const Quaternion& a, const Quaternion& b) { return SameBits(a.x, b.x) && SameBits(a.y, b.y) && SameBits(a.z, b.z) && SameBits(a.w, b.w); }
+
+// MakeAffineMatrix(s, r, t) → Decompose → 組み直しが元の行列に戻るかを、
+// 正の拡大縮小、1 軸が負（鏡映。scale.x が負になる経路）、1 軸が 0 に近い（false を返す経路）で調べる。
+// さらに DecomposeMany と FromRotationMatrices が SIMD の各段階で 1 つずつの版と同じビットを返すかを調べる。
+// どれかが外れたら false
+bool CheckDecompose(Random& random) {
+	// 組み直した行列の誤差の上限（行の長さにおける ULP）。実測の最大（約 11 ulp）に余裕を持たせた値
+	constexpr double kRoundTripBound = 32.0;
+	constexpr size_t kBatchCount = 1027; // 4 の倍数でない端数も通す
+
+	// 正の拡大縮小
+	ErrorStats positive;
+	size_t failures = 0;
+	for (size_t i = 0; i < kSampleCount; ++i) {
+		const Transform t = random.RandomTransform(3.14f);
+		Vector3 scale, translate;
+		Quaternion rotation;
+		if (!Quaternion::Decompose(MakeAffineMatrix(t.scale, t.rotation, t.translation), scale, rotation, translate) || scale.x < 0.0f) {
+			++failures;
+			continue;
+		}
+		positive.Add(Recompose(scale, rotation, translate), MakeAffineRef(t));
+	}
+
+	// 1 軸だけ負（どの軸でも Decompose は scale.x を負にして回転で吸収する）
+	ErrorStats mirrored;
+	for (size_t i = 0; i < kSampleCount; ++i) {
+		Transform t = random.RandomTransform(3.14f);
+		float* axis[3] = {&t.scale.x, &t.scale.y, &t.scale.z};
+		*axis[random.Next() % 3] *= -1.0f;
+		Vector3 scale, translate;
+		Quaternion rotation;
+		if (!Quaternion::Decompose(MakeAffineMatrix(t.scale, t.rotation, t.translation), scale, rotation, translate) || scale.x >= 0.0f) {
+			++failures;
+			continue;
+		}
+		mirrored.Add(Recompose(scale, rotation, translate), MakeAffineRef(t));
+	}
+
+	// 1 軸が 0 に近い（1e-9..1e-7）。false と単位Quaternionを返す約束
+	size_t degenerateFailures = 0;
+	for (size_t i = 0; i < kSampleCount; ++i) {
+		Transform t = random.RandomTransform(3.14f);
+		float* axis[3] = {&t.scale.x, &t.scale.y, &t.scale.z};
+		*axis[random.Next() % 3] = random.LogUniform(-9.0f, -7.0f);
+		Vector3 scale, translate;
+		Quaternion rotation;
+		const bool decomposed = Quaternion::Decompose(MakeAffineMatrix(t.scale, t.rotation, t.translation), scale, rotation, translate);
+		if (decomposed || !SameBits(rotation, Quaternion::IdentityQuaternion())) {
+			++degenerateFailures;
+		}
+	}
+
+	// バッチ版と 1 つずつの版（上の 3 種類を混ぜ、0 に近いものが 4 個の組に入る場合も通す）
+	std::vector<Matrix4x4> matrices(kBatchCount);
+	for (Matrix4x4& m : matrices) {
+		Transform t = random.RandomTransform(1000.0f);
+		float* axis[3] = {&t.scale.x, &t.scale.y, &t.scale.z};
+		switch (random.Next() % 8) {
+		case 0:
+			*axis[random.Next() % 3] = random.LogUniform(-9.0f, -7.0f);
+			break;
+		case 1:
+		case 2:
+			*axis[random.Next() % 3] *= -1.0f;
+			break;
+		default:
+			break;
+		}
+		m = MakeAffineMatrix(t.scale, t.rotation, t.translation);
+	}
+	std::vector<Vector3> expectedScales(kBatchCount), expectedTranslates(kBatchCount), scales(kBatchCount), translates(kBatchCount);
+	std::vector<Quaternion> expectedRotations(kBatchCount), expectedFromMatrix(kBatchCount), rotations(kBatchCount), fromMatrix(kBatchCount);
+	std::vector<Matrix4x4> rotationMatrices(kBatchCount);
+	for (size_t i = 0; i < kBatchCount; ++i) {
+		Quaternion::Decompose(matrices[i], expectedScales[i], expectedRotations[i], expectedTranslates[i]);
+		rotationMatrices[i] = Quaternion::MakeRotateMatrix(expectedRotations[i]);
+		expectedFromMatrix[i] = Quaternion::FromRotationMatrix(rotationMatrices[i]);
+	}
+	std::string batchMismatches;
+	for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2}) {
+		SetSimdLevelOverride(level);
+		Quaternion::DecomposeMany(matrices.data(), scales.data(), rotations.data(), translates.data(), kBatchCount);
+		Quaternion::FromRotationMatrices(rotationMatrices.data(), fromMatrix.data(), kBatchCount);
+		size_t decomposeMismatch = 0;
+		size_t fromMatrixMismatch = 0;
+		for (size_t i = 0; i < kBatchCount; ++i) {
+			if (!SameBits(scales[i], expectedScales[i]) || !SameBits(rotations[i], expectedRotations[i]) || !SameBits(translates[i], expectedTranslates[i])) {
+				++decomposeMismatch;
+			}
+			if (!SameBits(fromMatrix[i], expectedFromMatrix[i])) {
+				++fromMatrixMismatch;
+			}
+		}
+		if (decomposeMismatch != 0 || fromMatrixMismatch != 0) {
+			batchMismatches += std::string(" ") + ToString(GetSimdLevel()) + " (DecomposeMany " + std::to_string(decomposeMismatch) + ", FromRotationMatrices " + std::to_string(fromMatrixMismatch) + ")";
+		}
+	}
+	ClearSimdLevelOverride();
+
+	const bool ok = failures == 0 && degenerateFailures == 0 && batchMismatches.empty() && positive.nonFinite == 0 && mirrored.nonFinite == 0 && positive.maxUlp <= kRoundTripBound &&
+	                mirrored.maxUlp <= kRoundTripBound;
+	std::printf("\nDecompose round trip (MakeAffineMatrix -> Decompose -> rebuild, %zu samples each)\n", kSampleCount);
+	std::printf("  positive scale : max %.2f ulp (bound %.0f)\n", positive.maxUlp, kRoundTripBound);
+	std::printf("  mirrored       : max %.2f ulp (bound %.0f)\n", mirrored.maxUlp, kRoundTripBound);
+	std::printf("  wrong sign or false return: %zu, near-zero scale not rejected: %zu\n", failures, degenerateFailures);
+	std::printf("  batch vs scalar (%zu matrices):%s\n", kBatchCount, batchMismatches.empty() ? " identical at every SIMD level" : batchMismatches.c_str());
+	std::printf("  %s\n", ok ? "ok" : "FAILED");
+	return ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	Bench::Options options;
+	if (!options.Parse(argc, argv)) {
+		return 1;
+	}
+	const std::string jsonPath = options.jsonPath;
+	options.jsonPath.clear();
+	Bench::Runner runner(options);
+	runner.SetQuiet(true);
+
+	std::printf("simd: %s, %zu samples per input class\n", ToString(GetSimdLevel()), kSampleCount);
+	Report report(options, runner);
+	report.PrintHeader();
+	CheckVector3(report);
+	CheckMatrix(report);
+	CheckQuaternion(report);
+
+	bool ok = true;
+	if (report.Wants("Quaternion/SlerpFast")) {
+		ok = CheckSlerpFastBound(report.GetRandom()) && ok;
+	}
+	if (report.Wants("Quaternion/Decompose")) {
+		ok = CheckDecompose(report.GetRandom()) && ok;
+	}
+	if (!jsonPath.empty() && !report.WriteJson(jsonPath)) {
+		std::fprintf(stderr, "cannot write %s\n", jsonPath.c_str());
+		return 1;
+	}
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,257 @@
+// Math3D と Quaternion の公開関数を 1 つずつ測る。
+// どの関数も乱数で作った 1024 個の入力に順に適用し、1 回の呼び出しを 1 op として数える
+// （入力を変えるので、定数畳み込みや分岐予測の当たりすぎで速く見えることはない）。
+// 物理の更新（バネ・振り子など）は状態をコピーしてから進めるので、回を重ねても入力は変わらない。
+// 行列のバッチ関数（MatrixKernels.h）は、対応する 1 つずつの関数と並べて比べる。
+// スプラインは 1 区間を 1024 点に分ける時間を、点ごとの評価と前進差分（Tessellate）で比べる。
+//
+// 計測の方法と引数（--json / --baseline / --filter / --perf など）は BenchmarkHarness.h を参照。
+// 例: 変更前に --json before.json で保存し、変更後に --baseline before.json で増減を見る。
+//
+// ビルド例（リポジトリのルートで）:
+//   g++ -std=c++20 -O2 -ISource Benchmark/MathBenchmark.cpp Source/Math/CpuFeatures.cpp Source/Math/Math3D.cpp Source/Math/MatrixKernels.cpp Source/Math/Spline.cpp Source/Quaternion/Quaternion.cpp
+#include "BenchmarkHarness.h"
+#include "Math/CpuFeatures.h"
+#include "Math/Math3D.h"
+#include "Math/Spline.h"
+#include "Quaternion/Quaternion.h"
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr size_t kBatch = 1024;
+
+struct Inputs {
+	std::vector<Vector3> a, b, c, unit;
+	std::vector<float> scalar, t;
+	std::vector<Matrix4x4> m0, m1, affine;
+	std::vector<Transform> transforms;
+	std::vector<Quaternion> q0, q1;
+	std::vector<Segment> segments;
+	std::vector<AABB> aabbs;
+	std::vector<Ball> balls;
+	std::vector<Circular> circulars;
+	std::vector<Spring> springs;
+	std::vector<Pendulum> pendulums;
+	std::vector<ConicalPendulum> conicals;
+};
+
+Inputs MakeInputs() {
+	std::mt19937 rng(12345);
+	std::uniform_real_distribution<float> value(-10.0f, 10.0f);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> angle(-3.14f, 3.14f);
+	std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+	std::uniform_real_distribution<float> zeroToOne(0.0f, 1.0f);
+	auto randomVector = [&] { return Vector3{value(rng), value(rng), value(rng)}; };
+	auto randomQuaternion = [&] { return Quaternion::Normalize(Quaternion(unit(rng), unit(rng), unit(rng), unit(rng))); };
+
+	Inputs in;
+	for (size_t i = 0; i < kBatch; ++i) {
+		in.a.push_back(randomVector());
+		in.b.push_back(randomVector());
+		in.c.push_back(randomVector());
+		in.unit.push_back(Normalize(randomVector()));
+		in.scalar.push_back(value(rng));
+		in.t.push_back(zeroToOne(rng));
+
+		const Transform transform = {
+		    {scale(rng),  scale(rng),  scale(rng) },
+		    {angle(rng),  angle(rng),  angle(rng) },
+		    {value(rng),  value(rng),  value(rng) },
+		};
+		in.transforms.push_back(transform);
+		in.affine.push_back(MakeAffineMatrix(transform.scale, transform.rotation, transform.translation));
+		Matrix4x4 m0, m1;
+		for (int r = 0; r < 4; ++r) {
+			for (int c = 0; c < 4; ++c) {
+				m0.m[r][c] = unit(rng);
+				m1.m[r][c] = unit(rng);
+			}
+		}
+		in.m0.push_back(m0);
+		in.m1.push_back(m1);
+
+		in.q0.push_back(randomQuaternion());
+		in.q1.push_back(randomQuaternion());
+		in.segments.push_back({randomVector(), randomVector()});
+		in.aabbs.push_back({randomVector(), randomVector()});
+
+		Ball ball;
+		ball.position = randomVector();
+		ball.velocity = randomVector();
+		ball.angle = angle(rng);
+		in.balls.push_back(ball);
+		Circular circular;
+		circular.radius = scale(rng);
+		circular.isMove = true;
+		in.circulars.push_back(circular);
+		Spring spring;
+		spring.isMove = true;
+		in.springs.push_back(spring);
+		Pendulum pendulum;
+		pendulum.angle = angle(rng);
+		pendulum.isMove = true;
+		in.pendulums.push_back(pendulum);
+		ConicalPendulum conical;
+		conical.angle = angle(rng);
+		conical.isMove = true;
+		in.conicals.push_back(conical);
+	}
+	return in;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	Bench::Options options;
+	if (!options.Parse(argc, argv)) {
+		return 1;
+	}
+	Bench::Runner runner(options);
+	runner.AddContext("simd", ToString(GetSimdLevel()));
+
+	const Inputs in = MakeInputs();
+	std::vector<Vector3> vectors(kBatch);
+	std::vector<float> floats(kBatch);
+	std::vector<Matrix4x4> matrices(kBatch);
+	std::vector<Quaternion> quaternions(kBatch);
+	std::vector<Vector3> scales(kBatch), translates(kBatch);
+	std::vector<Ball> balls(kBatch);
+	std::vector<AABB> aabbs(kBatch);
+
+	// body(i) を入力の全要素に適用する 1 回を 1024 op として測る
+	auto measure = [&](const char* name, auto&& body) {
+		runner.Run(name, kBatch, [&] {
+			for (size_t i = 0; i < kBatch; ++i) {
+				body(i);
+			}
+			Bench::ClobberMemory();
+		});
+	};
+	// バッチ関数を 1 回呼んで 1024 op として測る
+	auto measureBatch = [&](const char* name, auto&& body) {
+		runner.Run(name, kBatch, [&] {
+			body();
+			Bench::ClobberMemory();
+		});
+	};
+
+	//==================================
+	// Vector3
+	//==================================
+	measure("Vector3/Add", [&](size_t i) { vectors[i] = Add(in.a[i], in.b[i]); });
+	measure("Vector3/Subtract", [&](size_t i) { vectors[i] = Subtract(in.a[i], in.b[i]); });
+	measure("Vector3/MultiplyScalar", [&](size_t i) { vectors[i] = Multiply(in.a[i], in.scalar[i]); });
+	measure("Vector3/Dot", [&](size_t i) { floats[i] = Dot(in.a[i], in.b[i]); });
+	measure("Vector3/Cross", [&](size_t i) { vectors[i] = Cross(in.a[i], in.b[i]); });
+	measure("Vector3/Length", [&](size_t i) { floats[i] = Length(in.a[i]); });
+	measure("Vector3/Normalize", [&](size_t i) { vectors[i] = Normalize(in.a[i]); });
+	measure("Vector3/Project", [&](size_t i) { vectors[i] = Project(in.a[i], in.b[i]); });
+	measure("Vector3/Reflect", [&](size_t i) { vectors[i] = Reflect(in.a[i], in.unit[i]); });
+	measure("Vector3/Lerp", [&](size_t i) { vectors[i] = Lerp(in.a[i], in.b[i], in.t[i]); });
+	measure("Vector3/Bezier", [&](size_t i) { vectors[i] = Bezier(in.a[i], in.b[i], in.c[i], in.t[i]); });
+	measure("Vector3/closestPoint", [&](size_t i) { vectors[i] = closestPoint(in.a[i], in.segments[i]); });
+	measure("Vector3/Vector3Transform", [&](size_t i) { vectors[i] = Vector3Transform(in.a[i], in.affine[i]); });
+
+	//==================================
+	// Matrix4x4
+	//==================================
+	measure("Matrix4x4/Add", [&](size_t i) { matrices[i] = Add(in.m0[i], in.m1[i]); });
+	measure("Matrix4x4/Subtract", [&](size_t i) { matrices[i] = Subtract(in.m0[i], in.m1[i]); });
+	measure("Matrix4x4/Multiply", [&](size_t i) { matrices[i] = Multiply(in.m0[i], in.m1[i]); });
+	measureBatch("Matrix4x4/MultiplyMany", [&] { MultiplyMany(in.m0.data(), in.m1.data(), matrices.data(), kBatch); });
+	measure("Matrix4x4/Transpose", [&](size_t i) { matrices[i] = Transpose(in.m0[i]); });
+	measure("Matrix4x4/Inverse", [&](size_t i) { matrices[i] = Inverse(in.m0[i]); });
+	measureBatch("Matrix4x4/InverseMany", [&] { InverseMany(in.m0.data(), matrices.data(), kBatch); });
+	measure("Matrix4x4/InverseAffine", [&](size_t i) { matrices[i] = InverseAffine(in.affine[i]); });
+	measure("Matrix4x4/MakeNormalMatrix", [&](size_t i) { matrices[i] = MakeNormalMatrix(in.affine[i]); });
+	measure("Matrix4x4/MakeIdentity4x4", [&](size_t i) { matrices[i] = MakeIdentity4x4(); });
+	measure("Matrix4x4/MakeRotateMatrixX", [&](size_t i) { matrices[i] = MakeRotateMatrix(X, in.scalar[i]); });
+	measure("Matrix4x4/MakeRotateMatrixY", [&](size_t i) { matrices[i] = MakeRotateMatrix(Y, in.scalar[i]); });
+	measure("Matrix4x4/MakeRotateMatrixZ", [&](size_t i) { matrices[i] = MakeRotateMatrix(Z, in.scalar[i]); });
+	measure("Matrix4x4/MakeTranslateMatrix", [&](size_t i) { matrices[i] = MakeTranslateMatrix(in.a[i]); });
+	measure("Matrix4x4/MakeScaleMatrix", [&](size_t i) { matrices[i] = MakeScaleMatrix(in.a[i]); });
+	measure("Matrix4x4/MakeAffineMatrix", [&](size_t i) {
+		const Transform& transform = in.transforms[i];
+		matrices[i] = MakeAffineMatrix(transform.scale, transform.rotation, transform.translation);
+	});
+	measureBatch("Matrix4x4/MakeAffineMatrices", [&] { MakeAffineMatrices(in.transforms.data(), matrices.data(), kBatch); });
+	measure("Matrix4x4/MakeRotateAxisAngle", [&](size_t i) { matrices[i] = MakeRotateAxisAngle(in.unit[i], in.scalar[i]); });
+	measure("Matrix4x4/DirectionToDirection", [&](size_t i) { matrices[i] = DirectionToDirection(in.unit[i], Normalize(in.b[i])); });
+	measure("Matrix4x4/MakePerspectiveFovMatrix", [&](size_t i) { matrices[i] = MakePerspectiveFovMatrix(0.45f + in.t[i], 16.0f / 9.0f, 0.1f, 100.0f); });
+	measure("Matrix4x4/MakeOrthographicMatrix", [&](size_t i) { matrices[i] = MakeOrthographicMatrix(-in.scalar[i], 10.0f, in.scalar[i] + 21.0f, -10.0f, 0.0f, 100.0f); });
+	measure("Matrix4x4/MakeViewportMatrix", [&](size_t i) { matrices[i] = MakeViewportMatrix(0.0f, 0.0f, 1280.0f + in.scalar[i], 720.0f, 0.0f, 1.0f); });
+	measure("AABB/keepMinMax", [&](size_t i) {
+		aabbs[i] = in.aabbs[i];
+		keepMinMax(aabbs[i]);
+	});
+
+	//==================================
+	// 物理の更新
+	//==================================
+	measure("Physics/CircularMotion", [&](size_t i) {
+		Circular circular = in.circulars[i];
+		balls[i] = in.balls[i];
+		CircularMotion(balls[i], circular);
+	});
+	measure("Physics/UpdateSpring", [&](size_t i) {
+		Spring spring = in.springs[i];
+		balls[i] = in.balls[i];
+		UpdateSpring(balls[i], spring);
+	});
+	measure("Physics/UpdatePendulum", [&](size_t i) {
+		Pendulum pendulum = in.pendulums[i];
+		balls[i] = in.balls[i];
+		UpdatePendulum(balls[i], pendulum);
+	});
+	measure("Physics/InitializeConicalPendulum", [&](size_t i) {
+		ConicalPendulum conical = in.conicals[i];
+		balls[i] = in.balls[i];
+		InitializeConicalPendulum(conical, balls[i]);
+	});
+	measure("Physics/UpdateConicalPendulum", [&](size_t i) {
+		ConicalPendulum conical = in.conicals[i];
+		balls[i] = in.balls[i];
+		UpdateConicalPendulum(balls[i], conical);
+	});
+
+	//==================================
+	// Quaternion
+	//==================================
+	measure("Quaternion/Multiply", [&](size_t i) { quaternions[i] = Quaternion::Muyltiply(in.q0[i], in.q1[i]); });
+	measure("Quaternion/Conjugate", [&](size_t i) { quaternions[i] = Quaternion::Conjugate(in.q0[i]); });
+	measure("Quaternion/Norm", [&](size_t i) { floats[i] = Quaternion::Norm(in.q0[i]); });
+	measure("Quaternion/Normalize", [&](size_t i) { quaternions[i] = Quaternion::Normalize(in.q0[i]); });
+	measure("Quaternion/Inverse", [&](size_t i) { quaternions[i] = Quaternion::Inverse(in.q0[i]); });
+	measure("Quaternion/MakeRotateAxisAngleQuaternion", [&](size_t i) { quaternions[i] = Quaternion::MakeRotateAxisAngleQuaternion(in.unit[i], in.scalar[i]); });
+	measure("Quaternion/RottateVector", [&](size_t i) { vectors[i] = Quaternion::RottateVector(in.a[i], in.q0[i]); });
+	measure("Quaternion/RotateVectorNormalized", [&](size_t i) { vectors[i] = Quaternion::RotateVectorNormalized(in.a[i], in.q0[i]); });
+	measureBatch("Quaternion/RotateVectors", [&] { Quaternion::RotateVectors(in.q0[0], in.a.data(), vectors.data(), kBatch); });
+	measure("Quaternion/MakeRotateMatrix", [&](size_t i) { matrices[i] = Quaternion::MakeRotateMatrix(in.q0[i]); });
+	measure("Quaternion/FromRotationMatrix", [&](size_t i) { quaternions[i] = Quaternion::FromRotationMatrix(in.affine[i]); });
+	measureBatch("Quaternion/FromRotationMatrices", [&] { Quaternion::FromRotationMatrices(in.affine.data(), quaternions.data(), kBatch); });
+	measure("Quaternion/Decompose", [&](size_t i) { Quaternion::Decompose(in.affine[i], scales[i], quaternions[i], translates[i]); });
+	measureBatch("Quaternion/DecomposeMany", [&] { Quaternion::DecomposeMany(in.affine.data(), scales.data(), quaternions.data(), translates.data(), kBatch); });
+	measure("Quaternion/Slerp", [&](size_t i) { quaternions[i] = Quaternion::Slerp(in.q0[i], in.q1[i], in.t[i]); });
+	measure("Quaternion/SlerpFast", [&](size_t i) { quaternions[i] = Quaternion::SlerpFast(in.q0[i], in.q1[i], in.t[i]); });
+
+	//==================================
+	// スプライン
+	//==================================
+	const Spline spline(SplineType::CatmullRom, std::vector<Vector3>(in.a.begin(), in.a.begin() + 4));
+	const CubicSegment& segment = spline.GetSegment(0);
+	measure("Spline/Evaluate", [&](size_t i) { vectors[i] = segment.Evaluate(static_cast<float>(i) / static_cast<float>(kBatch - 1)); });
+	measureBatch("Spline/Tessellate", [&] { segment.Tessellate(vectors.data(), kBatch); });
+	Spline arcSpline(SplineType::CatmullRom, in.a);
+	arcSpline.BuildArcLengthTable();
+	measure("Spline/ParameterAtDistance", [&](size_t i) { floats[i] = arcSpline.ParameterAtDistance(in.t[i] * arcSpline.Length()); });
+	measure("Spline/PointAtDistance", [&](size_t i) { vectors[i] = arcSpline.PointAtDistance(in.t[i] * arcSpline.Length()); });
+
+	if (!options.jsonPath.empty() && !runner.WriteJson(options.jsonPath)) {
+		std::fprintf(stderr, "cannot write %s\n", options.jsonPath.c_str());
+		return 1;
+	}
+	return 0;
+}
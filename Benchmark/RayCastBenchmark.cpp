@@ -0,0 +1,103 @@
+// レイと三角形の判定速度を測る（百万回/秒）。
+// 4096 個の三角形に対して 256 本のレイを当て、1 本ずつ全ての三角形を調べる場合（RayCast）と、
+// レイをまとめて三角形を 1 つずつ配る場合（RaySoA の RayCast）を、SIMD の段階ごとに比べる。
+// 最後に線分での遮りの判定（IsOccluded、最初の当たりで打ち切る）も測る。
+//
+// ビルド例（リポジトリのルートで）:
+//   g++ -std=c++20 -O2 -ISource -pthread Benchmark/RayCastBenchmark.cpp Source/Collision/*.cpp Source/Job/*.cpp Source/Profiler/Profiler.cpp Source/Math/CpuFeatures.cpp Source/Math/Math3D.cpp Source/Math/MatrixKernels.cpp
+#include "Collision/RayCast.h"
+#include "Math/CpuFeatures.h"
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr size_t kTriangleCount = 4096;
+constexpr size_t kRayCount = 256;
+constexpr int kRepeatCount = 20;
+
+std::mt19937 rng(12345);
+
+float Random(float min, float max) { return std::uniform_real_distribution<float>(min, max)(rng); }
+
+Vector3 RandomVector(float range) { return {Random(-range, range), Random(-range, range), Random(-range, range)}; }
+
+template <typename Function> double MeasureMegaTestsPerSecond(size_t testsPerCall, Function&& function) {
+	size_t checksum = function();
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < kRepeatCount; ++i) {
+		checksum += function();
+	}
+	const auto end = std::chrono::steady_clock::now();
+	const double seconds = std::chrono::duration<double>(end - start).count();
+	// 結果を使って最適化で消されないようにする
+	if (checksum == static_cast<size_t>(-1)) {
+		std::printf("!");
+	}
+	return static_cast<double>(testsPerCall) * kRepeatCount / seconds / 1.0e6;
+}
+
+} // namespace
+
+int main() {
+	TriangleBatch triangles;
+	for (size_t i = 0; i < kTriangleCount; ++i) {
+		Triangle triangle;
+		const Vector3 anchor = RandomVector(20.0f);
+		for (Vector3& vertex : triangle.vertices) {
+			vertex = {anchor.x + Random(-2.0f, 2.0f), anchor.y + Random(-2.0f, 2.0f), anchor.z + Random(-2.0f, 2.0f)};
+		}
+		triangles.Add(triangle);
+	}
+	std::vector<Ray> rays;
+	std::vector<Segment> segments;
+	RayBatch rayBatch;
+	for (size_t i = 0; i < kRayCount; ++i) {
+		Ray ray;
+		ray.origin = RandomVector(25.0f);
+		ray.diff = RandomVector(1.0f);
+		rays.push_back(ray);
+		rayBatch.Add(ray);
+		Segment segment;
+		segment.origin = ray.origin;
+		segment.diff = {ray.diff.x * 10.0f, ray.diff.y * 10.0f, ray.diff.z * 10.0f};
+		segments.push_back(segment);
+	}
+
+	const TriangleSoA view = triangles.View();
+	const size_t tests = kTriangleCount * kRayCount;
+	std::vector<RayHit> hits(kRayCount);
+
+	std::printf("%-8s %14s %14s %14s\n", "level", "single ray", "ray packet", "occluded");
+	for (const SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2}) {
+		SetSimdLevelOverride(level);
+		if (GetSimdLevel() != level) {
+			continue;
+		}
+		const double single = MeasureMegaTestsPerSecond(tests, [&] {
+			size_t hitCount = 0;
+			for (const Ray& ray : rays) {
+				RayHit hit;
+				hitCount += RayCast(ray, view, kTriangleCount, hit) ? 1 : 0;
+			}
+			return hitCount;
+		});
+		const double packet = MeasureMegaTestsPerSecond(tests, [&] {
+			hits.assign(kRayCount, RayHit{});
+			return RayCast(rayBatch.View(), kRayCount, view, kTriangleCount, hits.data());
+		});
+		// 打ち切りがあるので、実際に調べた数ではなく最悪の場合の数で割った値
+		const double occluded = MeasureMegaTestsPerSecond(tests, [&] {
+			size_t hitCount = 0;
+			for (const Segment& segment : segments) {
+				hitCount += IsOccluded(segment, view, kTriangleCount) ? 1 : 0;
+			}
+			return hitCount;
+		});
+		std::printf("%-8s %10.1f M/s %10.1f M/s %10.1f M/s\n", ToString(level), single, packet, occluded);
+	}
+	ClearSimdLevelOverride();
+	return 0;
+}
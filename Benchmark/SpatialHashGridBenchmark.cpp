@@ -0,0 +1,92 @@
+// SpatialHashGrid で球の重なっている組を全て求める時間を測る。
+// 密度が一定になるよう空間を広げながら球の数を変え、毎フレームの作り直し（Build）と
+// 全組判定（FindAllPairs、1 スレッド / 複数スレッド）を、総当たり（TestCollisions で 1 対 残り全部）と比べる。
+// 総当たりは O(N^2) なので 100k では 1 回しか測らない。
+// 組の数が総当たりと一致しなければ終了コード 1 を返す。
+//
+// ビルド例（リポジトリのルートで）:
+//   g++ -std=c++20 -O2 -ISource -pthread Benchmark/SpatialHashGridBenchmark.cpp Source/Collision/*.cpp Source/Job/*.cpp Source/Profiler/Profiler.cpp Source/Math/CpuFeatures.cpp Source/Math/Math3D.cpp Source/Math/MatrixKernels.cpp
+#include "Collision/SpatialHashGrid.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr float kRadius = 0.5f;
+
+struct Spheres {
+	std::vector<float> x, y, z, radius;
+
+	SphereSoA View() const { return {{x.data(), y.data(), z.data()}, radius.data()}; }
+	size_t Size() const { return x.size(); }
+};
+
+// 1 つの球が平均して数個の球と重なる程度の密度にする
+Spheres MakeSpheres(size_t count) {
+	std::mt19937 rng(12345);
+	const float halfSize = 1.5f * std::cbrt(static_cast<float>(count));
+	std::uniform_real_distribution<float> position(-halfSize, halfSize);
+	std::uniform_real_distribution<float> radius(0.5f * kRadius, kRadius);
+	Spheres spheres;
+	for (size_t i = 0; i < count; ++i) {
+		spheres.x.push_back(position(rng));
+		spheres.y.push_back(position(rng));
+		spheres.z.push_back(position(rng));
+		spheres.radius.push_back(radius(rng));
+	}
+	return spheres;
+}
+
+template <typename Function> double MeasureMilliseconds(int iterations, Function&& function) {
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i) {
+		function();
+	}
+	const auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+size_t BruteForce(const Spheres& spheres, std::vector<uint8_t>& hits) {
+	const SphereSoA view = spheres.View();
+	const size_t count = spheres.Size();
+	hits.resize(count);
+	size_t pairs = 0;
+	for (size_t i = 0; i + 1 < count; ++i) {
+		const Sphere sphere = {{spheres.x[i], spheres.y[i], spheres.z[i]}, spheres.radius[i]};
+		const SphereSoA rest = {{view.center.x + i + 1, view.center.y + i + 1, view.center.z + i + 1}, view.radius + i + 1};
+		pairs += TestCollisions(sphere, rest, count - i - 1, hits.data());
+	}
+	return pairs;
+}
+
+} // namespace
+
+int main() {
+	std::printf("%8s %11s %14s %14s %14s %10s\n", "spheres", "build", "pairs", "pairs mt", "brute force", "pairs");
+	bool ok = true;
+	for (const size_t count : {1000u, 10000u, 100000u}) {
+		const Spheres spheres = MakeSpheres(count);
+		const int iterations = count >= 100000 ? 10 : 100;
+
+		SpatialHashGrid grid;
+		std::vector<SpatialHashGrid::Pair> pairs;
+		const double build = MeasureMilliseconds(iterations, [&] { grid.Build(spheres.View(), spheres.Size()); });
+		const double find = MeasureMilliseconds(iterations, [&] { grid.FindAllPairs(pairs, false); });
+		const size_t singlePairs = pairs.size();
+		const double findMt = MeasureMilliseconds(iterations, [&] { grid.FindAllPairs(pairs, true); });
+
+		std::vector<uint8_t> hits;
+		size_t brutePairs = 0;
+		const double brute = MeasureMilliseconds(count >= 100000 ? 1 : 10, [&] { brutePairs = BruteForce(spheres, hits); });
+
+		if (brutePairs != singlePairs || brutePairs != pairs.size()) {
+			std::printf("mismatch: grid %zu, grid mt %zu, brute force %zu\n", singlePairs, pairs.size(), brutePairs);
+			ok = false;
+		}
+		std::printf("%8zu %8.3f ms %11.3f ms %11.3f ms %11.3f ms %10zu\n", count, build, find, findMt, brute, pairs.size());
+	}
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+// SweepAndPrune の 1 Step あたりの時間を測る。
+// 球を少しずつ動かし続ける場合の逐次更新（挿入ソート）と、
+// 毎フレーム作り直す場合（全体ソートと掃引）を物体数ごとに比べる。
+//
+// ビルド例（リポジトリのルートで）:
+//   g++ -std=c++20 -O2 -ISource -pthread Benchmark/SweepAndPruneBenchmark.cpp Source/Collision/SweepAndPrune.cpp Source/Job/*.cpp Source/Profiler/Profiler.cpp
+#include "Collision/SweepAndPrune.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+constexpr int kFrameCount = 60;
+constexpr float kRadius = 0.5f;
+constexpr float kDeltaTime = 1.0f / 60.0f;
+
+struct Body {
+	Vector3 position;
+	Vector3 velocity;
+};
+
+// 密度が一定になるよう、物体数に応じて空間の大きさを決める
+std::vector<Body> MakeBodies(size_t count) {
+	std::mt19937 rng(12345);
+	const float halfSize = 2.0f * std::cbrt(static_cast<float>(count));
+	std::uniform_real_distribution<float> position(-halfSize, halfSize);
+	std::uniform_real_distribution<float> velocity(-2.0f, 2.0f);
+	std::vector<Body> bodies(count);
+	for (Body& body : bodies) {
+		body.position = {position(rng), position(rng), position(rng)};
+		body.velocity = {velocity(rng), velocity(rng), velocity(rng)};
+	}
+	return bodies;
+}
+
+void Integrate(std::vector<Body>& bodies) {
+	for (Body& body : bodies) {
+		body.position.x += body.velocity.x * kDeltaTime;
+		body.position.y += body.velocity.y * kDeltaTime;
+		body.position.z += body.velocity.z * kDeltaTime;
+	}
+}
+
+double Run(size_t count, bool rebuildEveryFrame, bool multithreaded, size_t& pairChanges) {
+	std::vector<Body> bodies = MakeBodies(count);
+	SweepAndPrune sap;
+	sap.SetMultithreaded(multithreaded);
+	for (const Body& body : bodies) {
+		sap.Add(body.position, kRadius);
+	}
+	sap.Step();
+
+	pairChanges = 0;
+	double total = 0.0;
+	for (int frame = 0; frame < kFrameCount; ++frame) {
+		Integrate(bodies);
+		const auto start = std::chrono::steady_clock::now();
+		if (rebuildEveryFrame) {
+			sap.Clear();
+			for (const Body& body : bodies) {
+				sap.Add(body.position, kRadius);
+			}
+		} else {
+			for (size_t i = 0; i < bodies.size(); ++i) {
+				sap.Update(static_cast<uint32_t>(i), bodies[i].position, kRadius);
+			}
+		}
+		sap.Step();
+		const auto end = std::chrono::steady_clock::now();
+		total += std::chrono::duration<double, std::milli>(end - start).count();
+		pairChanges += sap.AddedPairs().size() + sap.RemovedPairs().size();
+	}
+	return total / kFrameCount;
+}
+
+} // namespace
+
+int main() {
+	std::printf("%8s %14s %14s %14s %12s\n", "bodies", "incremental", "incremental mt", "rebuild", "pair changes");
+	for (const size_t count : {1000u, 10000u, 100000u}) {
+		size_t changes = 0;
+		size_t ignored = 0;
+		const double incremental = Run(count, false, false, changes);
+		const double incrementalMt = Run(count, false, true, ignored);
+		const double rebuild = Run(count, true, false, ignored);
+		std::printf("%8zu %11.3f ms %11.3f ms %11.3f ms %12.1f\n", count, incremental, incrementalMt, rebuild, static_cast<double>(changes) / kFrameCount);
+	}
+	return 0;
+}
@@ -0,0 +1,121 @@
+// TransformHierarchy の Update にかかる時間を、並列に使うスレッド数を変えながら測る。
+// 10 万ノードの木（根 16 個、各ノードの親は 1 つ浅い段から選ぶ）で、
+// 全ノードのローカルの値を変えた場合と、1% だけ変えた場合を比べる。
+// 1 スレッドの列は SetMultithreaded(false)、それ以降は SetWorkerThreadCount で数を変えた並列更新。
+// 併せて、中身のない ParallelFor 1 回あたりの時間（ジョブを配って待つまでの手間）も出す。
+//
+// ビルド例（リポジトリのルートで）:
+//   g++ -std=c++20 -O2 -ISource -pthread Benchmark/TransformHierarchyBenchmark.cpp Source/Scene/TransformHierarchy.cpp Source/Job/*.cpp Source/Profiler/Profiler.cpp Source/Math/CpuFeatures.cpp Source/Math/Math3D.cpp Source/Math/MatrixKernels.cpp
+#include "Job/ParallelFor.h"
+#include "Scene/TransformHierarchy.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr size_t kNodeCount = 100000;
+constexpr size_t kRootCount = 16;
+constexpr size_t kFanOut = 4;
+
+Transform RandomTransform(std::mt19937& rng) {
+	std::uniform_real_distribution<float> scale(0.9f, 1.1f);
+	std::uniform_real_distribution<float> angle(-3.14f, 3.14f);
+	std::uniform_real_distribution<float> position(-2.0f, 2.0f);
+	return {
+	    {scale(rng),    scale(rng),    scale(rng)   },
+	    {angle(rng),    angle(rng),    angle(rng)   },
+	    {position(rng), position(rng), position(rng)},
+	};
+}
+
+// 段ごとにノード数がおよそ kFanOut 倍になる木を作る
+std::vector<TransformHierarchy::Handle> BuildTree(TransformHierarchy& hierarchy, std::mt19937& rng) {
+	std::vector<TransformHierarchy::Handle> handles;
+	std::vector<TransformHierarchy::Handle> previous;
+	for (size_t i = 0; i < kRootCount; ++i) {
+		previous.push_back(hierarchy.Create(RandomTransform(rng)));
+	}
+	handles = previous;
+	while (handles.size() < kNodeCount) {
+		std::vector<TransformHierarchy::Handle> level;
+		const size_t levelSize = (std::min)(previous.size() * kFanOut, kNodeCount - handles.size());
+		for (size_t i = 0; i < levelSize; ++i) {
+			level.push_back(hierarchy.Create(RandomTransform(rng), previous[rng() % previous.size()]));
+		}
+		handles.insert(handles.end(), level.begin(), level.end());
+		previous.swap(level);
+	}
+	return handles;
+}
+
+template <typename Function> double MeasureMilliseconds(int iterations, Function&& function) {
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; ++i) {
+		function();
+	}
+	const auto end = std::chrono::steady_clock::now();
+	return std::chrono::duration<double, std::milli>(end - start).count() / iterations;
+}
+
+} // namespace
+
+int main() {
+	std::mt19937 rng(12345);
+	TransformHierarchy hierarchy;
+	const std::vector<TransformHierarchy::Handle> handles = BuildTree(hierarchy, rng);
+	hierarchy.Update();
+
+	std::vector<Transform> transforms(handles.size());
+	for (Transform& transform : transforms) {
+		transform = RandomTransform(rng);
+	}
+	std::vector<TransformHierarchy::Handle> partial;
+	for (size_t i = 0; i < handles.size() / 100; ++i) {
+		partial.push_back(handles[rng() % handles.size()]);
+	}
+
+	const size_t hardwareThreads = (std::max)(1u, std::thread::hardware_concurrency());
+	std::vector<size_t> threadCounts = {1};
+	for (size_t threads = 2; threads < hardwareThreads; threads *= 2) {
+		threadCounts.push_back(threads);
+	}
+	if (hardwareThreads > 1) {
+		threadCounts.push_back(hardwareThreads);
+	}
+
+	std::printf("nodes %zu, levels %zu, hardware threads %zu\n", hierarchy.Size(), hierarchy.LevelCount(), hardwareThreads);
+	std::printf("%8s %11s %9s %11s %9s %16s\n", "threads", "full", "speedup", "1% dirty", "speedup", "empty for (us)");
+
+	double fullBase = 0.0;
+	double partialBase = 0.0;
+	for (const size_t threads : threadCounts) {
+		SetWorkerThreadCount(threads);
+		hierarchy.SetMultithreaded(threads > 1);
+
+		const double full = MeasureMilliseconds(20, [&] {
+			for (size_t i = 0; i < handles.size(); ++i) {
+				hierarchy.SetLocal(handles[i], transforms[i]);
+			}
+			hierarchy.Update();
+		});
+		const double dirty = MeasureMilliseconds(100, [&] {
+			for (const TransformHierarchy::Handle handle : partial) {
+				hierarchy.SetTranslation(handle, {0.0f, 1.0f, 0.0f});
+			}
+			hierarchy.Update();
+		});
+		const double emptyFor = 1000.0 * MeasureMilliseconds(1000, [] { ParallelFor(1024, 1, [](size_t, size_t) {}); });
+
+		if (threads == 1) {
+			fullBase = full;
+			partialBase = dirty;
+		}
+		std::printf("%8zu %8.3f ms %8.2fx %8.3f ms %8.2fx %16.2f\n", threads, full, fullBase / full, dirty, partialBase / dirty, emptyFor);
+	}
+	SetWorkerThreadCount(0);
+	return 0;
+}
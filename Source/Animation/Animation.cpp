@@ -0,0 +1,75 @@
+#include "Animation.h"
+#include <algorithm>
+#include <cmath>
+
+float WrapAnimationTime(float time, float duration) {
+	if (duration <= 0.0f) {
+		return 0.0f;
+	}
+	float t = std::fmod(time, duration);
+	if (t < 0.0f) {
+		t += duration;
+	}
+	return t;
+}
+
+uint32_t FindKeyIndex(const std::vector<float>& times, float time) {
+	if (times.empty()) {
+		return 0;
+	}
+	// time より大きい最初のキーの 1 つ前
+	const auto it = std::upper_bound(times.begin(), times.end(), time);
+	if (it == times.begin()) {
+		return 0;
+	}
+	return static_cast<uint32_t>(it - times.begin() - 1);
+}
+
+namespace {
+
+// 区間内の補間係数（区間外は 0 か 1 に丸める）
+inline float SegmentFactor(const std::vector<float>& times, uint32_t key, float time) {
+	const float t0 = times[key];
+	const float t1 = times[key + 1];
+	const float t = (time - t0) / (t1 - t0);
+	return std::clamp(t, 0.0f, 1.0f);
+}
+
+} // namespace
+
+Vector3 EvaluateCurve(const AnimationCurve<Vector3>& curve, uint32_t key, float time, const Vector3& defaultValue) {
+	const uint32_t count = curve.KeyCount();
+	if (count == 0) {
+		return defaultValue;
+	}
+	if (key + 1 >= count) {
+		return curve.values[count - 1];
+	}
+
+	const float t = SegmentFactor(curve.times, key, time);
+	const Vector3& a = curve.values[key];
+	const Vector3& b = curve.values[key + 1];
+	const float invT = 1.0f - t;
+	return Vector3(invT * a.x + t * b.x, invT * a.y + t * b.y, invT * a.z + t * b.z);
+}
+
+Quaternion EvaluateCurve(const AnimationCurve<Quaternion>& curve, uint32_t key, float time, SlerpMode mode) {
+	const uint32_t count = curve.KeyCount();
+	if (count == 0) {
+		return Quaternion::IdentityQuaternion();
+	}
+	if (key + 1 >= count) {
+		return curve.values[count - 1];
+	}
+
+	const float t = SegmentFactor(curve.times, key, time);
+	return Quaternion::Slerp(curve.values[key], curve.values[key + 1], t, mode);
+}
+
+TransformPose SampleTrack(const AnimationTrack& track, float time, SlerpMode mode) {
+	TransformPose pose;
+	pose.translate = EvaluateCurve(track.translate, FindKeyIndex(track.translate.times, time), time, pose.translate);
+	pose.rotate = EvaluateCurve(track.rotate, FindKeyIndex(track.rotate.times, time), time, mode);
+	pose.scale = EvaluateCurve(track.scale, FindKeyIndex(track.scale.times, time), time, pose.scale);
+	return pose;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include "Math/MathTypes.h"
+#include "Quaternion/Quaternion.h"
+#include <cstdint>
+#include <vector>
+
+using namespace KamataEngine;
+
+//==================================
+// キーフレームアニメーション
+//==================================
+// 1 つのノード（ジョイント）の平行移動・回転・拡大縮小をそれぞれ独立したキー列で持つ。
+// キーの時刻は昇順で、範囲外の時刻は最初または最後のキーの値になる。
+// キーの無いチャンネルは既定値（拡大縮小 1、回転なし、平行移動 0）を返す。
+
+// 時刻と値を別配列で持つキー列（時刻の探索でキャッシュを汚さないため）
+template <typename T> struct AnimationCurve {
+	std::vector<float> times;
+	std::vector<T> values;
+
+	void AddKey(float time, const T& value) {
+		times.push_back(time);
+		values.push_back(value);
+	}
+
+	uint32_t KeyCount() const { return static_cast<uint32_t>(times.size()); }
+};
+
+struct AnimationTrack {
+	AnimationCurve<Vector3> translate;
+	AnimationCurve<Quaternion> rotate;
+	AnimationCurve<Vector3> scale;
+};
+
+struct AnimationClip {
+	float duration = 0.0f;
+	std::vector<AnimationTrack> tracks;
+};
+
+// 1 ノードぶんのサンプル結果
+struct TransformPose {
+	Vector3 scale = {1.0f, 1.0f, 1.0f};
+	Quaternion rotate;
+	Vector3 translate = {0.0f, 0.0f, 0.0f};
+};
+
+// ループ再生用に時刻を [0, duration) に折り返す
+float WrapAnimationTime(float time, float duration);
+
+// time を含む区間の先頭キー（times[k] <= time < times[k + 1]）を二分探索で求める。
+// time が最初のキーより前なら 0、最後のキー以降なら最後のキーの番号
+uint32_t FindKeyIndex(const std::vector<float>& times, float time);
+
+// 区間 [key, key + 1] で補間した値（回転は mode に応じた Slerp）
+Vector3 EvaluateCurve(const AnimationCurve<Vector3>& curve, uint32_t key, float time, const Vector3& defaultValue);
+Quaternion EvaluateCurve(const AnimationCurve<Quaternion>& curve, uint32_t key, float time, SlerpMode mode);
+
+// 二分探索による単発のサンプリング（再生位置が飛ぶ場合や 1 回だけ評価する場合用）
+TransformPose SampleTrack(const AnimationTrack& track, float time, SlerpMode mode = SlerpMode::Exact);
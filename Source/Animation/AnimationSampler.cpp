@@ -0,0 +1,70 @@
+#include "AnimationSampler.h"
+
+namespace {
+
+// 前回の区間から 2 つ先までは線形に進め、それ以外は二分探索
+constexpr uint32_t kMaxCursorSteps = 2;
+
+uint32_t AdvanceCursor(const std::vector<float>& times, uint32_t cursor, float time) {
+	const uint32_t count = static_cast<uint32_t>(times.size());
+	if (count <= 1) {
+		return 0;
+	}
+	if (cursor >= count || time < times[cursor]) {
+		// 巻き戻し（ループの先頭に戻った場合など）
+		return FindKeyIndex(times, time);
+	}
+	for (uint32_t step = 0; step <= kMaxCursorSteps; ++step) {
+		if (cursor + 1 >= count || time < times[cursor + 1]) {
+			return cursor;
+		}
+		++cursor;
+	}
+	return FindKeyIndex(times, time);
+}
+
+} // namespace
+
+AnimationSampler::AnimationSampler(const AnimationClip* clip) { SetClip(clip); }
+
+void AnimationSampler::SetClip(const AnimationClip* clip) {
+	clip_ = clip;
+	ResetCursors();
+}
+
+void AnimationSampler::ResetCursors() { cursors_.assign(clip_ ? clip_->tracks.size() * 3 : 0, 0); }
+
+void AnimationSampler::Sample(float time, TransformPose* out, SlerpMode mode) {
+	if (!clip_) {
+		return;
+	}
+	// トラック数が変わっていたらカーソルを作り直す
+	if (cursors_.size() != clip_->tracks.size() * 3) {
+		ResetCursors();
+	}
+
+	const size_t trackCount = clip_->tracks.size();
+	const AnimationTrack* tracks = clip_->tracks.data();
+	uint32_t* cursor = cursors_.data();
+	for (size_t i = 0; i < trackCount; ++i, cursor += 3) {
+		const AnimationTrack& track = tracks[i];
+		TransformPose& pose = out[i];
+
+		cursor[0] = AdvanceCursor(track.translate.times, cursor[0], time);
+		cursor[1] = AdvanceCursor(track.rotate.times, cursor[1], time);
+		cursor[2] = AdvanceCursor(track.scale.times, cursor[2], time);
+
+		pose.translate = EvaluateCurve(track.translate, cursor[0], time, Vector3{0.0f, 0.0f, 0.0f});
+		pose.rotate = EvaluateCurve(track.rotate, cursor[1], time, mode);
+		pose.scale = EvaluateCurve(track.scale, cursor[2], time, Vector3{1.0f, 1.0f, 1.0f});
+	}
+}
+
+void AnimationSampler::Sample(float time, std::vector<TransformPose>& pose, SlerpMode mode) {
+	if (!clip_) {
+		pose.clear();
+		return;
+	}
+	pose.resize(clip_->tracks.size());
+	Sample(time, pose.data(), mode);
+}
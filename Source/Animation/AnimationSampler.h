@@ -0,0 +1,35 @@
+#pragma once
+#include "Animation.h"
+
+//==================================
+// クリップの全トラックをまとめてサンプリングする
+//==================================
+// チャンネルごとに前回のキー位置（カーソル）を覚えておき、
+// 時刻が前回と同じ区間か次の区間にあれば探索せずに済ませる（通常の再生では O(1)）。
+// 巻き戻しや大きく飛んだ場合だけ二分探索する。
+
+class AnimationSampler {
+
+public:
+	AnimationSampler() = default;
+	explicit AnimationSampler(const AnimationClip* clip);
+
+	// クリップを差し替え、カーソルを先頭に戻す
+	void SetClip(const AnimationClip* clip);
+
+	const AnimationClip* GetClip() const { return clip_; }
+
+	void ResetCursors();
+
+	// out には clip の tracks.size() 個ぶんの領域が必要
+	void Sample(float time, TransformPose* out, SlerpMode mode = SlerpMode::Exact);
+
+	// pose を tracks.size() 個に合わせてからサンプリングする
+	void Sample(float time, std::vector<TransformPose>& pose, SlerpMode mode = SlerpMode::Exact);
+
+private:
+	const AnimationClip* clip_ = nullptr;
+
+	// トラックごとに translate, rotate, scale の順で 3 つ
+	std::vector<uint32_t> cursors_;
+};
@@ -0,0 +1,424 @@
+#include "Collision.h"
+#include "CollisionKernels.h"
+#include "Math/Math3D.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 長さ 0 とみなす線分の長さの 2 乗
+constexpr float kDegenerateLengthSq = 1.0e-12f;
+// 平面に平行な線を平面上にあるとみなす距離
+constexpr float kOnPlaneDistance = 1.0e-5f;
+
+// 線の種類ごとの t の範囲
+constexpr float kLineMin = -INFINITY;
+constexpr float kLineMax = INFINITY;
+constexpr float kRayMin = 0.0f;
+constexpr float kRayMax = INFINITY;
+constexpr float kSegmentMin = 0.0f;
+constexpr float kSegmentMax = 1.0f;
+
+//==================================
+// 線分と線の最近接点
+//==================================
+
+// 線分 s1 と origin + t * diff（t は [tMin, tMax]）の最近接点同士の距離の 2 乗。
+// Ericson 5.1.9 の t の範囲を [0, 1] から広げたもの。tMin は 0 か -∞、tMax は 1 か +∞ に限る
+// （無限の端では t が範囲を外れないので、外れたときの s は端が 0 / 1 の式で求まる）
+float ClosestPointsSegmentLine(const Segment& s1, const Vector3& origin, const Vector3& diff, float tMin, float tMax, Vector3& closest1, Vector3& closest2) {
+	const Vector3& d1 = s1.diff;
+	const Vector3& d2 = diff;
+	const Vector3 r = Subtract(s1.origin, origin);
+	const float a = Dot(d1, d1);
+	const float e = Dot(d2, d2);
+	const float f = Dot(d2, r);
+
+	float s = 0.0f;
+	float t = 0.0f;
+	if (a <= kDegenerateLengthSq && e <= kDegenerateLengthSq) {
+		// 両方とも点
+	} else if (a <= kDegenerateLengthSq) {
+		// s1 が点
+		t = std::clamp(f / e, tMin, tMax);
+	} else {
+		const float c = Dot(d1, r);
+		if (e <= kDegenerateLengthSq) {
+			// 2 本目が点
+			s = std::clamp(-c / a, 0.0f, 1.0f);
+		} else {
+			const float b = Dot(d1, d2);
+			const float denominator = a * e - b * b;
+			// 平行な場合は s = 0 から始める
+			if (denominator != 0.0f) {
+				s = std::clamp((b * f - c * e) / denominator, 0.0f, 1.0f);
+			}
+			t = (b * s + f) / e;
+			if (t < tMin) {
+				t = tMin;
+				s = std::clamp(-c / a, 0.0f, 1.0f);
+			} else if (t > tMax) {
+				t = tMax;
+				s = std::clamp((b - c) / a, 0.0f, 1.0f);
+			}
+		}
+	}
+
+	closest1 = Add(s1.origin, Multiply(d1, s));
+	closest2 = Add(origin, Multiply(d2, t));
+	const Vector3 between = Subtract(closest1, closest2);
+	return Dot(between, between);
+}
+
+// origin + t * diff（t は [tMin, tMax]）上で point に最も近い点
+Vector3 ClosestPointOnLine(const Vector3& point, const Vector3& origin, const Vector3& diff, float tMin, float tMax) {
+	const float lengthSq = Dot(diff, diff);
+	if (lengthSq <= kDegenerateLengthSq) {
+		return origin;
+	}
+	const float t = std::clamp(Dot(Subtract(point, origin), diff) / lengthSq, tMin, tMax);
+	return Add(origin, Multiply(diff, t));
+}
+
+//==================================
+// 線と AABB（スラブ法）
+//==================================
+
+// origin + t * diff が [tMin, tMax] の範囲で AABB を通るか
+bool IntersectSlabs(const Vector3& origin, const Vector3& diff, const AABB& aabb, float tMin, float tMax) {
+	const float o[3] = {origin.x, origin.y, origin.z};
+	const float d[3] = {diff.x, diff.y, diff.z};
+	const float lo[3] = {aabb.min.x, aabb.min.y, aabb.min.z};
+	const float hi[3] = {aabb.max.x, aabb.max.y, aabb.max.z};
+	for (int axis = 0; axis < 3; ++axis) {
+		if (d[axis] == 0.0f) {
+			// 軸に平行な場合はスラブの内側にいるかだけを見る
+			if (o[axis] < lo[axis] || o[axis] > hi[axis]) {
+				return false;
+			}
+			continue;
+		}
+		const float inv = 1.0f / d[axis];
+		float tNear = (lo[axis] - o[axis]) * inv;
+		float tFar = (hi[axis] - o[axis]) * inv;
+		if (tNear > tFar) {
+			std::swap(tNear, tFar);
+		}
+		tMin = (std::max)(tMin, tNear);
+		tMax = (std::min)(tMax, tFar);
+		if (tMin > tMax) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//==================================
+// 線と平面
+//==================================
+
+bool IntersectPlane(const Vector3& origin, const Vector3& diff, const Plane& plane, float tMin, float tMax) {
+	const float denominator = Dot(plane.normal, diff);
+	if (denominator == 0.0f) {
+		// 平行な場合は平面上にあれば（t の範囲のどこでも）交わる
+		return std::fabs(Dot(plane.normal, origin) - plane.distance) <= kOnPlaneDistance;
+	}
+	const float t = (plane.distance - Dot(plane.normal, origin)) / denominator;
+	return t >= tMin && t <= tMax;
+}
+
+//==================================
+// 線と三角形（Möller–Trumbore）
+//==================================
+
+bool IntersectTriangle(const Vector3& origin, const Vector3& diff, const Triangle& triangle, float tMin, float tMax) {
+	const Vector3 edge1 = Subtract(triangle.vertices[1], triangle.vertices[0]);
+	const Vector3 edge2 = Subtract(triangle.vertices[2], triangle.vertices[0]);
+	float t, u, v;
+	return CollisionKernels::IntersectTriangle(origin, diff, triangle.vertices[0], edge1, edge2, t, u, v) && t >= tMin && t <= tMax;
+}
+
+//==================================
+// 三角形と AABB（分離軸判定）
+//==================================
+
+// 頂点 v0..v2 を axis へ投影した範囲と、半径 r の箱の投影が離れているか
+bool IsSeparated(const Vector3& v0, const Vector3& v1, const Vector3& v2, const Vector3& axis, const Vector3& extent) {
+	const float p0 = Dot(v0, axis);
+	const float p1 = Dot(v1, axis);
+	const float p2 = Dot(v2, axis);
+	const float r = extent.x * std::fabs(axis.x) + extent.y * std::fabs(axis.y) + extent.z * std::fabs(axis.z);
+	return (std::max)({p0, p1, p2}) < -r || (std::min)({p0, p1, p2}) > r;
+}
+
+} // namespace
+
+//==================================
+// 最近接点
+//==================================
+
+// Ericson "Real-Time Collision Detection" 5.1.5 の領域判定
+Vector3 ClosestPointOnTriangle(const Vector3& point, const Triangle& triangle) {
+	const Vector3& a = triangle.vertices[0];
+	const Vector3& b = triangle.vertices[1];
+	const Vector3& c = triangle.vertices[2];
+	const Vector3 ab = Subtract(b, a);
+	const Vector3 ac = Subtract(c, a);
+
+	// 頂点 a の外側
+	const Vector3 ap = Subtract(point, a);
+	const float d1 = Dot(ab, ap);
+	const float d2 = Dot(ac, ap);
+	if (d1 <= 0.0f && d2 <= 0.0f) {
+		return a;
+	}
+
+	// 頂点 b の外側
+	const Vector3 bp = Subtract(point, b);
+	const float d3 = Dot(ab, bp);
+	const float d4 = Dot(ac, bp);
+	if (d3 >= 0.0f && d4 <= d3) {
+		return b;
+	}
+
+	// 辺 ab の外側
+	const float vc = d1 * d4 - d3 * d2;
+	if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+		return Add(a, Multiply(ab, d1 / (d1 - d3)));
+	}
+
+	// 頂点 c の外側
+	const Vector3 cp = Subtract(point, c);
+	const float d5 = Dot(ab, cp);
+	const float d6 = Dot(ac, cp);
+	if (d6 >= 0.0f && d5 <= d6) {
+		return c;
+	}
+
+	// 辺 ac の外側
+	const float vb = d5 * d2 - d1 * d6;
+	if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+		return Add(a, Multiply(ac, d2 / (d2 - d6)));
+	}
+
+	// 辺 bc の外側
+	const float va = d3 * d6 - d5 * d4;
+	if (va <= 0.0f && (d4 - d3) >= 0.0f && (d5 - d6) >= 0.0f) {
+		return Add(b, Multiply(Subtract(c, b), (d4 - d3) / ((d4 - d3) + (d5 - d6))));
+	}
+
+	// 面の内側
+	const float denominator = 1.0f / (va + vb + vc);
+	const float v = vb * denominator;
+	const float w = vc * denominator;
+	return Add(a, Add(Multiply(ab, v), Multiply(ac, w)));
+}
+
+// Ericson "Real-Time Collision Detection" 5.1.9
+float ClosestPointsSegmentSegment(const Segment& s1, const Segment& s2, Vector3& closest1, Vector3& closest2) {
+	return ClosestPointsSegmentLine(s1, s2.origin, s2.diff, kSegmentMin, kSegmentMax, closest1, closest2);
+}
+
+//==================================
+// 球
+//==================================
+
+bool IsCollision(const Sphere& s1, const Sphere& s2) {
+	const Vector3 between = Subtract(s2.center, s1.center);
+	const float radiusSum = s1.radius + s2.radius;
+	return Dot(between, between) <= radiusSum * radiusSum;
+}
+
+bool IsCollision(const Sphere& sphere, const Plane& plane) {
+	const float distance = Dot(plane.normal, sphere.center) - plane.distance;
+	return std::fabs(distance) <= sphere.radius;
+}
+
+bool IsCollision(const Sphere& sphere, const AABB& aabb) {
+	const Vector3 closest = {
+	    std::clamp(sphere.center.x, aabb.min.x, aabb.max.x),
+	    std::clamp(sphere.center.y, aabb.min.y, aabb.max.y),
+	    std::clamp(sphere.center.z, aabb.min.z, aabb.max.z),
+	};
+	const Vector3 between = Subtract(closest, sphere.center);
+	return Dot(between, between) <= sphere.radius * sphere.radius;
+}
+
+bool IsCollision(const Sphere& sphere, const Triangle& triangle) {
+	const Vector3 between = Subtract(ClosestPointOnTriangle(sphere.center, triangle), sphere.center);
+	return Dot(between, between) <= sphere.radius * sphere.radius;
+}
+
+bool IsCollision(const Sphere& sphere, const Segment& segment) {
+	const Vector3 between = Subtract(closestPoint(sphere.center, segment), sphere.center);
+	return Dot(between, between) <= sphere.radius * sphere.radius;
+}
+
+bool IsCollision(const Sphere& sphere, const Line& line) {
+	const Vector3 between = Subtract(ClosestPointOnLine(sphere.center, line.origin, line.diff, kLineMin, kLineMax), sphere.center);
+	return Dot(between, between) <= sphere.radius * sphere.radius;
+}
+
+bool IsCollision(const Sphere& sphere, const Ray& ray) {
+	const Vector3 between = Subtract(ClosestPointOnLine(sphere.center, ray.origin, ray.diff, kRayMin, kRayMax), sphere.center);
+	return Dot(between, between) <= sphere.radius * sphere.radius;
+}
+
+bool IsCollision(const Sphere& sphere, const Capsule& capsule) {
+	const Vector3 between = Subtract(closestPoint(sphere.center, capsule.segment), sphere.center);
+	const float radiusSum = sphere.radius + capsule.radius;
+	return Dot(between, between) <= radiusSum * radiusSum;
+}
+
+//==================================
+// AABB
+//==================================
+
+bool IsCollision(const AABB& a, const AABB& b) {
+	return a.min.x <= b.max.x && a.max.x >= b.min.x && //
+	       a.min.y <= b.max.y && a.max.y >= b.min.y && //
+	       a.min.z <= b.max.z && a.max.z >= b.min.z;
+}
+
+bool IsCollision(const AABB& aabb, const Plane& plane) {
+	const Vector3 center = Multiply(Add(aabb.min, aabb.max), 0.5f);
+	const Vector3 extent = Subtract(aabb.max, center);
+	// 箱を法線方向へ投影した半径
+	const float r = extent.x * std::fabs(plane.normal.x) + extent.y * std::fabs(plane.normal.y) + extent.z * std::fabs(plane.normal.z);
+	const float distance = Dot(plane.normal, center) - plane.distance;
+	return std::fabs(distance) <= r;
+}
+
+// Akenine-Möller の分離軸判定（箱の 3 軸、三角形の法線、辺 × 箱の軸の 9 軸）
+bool IsCollision(const AABB& aabb, const Triangle& triangle) {
+	const Vector3 center = Multiply(Add(aabb.min, aabb.max), 0.5f);
+	const Vector3 extent = Subtract(aabb.max, center);
+
+	// 箱の中心を原点に移す
+	const Vector3 v0 = Subtract(triangle.vertices[0], center);
+	const Vector3 v1 = Subtract(triangle.vertices[1], center);
+	const Vector3 v2 = Subtract(triangle.vertices[2], center);
+	const Vector3 edges[3] = {Subtract(v1, v0), Subtract(v2, v1), Subtract(v0, v2)};
+
+	// 辺 × 箱の軸
+	for (const Vector3& edge : edges) {
+		const Vector3 axes[3] = {
+		    {0.0f, -edge.z, edge.y},
+		    {edge.z, 0.0f, -edge.x},
+		    {-edge.y, edge.x, 0.0f},
+		};
+		for (const Vector3& axis : axes) {
+			if (IsSeparated(v0, v1, v2, axis, extent)) {
+				return false;
+			}
+		}
+	}
+
+	// 箱の 3 軸（三角形の AABB との比較）
+	if ((std::max)({v0.x, v1.x, v2.x}) < -extent.x || (std::min)({v0.x, v1.x, v2.x}) > extent.x) {
+		return false;
+	}
+	if ((std::max)({v0.y, v1.y, v2.y}) < -extent.y || (std::min)({v0.y, v1.y, v2.y}) > extent.y) {
+		return false;
+	}
+	if ((std::max)({v0.z, v1.z, v2.z}) < -extent.z || (std::min)({v0.z, v1.z, v2.z}) > extent.z) {
+		return false;
+	}
+
+	// 三角形の面
+	const Vector3 normal = Cross(edges[0], edges[1]);
+	return !IsSeparated(v0, v1, v2, normal, extent);
+}
+
+bool IsCollision(const AABB& aabb, const Line& line) { return IntersectSlabs(line.origin, line.diff, aabb, kLineMin, kLineMax); }
+
+bool IsCollision(const AABB& aabb, const Ray& ray) { return IntersectSlabs(ray.origin, ray.diff, aabb, kRayMin, kRayMax); }
+
+bool IsCollision(const AABB& aabb, const Segment& segment) { return IntersectSlabs(segment.origin, segment.diff, aabb, kSegmentMin, kSegmentMax); }
+
+//==================================
+// 平面
+//==================================
+
+bool IsCollision(const Line& line, const Plane& plane) { return IntersectPlane(line.origin, line.diff, plane, kLineMin, kLineMax); }
+
+bool IsCollision(const Ray& ray, const Plane& plane) { return IntersectPlane(ray.origin, ray.diff, plane, kRayMin, kRayMax); }
+
+bool IsCollision(const Segment& segment, const Plane& plane) { return IntersectPlane(segment.origin, segment.diff, plane, kSegmentMin, kSegmentMax); }
+
+bool IsCollision(const Capsule& capsule, const Plane& plane) {
+	const Vector3 end = Add(capsule.segment.origin, capsule.segment.diff);
+	const float d0 = Dot(plane.normal, capsule.segment.origin) - plane.distance;
+	const float d1 = Dot(plane.normal, end) - plane.distance;
+	if ((d0 <= 0.0f && d1 >= 0.0f) || (d0 >= 0.0f && d1 <= 0.0f)) {
+		// 軸が平面をまたいでいる
+		return true;
+	}
+	return (std::min)(std::fabs(d0), std::fabs(d1)) <= capsule.radius;
+}
+
+//==================================
+// 三角形
+//==================================
+
+bool IsCollision(const Line& line, const Triangle& triangle) { return IntersectTriangle(line.origin, line.diff, triangle, kLineMin, kLineMax); }
+
+bool IsCollision(const Ray& ray, const Triangle& triangle) { return IntersectTriangle(ray.origin, ray.diff, triangle, kRayMin, kRayMax); }
+
+bool IsCollision(const Segment& segment, const Triangle& triangle) { return IntersectTriangle(segment.origin, segment.diff, triangle, kSegmentMin, kSegmentMax); }
+
+//==================================
+// カプセル
+//==================================
+
+bool IsCollision(const Capsule& c1, const Capsule& c2) {
+	Vector3 closest1;
+	Vector3 closest2;
+	const float distanceSq = ClosestPointsSegmentSegment(c1.segment, c2.segment, closest1, closest2);
+	const float radiusSum = c1.radius + c2.radius;
+	return distanceSq <= radiusSum * radiusSum;
+}
+
+bool IsCollision(const Capsule& capsule, const Line& line) {
+	Vector3 closest1;
+	Vector3 closest2;
+	return ClosestPointsSegmentLine(capsule.segment, line.origin, line.diff, kLineMin, kLineMax, closest1, closest2) <= capsule.radius * capsule.radius;
+}
+
+bool IsCollision(const Capsule& capsule, const Ray& ray) {
+	Vector3 closest1;
+	Vector3 closest2;
+	return ClosestPointsSegmentLine(capsule.segment, ray.origin, ray.diff, kRayMin, kRayMax, closest1, closest2) <= capsule.radius * capsule.radius;
+}
+
+bool IsCollision(const Capsule& capsule, const Segment& segment) {
+	Vector3 closest1;
+	Vector3 closest2;
+	return ClosestPointsSegmentSegment(capsule.segment, segment, closest1, closest2) <= capsule.radius * capsule.radius;
+}
+
+// 軸が三角形を貫いていなければ、最短距離は軸の端点と三角形の間か、軸と三角形の辺の間にある
+bool IsCollision(const Capsule& capsule, const Triangle& triangle) {
+	if (IsCollision(capsule.segment, triangle)) {
+		return true;
+	}
+	const float radiusSq = capsule.radius * capsule.radius;
+	const Vector3 ends[2] = {capsule.segment.origin, Add(capsule.segment.origin, capsule.segment.diff)};
+	for (const Vector3& end : ends) {
+		const Vector3 between = Subtract(ClosestPointOnTriangle(end, triangle), end);
+		if (Dot(between, between) <= radiusSq) {
+			return true;
+		}
+	}
+	for (int k = 0; k < 3; ++k) {
+		Segment edge;
+		edge.origin = triangle.vertices[k];
+		edge.diff = Subtract(triangle.vertices[(k + 1) % 3], triangle.vertices[k]);
+		Vector3 closest1;
+		Vector3 closest2;
+		if (ClosestPointsSegmentSegment(capsule.segment, edge, closest1, closest2) <= radiusSq) {
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,103 @@
+#pragma once
+#include "Math/MathCore.h"
+#include "struct.h"
+
+using namespace KamataEngine;
+
+//==================================
+// 衝突判定（struct.h の図形同士）
+//==================================
+// 接している場合も衝突とみなす。
+// Line は t が全実数、Ray は t >= 0、Segment は 0 <= t <= 1 の origin + t * diff。
+// Plane は dot(normal, p) = distance（normal は単位ベクトル前提）。
+// 平面に平行な Line / Ray / Segment は、平面からの距離が 1e-5 以内なら平面上にあるとして衝突とみなす。
+// 多数の相手とまとめて判定する場合は CollisionBatch.h を使う。
+
+//==================================
+// 最近接点
+//==================================
+
+// 三角形上で point に最も近い点
+Vector3 ClosestPointOnTriangle(const Vector3& point, const Triangle& triangle);
+
+// 2 本の線分の最近接点同士の距離の 2 乗（closest1 / closest2 に最近接点を返す）
+float ClosestPointsSegmentSegment(const Segment& s1, const Segment& s2, Vector3& closest1, Vector3& closest2);
+
+//==================================
+// 球
+//==================================
+
+bool IsCollision(const Sphere& s1, const Sphere& s2);
+bool IsCollision(const Sphere& sphere, const Plane& plane);
+bool IsCollision(const Sphere& sphere, const AABB& aabb);
+bool IsCollision(const Sphere& sphere, const Triangle& triangle);
+bool IsCollision(const Sphere& sphere, const Line& line);
+bool IsCollision(const Sphere& sphere, const Ray& ray);
+bool IsCollision(const Sphere& sphere, const Segment& segment);
+bool IsCollision(const Sphere& sphere, const Capsule& capsule);
+
+//==================================
+// AABB
+//==================================
+
+bool IsCollision(const AABB& a, const AABB& b);
+bool IsCollision(const AABB& aabb, const Plane& plane);
+bool IsCollision(const AABB& aabb, const Triangle& triangle);
+bool IsCollision(const AABB& aabb, const Line& line);
+bool IsCollision(const AABB& aabb, const Ray& ray);
+bool IsCollision(const AABB& aabb, const Segment& segment);
+
+//==================================
+// 平面
+//==================================
+
+bool IsCollision(const Line& line, const Plane& plane);
+bool IsCollision(const Ray& ray, const Plane& plane);
+bool IsCollision(const Segment& segment, const Plane& plane);
+bool IsCollision(const Capsule& capsule, const Plane& plane);
+
+//==================================
+// 三角形
+//==================================
+
+bool IsCollision(const Line& line, const Triangle& triangle);
+bool IsCollision(const Ray& ray, const Triangle& triangle);
+bool IsCollision(const Segment& segment, const Triangle& triangle);
+
+//==================================
+// カプセル
+//==================================
+
+bool IsCollision(const Capsule& c1, const Capsule& c2);
+bool IsCollision(const Capsule& capsule, const Line& line);
+bool IsCollision(const Capsule& capsule, const Ray& ray);
+bool IsCollision(const Capsule& capsule, const Segment& segment);
+bool IsCollision(const Capsule& capsule, const Triangle& triangle);
+
+//==================================
+// 引数の順序違い
+//==================================
+
+inline bool IsCollision(const Plane& plane, const Sphere& sphere) { return IsCollision(sphere, plane); }
+inline bool IsCollision(const AABB& aabb, const Sphere& sphere) { return IsCollision(sphere, aabb); }
+inline bool IsCollision(const Triangle& triangle, const Sphere& sphere) { return IsCollision(sphere, triangle); }
+inline bool IsCollision(const Line& line, const Sphere& sphere) { return IsCollision(sphere, line); }
+inline bool IsCollision(const Ray& ray, const Sphere& sphere) { return IsCollision(sphere, ray); }
+inline bool IsCollision(const Segment& segment, const Sphere& sphere) { return IsCollision(sphere, segment); }
+inline bool IsCollision(const Capsule& capsule, const Sphere& sphere) { return IsCollision(sphere, capsule); }
+inline bool IsCollision(const Plane& plane, const AABB& aabb) { return IsCollision(aabb, plane); }
+inline bool IsCollision(const Triangle& triangle, const AABB& aabb) { return IsCollision(aabb, triangle); }
+inline bool IsCollision(const Line& line, const AABB& aabb) { return IsCollision(aabb, line); }
+inline bool IsCollision(const Ray& ray, const AABB& aabb) { return IsCollision(aabb, ray); }
+inline bool IsCollision(const Segment& segment, const AABB& aabb) { return IsCollision(aabb, segment); }
+inline bool IsCollision(const Plane& plane, const Line& line) { return IsCollision(line, plane); }
+inline bool IsCollision(const Plane& plane, const Ray& ray) { return IsCollision(ray, plane); }
+inline bool IsCollision(const Plane& plane, const Segment& segment) { return IsCollision(segment, plane); }
+inline bool IsCollision(const Plane& plane, const Capsule& capsule) { return IsCollision(capsule, plane); }
+inline bool IsCollision(const Triangle& triangle, const Line& line) { return IsCollision(line, triangle); }
+inline bool IsCollision(const Triangle& triangle, const Ray& ray) { return IsCollision(ray, triangle); }
+inline bool IsCollision(const Triangle& triangle, const Segment& segment) { return IsCollision(segment, triangle); }
+inline bool IsCollision(const Line& line, const Capsule& capsule) { return IsCollision(capsule, line); }
+inline bool IsCollision(const Ray& ray, const Capsule& capsule) { return IsCollision(capsule, ray); }
+inline bool IsCollision(const Segment& segment, const Capsule& capsule) { return IsCollision(capsule, segment); }
+inline bool IsCollision(const Triangle& triangle, const Capsule& capsule) { return IsCollision(capsule, triangle); }
@@ -0,0 +1,689 @@
+#include "CollisionBatch.h"
+#include "CollisionKernels.h"
+#include "Math/CpuFeatures.h"
+#include "Math/Math3D.h"
+#include "Math/SimdMath.h"
+#include <bit>
+#include <cmath>
+
+namespace {
+
+// Collision.cpp と同じ値
+constexpr float kDegenerateLengthSq = 1.0e-12f;
+
+//==================================
+// 共通処理
+//==================================
+
+Sphere LoadSphere(const SphereSoA& s, size_t i) {
+	Sphere sphere;
+	sphere.center = {s.center.x[i], s.center.y[i], s.center.z[i]};
+	sphere.radius = s.radius[i];
+	return sphere;
+}
+
+AABB LoadAABB(const AABBSoA& a, size_t i) {
+	AABB aabb;
+	aabb.min = {a.min.x[i], a.min.y[i], a.min.z[i]};
+	aabb.max = {a.max.x[i], a.max.y[i], a.max.z[i]};
+	return aabb;
+}
+
+Capsule LoadCapsule(const CapsuleSoA& c, size_t i) {
+	Capsule capsule;
+	capsule.segment.origin = {c.origin.x[i], c.origin.y[i], c.origin.z[i]};
+	capsule.segment.diff = {c.diff.x[i], c.diff.y[i], c.diff.z[i]};
+	capsule.radius = c.radius[i];
+	return capsule;
+}
+
+// begin 以降をスカラーで判定する
+template <typename Test> size_t TestScalar(size_t begin, size_t count, uint8_t* hits, Test&& test) {
+	size_t hitCount = 0;
+	for (size_t i = begin; i < count; ++i) {
+		const bool hit = test(i);
+		hits[i] = hit ? 1 : 0;
+		hitCount += hit ? 1 : 0;
+	}
+	return hitCount;
+}
+
+// 三角形 i を origin + t * diff が [tMin, tMax] の範囲で通るか
+bool IntersectTriangle(const Vector3& origin, const Vector3& diff, const TriangleSoA& tri, size_t i, float tMin, float tMax) {
+	float t, u, v;
+	return CollisionKernels::IntersectTriangle(origin, diff, tri, i, t, u, v) && t >= tMin && t <= tMax;
+}
+
+#if defined(MT4_SSE2)
+
+//==================================
+// SSE2 版（4 個ずつ）
+//==================================
+
+// movemask の結果を hits に展開し、衝突数を返す
+inline size_t StoreHits4(__m128 mask, uint8_t* hits) {
+	const unsigned bits = static_cast<unsigned>(_mm_movemask_ps(mask));
+	for (int k = 0; k < 4; ++k) {
+		hits[k] = static_cast<uint8_t>((bits >> k) & 1u);
+	}
+	return static_cast<size_t>(std::popcount(bits));
+}
+
+using CollisionKernels::Dot4;
+
+inline __m128 Clamp01(__m128 v) { return _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(1.0f)); }
+
+size_t SphereSpheresSSE2(const Sphere& sphere, const SphereSoA& spheres, size_t count, uint8_t* hits, size_t& hitCount) {
+	const __m128 cx = _mm_set1_ps(sphere.center.x);
+	const __m128 cy = _mm_set1_ps(sphere.center.y);
+	const __m128 cz = _mm_set1_ps(sphere.center.z);
+	const __m128 r = _mm_set1_ps(sphere.radius);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const __m128 bx = _mm_sub_ps(_mm_loadu_ps(spheres.center.x + i), cx);
+		const __m128 by = _mm_sub_ps(_mm_loadu_ps(spheres.center.y + i), cy);
+		const __m128 bz = _mm_sub_ps(_mm_loadu_ps(spheres.center.z + i), cz);
+		const __m128 radiusSum = _mm_add_ps(r, _mm_loadu_ps(spheres.radius + i));
+		const __m128 mask = _mm_cmple_ps(Dot4(bx, by, bz, bx, by, bz), _mm_mul_ps(radiusSum, radiusSum));
+		hitCount += StoreHits4(mask, hits + i);
+	}
+	return i;
+}
+
+// 点を箱へクランプした距離と半径の比較（球と箱のどちらが多数側でもよい）
+inline __m128 SphereAABB4(__m128 cx, __m128 cy, __m128 cz, __m128 r, __m128 minX, __m128 minY, __m128 minZ, __m128 maxX, __m128 maxY, __m128 maxZ) {
+	const __m128 bx = _mm_sub_ps(_mm_min_ps(_mm_max_ps(cx, minX), maxX), cx);
+	const __m128 by = _mm_sub_ps(_mm_min_ps(_mm_max_ps(cy, minY), maxY), cy);
+	const __m128 bz = _mm_sub_ps(_mm_min_ps(_mm_max_ps(cz, minZ), maxZ), cz);
+	return _mm_cmple_ps(Dot4(bx, by, bz, bx, by, bz), _mm_mul_ps(r, r));
+}
+
+size_t SphereAABBsSSE2(const Sphere& sphere, const AABBSoA& aabbs, size_t count, uint8_t* hits, size_t& hitCount) {
+	const __m128 cx = _mm_set1_ps(sphere.center.x);
+	const __m128 cy = _mm_set1_ps(sphere.center.y);
+	const __m128 cz = _mm_set1_ps(sphere.center.z);
+	const __m128 r = _mm_set1_ps(sphere.radius);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const __m128 mask = SphereAABB4(
+		    cx, cy, cz, r, _mm_loadu_ps(aabbs.min.x + i), _mm_loadu_ps(aabbs.min.y + i), _mm_loadu_ps(aabbs.min.z + i), _mm_loadu_ps(aabbs.max.x + i), _mm_loadu_ps(aabbs.max.y + i),
+		    _mm_loadu_ps(aabbs.max.z + i));
+		hitCount += StoreHits4(mask, hits + i);
+	}
+	return i;
+}
+
+size_t AABBSpheresSSE2(const AABB& aabb, const SphereSoA& spheres, size_t count, uint8_t* hits, size_t& hitCount) {
+	const __m128 minX = _mm_set1_ps(aabb.min.x);
+	const __m128 minY = _mm_set1_ps(aabb.min.y);
+	const __m128 minZ = _mm_set1_ps(aabb.min.z);
+	const __m128 maxX = _mm_set1_ps(aabb.max.x);
+	const __m128 maxY = _mm_set1_ps(aabb.max.y);
+	const __m128 maxZ = _mm_set1_ps(aabb.max.z);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const __m128 mask = SphereAABB4(
+		    _mm_loadu_ps(spheres.center.x + i), _mm_loadu_ps(spheres.center.y + i), _mm_loadu_ps(spheres.center.z + i), _mm_loadu_ps(spheres.radius + i), minX, minY, minZ, maxX, maxY,
+		    maxZ);
+		hitCount += StoreHits4(mask, hits + i);
+	}
+	return i;
+}
+
+size_t AABBAABBsSSE2(const AABB& aabb, const AABBSoA& aabbs, size_t count, uint8_t* hits, size_t& hitCount) {
+	const __m128 minX = _mm_set1_ps(aabb.min.x);
+	const __m128 minY = _mm_set1_ps(aabb.min.y);
+	const __m128 minZ = _mm_set1_ps(aabb.min.z);
+	const __m128 maxX = _mm_set1_ps(aabb.max.x);
+	const __m128 maxY = _mm_set1_ps(aabb.max.y);
+	const __m128 maxZ = _mm_set1_ps(aabb.max.z);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 mask = _mm_and_ps(_mm_cmple_ps(minX, _mm_loadu_ps(aabbs.max.x + i)), _mm_cmpge_ps(maxX, _mm_loadu_ps(aabbs.min.x + i)));
+		mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmple_ps(minY, _mm_loadu_ps(aabbs.max.y + i)), _mm_cmpge_ps(maxY, _mm_loadu_ps(aabbs.min.y + i))));
+		mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmple_ps(minZ, _mm_loadu_ps(aabbs.max.z + i)), _mm_cmpge_ps(maxZ, _mm_loadu_ps(aabbs.min.z + i))));
+		hitCount += StoreHits4(mask, hits + i);
+	}
+	return i;
+}
+
+size_t PlaneSpheresSSE2(const Plane& plane, const SphereSoA& spheres, size_t count, uint8_t* hits, size_t& hitCount) {
+	const __m128 nx = _mm_set1_ps(plane.normal.x);
+	const __m128 ny = _mm_set1_ps(plane.normal.y);
+	const __m128 nz = _mm_set1_ps(plane.normal.z);
+	const __m128 d = _mm_set1_ps(plane.distance);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const __m128 distance = _mm_sub_ps(Dot4(nx, ny, nz, _mm_loadu_ps(spheres.center.x + i), _mm_loadu_ps(spheres.center.y + i), _mm_loadu_ps(spheres.center.z + i)), d);
+		const __m128 mask = _mm_cmple_ps(SimdMath::Abs(distance), _mm_loadu_ps(spheres.radius + i));
+		hitCount += StoreHits4(mask, hits + i);
+	}
+	return i;
+}
+
+size_t PlaneAABBsSSE2(const Plane& plane, const AABBSoA& aabbs, size_t count, uint8_t* hits, size_t& hitCount) {
+	const __m128 nx = _mm_set1_ps(plane.normal.x);
+	const __m128 ny = _mm_set1_ps(plane.normal.y);
+	const __m128 nz = _mm_set1_ps(plane.normal.z);
+	const __m128 absX = _mm_set1_ps(std::fabs(plane.normal.x));
+	const __m128 absY = _mm_set1_ps(std::fabs(plane.normal.y));
+	const __m128 absZ = _mm_set1_ps(std::fabs(plane.normal.z));
+	const __m128 d = _mm_set1_ps(plane.distance);
+	const __m128 half = _mm_set1_ps(0.5f);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const __m128 maxX = _mm_loadu_ps(aabbs.max.x + i);
+		const __m128 maxY = _mm_loadu_ps(aabbs.max.y + i);
+		const __m128 maxZ = _mm_loadu_ps(aabbs.max.z + i);
+		const __m128 centerX = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(aabbs.min.x + i), maxX), half);
+		const __m128 centerY = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(aabbs.min.y + i), maxY), half);
+		const __m128 centerZ = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(aabbs.min.z + i), maxZ), half);
+		const __m128 r = Dot4(_mm_sub_ps(maxX, centerX), _mm_sub_ps(maxY, centerY), _mm_sub_ps(maxZ, centerZ), absX, absY, absZ);
+		const __m128 distance = _mm_sub_ps(Dot4(nx, ny, nz, centerX, centerY, centerZ), d);
+		hitCount += StoreHits4(_mm_cmple_ps(SimdMath::Abs(distance), r), hits + i);
+	}
+	return i;
+}
+
+// スラブ法。線は 1 本なので、軸に平行かどうかの分岐と逆数はループの外で決まる
+size_t LineAABBsSSE2(const Vector3& origin, const Vector3& diff, float tMin, float tMax, const AABBSoA& aabbs, size_t count, uint8_t* hits, size_t& hitCount) {
+	const float o[3] = {origin.x, origin.y, origin.z};
+	const float d[3] = {diff.x, diff.y, diff.z};
+	const float* lo[3] = {aabbs.min.x, aabbs.min.y, aabbs.min.z};
+	const float* hi[3] = {aabbs.max.x, aabbs.max.y, aabbs.max.z};
+	__m128 originV[3];
+	__m128 inv[3];
+	for (int axis = 0; axis < 3; ++axis) {
+		originV[axis] = _mm_set1_ps(o[axis]);
+		inv[axis] = _mm_set1_ps(d[axis] == 0.0f ? 0.0f : 1.0f / d[axis]);
+	}
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 enter = _mm_set1_ps(tMin);
+		__m128 exit = _mm_set1_ps(tMax);
+		__m128 mask = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for (int axis = 0; axis < 3; ++axis) {
+			const __m128 low = _mm_loadu_ps(lo[axis] + i);
+			const __m128 high = _mm_loadu_ps(hi[axis] + i);
+			if (d[axis] == 0.0f) {
+				mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(originV[axis], low), _mm_cmple_ps(originV[axis], high)));
+				continue;
+			}
+			const __m128 tNear = _mm_mul_ps(_mm_sub_ps(low, originV[axis]), inv[axis]);
+			const __m128 tFar = _mm_mul_ps(_mm_sub_ps(high, originV[axis]), inv[axis]);
+			enter = _mm_max_ps(enter, _mm_min_ps(tNear, tFar));
+			exit = _mm_min_ps(exit, _mm_max_ps(tNear, tFar));
+		}
+		mask = _mm_and_ps(mask, _mm_cmple_ps(enter, exit));
+		hitCount += StoreHits4(mask, hits + i);
+	}
+	return i;
+}
+
+// Möller–Trumbore（CollisionKernels.h）に t の範囲の判定を足したもの
+size_t LineTrianglesSSE2(const Vector3& origin, const Vector3& diff, float tMin, float tMax, const TriangleSoA& tri, size_t count, uint8_t* hits, size_t& hitCount) {
+	const __m128 ox = _mm_set1_ps(origin.x);
+	const __m128 oy = _mm_set1_ps(origin.y);
+	const __m128 oz = _mm_set1_ps(origin.z);
+	const __m128 dx = _mm_set1_ps(diff.x);
+	const __m128 dy = _mm_set1_ps(diff.y);
+	const __m128 dz = _mm_set1_ps(diff.z);
+	const __m128 lower = _mm_set1_ps(tMin);
+	const __m128 upper = _mm_set1_ps(tMax);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 t, u, v;
+		__m128 mask = CollisionKernels::IntersectTriangle4(ox, oy, oz, dx, dy, dz, _mm_loadu_ps(tri.vertex0.x + i), _mm_loadu_ps(tri.vertex0.y + i), _mm_loadu_ps(tri.vertex0.z + i),
+		                                                   _mm_loadu_ps(tri.edge1.x + i), _mm_loadu_ps(tri.edge1.y + i), _mm_loadu_ps(tri.edge1.z + i), _mm_loadu_ps(tri.edge2.x + i),
+		                                                   _mm_loadu_ps(tri.edge2.y + i), _mm_loadu_ps(tri.edge2.z + i), t, u, v);
+		mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(t, lower), _mm_cmple_ps(t, upper)));
+		hitCount += StoreHits4(mask, hits + i);
+	}
+	return i;
+}
+
+// closestPoint（Math3D）と同じく、終点を求めてから始点を引いた向きを使う
+size_t SphereCapsulesSSE2(const Sphere& sphere, const CapsuleSoA& capsules, size_t count, uint8_t* hits, size_t& hitCount) {
+	const __m128 cx = _mm_set1_ps(sphere.center.x);
+	const __m128 cy = _mm_set1_ps(sphere.center.y);
+	const __m128 cz = _mm_set1_ps(sphere.center.z);
+	const __m128 r = _mm_set1_ps(sphere.radius);
+	const __m128 zero = _mm_setzero_ps();
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const __m128 ax = _mm_loadu_ps(capsules.origin.x + i);
+		const __m128 ay = _mm_loadu_ps(capsules.origin.y + i);
+		const __m128 az = _mm_loadu_ps(capsules.origin.z + i);
+		const __m128 abx = _mm_sub_ps(_mm_add_ps(ax, _mm_loadu_ps(capsules.diff.x + i)), ax);
+		const __m128 aby = _mm_sub_ps(_mm_add_ps(ay, _mm_loadu_ps(capsules.diff.y + i)), ay);
+		const __m128 abz = _mm_sub_ps(_mm_add_ps(az, _mm_loadu_ps(capsules.diff.z + i)), az);
+		const __m128 abLenSq = Dot4(abx, aby, abz, abx, aby, abz);
+		const __m128 t = Clamp01(_mm_div_ps(Dot4(_mm_sub_ps(cx, ax), _mm_sub_ps(cy, ay), _mm_sub_ps(cz, az), abx, aby, abz), abLenSq));
+		// 長さ 0 の線分は始点
+		const __m128 degenerate = _mm_cmpeq_ps(abLenSq, zero);
+		const __m128 px = SimdMath::Select(degenerate, ax, _mm_add_ps(ax, _mm_mul_ps(abx, t)));
+		const __m128 py = SimdMath::Select(degenerate, ay, _mm_add_ps(ay, _mm_mul_ps(aby, t)));
+		const __m128 pz = SimdMath::Select(degenerate, az, _mm_add_ps(az, _mm_mul_ps(abz, t)));
+		const __m128 bx = _mm_sub_ps(px, cx);
+		const __m128 by = _mm_sub_ps(py, cy);
+		const __m128 bz = _mm_sub_ps(pz, cz);
+		const __m128 radiusSum = _mm_add_ps(r, _mm_loadu_ps(capsules.radius + i));
+		hitCount += StoreHits4(_mm_cmple_ps(Dot4(bx, by, bz, bx, by, bz), _mm_mul_ps(radiusSum, radiusSum)), hits + i);
+	}
+	return i;
+}
+
+// ClosestPointsSegmentSegment の分岐を選択に置き換えたもの。
+// 1 本目の線分の長さはループの外で決まるので、そこだけは通常の分岐にする
+size_t CapsuleCapsulesSSE2(const Capsule& capsule, const CapsuleSoA& capsules, size_t count, uint8_t* hits, size_t& hitCount) {
+	const Vector3& o1 = capsule.segment.origin;
+	const Vector3& d1 = capsule.segment.diff;
+	const float a = Dot(d1, d1);
+	const bool firstIsPoint = a <= kDegenerateLengthSq;
+
+	const __m128 o1x = _mm_set1_ps(o1.x);
+	const __m128 o1y = _mm_set1_ps(o1.y);
+	const __m128 o1z = _mm_set1_ps(o1.z);
+	const __m128 d1x = _mm_set1_ps(d1.x);
+	const __m128 d1y = _mm_set1_ps(d1.y);
+	const __m128 d1z = _mm_set1_ps(d1.z);
+	const __m128 aV = _mm_set1_ps(a);
+	const __m128 r1 = _mm_set1_ps(capsule.radius);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 epsilon = _mm_set1_ps(kDegenerateLengthSq);
+	const __m128 signBit = _mm_set1_ps(-0.0f);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		const __m128 o2x = _mm_loadu_ps(capsules.origin.x + i);
+		const __m128 o2y = _mm_loadu_ps(capsules.origin.y + i);
+		const __m128 o2z = _mm_loadu_ps(capsules.origin.z + i);
+		const __m128 d2x = _mm_loadu_ps(capsules.diff.x + i);
+		const __m128 d2y = _mm_loadu_ps(capsules.diff.y + i);
+		const __m128 d2z = _mm_loadu_ps(capsules.diff.z + i);
+		const __m128 rx = _mm_sub_ps(o1x, o2x);
+		const __m128 ry = _mm_sub_ps(o1y, o2y);
+		const __m128 rz = _mm_sub_ps(o1z, o2z);
+		const __m128 e = Dot4(d2x, d2y, d2z, d2x, d2y, d2z);
+		const __m128 f = Dot4(d2x, d2y, d2z, rx, ry, rz);
+		const __m128 secondIsPoint = _mm_cmple_ps(e, epsilon);
+
+		__m128 s;
+		__m128 t;
+		if (firstIsPoint) {
+			s = zero;
+			t = _mm_andnot_ps(secondIsPoint, Clamp01(_mm_div_ps(f, e)));
+		} else {
+			const __m128 c = Dot4(d1x, d1y, d1z, rx, ry, rz);
+			const __m128 b = Dot4(d1x, d1y, d1z, d2x, d2y, d2z);
+			const __m128 sAtStart = Clamp01(_mm_div_ps(_mm_xor_ps(c, signBit), aV));
+			const __m128 sAtEnd = Clamp01(_mm_div_ps(_mm_sub_ps(b, c), aV));
+			const __m128 denominator = _mm_sub_ps(_mm_mul_ps(aV, e), _mm_mul_ps(b, b));
+			const __m128 sGeneral = _mm_and_ps(_mm_cmpneq_ps(denominator, zero), Clamp01(_mm_div_ps(_mm_sub_ps(_mm_mul_ps(b, f), _mm_mul_ps(c, e)), denominator)));
+			const __m128 tGeneral = _mm_div_ps(_mm_add_ps(_mm_mul_ps(b, sGeneral), f), e);
+			s = SimdMath::Select(_mm_cmplt_ps(tGeneral, zero), sAtStart, SimdMath::Select(_mm_cmpgt_ps(tGeneral, one), sAtEnd, sGeneral));
+			t = Clamp01(tGeneral);
+			// 2 本目が点の要素
+			s = SimdMath::Select(secondIsPoint, sAtStart, s);
+			t = _mm_andnot_ps(secondIsPoint, t);
+		}
+
+		const __m128 bx = _mm_sub_ps(_mm_add_ps(o1x, _mm_mul_ps(d1x, s)), _mm_add_ps(o2x, _mm_mul_ps(d2x, t)));
+		const __m128 by = _mm_sub_ps(_mm_add_ps(o1y, _mm_mul_ps(d1y, s)), _mm_add_ps(o2y, _mm_mul_ps(d2y, t)));
+		const __m128 bz = _mm_sub_ps(_mm_add_ps(o1z, _mm_mul_ps(d1z, s)), _mm_add_ps(o2z, _mm_mul_ps(d2z, t)));
+		const __m128 radiusSum = _mm_add_ps(r1, _mm_loadu_ps(capsules.radius + i));
+		hitCount += StoreHits4(_mm_cmple_ps(Dot4(bx, by, bz, bx, by, bz), _mm_mul_ps(radiusSum, radiusSum)), hits + i);
+	}
+	return i;
+}
+
+//==================================
+// AVX2 版（8 個ずつ、ブロードフェーズ向けの組み合わせのみ）
+//==================================
+
+MT4_TARGET_AVX2 inline size_t StoreHits8(__m256 mask, uint8_t* hits) {
+	const unsigned bits = static_cast<unsigned>(_mm256_movemask_ps(mask));
+	for (int k = 0; k < 8; ++k) {
+		hits[k] = static_cast<uint8_t>((bits >> k) & 1u);
+	}
+	return static_cast<size_t>(std::popcount(bits));
+}
+
+using CollisionKernels::Dot8;
+
+MT4_TARGET_AVX2 size_t SphereSpheresAVX2(const Sphere& sphere, const SphereSoA& spheres, size_t count, uint8_t* hits, size_t& hitCount) {
+	const __m256 cx = _mm256_set1_ps(sphere.center.x);
+	const __m256 cy = _mm256_set1_ps(sphere.center.y);
+	const __m256 cz = _mm256_set1_ps(sphere.center.z);
+	const __m256 r = _mm256_set1_ps(sphere.radius);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m256 bx = _mm256_sub_ps(_mm256_loadu_ps(spheres.center.x + i), cx);
+		const __m256 by = _mm256_sub_ps(_mm256_loadu_ps(spheres.center.y + i), cy);
+		const __m256 bz = _mm256_sub_ps(_mm256_loadu_ps(spheres.center.z + i), cz);
+		const __m256 radiusSum = _mm256_add_ps(r, _mm256_loadu_ps(spheres.radius + i));
+		const __m256 mask = _mm256_cmp_ps(Dot8(bx, by, bz, bx, by, bz), _mm256_mul_ps(radiusSum, radiusSum), _CMP_LE_OQ);
+		hitCount += StoreHits8(mask, hits + i);
+	}
+	return i;
+}
+
+MT4_TARGET_AVX2 inline __m256 SphereAABB8(__m256 cx, __m256 cy, __m256 cz, __m256 r, __m256 minX, __m256 minY, __m256 minZ, __m256 maxX, __m256 maxY, __m256 maxZ) {
+	const __m256 bx = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(cx, minX), maxX), cx);
+	const __m256 by = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(cy, minY), maxY), cy);
+	const __m256 bz = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(cz, minZ), maxZ), cz);
+	return _mm256_cmp_ps(Dot8(bx, by, bz, bx, by, bz), _mm256_mul_ps(r, r), _CMP_LE_OQ);
+}
+
+MT4_TARGET_AVX2 size_t SphereAABBsAVX2(const Sphere& sphere, const AABBSoA& aabbs, size_t count, uint8_t* hits, size_t& hitCount) {
+	const __m256 cx = _mm256_set1_ps(sphere.center.x);
+	const __m256 cy = _mm256_set1_ps(sphere.center.y);
+	const __m256 cz = _mm256_set1_ps(sphere.center.z);
+	const __m256 r = _mm256_set1_ps(sphere.radius);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m256 mask = SphereAABB8(
+		    cx, cy, cz, r, _mm256_loadu_ps(aabbs.min.x + i), _mm256_loadu_ps(aabbs.min.y + i), _mm256_loadu_ps(aabbs.min.z + i), _mm256_loadu_ps(aabbs.max.x + i),
+		    _mm256_loadu_ps(aabbs.max.y + i), _mm256_loadu_ps(aabbs.max.z + i));
+		hitCount += StoreHits8(mask, hits + i);
+	}
+	return i;
+}
+
+MT4_TARGET_AVX2 size_t AABBSpheresAVX2(const AABB& aabb, const SphereSoA& spheres, size_t count, uint8_t* hits, size_t& hitCount) {
+	const __m256 minX = _mm256_set1_ps(aabb.min.x);
+	const __m256 minY = _mm256_set1_ps(aabb.min.y);
+	const __m256 minZ = _mm256_set1_ps(aabb.min.z);
+	const __m256 maxX = _mm256_set1_ps(aabb.max.x);
+	const __m256 maxY = _mm256_set1_ps(aabb.max.y);
+	const __m256 maxZ = _mm256_set1_ps(aabb.max.z);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m256 mask = SphereAABB8(
+		    _mm256_loadu_ps(spheres.center.x + i), _mm256_loadu_ps(spheres.center.y + i), _mm256_loadu_ps(spheres.center.z + i), _mm256_loadu_ps(spheres.radius + i), minX, minY, minZ,
+		    maxX, maxY, maxZ);
+		hitCount += StoreHits8(mask, hits + i);
+	}
+	return i;
+}
+
+MT4_TARGET_AVX2 size_t AABBAABBsAVX2(const AABB& aabb, const AABBSoA& aabbs, size_t count, uint8_t* hits, size_t& hitCount) {
+	const __m256 minX = _mm256_set1_ps(aabb.min.x);
+	const __m256 minY = _mm256_set1_ps(aabb.min.y);
+	const __m256 minZ = _mm256_set1_ps(aabb.min.z);
+	const __m256 maxX = _mm256_set1_ps(aabb.max.x);
+	const __m256 maxY = _mm256_set1_ps(aabb.max.y);
+	const __m256 maxZ = _mm256_set1_ps(aabb.max.z);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256 mask = _mm256_and_ps(_mm256_cmp_ps(minX, _mm256_loadu_ps(aabbs.max.x + i), _CMP_LE_OQ), _mm256_cmp_ps(maxX, _mm256_loadu_ps(aabbs.min.x + i), _CMP_GE_OQ));
+		mask = _mm256_and_ps(mask, _mm256_and_ps(_mm256_cmp_ps(minY, _mm256_loadu_ps(aabbs.max.y + i), _CMP_LE_OQ), _mm256_cmp_ps(maxY, _mm256_loadu_ps(aabbs.min.y + i), _CMP_GE_OQ)));
+		mask = _mm256_and_ps(mask, _mm256_and_ps(_mm256_cmp_ps(minZ, _mm256_loadu_ps(aabbs.max.z + i), _CMP_LE_OQ), _mm256_cmp_ps(maxZ, _mm256_loadu_ps(aabbs.min.z + i), _CMP_GE_OQ)));
+		hitCount += StoreHits8(mask, hits + i);
+	}
+	return i;
+}
+
+MT4_TARGET_AVX2 size_t PlaneSpheresAVX2(const Plane& plane, const SphereSoA& spheres, size_t count, uint8_t* hits, size_t& hitCount) {
+	const __m256 nx = _mm256_set1_ps(plane.normal.x);
+	const __m256 ny = _mm256_set1_ps(plane.normal.y);
+	const __m256 nz = _mm256_set1_ps(plane.normal.z);
+	const __m256 d = _mm256_set1_ps(plane.distance);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		const __m256 distance =
+		    _mm256_sub_ps(Dot8(nx, ny, nz, _mm256_loadu_ps(spheres.center.x + i), _mm256_loadu_ps(spheres.center.y + i), _mm256_loadu_ps(spheres.center.z + i)), d);
+		const __m256 mask = _mm256_cmp_ps(SimdMath::Abs(distance), _mm256_loadu_ps(spheres.radius + i), _CMP_LE_OQ);
+		hitCount += StoreHits8(mask, hits + i);
+	}
+	return i;
+}
+
+#endif
+
+} // namespace
+
+//==================================
+// SoA の格納先
+//==================================
+
+void SphereBatch::Add(const Sphere& sphere) {
+	x_.push_back(sphere.center.x);
+	y_.push_back(sphere.center.y);
+	z_.push_back(sphere.center.z);
+	radius_.push_back(sphere.radius);
+}
+
+void SphereBatch::Clear() {
+	x_.clear();
+	y_.clear();
+	z_.clear();
+	radius_.clear();
+}
+
+void AABBBatch::Add(const AABB& aabb) {
+	minX_.push_back(aabb.min.x);
+	minY_.push_back(aabb.min.y);
+	minZ_.push_back(aabb.min.z);
+	maxX_.push_back(aabb.max.x);
+	maxY_.push_back(aabb.max.y);
+	maxZ_.push_back(aabb.max.z);
+}
+
+void AABBBatch::Clear() {
+	minX_.clear();
+	minY_.clear();
+	minZ_.clear();
+	maxX_.clear();
+	maxY_.clear();
+	maxZ_.clear();
+}
+
+// 辺は Collision.cpp と同じ引き算で求めるので、判定結果も一致する
+void TriangleBatch::Add(const Triangle& triangle) {
+	const Vector3 edge1 = Subtract(triangle.vertices[1], triangle.vertices[0]);
+	const Vector3 edge2 = Subtract(triangle.vertices[2], triangle.vertices[0]);
+	v0x_.push_back(triangle.vertices[0].x);
+	v0y_.push_back(triangle.vertices[0].y);
+	v0z_.push_back(triangle.vertices[0].z);
+	e1x_.push_back(edge1.x);
+	e1y_.push_back(edge1.y);
+	e1z_.push_back(edge1.z);
+	e2x_.push_back(edge2.x);
+	e2y_.push_back(edge2.y);
+	e2z_.push_back(edge2.z);
+}
+
+void TriangleBatch::Clear() {
+	for (std::vector<float>* v : {&v0x_, &v0y_, &v0z_, &e1x_, &e1y_, &e1z_, &e2x_, &e2y_, &e2z_}) {
+		v->clear();
+	}
+}
+
+void CapsuleBatch::Add(const Capsule& capsule) {
+	ox_.push_back(capsule.segment.origin.x);
+	oy_.push_back(capsule.segment.origin.y);
+	oz_.push_back(capsule.segment.origin.z);
+	dx_.push_back(capsule.segment.diff.x);
+	dy_.push_back(capsule.segment.diff.y);
+	dz_.push_back(capsule.segment.diff.z);
+	radius_.push_back(capsule.radius);
+}
+
+void CapsuleBatch::Clear() {
+	for (std::vector<float>* v : {&ox_, &oy_, &oz_, &dx_, &dy_, &dz_, &radius_}) {
+		v->clear();
+	}
+}
+
+//==================================
+// 1 対 多の判定
+//==================================
+
+size_t TestCollisions(const Sphere& sphere, const SphereSoA& spheres, size_t count, uint8_t* hits) {
+	size_t hitCount = 0;
+	size_t done = 0;
+	switch (GetSimdLevel()) {
+#if defined(MT4_SSE2)
+	case SimdLevel::AVX2:
+		done = SphereSpheresAVX2(sphere, spheres, count, hits, hitCount);
+		break;
+	case SimdLevel::SSE2:
+		done = SphereSpheresSSE2(sphere, spheres, count, hits, hitCount);
+		break;
+#endif
+	default:
+		break;
+	}
+	return hitCount + TestScalar(done, count, hits, [&](size_t i) { return IsCollision(sphere, LoadSphere(spheres, i)); });
+}
+
+size_t TestCollisions(const Sphere& sphere, const AABBSoA& aabbs, size_t count, uint8_t* hits) {
+	size_t hitCount = 0;
+	size_t done = 0;
+	switch (GetSimdLevel()) {
+#if defined(MT4_SSE2)
+	case SimdLevel::AVX2:
+		done = SphereAABBsAVX2(sphere, aabbs, count, hits, hitCount);
+		break;
+	case SimdLevel::SSE2:
+		done = SphereAABBsSSE2(sphere, aabbs, count, hits, hitCount);
+		break;
+#endif
+	default:
+		break;
+	}
+	return hitCount + TestScalar(done, count, hits, [&](size_t i) { return IsCollision(sphere, LoadAABB(aabbs, i)); });
+}
+
+size_t TestCollisions(const AABB& aabb, const SphereSoA& spheres, size_t count, uint8_t* hits) {
+	size_t hitCount = 0;
+	size_t done = 0;
+	switch (GetSimdLevel()) {
+#if defined(MT4_SSE2)
+	case SimdLevel::AVX2:
+		done = AABBSpheresAVX2(aabb, spheres, count, hits, hitCount);
+		break;
+	case SimdLevel::SSE2:
+		done = AABBSpheresSSE2(aabb, spheres, count, hits, hitCount);
+		break;
+#endif
+	default:
+		break;
+	}
+	return hitCount + TestScalar(done, count, hits, [&](size_t i) { return IsCollision(LoadSphere(spheres, i), aabb); });
+}
+
+size_t TestCollisions(const AABB& aabb, const AABBSoA& aabbs, size_t count, uint8_t* hits) {
+	size_t hitCount = 0;
+	size_t done = 0;
+	switch (GetSimdLevel()) {
+#if defined(MT4_SSE2)
+	case SimdLevel::AVX2:
+		done = AABBAABBsAVX2(aabb, aabbs, count, hits, hitCount);
+		break;
+	case SimdLevel::SSE2:
+		done = AABBAABBsSSE2(aabb, aabbs, count, hits, hitCount);
+		break;
+#endif
+	default:
+		break;
+	}
+	return hitCount + TestScalar(done, count, hits, [&](size_t i) { return IsCollision(aabb, LoadAABB(aabbs, i)); });
+}
+
+size_t TestCollisions(const Plane& plane, const SphereSoA& spheres, size_t count, uint8_t* hits) {
+	size_t hitCount = 0;
+	size_t done = 0;
+	switch (GetSimdLevel()) {
+#if defined(MT4_SSE2)
+	case SimdLevel::AVX2:
+		done = PlaneSpheresAVX2(plane, spheres, count, hits, hitCount);
+		break;
+	case SimdLevel::SSE2:
+		done = PlaneSpheresSSE2(plane, spheres, count, hits, hitCount);
+		break;
+#endif
+	default:
+		break;
+	}
+	return hitCount + TestScalar(done, count, hits, [&](size_t i) { return IsCollision(LoadSphere(spheres, i), plane); });
+}
+
+size_t TestCollisions(const Plane& plane, const AABBSoA& aabbs, size_t count, uint8_t* hits) {
+	size_t hitCount = 0;
+	size_t done = 0;
+#if defined(MT4_SSE2)
+	if (GetSimdLevel() != SimdLevel::Scalar) {
+		done = PlaneAABBsSSE2(plane, aabbs, count, hits, hitCount);
+	}
+#endif
+	return hitCount + TestScalar(done, count, hits, [&](size_t i) { return IsCollision(LoadAABB(aabbs, i), plane); });
+}
+
+size_t TestCollisions(const Ray& ray, const AABBSoA& aabbs, size_t count, uint8_t* hits) {
+	size_t hitCount = 0;
+	size_t done = 0;
+#if defined(MT4_SSE2)
+	if (GetSimdLevel() != SimdLevel::Scalar) {
+		done = LineAABBsSSE2(ray.origin, ray.diff, 0.0f, INFINITY, aabbs, count, hits, hitCount);
+	}
+#endif
+	return hitCount + TestScalar(done, count, hits, [&](size_t i) { return IsCollision(LoadAABB(aabbs, i), ray); });
+}
+
+size_t TestCollisions(const Segment& segment, const AABBSoA& aabbs, size_t count, uint8_t* hits) {
+	size_t hitCount = 0;
+	size_t done = 0;
+#if defined(MT4_SSE2)
+	if (GetSimdLevel() != SimdLevel::Scalar) {
+		done = LineAABBsSSE2(segment.origin, segment.diff, 0.0f, 1.0f, aabbs, count, hits, hitCount);
+	}
+#endif
+	return hitCount + TestScalar(done, count, hits, [&](size_t i) { return IsCollision(LoadAABB(aabbs, i), segment); });
+}
+
+size_t TestCollisions(const Ray& ray, const TriangleSoA& triangles, size_t count, uint8_t* hits) {
+	size_t hitCount = 0;
+	size_t done = 0;
+#if defined(MT4_SSE2)
+	if (GetSimdLevel() != SimdLevel::Scalar) {
+		done = LineTrianglesSSE2(ray.origin, ray.diff, 0.0f, INFINITY, triangles, count, hits, hitCount);
+	}
+#endif
+	return hitCount + TestScalar(done, count, hits, [&](size_t i) { return IntersectTriangle(ray.origin, ray.diff, triangles, i, 0.0f, INFINITY); });
+}
+
+size_t TestCollisions(const Segment& segment, const TriangleSoA& triangles, size_t count, uint8_t* hits) {
+	size_t hitCount = 0;
+	size_t done = 0;
+#if defined(MT4_SSE2)
+	if (GetSimdLevel() != SimdLevel::Scalar) {
+		done = LineTrianglesSSE2(segment.origin, segment.diff, 0.0f, 1.0f, triangles, count, hits, hitCount);
+	}
+#endif
+	return hitCount + TestScalar(done, count, hits, [&](size_t i) { return IntersectTriangle(segment.origin, segment.diff, triangles, i, 0.0f, 1.0f); });
+}
+
+size_t TestCollisions(const Sphere& sphere, const CapsuleSoA& capsules, size_t count, uint8_t* hits) {
+	size_t hitCount = 0;
+	size_t done = 0;
+#if defined(MT4_SSE2)
+	if (GetSimdLevel() != SimdLevel::Scalar) {
+		done = SphereCapsulesSSE2(sphere, capsules, count, hits, hitCount);
+	}
+#endif
+	return hitCount + TestScalar(done, count, hits, [&](size_t i) { return IsCollision(sphere, LoadCapsule(capsules, i)); });
+}
+
+size_t TestCollisions(const Capsule& capsule, const CapsuleSoA& capsules, size_t count, uint8_t* hits) {
+	size_t hitCount = 0;
+	size_t done = 0;
+#if defined(MT4_SSE2)
+	if (GetSimdLevel() != SimdLevel::Scalar) {
+		done = CapsuleCapsulesSSE2(capsule, capsules, count, hits, hitCount);
+	}
+#endif
+	return hitCount + TestScalar(done, count, hits, [&](size_t i) { return IsCollision(capsule, LoadCapsule(capsules, i)); });
+}
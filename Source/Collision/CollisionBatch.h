@@ -0,0 +1,115 @@
+#pragma once
+#include "Collision.h"
+#include "Math/TransformKernels.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//==================================
+// 衝突判定の一括処理（1 対 多）
+//==================================
+// 1 つの図形と、SoA で並べた多数の図形をまとめて判定する。
+// 結果は hits[i] に 1（衝突）/ 0 を書き込み、戻り値は衝突した数。
+// 判定式と演算の順序は Collision.h の IsCollision と同じなので、
+// 同じ値を渡せば 1 つずつ判定した場合と結果が一致する。
+//
+// SSE2 では 4 個、AVX2 では 8 個ずつ判定する。AVX2 版があるのは
+// 球 / AABB 同士と平面の判定（ブロードフェーズで数が多くなるもの）で、
+// 線分・三角形・カプセルは SSE2 版を使う。
+
+//==================================
+// SoA の参照
+//==================================
+
+struct SphereSoA {
+	ConstVector3SoA center;
+	const float* radius;
+};
+
+struct AABBSoA {
+	ConstVector3SoA min;
+	ConstVector3SoA max;
+};
+
+// 三角形は Möller–Trumbore でそのまま使えるよう、頂点 0 と 2 辺で持つ
+struct TriangleSoA {
+	ConstVector3SoA vertex0;
+	ConstVector3SoA edge1; // vertices[1] - vertices[0]
+	ConstVector3SoA edge2; // vertices[2] - vertices[0]
+};
+
+struct CapsuleSoA {
+	ConstVector3SoA origin;
+	ConstVector3SoA diff;
+	const float* radius;
+};
+
+//==================================
+// SoA の格納先
+//==================================
+// struct.h の図形を Add で追加していき、View() で判定関数へ渡す
+
+class SphereBatch {
+public:
+	void Add(const Sphere& sphere);
+	void Clear();
+	size_t Size() const { return radius_.size(); }
+	SphereSoA View() const { return {{x_.data(), y_.data(), z_.data()}, radius_.data()}; }
+
+private:
+	std::vector<float> x_, y_, z_, radius_;
+};
+
+class AABBBatch {
+public:
+	void Add(const AABB& aabb);
+	void Clear();
+	size_t Size() const { return minX_.size(); }
+	AABBSoA View() const { return {{minX_.data(), minY_.data(), minZ_.data()}, {maxX_.data(), maxY_.data(), maxZ_.data()}}; }
+
+private:
+	std::vector<float> minX_, minY_, minZ_, maxX_, maxY_, maxZ_;
+};
+
+class TriangleBatch {
+public:
+	void Add(const Triangle& triangle);
+	void Clear();
+	size_t Size() const { return v0x_.size(); }
+	TriangleSoA View() const {
+		return {{v0x_.data(), v0y_.data(), v0z_.data()}, {e1x_.data(), e1y_.data(), e1z_.data()}, {e2x_.data(), e2y_.data(), e2z_.data()}};
+	}
+
+private:
+	std::vector<float> v0x_, v0y_, v0z_, e1x_, e1y_, e1z_, e2x_, e2y_, e2z_;
+};
+
+class CapsuleBatch {
+public:
+	void Add(const Capsule& capsule);
+	void Clear();
+	size_t Size() const { return radius_.size(); }
+	CapsuleSoA View() const { return {{ox_.data(), oy_.data(), oz_.data()}, {dx_.data(), dy_.data(), dz_.data()}, radius_.data()}; }
+
+private:
+	std::vector<float> ox_, oy_, oz_, dx_, dy_, dz_, radius_;
+};
+
+//==================================
+// 1 対 多の判定
+//==================================
+
+size_t TestCollisions(const Sphere& sphere, const SphereSoA& spheres, size_t count, uint8_t* hits);
+size_t TestCollisions(const Sphere& sphere, const AABBSoA& aabbs, size_t count, uint8_t* hits);
+size_t TestCollisions(const AABB& aabb, const SphereSoA& spheres, size_t count, uint8_t* hits);
+size_t TestCollisions(const AABB& aabb, const AABBSoA& aabbs, size_t count, uint8_t* hits);
+size_t TestCollisions(const Plane& plane, const SphereSoA& spheres, size_t count, uint8_t* hits);
+size_t TestCollisions(const Plane& plane, const AABBSoA& aabbs, size_t count, uint8_t* hits);
+
+size_t TestCollisions(const Ray& ray, const AABBSoA& aabbs, size_t count, uint8_t* hits);
+size_t TestCollisions(const Segment& segment, const AABBSoA& aabbs, size_t count, uint8_t* hits);
+size_t TestCollisions(const Ray& ray, const TriangleSoA& triangles, size_t count, uint8_t* hits);
+size_t TestCollisions(const Segment& segment, const TriangleSoA& triangles, size_t count, uint8_t* hits);
+
+size_t TestCollisions(const Sphere& sphere, const CapsuleSoA& capsules, size_t count, uint8_t* hits);
+size_t TestCollisions(const Capsule& capsule, const CapsuleSoA& capsules, size_t count, uint8_t* hits);
@@ -0,0 +1,127 @@
+#pragma once
+#include "CollisionBatch.h"
+#include "Math/CpuFeatures.h"
+#include "Math/Math3D.h"
+#include <cstddef>
+
+//==================================
+// 衝突判定の共通カーネル（内部用）
+//==================================
+// Collision.cpp / CollisionBatch.cpp / RayCast.cpp / Frustum.cpp で共有する。
+// 1 つずつの版と SIMD 版の結果を一致させるため、Möller–Trumbore と
+// レーンごとの内積の演算順はここだけに書く。
+
+namespace CollisionKernels {
+
+// Möller–Trumbore（頂点 0 と 2 辺から始める）。三角形の内側を通れば t, u, v を書き込んで true を返す。
+// t の範囲は呼び出し側で調べる
+inline bool IntersectTriangle(const Vector3& origin, const Vector3& diff, const Vector3& vertex0, const Vector3& edge1, const Vector3& edge2, float& t, float& u, float& v) {
+	const Vector3 p = Cross(diff, edge2);
+	const float det = Dot(edge1, p);
+	if (det == 0.0f) {
+		// 三角形の面と平行
+		return false;
+	}
+	const float invDet = 1.0f / det;
+	const Vector3 s = Subtract(origin, vertex0);
+	u = Dot(s, p) * invDet;
+	if (u < 0.0f || u > 1.0f) {
+		return false;
+	}
+	const Vector3 q = Cross(s, edge1);
+	v = Dot(diff, q) * invDet;
+	if (v < 0.0f || u + v > 1.0f) {
+		return false;
+	}
+	t = Dot(edge2, q) * invDet;
+	return true;
+}
+
+inline bool IntersectTriangle(const Vector3& origin, const Vector3& diff, const TriangleSoA& tri, size_t i, float& t, float& u, float& v) {
+	const Vector3 vertex0 = {tri.vertex0.x[i], tri.vertex0.y[i], tri.vertex0.z[i]};
+	const Vector3 edge1 = {tri.edge1.x[i], tri.edge1.y[i], tri.edge1.z[i]};
+	const Vector3 edge2 = {tri.edge2.x[i], tri.edge2.y[i], tri.edge2.z[i]};
+	return IntersectTriangle(origin, diff, vertex0, edge1, edge2, t, u, v);
+}
+
+#if defined(MT4_SSE2)
+
+//==================================
+// SSE2 版（4 レーン）
+//==================================
+
+inline __m128 Dot4(__m128 ax, __m128 ay, __m128 az, __m128 bx, __m128 by, __m128 bz) {
+	return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+}
+
+// 4 組の線と三角形を判定し、三角形の内側を通るレーンのマスクを返す（t の範囲は呼び出し側で調べる）。
+// det が 0 のレーンは t, u, v が無限大や NaN になるが、マスクで落ちる
+inline __m128 IntersectTriangle4(__m128 ox, __m128 oy, __m128 oz, __m128 dx, __m128 dy, __m128 dz, __m128 v0x, __m128 v0y, __m128 v0z, __m128 e1x, __m128 e1y, __m128 e1z, __m128 e2x, __m128 e2y,
+                                 __m128 e2z, __m128& t, __m128& u, __m128& v) {
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+
+	// p = diff × edge2
+	const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+	const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+	const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+	const __m128 det = Dot4(e1x, e1y, e1z, px, py, pz);
+	const __m128 invDet = _mm_div_ps(one, det);
+
+	const __m128 sx = _mm_sub_ps(ox, v0x);
+	const __m128 sy = _mm_sub_ps(oy, v0y);
+	const __m128 sz = _mm_sub_ps(oz, v0z);
+	u = _mm_mul_ps(Dot4(sx, sy, sz, px, py, pz), invDet);
+
+	// q = s × edge1
+	const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+	const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+	const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+	v = _mm_mul_ps(Dot4(dx, dy, dz, qx, qy, qz), invDet);
+	t = _mm_mul_ps(Dot4(e2x, e2y, e2z, qx, qy, qz), invDet);
+
+	__m128 mask = _mm_cmpneq_ps(det, zero);
+	mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one)));
+	return _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+}
+
+//==================================
+// AVX2 版（8 レーン）
+//==================================
+
+MT4_TARGET_AVX2 inline __m256 Dot8(__m256 ax, __m256 ay, __m256 az, __m256 bx, __m256 by, __m256 bz) {
+	return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(ax, bx), _mm256_mul_ps(ay, by)), _mm256_mul_ps(az, bz));
+}
+
+MT4_TARGET_AVX2 inline __m256 IntersectTriangle8(__m256 ox, __m256 oy, __m256 oz, __m256 dx, __m256 dy, __m256 dz, __m256 v0x, __m256 v0y, __m256 v0z, __m256 e1x, __m256 e1y, __m256 e1z, __m256 e2x,
+                                                 __m256 e2y, __m256 e2z, __m256& t, __m256& u, __m256& v) {
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.0f);
+
+	// p = diff × edge2
+	const __m256 px = _mm256_sub_ps(_mm256_mul_ps(dy, e2z), _mm256_mul_ps(dz, e2y));
+	const __m256 py = _mm256_sub_ps(_mm256_mul_ps(dz, e2x), _mm256_mul_ps(dx, e2z));
+	const __m256 pz = _mm256_sub_ps(_mm256_mul_ps(dx, e2y), _mm256_mul_ps(dy, e2x));
+	const __m256 det = Dot8(e1x, e1y, e1z, px, py, pz);
+	const __m256 invDet = _mm256_div_ps(one, det);
+
+	const __m256 sx = _mm256_sub_ps(ox, v0x);
+	const __m256 sy = _mm256_sub_ps(oy, v0y);
+	const __m256 sz = _mm256_sub_ps(oz, v0z);
+	u = _mm256_mul_ps(Dot8(sx, sy, sz, px, py, pz), invDet);
+
+	// q = s × edge1
+	const __m256 qx = _mm256_sub_ps(_mm256_mul_ps(sy, e1z), _mm256_mul_ps(sz, e1y));
+	const __m256 qy = _mm256_sub_ps(_mm256_mul_ps(sz, e1x), _mm256_mul_ps(sx, e1z));
+	const __m256 qz = _mm256_sub_ps(_mm256_mul_ps(sx, e1y), _mm256_mul_ps(sy, e1x));
+	v = _mm256_mul_ps(Dot8(dx, dy, dz, qx, qy, qz), invDet);
+	t = _mm256_mul_ps(Dot8(e2x, e2y, e2z, qx, qy, qz), invDet);
+
+	__m256 mask = _mm256_cmp_ps(det, zero, _CMP_NEQ_UQ);
+	mask = _mm256_and_ps(mask, _mm256_and_ps(_mm256_cmp_ps(u, zero, _CMP_GE_OQ), _mm256_cmp_ps(u, one, _CMP_LE_OQ)));
+	return _mm256_and_ps(mask, _mm256_and_ps(_mm256_cmp_ps(v, zero, _CMP_GE_OQ), _mm256_cmp_ps(_mm256_add_ps(u, v), one, _CMP_LE_OQ)));
+}
+
+#endif
+
+} // namespace CollisionKernels
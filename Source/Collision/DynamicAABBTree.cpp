@@ -0,0 +1,532 @@
+#include "DynamicAABBTree.h"
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace {
+
+// Rebuild の SAH で使うビンの数
+constexpr int kSahBinCount = 16;
+
+// 太い AABB が実際の AABB よりこの倍数ぶん以上大きくなったら縮め直す
+constexpr float kShrinkMarginScale = 4.0f;
+
+} // namespace
+
+DynamicAABBTree::DynamicAABBTree(const Settings& settings) : settings_(settings) {}
+
+//==================================
+// ノードの確保
+//==================================
+
+int32_t DynamicAABBTree::AllocateNode() {
+	if (freeList_ == kNullNode) {
+		nodes_.push_back({});
+		freeList_ = static_cast<int32_t>(nodes_.size() - 1);
+		nodes_[freeList_].parent = kNullNode;
+	}
+	const int32_t index = freeList_;
+	Node& node = nodes_[index];
+	freeList_ = node.parent;
+	node.parent = kNullNode;
+	node.child1 = kNullNode;
+	node.child2 = kNullNode;
+	node.height = 0;
+	node.userData = 0;
+	return index;
+}
+
+void DynamicAABBTree::FreeNode(int32_t index) {
+	Node& node = nodes_[index];
+	node.parent = freeList_;
+	node.height = -1;
+	freeList_ = index;
+}
+
+void DynamicAABBTree::Clear() {
+	nodes_.clear();
+	root_ = kNullNode;
+	freeList_ = kNullNode;
+	proxyCount_ = 0;
+}
+
+//==================================
+// プロキシ
+//==================================
+
+DynamicAABBTree::Bounds DynamicAABBTree::MakeFatBounds(const AABB& aabb, const Vector3& displacement) const {
+	const float margin = settings_.fatMargin;
+	Bounds fat = {
+	    {aabb.min.x - margin, aabb.min.y - margin, aabb.min.z - margin},
+	    {aabb.max.x + margin, aabb.max.y + margin, aabb.max.z + margin},
+	};
+
+	// 進行方向へ先回りして広げる
+	const float dx = settings_.displacementMultiplier * displacement.x;
+	const float dy = settings_.displacementMultiplier * displacement.y;
+	const float dz = settings_.displacementMultiplier * displacement.z;
+	(dx < 0.0f ? fat.min.x : fat.max.x) += dx;
+	(dy < 0.0f ? fat.min.y : fat.max.y) += dy;
+	(dz < 0.0f ? fat.min.z : fat.max.z) += dz;
+	return fat;
+}
+
+int32_t DynamicAABBTree::Insert(const AABB& aabb, uint32_t userData) {
+	const int32_t proxy = AllocateNode();
+	Node& node = nodes_[proxy];
+	node.bounds = MakeFatBounds(aabb, {0.0f, 0.0f, 0.0f});
+	node.userData = userData;
+	InsertLeaf(proxy);
+	++proxyCount_;
+	return proxy;
+}
+
+void DynamicAABBTree::Remove(int32_t proxy) {
+	assert(nodes_[proxy].IsLeaf());
+	RemoveLeaf(proxy);
+	FreeNode(proxy);
+	--proxyCount_;
+}
+
+bool DynamicAABBTree::Move(int32_t proxy, const AABB& aabb, const Vector3& displacement) {
+	assert(nodes_[proxy].IsLeaf());
+	Node& node = nodes_[proxy];
+
+	if (settings_.updateMode == UpdateMode::Refit) {
+		node.bounds = MakeFatBounds(aabb, displacement);
+		return false;
+	}
+
+	const Bounds tight = {aabb.min, aabb.max};
+	if (Contains(node.bounds, tight)) {
+		// まだ収まっていても、太い AABB が大きすぎるなら縮め直す
+		const float margin = settings_.fatMargin * kShrinkMarginScale;
+		const Bounds fatLimit = MakeFatBounds(
+		    {
+		        {aabb.min.x - margin, aabb.min.y - margin, aabb.min.z - margin},
+		        {aabb.max.x + margin, aabb.max.y + margin, aabb.max.z + margin},
+		    },
+		    displacement);
+		if (Contains(fatLimit, node.bounds)) {
+			return false;
+		}
+	}
+
+	RemoveLeaf(proxy);
+	nodes_[proxy].bounds = MakeFatBounds(aabb, displacement);
+	InsertLeaf(proxy);
+	return true;
+}
+
+AABB DynamicAABBTree::GetFatAABB(int32_t proxy) const {
+	AABB aabb;
+	aabb.min = nodes_[proxy].bounds.min;
+	aabb.max = nodes_[proxy].bounds.max;
+	return aabb;
+}
+
+//==================================
+// 挿入と削除
+//==================================
+
+void DynamicAABBTree::ReplaceChild(int32_t parent, int32_t oldChild, int32_t newChild) {
+	if (parent == kNullNode) {
+		root_ = newChild;
+	} else if (nodes_[parent].child1 == oldChild) {
+		nodes_[parent].child1 = newChild;
+	} else {
+		nodes_[parent].child2 = newChild;
+	}
+}
+
+void DynamicAABBTree::UpdateFromChildren(int32_t index) {
+	Node& node = nodes_[index];
+	const Node& child1 = nodes_[node.child1];
+	const Node& child2 = nodes_[node.child2];
+	node.bounds = Union(child1.bounds, child2.bounds);
+	node.height = 1 + (std::max)(child1.height, child2.height);
+}
+
+// 表面積の増加が最も少ない兄弟を探して、その位置に親を挟んで入れる
+void DynamicAABBTree::InsertLeaf(int32_t leaf) {
+	if (root_ == kNullNode) {
+		root_ = leaf;
+		nodes_[leaf].parent = kNullNode;
+		return;
+	}
+
+	const Bounds leafBounds = nodes_[leaf].bounds;
+	int32_t index = root_;
+	while (!nodes_[index].IsLeaf()) {
+		const Node& node = nodes_[index];
+		const float area = HalfArea(node.bounds);
+		const float combinedArea = HalfArea(Union(node.bounds, leafBounds));
+
+		// ここに兄弟として入れる場合のコスト
+		const float cost = 2.0f * combinedArea;
+		// 子へ降りる場合に、このノードが広がるぶんのコスト
+		const float inheritanceCost = 2.0f * (combinedArea - area);
+
+		auto descendCost = [&](int32_t childIndex) {
+			const Node& child = nodes_[childIndex];
+			const float unionArea = HalfArea(Union(child.bounds, leafBounds));
+			return child.IsLeaf() ? unionArea + inheritanceCost : (unionArea - HalfArea(child.bounds)) + inheritanceCost;
+		};
+		const float cost1 = descendCost(node.child1);
+		const float cost2 = descendCost(node.child2);
+
+		if (cost < cost1 && cost < cost2) {
+			break;
+		}
+		index = cost1 < cost2 ? node.child1 : node.child2;
+	}
+
+	const int32_t sibling = index;
+	const int32_t oldParent = nodes_[sibling].parent;
+	const int32_t newParent = AllocateNode();
+	Node& parent = nodes_[newParent];
+	parent.parent = oldParent;
+	parent.child1 = sibling;
+	parent.child2 = leaf;
+	parent.bounds = Union(leafBounds, nodes_[sibling].bounds);
+	parent.height = nodes_[sibling].height + 1;
+	ReplaceChild(oldParent, sibling, newParent);
+	nodes_[sibling].parent = newParent;
+	nodes_[leaf].parent = newParent;
+
+	// 祖先の AABB と高さを直しながら回転で釣り合いを取る
+	index = nodes_[leaf].parent;
+	while (index != kNullNode) {
+		index = Balance(index);
+		UpdateFromChildren(index);
+		index = nodes_[index].parent;
+	}
+}
+
+void DynamicAABBTree::RemoveLeaf(int32_t leaf) {
+	if (leaf == root_) {
+		root_ = kNullNode;
+		return;
+	}
+
+	const int32_t parent = nodes_[leaf].parent;
+	const int32_t grandParent = nodes_[parent].parent;
+	const int32_t sibling = nodes_[parent].child1 == leaf ? nodes_[parent].child2 : nodes_[parent].child1;
+
+	// 親を消して兄弟を繰り上げる
+	ReplaceChild(grandParent, parent, sibling);
+	nodes_[sibling].parent = grandParent;
+	FreeNode(parent);
+
+	int32_t index = grandParent;
+	while (index != kNullNode) {
+		index = Balance(index);
+		UpdateFromChildren(index);
+		index = nodes_[index].parent;
+	}
+}
+
+// 左右の高さの差が 2 以上なら、高い側の子を 1 段持ち上げる。
+// 回転後に index の位置に来たノードを返す
+int32_t DynamicAABBTree::Balance(int32_t iA) {
+	Node& a = nodes_[iA];
+	if (a.IsLeaf() || a.height < 2) {
+		return iA;
+	}
+
+	const int32_t iB = a.child1;
+	const int32_t iC = a.child2;
+	Node& b = nodes_[iB];
+	Node& c = nodes_[iC];
+	const int32_t balance = c.height - b.height;
+
+	// C を持ち上げる
+	if (balance > 1) {
+		const int32_t iF = c.child1;
+		const int32_t iG = c.child2;
+		Node& f = nodes_[iF];
+		Node& g = nodes_[iG];
+
+		c.child1 = iA;
+		c.parent = a.parent;
+		a.parent = iC;
+		ReplaceChild(c.parent, iA, iC);
+
+		// F と G の高い方を C に残す
+		if (f.height > g.height) {
+			c.child2 = iF;
+			a.child2 = iG;
+			g.parent = iA;
+		} else {
+			c.child2 = iG;
+			a.child2 = iF;
+			f.parent = iA;
+		}
+		UpdateFromChildren(iA);
+		UpdateFromChildren(iC);
+		return iC;
+	}
+
+	// B を持ち上げる
+	if (balance < -1) {
+		const int32_t iD = b.child1;
+		const int32_t iE = b.child2;
+		Node& d = nodes_[iD];
+		Node& e = nodes_[iE];
+
+		b.child1 = iA;
+		b.parent = a.parent;
+		a.parent = iB;
+		ReplaceChild(b.parent, iA, iB);
+
+		if (d.height > e.height) {
+			b.child2 = iD;
+			a.child1 = iE;
+			e.parent = iA;
+		} else {
+			b.child2 = iE;
+			a.child1 = iD;
+			d.parent = iA;
+		}
+		UpdateFromChildren(iA);
+		UpdateFromChildren(iB);
+		return iB;
+	}
+
+	return iA;
+}
+
+//==================================
+// Refit / Rebuild
+//==================================
+
+void DynamicAABBTree::Refit() {
+	if (root_ == kNullNode) {
+		return;
+	}
+	// 行きがけ順に並べて逆から処理すれば、子が親より先に更新される
+	std::vector<int32_t> order;
+	order.reserve(nodes_.size());
+	NodeStack<> stack;
+	stack.Push(root_);
+	while (!stack.Empty()) {
+		const int32_t index = stack.Pop();
+		const Node& node = nodes_[index];
+		if (node.IsLeaf()) {
+			continue;
+		}
+		order.push_back(index);
+		stack.Push(node.child1);
+		stack.Push(node.child2);
+	}
+	for (auto it = order.rbegin(); it != order.rend(); ++it) {
+		UpdateFromChildren(*it);
+	}
+}
+
+void DynamicAABBTree::Rebuild() {
+	if (root_ == kNullNode) {
+		return;
+	}
+
+	// 葉を集め、内部ノードは全て空きに戻す
+	std::vector<BuildLeaf> leaves;
+	leaves.reserve(proxyCount_);
+	NodeStack<> stack;
+	stack.Push(root_);
+	while (!stack.Empty()) {
+		const int32_t index = stack.Pop();
+		const Node& node = nodes_[index];
+		if (node.IsLeaf()) {
+			const Bounds& b = node.bounds;
+			leaves.push_back({b, {b.min.x + b.max.x, b.min.y + b.max.y, b.min.z + b.max.z}, index});
+			continue;
+		}
+		stack.Push(node.child1);
+		stack.Push(node.child2);
+		FreeNode(index);
+	}
+
+	root_ = BuildSubtree(leaves);
+	nodes_[root_].parent = kNullNode;
+	Refit();
+}
+
+// 葉の並びを上から分割して木を作る。AABB と高さは後の Refit() で求める
+int32_t DynamicAABBTree::BuildSubtree(std::vector<BuildLeaf>& leaves) {
+	struct Range {
+		size_t begin;
+		size_t end;
+		int32_t parent;
+		bool isChild1;
+	};
+
+	int32_t root = kNullNode;
+	std::vector<Range> work;
+	work.push_back({0, leaves.size(), kNullNode, true});
+	while (!work.empty()) {
+		const Range range = work.back();
+		work.pop_back();
+
+		int32_t index;
+		if (range.end - range.begin == 1) {
+			index = leaves[range.begin].leaf;
+		} else {
+			index = AllocateNode();
+			const size_t middle = SplitLeaves(leaves, range.begin, range.end);
+			work.push_back({range.begin, middle, index, true});
+			work.push_back({middle, range.end, index, false});
+		}
+
+		nodes_[index].parent = range.parent;
+		if (range.parent == kNullNode) {
+			root = index;
+		} else if (range.isChild1) {
+			nodes_[range.parent].child1 = index;
+		} else {
+			nodes_[range.parent].child2 = index;
+		}
+	}
+	return root;
+}
+
+// 重心が最も広がっている軸でビンに分け、SAH のコストが最小になる位置で分割する。
+// 分割位置を返す（どちらの側も 1 つ以上になる）
+size_t DynamicAABBTree::SplitLeaves(std::vector<BuildLeaf>& leaves, size_t begin, size_t end) {
+	// 重心の範囲
+	float centroidMin[3] = {INFINITY, INFINITY, INFINITY};
+	float centroidMax[3] = {-INFINITY, -INFINITY, -INFINITY};
+	for (size_t i = begin; i < end; ++i) {
+		for (int axis = 0; axis < 3; ++axis) {
+			const float c = leaves[i].centroid[axis];
+			centroidMin[axis] = (std::min)(centroidMin[axis], c);
+			centroidMax[axis] = (std::max)(centroidMax[axis], c);
+		}
+	}
+	int axis = 0;
+	for (int a = 1; a < 3; ++a) {
+		if (centroidMax[a] - centroidMin[a] > centroidMax[axis] - centroidMin[axis]) {
+			axis = a;
+		}
+	}
+	const size_t middle = begin + (end - begin) / 2;
+	const float extent = centroidMax[axis] - centroidMin[axis];
+
+	// 全ての重心が重なっている場合は半分に分ける
+	if (extent <= 0.0f) {
+		return middle;
+	}
+
+	struct Bin {
+		Bounds bounds = {{INFINITY, INFINITY, INFINITY}, {-INFINITY, -INFINITY, -INFINITY}};
+		size_t count = 0;
+	};
+	Bin bins[kSahBinCount];
+	const float scale = kSahBinCount / extent;
+	auto binIndex = [&](const BuildLeaf& leaf) { return (std::min)(static_cast<int>((leaf.centroid[axis] - centroidMin[axis]) * scale), kSahBinCount - 1); };
+	for (size_t i = begin; i < end; ++i) {
+		Bin& bin = bins[binIndex(leaves[i])];
+		bin.bounds = Union(bin.bounds, leaves[i].bounds);
+		++bin.count;
+	}
+
+	// 右側の累積を先に求め、左から走査して各分割位置のコストを比べる
+	const Bounds empty = Bin{}.bounds;
+	float rightArea[kSahBinCount] = {};
+	size_t rightCount[kSahBinCount] = {};
+	Bounds accumulated = empty;
+	size_t count = 0;
+	for (int i = kSahBinCount - 1; i > 0; --i) {
+		accumulated = Union(accumulated, bins[i].bounds);
+		count += bins[i].count;
+		rightArea[i] = count > 0 ? HalfArea(accumulated) : 0.0f;
+		rightCount[i] = count;
+	}
+
+	float bestCost = INFINITY;
+	int bestSplit = -1;
+	accumulated = empty;
+	count = 0;
+	for (int i = 1; i < kSahBinCount; ++i) {
+		accumulated = Union(accumulated, bins[i - 1].bounds);
+		count += bins[i - 1].count;
+		if (count == 0 || rightCount[i] == 0) {
+			continue;
+		}
+		const float cost = HalfArea(accumulated) * count + rightArea[i] * rightCount[i];
+		if (cost < bestCost) {
+			bestCost = cost;
+			bestSplit = i;
+		}
+	}
+	if (bestSplit < 0) {
+		return middle;
+	}
+
+	const auto split = std::partition(leaves.begin() + begin, leaves.begin() + end, [&](const BuildLeaf& leaf) { return binIndex(leaf) < bestSplit; });
+	return static_cast<size_t>(split - leaves.begin());
+}
+
+//==================================
+// 問い合わせ
+//==================================
+
+float DynamicAABBTree::RayEnter(const Bounds& b, const Vector3& origin, const Vector3& diff, const Vector3& invDiff, float maxT) {
+	const float o[3] = {origin.x, origin.y, origin.z};
+	const float d[3] = {diff.x, diff.y, diff.z};
+	const float inv[3] = {invDiff.x, invDiff.y, invDiff.z};
+	const float lo[3] = {b.min.x, b.min.y, b.min.z};
+	const float hi[3] = {b.max.x, b.max.y, b.max.z};
+	float tMin = 0.0f;
+	float tMax = maxT;
+	for (int axis = 0; axis < 3; ++axis) {
+		if (d[axis] == 0.0f) {
+			if (o[axis] < lo[axis] || o[axis] > hi[axis]) {
+				return INFINITY;
+			}
+			continue;
+		}
+		float tNear = (lo[axis] - o[axis]) * inv[axis];
+		float tFar = (hi[axis] - o[axis]) * inv[axis];
+		if (tNear > tFar) {
+			std::swap(tNear, tFar);
+		}
+		tMin = (std::max)(tMin, tNear);
+		tMax = (std::min)(tMax, tFar);
+		if (tMin > tMax) {
+			return INFINITY;
+		}
+	}
+	return tMin;
+}
+
+void DynamicAABBTree::QueryAABB(const AABB& aabb, std::vector<int32_t>& out) const {
+	QueryAABB(aabb, [&](int32_t proxy) {
+		out.push_back(proxy);
+		return true;
+	});
+}
+
+void DynamicAABBTree::QuerySphere(const Sphere& sphere, std::vector<int32_t>& out) const {
+	QuerySphere(sphere, [&](int32_t proxy) {
+		out.push_back(proxy);
+		return true;
+	});
+}
+
+float DynamicAABBTree::GetAreaRatio() const {
+	if (root_ == kNullNode) {
+		return 0.0f;
+	}
+	const float rootArea = HalfArea(nodes_[root_].bounds);
+	if (rootArea <= 0.0f) {
+		return 0.0f;
+	}
+	float totalArea = 0.0f;
+	for (const Node& node : nodes_) {
+		if (node.height > 0) {
+			totalArea += HalfArea(node.bounds);
+		}
+	}
+	return totalArea / rootArea;
+}
@@ -0,0 +1,302 @@
+#pragma once
+#include "struct.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace KamataEngine;
+
+//==================================
+// 動的 AABB 木（BVH）
+//==================================
+// シーン内の物体の AABB を二分木にまとめ、重なり判定やレイキャストを O(log N) 程度にする。
+// 葉は物体 1 つ（プロキシ）に対応し、Insert で返す番号は Remove するまで変わらない。
+// ノードは 1 本の配列に確保し、空きは番号のリストで再利用する。
+//
+// 葉には実際の AABB を fatMargin だけ広げた「太い AABB」を入れる。
+// Move で渡した AABB が太い AABB に収まっている間は木を組み替えないので、
+// 少しずつ動く物体では挿入・削除がほとんど起きない。
+// 挿入は表面積が最小になる位置を探し、祖先を回転して高さの偏りを直す。
+// 長く使って木の質が落ちたら Rebuild() で SAH（表面積ヒューリスティック）により作り直す。
+//
+// UpdateMode::Refit ではアニメーションする物体向けに木の形を変えず、
+// Move は葉の AABB だけを書き換える。全員を動かした後に Refit() で親の AABB を作り直すこと。
+//
+// 問い合わせは太い AABB との重なりで候補を返すので、厳密な判定は呼び出し側で行う。
+
+class DynamicAABBTree {
+
+public:
+	static constexpr int32_t kNullNode = -1;
+
+	enum class UpdateMode {
+		Reinsert, // 太い AABB からはみ出したら葉を挿入し直す
+		Refit,    // 木の形は変えず、Refit() で親の AABB を作り直す
+	};
+
+	struct Settings {
+		float fatMargin = 0.1f;              // 太い AABB の余白
+		float displacementMultiplier = 4.0f; // 移動量の何倍ぶん進行方向へ広げるか
+		UpdateMode updateMode = UpdateMode::Reinsert;
+	};
+
+	DynamicAABBTree() = default;
+	explicit DynamicAABBTree(const Settings& settings);
+
+	void SetSettings(const Settings& settings) { settings_ = settings; }
+	const Settings& GetSettings() const { return settings_; }
+
+	// 葉を追加してプロキシ番号を返す。userData は問い合わせで物体を見分けるのに使う
+	int32_t Insert(const AABB& aabb, uint32_t userData);
+	void Remove(int32_t proxy);
+
+	// aabb は移動後の実際の AABB、displacement は今回の移動量（太い AABB を進行方向へ広げる）。
+	// 木を組み替えたら true を返す。Refit モードでは常に false
+	bool Move(int32_t proxy, const AABB& aabb, const Vector3& displacement = {0.0f, 0.0f, 0.0f});
+
+	// 全ての内部ノードの AABB と高さを子から作り直す（Refit モードで Move した後に呼ぶ）
+	void Refit();
+
+	// 全ての葉から SAH で木を作り直す。プロキシ番号は変わらない
+	void Rebuild();
+
+	void Clear();
+
+	uint32_t GetUserData(int32_t proxy) const { return nodes_[proxy].userData; }
+	AABB GetFatAABB(int32_t proxy) const;
+
+	size_t ProxyCount() const { return proxyCount_; }
+	int32_t GetHeight() const { return root_ == kNullNode ? 0 : nodes_[root_].height; }
+
+	// 内部ノードの表面積の合計と根の表面積の比（小さいほど質がよい。Rebuild の目安）
+	float GetAreaRatio() const;
+
+	//==================================
+	// 問い合わせ
+	//==================================
+	// callback(proxy) が false を返すと探索を打ち切る
+
+	template <typename Callback> void QueryAABB(const AABB& aabb, Callback&& callback) const;
+	template <typename Callback> void QuerySphere(const Sphere& sphere, Callback&& callback) const;
+
+	// ray の t が [0, maxT] の範囲で太い AABB を通る葉を、近いノードから順に callback(proxy, maxT) へ渡す。
+	// maxT が縮んだ後は、太い AABB へ入る t がそれより先の葉は渡さない。
+	// callback は以降の探索に使う maxT（当たった位置で縮めるなど）を返し、負の値で打ち切る
+	template <typename Callback> void RayCast(const Ray& ray, Callback&& callback, float maxT = INFINITY) const;
+
+	// 重なった葉のプロキシ番号を out に追加する
+	void QueryAABB(const AABB& aabb, std::vector<int32_t>& out) const;
+	void QuerySphere(const Sphere& sphere, std::vector<int32_t>& out) const;
+
+private:
+	struct Bounds {
+		Vector3 min;
+		Vector3 max;
+	};
+
+	struct Node {
+		Bounds bounds;
+		int32_t parent; // 空きノードでは次の空きノード
+		int32_t child1;
+		int32_t child2;
+		int32_t height; // 葉は 0、空きノードは -1
+		uint32_t userData;
+
+		bool IsLeaf() const { return child1 == kNullNode; }
+	};
+
+	// 探索用のスタック。浅い木では配列だけで済ませる
+	template <typename Entry = int32_t> class NodeStack {
+	public:
+		void Push(const Entry& entry) {
+			if (size_ < kLocalSize) {
+				local_[size_] = entry;
+			} else {
+				overflow_.push_back(entry);
+			}
+			++size_;
+		}
+		Entry Pop() {
+			--size_;
+			if (size_ < kLocalSize) {
+				return local_[size_];
+			}
+			const Entry entry = overflow_.back();
+			overflow_.pop_back();
+			return entry;
+		}
+		bool Empty() const { return size_ == 0; }
+
+	private:
+		static constexpr size_t kLocalSize = 64;
+		Entry local_[kLocalSize];
+		std::vector<Entry> overflow_;
+		size_t size_ = 0;
+	};
+
+	// RayCast で積むノードと、積んだときに求めた太い AABB へ入る t
+	struct RayEntry {
+		int32_t node;
+		float enter;
+	};
+
+	int32_t AllocateNode();
+	void FreeNode(int32_t node);
+	void InsertLeaf(int32_t leaf);
+	void RemoveLeaf(int32_t leaf);
+	int32_t Balance(int32_t node);
+	void ReplaceChild(int32_t parent, int32_t oldChild, int32_t newChild);
+	void UpdateFromChildren(int32_t node);
+	Bounds MakeFatBounds(const AABB& aabb, const Vector3& displacement) const;
+
+	// Rebuild の作業用。分割中に何度も読むので葉の AABB と重心を並べて持つ
+	struct BuildLeaf {
+		Bounds bounds;
+		float centroid[3]; // min + max（2 倍した重心）
+		int32_t leaf;
+	};
+
+	int32_t BuildSubtree(std::vector<BuildLeaf>& leaves);
+	static size_t SplitLeaves(std::vector<BuildLeaf>& leaves, size_t begin, size_t end);
+
+	static Bounds Union(const Bounds& a, const Bounds& b) {
+		return {
+		    {(std::min)(a.min.x, b.min.x), (std::min)(a.min.y, b.min.y), (std::min)(a.min.z, b.min.z)},
+		    {(std::max)(a.max.x, b.max.x), (std::max)(a.max.y, b.max.y), (std::max)(a.max.z, b.max.z)},
+		};
+	}
+
+	// 表面積の半分（比較にしか使わないので 2 倍しない）
+	static float HalfArea(const Bounds& b) {
+		const float x = b.max.x - b.min.x;
+		const float y = b.max.y - b.min.y;
+		const float z = b.max.z - b.min.z;
+		return x * y + y * z + z * x;
+	}
+
+	static bool Contains(const Bounds& outer, const Bounds& inner) {
+		return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z && //
+		       inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+	}
+
+	static bool Overlaps(const Bounds& a, const Bounds& b) {
+		return a.min.x <= b.max.x && a.max.x >= b.min.x && //
+		       a.min.y <= b.max.y && a.max.y >= b.min.y && //
+		       a.min.z <= b.max.z && a.max.z >= b.min.z;
+	}
+
+	static bool Overlaps(const Bounds& b, const Sphere& sphere) {
+		const float dx = (std::max)((std::max)(b.min.x - sphere.center.x, sphere.center.x - b.max.x), 0.0f);
+		const float dy = (std::max)((std::max)(b.min.y - sphere.center.y, sphere.center.y - b.max.y), 0.0f);
+		const float dz = (std::max)((std::max)(b.min.z - sphere.center.z, sphere.center.z - b.max.z), 0.0f);
+		return dx * dx + dy * dy + dz * dz <= sphere.radius * sphere.radius;
+	}
+
+	// レイと箱の入る位置（外れたら INFINITY）。invDiff は軸に平行な成分で 0 を入れておく
+	static float RayEnter(const Bounds& b, const Vector3& origin, const Vector3& diff, const Vector3& invDiff, float maxT);
+
+	Settings settings_;
+	std::vector<Node> nodes_;
+	int32_t root_ = kNullNode;
+	int32_t freeList_ = kNullNode;
+	size_t proxyCount_ = 0;
+};
+
+//==================================
+// 問い合わせ（テンプレート）
+//==================================
+
+template <typename Callback> void DynamicAABBTree::QueryAABB(const AABB& aabb, Callback&& callback) const {
+	if (root_ == kNullNode) {
+		return;
+	}
+	const Bounds query = {aabb.min, aabb.max};
+	NodeStack<> stack;
+	stack.Push(root_);
+	while (!stack.Empty()) {
+		const Node& node = nodes_[stack.Pop()];
+		if (!Overlaps(node.bounds, query)) {
+			continue;
+		}
+		if (node.IsLeaf()) {
+			if (!callback(static_cast<int32_t>(&node - nodes_.data()))) {
+				return;
+			}
+		} else {
+			stack.Push(node.child1);
+			stack.Push(node.child2);
+		}
+	}
+}
+
+template <typename Callback> void DynamicAABBTree::QuerySphere(const Sphere& sphere, Callback&& callback) const {
+	if (root_ == kNullNode) {
+		return;
+	}
+	NodeStack<> stack;
+	stack.Push(root_);
+	while (!stack.Empty()) {
+		const Node& node = nodes_[stack.Pop()];
+		if (!Overlaps(node.bounds, sphere)) {
+			continue;
+		}
+		if (node.IsLeaf()) {
+			if (!callback(static_cast<int32_t>(&node - nodes_.data()))) {
+				return;
+			}
+		} else {
+			stack.Push(node.child1);
+			stack.Push(node.child2);
+		}
+	}
+}
+
+template <typename Callback> void DynamicAABBTree::RayCast(const Ray& ray, Callback&& callback, float maxT) const {
+	if (root_ == kNullNode) {
+		return;
+	}
+	const Vector3 invDiff = {
+	    ray.diff.x == 0.0f ? 0.0f : 1.0f / ray.diff.x,
+	    ray.diff.y == 0.0f ? 0.0f : 1.0f / ray.diff.y,
+	    ray.diff.z == 0.0f ? 0.0f : 1.0f / ray.diff.z,
+	};
+	const float rootEnter = RayEnter(nodes_[root_].bounds, ray.origin, ray.diff, invDiff, maxT);
+	if (rootEnter == INFINITY) {
+		return;
+	}
+	NodeStack<RayEntry> stack;
+	stack.Push({root_, rootEnter});
+	while (!stack.Empty()) {
+		const RayEntry entry = stack.Pop();
+		// 積んだ後に callback が maxT を縮めていれば、もう届かないノードは捨てる
+		if (entry.enter > maxT) {
+			continue;
+		}
+		const Node& node = nodes_[entry.node];
+		if (node.IsLeaf()) {
+			maxT = callback(entry.node, maxT);
+			if (maxT < 0.0f) {
+				return;
+			}
+			continue;
+		}
+		// 縮んだ maxT で子を調べ直し、近い方を後に積んで先に取り出す
+		const float enter1 = RayEnter(nodes_[node.child1].bounds, ray.origin, ray.diff, invDiff, maxT);
+		const float enter2 = RayEnter(nodes_[node.child2].bounds, ray.origin, ray.diff, invDiff, maxT);
+		if (enter1 <= enter2) {
+			if (enter2 != INFINITY) {
+				stack.Push({node.child2, enter2});
+			}
+			if (enter1 != INFINITY) {
+				stack.Push({node.child1, enter1});
+			}
+		} else {
+			if (enter1 != INFINITY) {
+				stack.Push({node.child1, enter1});
+			}
+			stack.Push({node.child2, enter2});
+		}
+	}
+}
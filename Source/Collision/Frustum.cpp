@@ -0,0 +1,440 @@
+#include "Frustum.h"
+#include "CollisionKernels.h"
+#include "Job/ParallelFor.h"
+#include "Math/CpuFeatures.h"
+#include "Math/Math3D.h"
+#include "Math/SimdMath.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace {
+
+constexpr int kPlaneCount = Frustum::kPlaneCount;
+
+// 並列に判定するときの 1 塊の物体数（SIMD の幅の倍数）
+constexpr size_t kCullBlockSize = 4096;
+
+// カーネルに渡す平面の係数
+struct PlaneLanes {
+	const float* normalX;
+	const float* normalY;
+	const float* normalZ;
+	const float* absNormalX;
+	const float* absNormalY;
+	const float* absNormalZ;
+	const float* distance;
+};
+
+// 平面 a x + b y + c z + d >= 0 を、内向きの単位法線と Plane の distance に直す
+Plane MakePlane(float a, float b, float c, float d) {
+	const float length = std::sqrt(a * a + b * b + c * c);
+	const float inverse = length == 0.0f ? 0.0f : 1.0f / length;
+	Plane plane;
+	plane.normal = {a * inverse, b * inverse, c * inverse};
+	plane.distance = -d * inverse;
+	return plane;
+}
+
+//==================================
+// スカラー版
+//==================================
+// 平面ごとに中心までの符号付き距離 dist と、平面の法線方向への広がり r を求め、
+// dist < -r なら外、dist >= r なら内側とする（SIMD 版も同じ式）
+
+struct SphereScalar {
+	Vector3 center;
+	float radius;
+
+	static SphereScalar Load(const SphereSoA& s, size_t i) { return {{s.center.x[i], s.center.y[i], s.center.z[i]}, s.radius[i]}; }
+	float Radius(const PlaneLanes&, int) const { return radius; }
+};
+
+struct AABBScalar {
+	Vector3 center;
+	Vector3 extent;
+
+	static AABBScalar Make(const Vector3& min, const Vector3& max) {
+		return {{(min.x + max.x) * 0.5f, (min.y + max.y) * 0.5f, (min.z + max.z) * 0.5f}, {(max.x - min.x) * 0.5f, (max.y - min.y) * 0.5f, (max.z - min.z) * 0.5f}};
+	}
+	static AABBScalar Load(const AABBSoA& a, size_t i) { return Make({a.min.x[i], a.min.y[i], a.min.z[i]}, {a.max.x[i], a.max.y[i], a.max.z[i]}); }
+	float Radius(const PlaneLanes& planes, int p) const { return (planes.absNormalX[p] * extent.x + planes.absNormalY[p] * extent.y) + planes.absNormalZ[p] * extent.z; }
+};
+
+template <typename Shape> float Distance(const PlaneLanes& planes, int p, const Shape& shape) {
+	return ((planes.normalX[p] * shape.center.x + planes.normalY[p] * shape.center.y) + planes.normalZ[p] * shape.center.z) - planes.distance[p];
+}
+
+template <typename Shape> bool IsOutside(const PlaneLanes& planes, int p, const Shape& shape) { return Distance(planes, p, shape) < -shape.Radius(planes, p); }
+
+template <typename Shape> FrustumResult ClassifyScalar(const PlaneLanes& planes, const Shape& shape) {
+	FrustumResult result = FrustumResult::Inside;
+	for (int p = 0; p < kPlaneCount; ++p) {
+		const float dist = Distance(planes, p, shape);
+		const float radius = shape.Radius(planes, p);
+		if (dist < -radius) {
+			return FrustumResult::Outside;
+		}
+		if (dist < radius) {
+			result = FrustumResult::Intersect;
+		}
+	}
+	return result;
+}
+
+// 覚えておいた平面を先に調べ、外なら次の物体へ。そうでなければ 6 枚を順に調べ、
+// 最初に外と判定した平面を覚える
+template <typename Shape, typename SoA> void CullScalar(const PlaneLanes& planes, const SoA& soa, size_t begin, size_t end, uint8_t* cache, std::vector<uint32_t>& visible) {
+	for (size_t i = begin; i < end; ++i) {
+		const Shape shape = Shape::Load(soa, i);
+		if (cache && IsOutside(planes, cache[i], shape)) {
+			continue;
+		}
+		int outsidePlane = -1;
+		for (int p = 0; p < kPlaneCount; ++p) {
+			if (IsOutside(planes, p, shape)) {
+				outsidePlane = p;
+				break;
+			}
+		}
+		if (outsidePlane < 0) {
+			visible.push_back(static_cast<uint32_t>(i));
+		} else if (cache) {
+			cache[i] = static_cast<uint8_t>(outsidePlane);
+		}
+	}
+}
+
+#if defined(MT4_SSE2)
+
+//==================================
+// SSE2 版（4 個ずつ）
+//==================================
+
+using CollisionKernels::Dot4;
+
+// -x（符号ビットの反転。スカラー版の -r と同じ値）
+inline __m128 Negate4(__m128 x) { return _mm_xor_ps(x, _mm_set1_ps(-0.0f)); }
+
+struct SphereLanes4 {
+	__m128 cx, cy, cz, radius;
+
+	static SphereLanes4 Load(const SphereSoA& s, size_t i) {
+		return {_mm_loadu_ps(s.center.x + i), _mm_loadu_ps(s.center.y + i), _mm_loadu_ps(s.center.z + i), _mm_loadu_ps(s.radius + i)};
+	}
+	__m128 Radius(__m128, __m128, __m128) const { return radius; }
+};
+
+struct AABBLanes4 {
+	__m128 cx, cy, cz, ex, ey, ez;
+
+	static AABBLanes4 Load(const AABBSoA& a, size_t i) {
+		const __m128 half = _mm_set1_ps(0.5f);
+		const __m128 minX = _mm_loadu_ps(a.min.x + i);
+		const __m128 minY = _mm_loadu_ps(a.min.y + i);
+		const __m128 minZ = _mm_loadu_ps(a.min.z + i);
+		const __m128 maxX = _mm_loadu_ps(a.max.x + i);
+		const __m128 maxY = _mm_loadu_ps(a.max.y + i);
+		const __m128 maxZ = _mm_loadu_ps(a.max.z + i);
+		return {
+		    _mm_mul_ps(_mm_add_ps(minX, maxX), half), _mm_mul_ps(_mm_add_ps(minY, maxY), half), _mm_mul_ps(_mm_add_ps(minZ, maxZ), half),
+		    _mm_mul_ps(_mm_sub_ps(maxX, minX), half), _mm_mul_ps(_mm_sub_ps(maxY, minY), half), _mm_mul_ps(_mm_sub_ps(maxZ, minZ), half),
+		};
+	}
+	__m128 Radius(__m128 absX, __m128 absY, __m128 absZ) const { return Dot4(absX, absY, absZ, ex, ey, ez); }
+};
+
+template <typename Lanes> inline __m128 Outside4(__m128 nx, __m128 ny, __m128 nz, __m128 ax, __m128 ay, __m128 az, __m128 d, const Lanes& shape) {
+	const __m128 dist = _mm_sub_ps(Dot4(nx, ny, nz, shape.cx, shape.cy, shape.cz), d);
+	return _mm_cmplt_ps(dist, Negate4(shape.Radius(ax, ay, az)));
+}
+
+template <typename Lanes, typename SoA> size_t CullSSE2(const PlaneLanes& planes, const SoA& soa, size_t begin, size_t end, uint8_t* cache, std::vector<uint32_t>& visible) {
+	__m128 nx[kPlaneCount], ny[kPlaneCount], nz[kPlaneCount], ax[kPlaneCount], ay[kPlaneCount], az[kPlaneCount], d[kPlaneCount], planeIndex[kPlaneCount];
+	for (int p = 0; p < kPlaneCount; ++p) {
+		nx[p] = _mm_set1_ps(planes.normalX[p]);
+		ny[p] = _mm_set1_ps(planes.normalY[p]);
+		nz[p] = _mm_set1_ps(planes.normalZ[p]);
+		ax[p] = _mm_set1_ps(planes.absNormalX[p]);
+		ay[p] = _mm_set1_ps(planes.absNormalY[p]);
+		az[p] = _mm_set1_ps(planes.absNormalZ[p]);
+		d[p] = _mm_set1_ps(planes.distance[p]);
+		planeIndex[p] = _mm_castsi128_ps(_mm_set1_epi32(p));
+	}
+
+	size_t i = begin;
+	for (; i + 4 <= end; i += 4) {
+		const Lanes shape = Lanes::Load(soa, i);
+
+		__m128 cached = _mm_setzero_ps();
+		__m128 cachedOutside = _mm_setzero_ps();
+		if (cache) {
+			const uint8_t* c = cache + i;
+			cached = _mm_castsi128_ps(_mm_setr_epi32(c[0], c[1], c[2], c[3]));
+			cachedOutside = Outside4(_mm_setr_ps(planes.normalX[c[0]], planes.normalX[c[1]], planes.normalX[c[2]], planes.normalX[c[3]]),
+			                         _mm_setr_ps(planes.normalY[c[0]], planes.normalY[c[1]], planes.normalY[c[2]], planes.normalY[c[3]]),
+			                         _mm_setr_ps(planes.normalZ[c[0]], planes.normalZ[c[1]], planes.normalZ[c[2]], planes.normalZ[c[3]]),
+			                         _mm_setr_ps(planes.absNormalX[c[0]], planes.absNormalX[c[1]], planes.absNormalX[c[2]], planes.absNormalX[c[3]]),
+			                         _mm_setr_ps(planes.absNormalY[c[0]], planes.absNormalY[c[1]], planes.absNormalY[c[2]], planes.absNormalY[c[3]]),
+			                         _mm_setr_ps(planes.absNormalZ[c[0]], planes.absNormalZ[c[1]], planes.absNormalZ[c[2]], planes.absNormalZ[c[3]]),
+			                         _mm_setr_ps(planes.distance[c[0]], planes.distance[c[1]], planes.distance[c[2]], planes.distance[c[3]]), shape);
+			if (_mm_movemask_ps(cachedOutside) == 0xF) {
+				continue;
+			}
+		}
+
+		// 後ろの平面から選び直して、最初に外と判定した平面を残す
+		__m128 outside = _mm_setzero_ps();
+		__m128 firstPlane = cached;
+		for (int p = kPlaneCount - 1; p >= 0; --p) {
+			const __m128 o = Outside4(nx[p], ny[p], nz[p], ax[p], ay[p], az[p], d[p], shape);
+			outside = _mm_or_ps(outside, o);
+			firstPlane = SimdMath::Select(o, planeIndex[p], firstPlane);
+		}
+
+		if (cache) {
+			const __m128 update = _mm_andnot_ps(cachedOutside, outside);
+			if (_mm_movemask_ps(update) != 0) {
+				alignas(16) uint32_t lanes[4];
+				_mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_castps_si128(SimdMath::Select(update, firstPlane, cached)));
+				for (int k = 0; k < 4; ++k) {
+					cache[i + k] = static_cast<uint8_t>(lanes[k]);
+				}
+			}
+		}
+
+		unsigned bits = static_cast<unsigned>(~_mm_movemask_ps(outside)) & 0xFu;
+		while (bits != 0) {
+			visible.push_back(static_cast<uint32_t>(i + std::countr_zero(bits)));
+			bits &= bits - 1;
+		}
+	}
+	return i;
+}
+
+//==================================
+// AVX2 版（8 個ずつ）
+//==================================
+
+using CollisionKernels::Dot8;
+
+MT4_TARGET_AVX2 inline __m256 Negate8(__m256 x) { return _mm256_xor_ps(x, _mm256_set1_ps(-0.0f)); }
+
+struct SphereLanes8 {
+	__m256 cx, cy, cz, radius;
+
+	MT4_TARGET_AVX2 static SphereLanes8 Load(const SphereSoA& s, size_t i) {
+		return {_mm256_loadu_ps(s.center.x + i), _mm256_loadu_ps(s.center.y + i), _mm256_loadu_ps(s.center.z + i), _mm256_loadu_ps(s.radius + i)};
+	}
+	MT4_TARGET_AVX2 __m256 Radius(__m256, __m256, __m256) const { return radius; }
+};
+
+struct AABBLanes8 {
+	__m256 cx, cy, cz, ex, ey, ez;
+
+	MT4_TARGET_AVX2 static AABBLanes8 Load(const AABBSoA& a, size_t i) {
+		const __m256 half = _mm256_set1_ps(0.5f);
+		const __m256 minX = _mm256_loadu_ps(a.min.x + i);
+		const __m256 minY = _mm256_loadu_ps(a.min.y + i);
+		const __m256 minZ = _mm256_loadu_ps(a.min.z + i);
+		const __m256 maxX = _mm256_loadu_ps(a.max.x + i);
+		const __m256 maxY = _mm256_loadu_ps(a.max.y + i);
+		const __m256 maxZ = _mm256_loadu_ps(a.max.z + i);
+		return {
+		    _mm256_mul_ps(_mm256_add_ps(minX, maxX), half), _mm256_mul_ps(_mm256_add_ps(minY, maxY), half), _mm256_mul_ps(_mm256_add_ps(minZ, maxZ), half),
+		    _mm256_mul_ps(_mm256_sub_ps(maxX, minX), half), _mm256_mul_ps(_mm256_sub_ps(maxY, minY), half), _mm256_mul_ps(_mm256_sub_ps(maxZ, minZ), half),
+		};
+	}
+	MT4_TARGET_AVX2 __m256 Radius(__m256 absX, __m256 absY, __m256 absZ) const { return Dot8(absX, absY, absZ, ex, ey, ez); }
+};
+
+template <typename Lanes> MT4_TARGET_AVX2 inline __m256 Outside8(__m256 nx, __m256 ny, __m256 nz, __m256 ax, __m256 ay, __m256 az, __m256 d, const Lanes& shape) {
+	const __m256 dist = _mm256_sub_ps(Dot8(nx, ny, nz, shape.cx, shape.cy, shape.cz), d);
+	return _mm256_cmp_ps(dist, Negate8(shape.Radius(ax, ay, az)), _CMP_LT_OQ);
+}
+
+// 覚えておいた平面の係数は gather で集める
+template <typename Lanes, typename SoA> MT4_TARGET_AVX2 size_t CullAVX2(const PlaneLanes& planes, const SoA& soa, size_t begin, size_t end, uint8_t* cache, std::vector<uint32_t>& visible) {
+	__m256 nx[kPlaneCount], ny[kPlaneCount], nz[kPlaneCount], ax[kPlaneCount], ay[kPlaneCount], az[kPlaneCount], d[kPlaneCount], planeIndex[kPlaneCount];
+	for (int p = 0; p < kPlaneCount; ++p) {
+		nx[p] = _mm256_set1_ps(planes.normalX[p]);
+		ny[p] = _mm256_set1_ps(planes.normalY[p]);
+		nz[p] = _mm256_set1_ps(planes.normalZ[p]);
+		ax[p] = _mm256_set1_ps(planes.absNormalX[p]);
+		ay[p] = _mm256_set1_ps(planes.absNormalY[p]);
+		az[p] = _mm256_set1_ps(planes.absNormalZ[p]);
+		d[p] = _mm256_set1_ps(planes.distance[p]);
+		planeIndex[p] = _mm256_castsi256_ps(_mm256_set1_epi32(p));
+	}
+
+	size_t i = begin;
+	for (; i + 8 <= end; i += 8) {
+		const Lanes shape = Lanes::Load(soa, i);
+
+		__m256 cached = _mm256_setzero_ps();
+		__m256 cachedOutside = _mm256_setzero_ps();
+		if (cache) {
+			const __m256i index = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(cache + i)));
+			cached = _mm256_castsi256_ps(index);
+			cachedOutside = Outside8(_mm256_i32gather_ps(planes.normalX, index, 4), _mm256_i32gather_ps(planes.normalY, index, 4), _mm256_i32gather_ps(planes.normalZ, index, 4),
+			                         _mm256_i32gather_ps(planes.absNormalX, index, 4), _mm256_i32gather_ps(planes.absNormalY, index, 4), _mm256_i32gather_ps(planes.absNormalZ, index, 4),
+			                         _mm256_i32gather_ps(planes.distance, index, 4), shape);
+			if (_mm256_movemask_ps(cachedOutside) == 0xFF) {
+				continue;
+			}
+		}
+
+		__m256 outside = _mm256_setzero_ps();
+		__m256 firstPlane = cached;
+		for (int p = kPlaneCount - 1; p >= 0; --p) {
+			const __m256 o = Outside8(nx[p], ny[p], nz[p], ax[p], ay[p], az[p], d[p], shape);
+			outside = _mm256_or_ps(outside, o);
+			firstPlane = SimdMath::Select(o, planeIndex[p], firstPlane);
+		}
+
+		if (cache) {
+			const __m256 update = _mm256_andnot_ps(cachedOutside, outside);
+			if (_mm256_movemask_ps(update) != 0) {
+				alignas(32) uint32_t lanes[8];
+				_mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_castps_si256(SimdMath::Select(update, firstPlane, cached)));
+				for (int k = 0; k < 8; ++k) {
+					cache[i + k] = static_cast<uint8_t>(lanes[k]);
+				}
+			}
+		}
+
+		unsigned bits = static_cast<unsigned>(~_mm256_movemask_ps(outside)) & 0xFFu;
+		while (bits != 0) {
+			visible.push_back(static_cast<uint32_t>(i + std::countr_zero(bits)));
+			bits &= bits - 1;
+		}
+	}
+	return i;
+}
+
+#endif
+
+// [begin, end) を SIMD で判定し、残りをスカラーで判定する
+template <typename Shape, typename Lanes4, typename Lanes8, typename SoA>
+void CullRange(const PlaneLanes& planes, const SoA& soa, size_t begin, size_t end, uint8_t* cache, std::vector<uint32_t>& visible) {
+	size_t done = begin;
+	switch (GetSimdLevel()) {
+#if defined(MT4_SSE2)
+	case SimdLevel::AVX2:
+		done = CullAVX2<Lanes8>(planes, soa, begin, end, cache, visible);
+		break;
+	case SimdLevel::SSE2:
+		done = CullSSE2<Lanes4>(planes, soa, begin, end, cache, visible);
+		break;
+#endif
+	default:
+		break;
+	}
+	CullScalar<Shape>(planes, soa, done, end, cache, visible);
+}
+
+// multithreaded なら塊ごとに別の配列へ書き、最後に塊の順でつなげる
+template <typename Shape, typename Lanes4, typename Lanes8, typename SoA>
+size_t CullShapes(const PlaneLanes& planes, const SoA& soa, size_t count, std::vector<uint32_t>& visible, uint8_t* cache, bool multithreaded) {
+	visible.clear();
+	if (!multithreaded || count <= kCullBlockSize) {
+		CullRange<Shape, Lanes4, Lanes8>(planes, soa, 0, count, cache, visible);
+		return visible.size();
+	}
+
+	const size_t blockCount = (count + kCullBlockSize - 1) / kCullBlockSize;
+	std::vector<std::vector<uint32_t>> blockVisible(blockCount);
+	ParallelFor(blockCount, 1, [&](size_t begin, size_t end) {
+		for (size_t block = begin; block < end; ++block) {
+			const size_t first = block * kCullBlockSize;
+			CullRange<Shape, Lanes4, Lanes8>(planes, soa, first, (std::min)(first + kCullBlockSize, count), cache, blockVisible[block]);
+		}
+	});
+
+	size_t total = 0;
+	for (const std::vector<uint32_t>& indices : blockVisible) {
+		total += indices.size();
+	}
+	visible.reserve(total);
+	for (const std::vector<uint32_t>& indices : blockVisible) {
+		visible.insert(visible.end(), indices.begin(), indices.end());
+	}
+	return visible.size();
+}
+
+} // namespace
+
+//==================================
+// 平面の取り出し
+//==================================
+
+Frustum::Frustum() : Frustum(MakeIdentity4x4()) {}
+
+Frustum::Frustum(const Matrix4x4& viewProjection) { SetViewProjection(viewProjection); }
+
+// クリップ座標 (x, y, z, w) = (p, 1) * m の列を組み合わせる（Gribb / Hartmann の方法）。
+// -w <= x <= w、-w <= y <= w、0 <= z <= w の各不等式が 1 枚の平面になる
+void Frustum::SetViewProjection(const Matrix4x4& m) {
+	auto column = [&](int c, int row) { return m.m[row][c]; };
+	auto combine = [&](int c, float sign) {
+		return MakePlane(column(3, 0) + sign * column(c, 0), column(3, 1) + sign * column(c, 1), column(3, 2) + sign * column(c, 2), column(3, 3) + sign * column(c, 3));
+	};
+	planes_[kLeft] = combine(0, 1.0f);
+	planes_[kRight] = combine(0, -1.0f);
+	planes_[kBottom] = combine(1, 1.0f);
+	planes_[kTop] = combine(1, -1.0f);
+	planes_[kNear] = MakePlane(column(2, 0), column(2, 1), column(2, 2), column(2, 3));
+	planes_[kFar] = combine(2, -1.0f);
+	UpdateLanes();
+}
+
+void Frustum::SetPlanes(const Plane (&planes)[kPlaneCount]) {
+	for (int p = 0; p < kPlaneCount; ++p) {
+		planes_[p] = planes[p];
+	}
+	UpdateLanes();
+}
+
+void Frustum::UpdateLanes() {
+	for (int p = 0; p < kPlaneCount; ++p) {
+		normalX_[p] = planes_[p].normal.x;
+		normalY_[p] = planes_[p].normal.y;
+		normalZ_[p] = planes_[p].normal.z;
+		absNormalX_[p] = std::abs(planes_[p].normal.x);
+		absNormalY_[p] = std::abs(planes_[p].normal.y);
+		absNormalZ_[p] = std::abs(planes_[p].normal.z);
+		distance_[p] = planes_[p].distance;
+	}
+}
+
+//==================================
+// 判定
+//==================================
+
+FrustumResult Frustum::Classify(const Sphere& sphere) const {
+	const PlaneLanes planes = {normalX_, normalY_, normalZ_, absNormalX_, absNormalY_, absNormalZ_, distance_};
+	return ClassifyScalar(planes, SphereScalar{sphere.center, sphere.radius});
+}
+
+FrustumResult Frustum::Classify(const AABB& aabb) const {
+	const PlaneLanes planes = {normalX_, normalY_, normalZ_, absNormalX_, absNormalY_, absNormalZ_, distance_};
+	return ClassifyScalar(planes, AABBScalar::Make(aabb.min, aabb.max));
+}
+
+size_t Frustum::Cull(const SphereSoA& spheres, size_t count, std::vector<uint32_t>& visible, uint8_t* planeCache, bool multithreaded) const {
+	const PlaneLanes planes = {normalX_, normalY_, normalZ_, absNormalX_, absNormalY_, absNormalZ_, distance_};
+#if defined(MT4_SSE2)
+	return CullShapes<SphereScalar, SphereLanes4, SphereLanes8>(planes, spheres, count, visible, planeCache, multithreaded);
+#else
+	return CullShapes<SphereScalar, void, void>(planes, spheres, count, visible, planeCache, multithreaded);
+#endif
+}
+
+size_t Frustum::Cull(const AABBSoA& aabbs, size_t count, std::vector<uint32_t>& visible, uint8_t* planeCache, bool multithreaded) const {
+	const PlaneLanes planes = {normalX_, normalY_, normalZ_, absNormalX_, absNormalY_, absNormalZ_, distance_};
+#if defined(MT4_SSE2)
+	return CullShapes<AABBScalar, AABBLanes4, AABBLanes8>(planes, aabbs, count, visible, planeCache, multithreaded);
+#else
+	return CullShapes<AABBScalar, void, void>(planes, aabbs, count, visible, planeCache, multithreaded);
+#endif
+}
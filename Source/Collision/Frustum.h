@@ -0,0 +1,72 @@
+#pragma once
+#include "CollisionBatch.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//==================================
+// 視錐台カリング
+//==================================
+// ビュープロジェクション行列（view * projection、行ベクトル右掛け）から 6 枚の平面を取り出し、
+// 球や AABB が画面に映る可能性があるかを判定する。クリップ空間の z は Direct3D と同じ [0, 1]。
+// 平面の法線は内側を向き、Plane と同じく Dot(normal, p) == distance が平面上の点になる。
+//
+// Cull は SoA の図形をまとめて判定し、見えるものの番号を visible に詰めて返す。
+// SSE2 で 4 個、AVX2 で 8 個ずつ 6 枚の平面を判定し、結果は SIMD の段階によらず一致する。
+//
+// planeCache を渡すと、物体ごとに前回外と判定した平面の番号を覚えておき（平面の連続性）、
+// 次回はその平面を最初に調べる。カメラが少しずつ動くなら、外にある物体の大半は 1 枚目で落ちる。
+// 配列は物体数ぶん用意して 0 で初期化しておくこと。
+// 効果が大きいのはスカラー版で、AVX2 では 6 枚をまとめて調べる方が速いこともある。
+// multithreaded なら物体を塊に分けて並列に判定する。visible の順番は 1 スレッドと同じ。
+
+enum class FrustumResult {
+	Outside,   // 完全に外
+	Intersect, // 境界をまたぐ
+	Inside,    // 完全に内側
+};
+
+class Frustum {
+
+public:
+	enum PlaneIndex {
+		kLeft,
+		kRight,
+		kBottom,
+		kTop,
+		kNear,
+		kFar,
+		kPlaneCount,
+	};
+
+	// 単位行列から作る（クリップ空間の箱）
+	Frustum();
+	explicit Frustum(const Matrix4x4& viewProjection);
+
+	void SetViewProjection(const Matrix4x4& viewProjection);
+	void SetPlanes(const Plane (&planes)[kPlaneCount]);
+	const Plane& GetPlane(int index) const { return planes_[index]; }
+
+	FrustumResult Classify(const Sphere& sphere) const;
+	FrustumResult Classify(const AABB& aabb) const;
+	bool IsVisible(const Sphere& sphere) const { return Classify(sphere) != FrustumResult::Outside; }
+	bool IsVisible(const AABB& aabb) const { return Classify(aabb) != FrustumResult::Outside; }
+
+	// 見える物体の番号を visible に昇順で書き込み（上書き）、その数を返す
+	size_t Cull(const SphereSoA& spheres, size_t count, std::vector<uint32_t>& visible, uint8_t* planeCache = nullptr, bool multithreaded = false) const;
+	size_t Cull(const AABBSoA& aabbs, size_t count, std::vector<uint32_t>& visible, uint8_t* planeCache = nullptr, bool multithreaded = false) const;
+
+private:
+	void UpdateLanes();
+
+	Plane planes_[kPlaneCount];
+
+	// SIMD の判定用に並べ替えた平面の係数と、AABB の投影半径用の法線の絶対値
+	float normalX_[kPlaneCount];
+	float normalY_[kPlaneCount];
+	float normalZ_[kPlaneCount];
+	float absNormalX_[kPlaneCount];
+	float absNormalY_[kPlaneCount];
+	float absNormalZ_[kPlaneCount];
+	float distance_[kPlaneCount];
+};
@@ -0,0 +1,380 @@
+#include "RayCast.h"
+#include "CollisionKernels.h"
+#include "Math/CpuFeatures.h"
+#include "Math/Math3D.h"
+#include "Math/SimdMath.h"
+
+namespace {
+
+//==================================
+// スカラー版
+//==================================
+
+using CollisionKernels::IntersectTriangle;
+
+// 三角形 [begin, count) を順に調べる。距離が同じなら先に見つかった（番号の小さい）方を残す
+void RayTrianglesScalar(const Vector3& origin, const Vector3& diff, const TriangleSoA& tri, size_t begin, size_t count, RayHit& hit) {
+	for (size_t i = begin; i < count; ++i) {
+		float t, u, v;
+		if (IntersectTriangle(origin, diff, tri, i, t, u, v) && t >= 0.0f && t < hit.t) {
+			hit = {t, u, v, static_cast<uint32_t>(i)};
+		}
+	}
+}
+
+// レーンごとに覚えた最も近い当たりを hit にまとめる（同じ距離なら番号の小さい三角形）
+void MergeLanes(const float* t, const float* u, const float* v, const uint32_t* index, int laneCount, RayHit& hit) {
+	for (int k = 0; k < laneCount; ++k) {
+		if (index[k] == RayHit::kNoHit) {
+			continue;
+		}
+		if (t[k] < hit.t || (t[k] == hit.t && index[k] < hit.triangle)) {
+			hit = {t[k], u[k], v[k], index[k]};
+		}
+	}
+}
+
+#if defined(MT4_SSE2)
+
+//==================================
+// SSE2 版（4 個ずつ）
+//==================================
+
+using CollisionKernels::IntersectTriangle4;
+
+// 1 本のレイと 4 個ずつの三角形。レーンごとに最も近い当たりを覚え、最後に hit へまとめる
+size_t RayTrianglesSSE2(const Vector3& origin, const Vector3& diff, const TriangleSoA& tri, size_t count, RayHit& hit) {
+	const __m128 ox = _mm_set1_ps(origin.x);
+	const __m128 oy = _mm_set1_ps(origin.y);
+	const __m128 oz = _mm_set1_ps(origin.z);
+	const __m128 dx = _mm_set1_ps(diff.x);
+	const __m128 dy = _mm_set1_ps(diff.y);
+	const __m128 dz = _mm_set1_ps(diff.z);
+	const __m128 zero = _mm_setzero_ps();
+
+	__m128 bestT = _mm_set1_ps(hit.t);
+	__m128 bestU = zero;
+	__m128 bestV = zero;
+	__m128 bestIndex = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(RayHit::kNoHit)));
+	__m128i index = _mm_setr_epi32(0, 1, 2, 3);
+	const __m128i step = _mm_set1_epi32(4);
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 t, u, v;
+		__m128 mask = IntersectTriangle4(ox, oy, oz, dx, dy, dz, _mm_loadu_ps(tri.vertex0.x + i), _mm_loadu_ps(tri.vertex0.y + i), _mm_loadu_ps(tri.vertex0.z + i), _mm_loadu_ps(tri.edge1.x + i),
+		                         _mm_loadu_ps(tri.edge1.y + i), _mm_loadu_ps(tri.edge1.z + i), _mm_loadu_ps(tri.edge2.x + i), _mm_loadu_ps(tri.edge2.y + i), _mm_loadu_ps(tri.edge2.z + i), t, u, v);
+		mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(t, zero), _mm_cmplt_ps(t, bestT)));
+		bestT = SimdMath::Select(mask, t, bestT);
+		bestU = SimdMath::Select(mask, u, bestU);
+		bestV = SimdMath::Select(mask, v, bestV);
+		bestIndex = SimdMath::Select(mask, _mm_castsi128_ps(index), bestIndex);
+		index = _mm_add_epi32(index, step);
+	}
+
+	alignas(16) float laneT[4], laneU[4], laneV[4];
+	alignas(16) uint32_t laneIndex[4];
+	_mm_store_ps(laneT, bestT);
+	_mm_store_ps(laneU, bestU);
+	_mm_store_ps(laneV, bestV);
+	_mm_store_si128(reinterpret_cast<__m128i*>(laneIndex), _mm_castps_si128(bestIndex));
+	MergeLanes(laneT, laneU, laneV, laneIndex, 4, hit);
+	return i;
+}
+
+// 4 本ずつのレイと、1 つずつ全レーンに配った三角形
+size_t RaysTrianglesSSE2(const RaySoA& rays, size_t rayCount, const TriangleSoA& tri, size_t triangleCount, RayHit* hits) {
+	const __m128 zero = _mm_setzero_ps();
+	size_t r = 0;
+	for (; r + 4 <= rayCount; r += 4) {
+		const __m128 ox = _mm_loadu_ps(rays.origin.x + r);
+		const __m128 oy = _mm_loadu_ps(rays.origin.y + r);
+		const __m128 oz = _mm_loadu_ps(rays.origin.z + r);
+		const __m128 dx = _mm_loadu_ps(rays.diff.x + r);
+		const __m128 dy = _mm_loadu_ps(rays.diff.y + r);
+		const __m128 dz = _mm_loadu_ps(rays.diff.z + r);
+
+		RayHit* h = hits + r;
+		__m128 bestT = _mm_setr_ps(h[0].t, h[1].t, h[2].t, h[3].t);
+		__m128 bestU = _mm_setr_ps(h[0].u, h[1].u, h[2].u, h[3].u);
+		__m128 bestV = _mm_setr_ps(h[0].v, h[1].v, h[2].v, h[3].v);
+		__m128 bestIndex = _mm_castsi128_ps(_mm_setr_epi32(static_cast<int>(h[0].triangle), static_cast<int>(h[1].triangle), static_cast<int>(h[2].triangle), static_cast<int>(h[3].triangle)));
+
+		for (size_t i = 0; i < triangleCount; ++i) {
+			__m128 t, u, v;
+			__m128 mask = IntersectTriangle4(ox, oy, oz, dx, dy, dz, _mm_set1_ps(tri.vertex0.x[i]), _mm_set1_ps(tri.vertex0.y[i]), _mm_set1_ps(tri.vertex0.z[i]), _mm_set1_ps(tri.edge1.x[i]), _mm_set1_ps(tri.edge1.y[i]),
+			                         _mm_set1_ps(tri.edge1.z[i]), _mm_set1_ps(tri.edge2.x[i]), _mm_set1_ps(tri.edge2.y[i]), _mm_set1_ps(tri.edge2.z[i]), t, u, v);
+			mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(t, zero), _mm_cmplt_ps(t, bestT)));
+			bestT = SimdMath::Select(mask, t, bestT);
+			bestU = SimdMath::Select(mask, u, bestU);
+			bestV = SimdMath::Select(mask, v, bestV);
+			bestIndex = SimdMath::Select(mask, _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(i))), bestIndex);
+		}
+
+		alignas(16) float laneT[4], laneU[4], laneV[4];
+		alignas(16) uint32_t laneIndex[4];
+		_mm_store_ps(laneT, bestT);
+		_mm_store_ps(laneU, bestU);
+		_mm_store_ps(laneV, bestV);
+		_mm_store_si128(reinterpret_cast<__m128i*>(laneIndex), _mm_castps_si128(bestIndex));
+		for (int k = 0; k < 4; ++k) {
+			h[k] = {laneT[k], laneU[k], laneV[k], laneIndex[k]};
+		}
+	}
+	return r;
+}
+
+// 1 つでも当たれば true。done には判定し終えた数を返す
+bool SegmentTrianglesSSE2(const Segment& segment, const TriangleSoA& tri, size_t count, size_t& done) {
+	const __m128 ox = _mm_set1_ps(segment.origin.x);
+	const __m128 oy = _mm_set1_ps(segment.origin.y);
+	const __m128 oz = _mm_set1_ps(segment.origin.z);
+	const __m128 dx = _mm_set1_ps(segment.diff.x);
+	const __m128 dy = _mm_set1_ps(segment.diff.y);
+	const __m128 dz = _mm_set1_ps(segment.diff.z);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 one = _mm_set1_ps(1.0f);
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4) {
+		__m128 t, u, v;
+		__m128 mask = IntersectTriangle4(ox, oy, oz, dx, dy, dz, _mm_loadu_ps(tri.vertex0.x + i), _mm_loadu_ps(tri.vertex0.y + i), _mm_loadu_ps(tri.vertex0.z + i), _mm_loadu_ps(tri.edge1.x + i),
+		                         _mm_loadu_ps(tri.edge1.y + i), _mm_loadu_ps(tri.edge1.z + i), _mm_loadu_ps(tri.edge2.x + i), _mm_loadu_ps(tri.edge2.y + i), _mm_loadu_ps(tri.edge2.z + i), t, u, v);
+		mask = _mm_and_ps(mask, _mm_and_ps(_mm_cmpge_ps(t, zero), _mm_cmple_ps(t, one)));
+		if (_mm_movemask_ps(mask) != 0) {
+			done = i;
+			return true;
+		}
+	}
+	done = i;
+	return false;
+}
+
+//==================================
+// AVX2 版（8 個ずつ）
+//==================================
+
+using CollisionKernels::IntersectTriangle8;
+
+MT4_TARGET_AVX2 size_t RayTrianglesAVX2(const Vector3& origin, const Vector3& diff, const TriangleSoA& tri, size_t count, RayHit& hit) {
+	const __m256 ox = _mm256_set1_ps(origin.x);
+	const __m256 oy = _mm256_set1_ps(origin.y);
+	const __m256 oz = _mm256_set1_ps(origin.z);
+	const __m256 dx = _mm256_set1_ps(diff.x);
+	const __m256 dy = _mm256_set1_ps(diff.y);
+	const __m256 dz = _mm256_set1_ps(diff.z);
+	const __m256 zero = _mm256_setzero_ps();
+
+	__m256 bestT = _mm256_set1_ps(hit.t);
+	__m256 bestU = zero;
+	__m256 bestV = zero;
+	__m256 bestIndex = _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(RayHit::kNoHit)));
+	__m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	const __m256i step = _mm256_set1_epi32(8);
+
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256 t, u, v;
+		__m256 mask = IntersectTriangle8(ox, oy, oz, dx, dy, dz, _mm256_loadu_ps(tri.vertex0.x + i), _mm256_loadu_ps(tri.vertex0.y + i), _mm256_loadu_ps(tri.vertex0.z + i), _mm256_loadu_ps(tri.edge1.x + i),
+		                         _mm256_loadu_ps(tri.edge1.y + i), _mm256_loadu_ps(tri.edge1.z + i), _mm256_loadu_ps(tri.edge2.x + i), _mm256_loadu_ps(tri.edge2.y + i), _mm256_loadu_ps(tri.edge2.z + i), t, u,
+		                         v);
+		mask = _mm256_and_ps(mask, _mm256_and_ps(_mm256_cmp_ps(t, zero, _CMP_GE_OQ), _mm256_cmp_ps(t, bestT, _CMP_LT_OQ)));
+		bestT = SimdMath::Select(mask, t, bestT);
+		bestU = SimdMath::Select(mask, u, bestU);
+		bestV = SimdMath::Select(mask, v, bestV);
+		bestIndex = SimdMath::Select(mask, _mm256_castsi256_ps(index), bestIndex);
+		index = _mm256_add_epi32(index, step);
+	}
+
+	alignas(32) float laneT[8], laneU[8], laneV[8];
+	alignas(32) uint32_t laneIndex[8];
+	_mm256_store_ps(laneT, bestT);
+	_mm256_store_ps(laneU, bestU);
+	_mm256_store_ps(laneV, bestV);
+	_mm256_store_si256(reinterpret_cast<__m256i*>(laneIndex), _mm256_castps_si256(bestIndex));
+	MergeLanes(laneT, laneU, laneV, laneIndex, 8, hit);
+	return i;
+}
+
+MT4_TARGET_AVX2 size_t RaysTrianglesAVX2(const RaySoA& rays, size_t rayCount, const TriangleSoA& tri, size_t triangleCount, RayHit* hits) {
+	const __m256 zero = _mm256_setzero_ps();
+	size_t r = 0;
+	for (; r + 8 <= rayCount; r += 8) {
+		const __m256 ox = _mm256_loadu_ps(rays.origin.x + r);
+		const __m256 oy = _mm256_loadu_ps(rays.origin.y + r);
+		const __m256 oz = _mm256_loadu_ps(rays.origin.z + r);
+		const __m256 dx = _mm256_loadu_ps(rays.diff.x + r);
+		const __m256 dy = _mm256_loadu_ps(rays.diff.y + r);
+		const __m256 dz = _mm256_loadu_ps(rays.diff.z + r);
+
+		RayHit* h = hits + r;
+		alignas(32) float laneT[8], laneU[8], laneV[8];
+		alignas(32) uint32_t laneIndex[8];
+		for (int k = 0; k < 8; ++k) {
+			laneT[k] = h[k].t;
+			laneU[k] = h[k].u;
+			laneV[k] = h[k].v;
+			laneIndex[k] = h[k].triangle;
+		}
+		__m256 bestT = _mm256_load_ps(laneT);
+		__m256 bestU = _mm256_load_ps(laneU);
+		__m256 bestV = _mm256_load_ps(laneV);
+		__m256 bestIndex = _mm256_castsi256_ps(_mm256_load_si256(reinterpret_cast<const __m256i*>(laneIndex)));
+
+		for (size_t i = 0; i < triangleCount; ++i) {
+			__m256 t, u, v;
+			__m256 mask = IntersectTriangle8(ox, oy, oz, dx, dy, dz, _mm256_broadcast_ss(tri.vertex0.x + i), _mm256_broadcast_ss(tri.vertex0.y + i), _mm256_broadcast_ss(tri.vertex0.z + i),
+			                         _mm256_broadcast_ss(tri.edge1.x + i), _mm256_broadcast_ss(tri.edge1.y + i), _mm256_broadcast_ss(tri.edge1.z + i), _mm256_broadcast_ss(tri.edge2.x + i),
+			                         _mm256_broadcast_ss(tri.edge2.y + i), _mm256_broadcast_ss(tri.edge2.z + i), t, u, v);
+			mask = _mm256_and_ps(mask, _mm256_and_ps(_mm256_cmp_ps(t, zero, _CMP_GE_OQ), _mm256_cmp_ps(t, bestT, _CMP_LT_OQ)));
+			bestT = SimdMath::Select(mask, t, bestT);
+			bestU = SimdMath::Select(mask, u, bestU);
+			bestV = SimdMath::Select(mask, v, bestV);
+			bestIndex = SimdMath::Select(mask, _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(i))), bestIndex);
+		}
+
+		_mm256_store_ps(laneT, bestT);
+		_mm256_store_ps(laneU, bestU);
+		_mm256_store_ps(laneV, bestV);
+		_mm256_store_si256(reinterpret_cast<__m256i*>(laneIndex), _mm256_castps_si256(bestIndex));
+		for (int k = 0; k < 8; ++k) {
+			h[k] = {laneT[k], laneU[k], laneV[k], laneIndex[k]};
+		}
+	}
+	return r;
+}
+
+MT4_TARGET_AVX2 bool SegmentTrianglesAVX2(const Segment& segment, const TriangleSoA& tri, size_t count, size_t& done) {
+	const __m256 ox = _mm256_set1_ps(segment.origin.x);
+	const __m256 oy = _mm256_set1_ps(segment.origin.y);
+	const __m256 oz = _mm256_set1_ps(segment.origin.z);
+	const __m256 dx = _mm256_set1_ps(segment.diff.x);
+	const __m256 dy = _mm256_set1_ps(segment.diff.y);
+	const __m256 dz = _mm256_set1_ps(segment.diff.z);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 one = _mm256_set1_ps(1.0f);
+	size_t i = 0;
+	for (; i + 8 <= count; i += 8) {
+		__m256 t, u, v;
+		__m256 mask = IntersectTriangle8(ox, oy, oz, dx, dy, dz, _mm256_loadu_ps(tri.vertex0.x + i), _mm256_loadu_ps(tri.vertex0.y + i), _mm256_loadu_ps(tri.vertex0.z + i), _mm256_loadu_ps(tri.edge1.x + i),
+		                         _mm256_loadu_ps(tri.edge1.y + i), _mm256_loadu_ps(tri.edge1.z + i), _mm256_loadu_ps(tri.edge2.x + i), _mm256_loadu_ps(tri.edge2.y + i), _mm256_loadu_ps(tri.edge2.z + i), t, u,
+		                         v);
+		mask = _mm256_and_ps(mask, _mm256_and_ps(_mm256_cmp_ps(t, zero, _CMP_GE_OQ), _mm256_cmp_ps(t, one, _CMP_LE_OQ)));
+		if (_mm256_movemask_ps(mask) != 0) {
+			done = i;
+			return true;
+		}
+	}
+	done = i;
+	return false;
+}
+
+#endif
+
+} // namespace
+
+//==================================
+// RayBatch
+//==================================
+
+void RayBatch::Add(const Ray& ray) {
+	ox_.push_back(ray.origin.x);
+	oy_.push_back(ray.origin.y);
+	oz_.push_back(ray.origin.z);
+	dx_.push_back(ray.diff.x);
+	dy_.push_back(ray.diff.y);
+	dz_.push_back(ray.diff.z);
+}
+
+void RayBatch::Clear() {
+	for (std::vector<float>* v : {&ox_, &oy_, &oz_, &dx_, &dy_, &dz_}) {
+		v->clear();
+	}
+}
+
+//==================================
+// レイキャスト
+//==================================
+
+bool RayCast(const Ray& ray, const TriangleSoA& triangles, size_t count, RayHit& hit) {
+	const float initialT = hit.t;
+	size_t done = 0;
+	switch (GetSimdLevel()) {
+#if defined(MT4_SSE2)
+	case SimdLevel::AVX2:
+		done = RayTrianglesAVX2(ray.origin, ray.diff, triangles, count, hit);
+		break;
+	case SimdLevel::SSE2:
+		done = RayTrianglesSSE2(ray.origin, ray.diff, triangles, count, hit);
+		break;
+#endif
+	default:
+		break;
+	}
+	RayTrianglesScalar(ray.origin, ray.diff, triangles, done, count, hit);
+	return hit.t < initialT;
+}
+
+size_t RayCast(const RaySoA& rays, size_t rayCount, const TriangleSoA& triangles, size_t triangleCount, RayHit* hits) {
+	size_t done = 0;
+	switch (GetSimdLevel()) {
+#if defined(MT4_SSE2)
+	case SimdLevel::AVX2:
+		done = RaysTrianglesAVX2(rays, rayCount, triangles, triangleCount, hits);
+		break;
+	case SimdLevel::SSE2:
+		done = RaysTrianglesSSE2(rays, rayCount, triangles, triangleCount, hits);
+		break;
+#endif
+	default:
+		break;
+	}
+	// 4 / 8 本に満たない残りは 1 本ずつ
+	for (size_t r = done; r < rayCount; ++r) {
+		Ray ray;
+		ray.origin = {rays.origin.x[r], rays.origin.y[r], rays.origin.z[r]};
+		ray.diff = {rays.diff.x[r], rays.diff.y[r], rays.diff.z[r]};
+		RayCast(ray, triangles, triangleCount, hits[r]);
+	}
+
+	size_t hitCount = 0;
+	for (size_t r = 0; r < rayCount; ++r) {
+		hitCount += hits[r].IsHit() ? 1 : 0;
+	}
+	return hitCount;
+}
+
+bool IsOccluded(const Segment& segment, const TriangleSoA& triangles, size_t count) {
+	size_t done = 0;
+	switch (GetSimdLevel()) {
+#if defined(MT4_SSE2)
+	case SimdLevel::AVX2:
+		if (SegmentTrianglesAVX2(segment, triangles, count, done)) {
+			return true;
+		}
+		break;
+	case SimdLevel::SSE2:
+		if (SegmentTrianglesSSE2(segment, triangles, count, done)) {
+			return true;
+		}
+		break;
+#endif
+	default:
+		break;
+	}
+	for (size_t i = done; i < count; ++i) {
+		float t, u, v;
+		if (IntersectTriangle(segment.origin, segment.diff, triangles, i, t, u, v) && t >= 0.0f && t <= 1.0f) {
+			return true;
+		}
+	}
+	return false;
+}
+
+Ray MakePickingRay(float screenX, float screenY, const Matrix4x4& inverseViewProjectionViewport) {
+	const Vector3 nearPoint = Vector3Transform({screenX, screenY, 0.0f}, inverseViewProjectionViewport);
+	const Vector3 farPoint = Vector3Transform({screenX, screenY, 1.0f}, inverseViewProjectionViewport);
+	Ray ray;
+	ray.origin = nearPoint;
+	ray.diff = Subtract(farPoint, nearPoint);
+	return ray;
+}
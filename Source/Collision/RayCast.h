@@ -0,0 +1,64 @@
+#pragma once
+#include "CollisionBatch.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//==================================
+// 三角形メッシュへのレイキャスト
+//==================================
+// マウスでのピッキングや視線の遮りの判定用。三角形は TriangleBatch で
+// 頂点 0 と 2 辺の SoA に前もって変換しておき、Möller–Trumbore で判定する。
+//
+// 1 本のレイ対 多数の三角形は SSE2 で 4 個、AVX2 で 8 個ずつ判定し、
+// レーンごとに最も近い当たりを覚えておいて最後にまとめる。
+// 複数のレイ（RaySoA）対 三角形はレイを 4 / 8 本ずつ並べ、三角形を 1 つずつ全レーンに配って判定する。
+// どちらも演算の順序はスカラー版と同じで、同じ距離の当たりは番号の小さい三角形を選ぶので、
+// SIMD の段階によらず結果が一致する。
+//
+// 当たりの範囲は 0 <= t < hit.t（hit.t の初期値は INFINITY）。
+// 遠すぎる当たりを除くときは hit.t に上限を入れてから呼ぶ。
+
+struct RayHit {
+	static constexpr uint32_t kNoHit = UINT32_MAX;
+
+	float t = INFINITY; // origin + diff * t が当たった位置
+	float u = 0.0f;     // 重心座標（vertices[1] の重み）
+	float v = 0.0f;     // 重心座標（vertices[2] の重み）
+	uint32_t triangle = kNoHit;
+
+	bool IsHit() const { return triangle != kNoHit; }
+};
+
+// 複数のレイの SoA
+struct RaySoA {
+	ConstVector3SoA origin;
+	ConstVector3SoA diff;
+};
+
+class RayBatch {
+public:
+	void Add(const Ray& ray);
+	void Clear();
+	size_t Size() const { return ox_.size(); }
+	RaySoA View() const { return {{ox_.data(), oy_.data(), oz_.data()}, {dx_.data(), dy_.data(), dz_.data()}}; }
+
+private:
+	std::vector<float> ox_, oy_, oz_, dx_, dy_, dz_;
+};
+
+// 最も近い当たりで hit を書き換え、hit.t より手前に当たりがあれば true を返す
+bool RayCast(const Ray& ray, const TriangleSoA& triangles, size_t count, RayHit& hit);
+
+// rays[i] ごとに最も近い当たりで hits[i] を書き換え、当たっているレイの数を返す
+size_t RayCast(const RaySoA& rays, size_t rayCount, const TriangleSoA& triangles, size_t triangleCount, RayHit* hits);
+
+// 線分が三角形のどれかに当たるか（視線の判定用）。最初に見つかった時点で打ち切る。
+// 当たりの範囲は IsCollision(Segment, Triangle) と同じ 0 <= t <= 1
+bool IsOccluded(const Segment& segment, const TriangleSoA& triangles, size_t count);
+
+// スクリーン座標 (x, y) を通り、ニアクリップ面からファークリップ面へ向かうレイを作る。
+// inverseViewProjectionViewport は Inverse(view * projection * viewport)。
+// diff の長さがニアからファーまでの距離になるので、t = 1 がファークリップ面になる
+Ray MakePickingRay(float screenX, float screenY, const Matrix4x4& inverseViewProjectionViewport);
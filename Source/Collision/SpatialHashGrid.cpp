@@ -0,0 +1,178 @@
+#include "SpatialHashGrid.h"
+#include "Job/ParallelFor.h"
+#include "Profiler/Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 全組判定で 1 つのスレッドがまとめて調べる要素数
+constexpr size_t kPairBlockSize = 1024;
+
+// セル座標をこの範囲に収める（極端に遠い座標で int32_t があふれないように）
+constexpr float kMaxCellCoordinate = 1073741824.0f; // 2^30
+
+// count 以上の 2 の累乗
+uint32_t NextPowerOfTwo(size_t count) {
+	uint32_t size = 1;
+	while (size < count) {
+		size <<= 1;
+	}
+	return size;
+}
+
+} // namespace
+
+SpatialHashGrid::SpatialHashGrid(const Settings& settings) : settings_(settings) {}
+
+//==================================
+// 構築
+//==================================
+
+void SpatialHashGrid::Build(const SphereSoA& spheres, size_t count) {
+	inputX_.assign(spheres.center.x, spheres.center.x + count);
+	inputY_.assign(spheres.center.y, spheres.center.y + count);
+	inputZ_.assign(spheres.center.z, spheres.center.z + count);
+	inputRadius_.assign(spheres.radius, spheres.radius + count);
+
+	maxRadius_ = 0.0f;
+	for (size_t i = 0; i < count; ++i) {
+		maxRadius_ = (std::max)(maxRadius_, inputRadius_[i]);
+	}
+	BuildSorted(count);
+}
+
+void SpatialHashGrid::Build(const ConstVector3SoA& centers, float radius, size_t count) {
+	inputX_.assign(centers.x, centers.x + count);
+	inputY_.assign(centers.y, centers.y + count);
+	inputZ_.assign(centers.z, centers.z + count);
+	inputRadius_.assign(count, radius);
+
+	maxRadius_ = count == 0 ? 0.0f : radius;
+	BuildSorted(count);
+}
+
+// バケットごとの個数を数え、累積和で各バケットの先頭を決めてから並べる（計数ソート）
+void SpatialHashGrid::BuildSorted(size_t count) {
+	MT4_PROFILE_SCOPE("SpatialHashGrid::Build");
+	cellSize_ = settings_.cellSize > 0.0f ? settings_.cellSize : 2.0f * maxRadius_;
+	if (!(cellSize_ > 0.0f)) {
+		cellSize_ = 1.0f;
+	}
+	inverseCellSize_ = 1.0f / cellSize_;
+
+	// 要素数の 2 倍程度のバケットを用意して衝突を減らす
+	const uint32_t bucketCount = NextPowerOfTwo(count * 2);
+	bucketMask_ = bucketCount - 1;
+
+	bucketStart_.assign(static_cast<size_t>(bucketCount) + 1, 0);
+	inputBucket_.resize(count);
+	for (size_t i = 0; i < count; ++i) {
+		const uint32_t bucket = Bucket(CellCoordinate(inputX_[i]), CellCoordinate(inputY_[i]), CellCoordinate(inputZ_[i]));
+		inputBucket_[i] = bucket;
+		++bucketStart_[bucket + 1];
+	}
+	for (uint32_t bucket = 0; bucket < bucketCount; ++bucket) {
+		bucketStart_[bucket + 1] += bucketStart_[bucket];
+	}
+
+	sortedIndex_.resize(count);
+	sortedX_.resize(count);
+	sortedY_.resize(count);
+	sortedZ_.resize(count);
+	sortedRadius_.resize(count);
+
+	// 各バケットの書き込み位置として、先頭からずらしながら使う（終わると次のバケットの先頭になる）
+	std::vector<uint32_t>& cursor = bucketStart_;
+	for (size_t i = 0; i < count; ++i) {
+		const uint32_t position = cursor[inputBucket_[i]]++;
+		sortedIndex_[position] = static_cast<uint32_t>(i);
+		sortedX_[position] = inputX_[i];
+		sortedY_[position] = inputY_[i];
+		sortedZ_[position] = inputZ_[i];
+		sortedRadius_[position] = inputRadius_[i];
+	}
+	// ずらした分を 1 つ戻して先頭に直す
+	for (uint32_t bucket = bucketCount; bucket > 0; --bucket) {
+		bucketStart_[bucket] = bucketStart_[bucket - 1];
+	}
+	bucketStart_[0] = 0;
+}
+
+int32_t SpatialHashGrid::CellCoordinate(float value) const {
+	const float cell = std::floor(value * inverseCellSize_);
+	return static_cast<int32_t>((std::min)((std::max)(cell, -kMaxCellCoordinate), kMaxCellCoordinate));
+}
+
+uint32_t SpatialHashGrid::Bucket(int32_t x, int32_t y, int32_t z) const {
+	const uint32_t hash = (static_cast<uint32_t>(x) * 73856093u) ^ (static_cast<uint32_t>(y) * 19349663u) ^ (static_cast<uint32_t>(z) * 83492791u);
+	return hash & bucketMask_;
+}
+
+//==================================
+// 問い合わせ
+//==================================
+
+void SpatialHashGrid::QueryRadius(const Vector3& center, float radius, std::vector<uint32_t>& out) const {
+	QueryRadius(center, radius, [&](uint32_t index) {
+		out.push_back(index);
+		return true;
+	});
+}
+
+// 並べ替え後の位置 [begin, end) の要素について、自分より後ろに並んだ相手との組を求める。
+// 相手が自分より前にある組は相手の側で見つかるので、各組は 1 回だけ出力される
+void SpatialHashGrid::FindPairsInRange(size_t begin, size_t end, std::vector<Pair>& out) const {
+	for (size_t i = begin; i < end; ++i) {
+		const float x = sortedX_[i];
+		const float y = sortedY_[i];
+		const float z = sortedZ_[i];
+		const float radius = sortedRadius_[i];
+		const float range = radius + maxRadius_;
+		const Vector3 min = {x - range, y - range, z - range};
+		const Vector3 max = {x + range, y + range, z + range};
+		ForEachBucket(min, max, [&](uint32_t bucketBegin, uint32_t bucketEnd) {
+			for (size_t j = (std::max)(static_cast<size_t>(bucketBegin), i + 1); j < bucketEnd; ++j) {
+				const float dx = sortedX_[j] - x;
+				const float dy = sortedY_[j] - y;
+				const float dz = sortedZ_[j] - z;
+				const float radiusSum = sortedRadius_[j] + radius;
+				if (dx * dx + dy * dy + dz * dz <= radiusSum * radiusSum) {
+					const uint32_t a = sortedIndex_[i];
+					const uint32_t b = sortedIndex_[j];
+					out.push_back(a < b ? Pair{a, b} : Pair{b, a});
+				}
+			}
+			return true;
+		});
+	}
+}
+
+void SpatialHashGrid::FindAllPairs(std::vector<Pair>& out, bool multithreaded) const {
+	MT4_PROFILE_SCOPE("SpatialHashGrid::FindAllPairs");
+	out.clear();
+	const size_t count = sortedIndex_.size();
+	if (!multithreaded || count <= kPairBlockSize) {
+		FindPairsInRange(0, count, out);
+		return;
+	}
+
+	// 塊ごとに別の配列へ書き、最後に塊の順でつなげる（スレッド数によらず同じ順になる）
+	const size_t blockCount = (count + kPairBlockSize - 1) / kPairBlockSize;
+	std::vector<std::vector<Pair>> blockPairs(blockCount);
+	ParallelFor(blockCount, 1, [&](size_t begin, size_t end) {
+		for (size_t block = begin; block < end; ++block) {
+			const size_t first = block * kPairBlockSize;
+			FindPairsInRange(first, (std::min)(first + kPairBlockSize, count), blockPairs[block]);
+		}
+	});
+
+	size_t total = 0;
+	for (const std::vector<Pair>& pairs : blockPairs) {
+		total += pairs.size();
+	}
+	out.reserve(total);
+	for (const std::vector<Pair>& pairs : blockPairs) {
+		out.insert(out.end(), pairs.begin(), pairs.end());
+	}
+}
@@ -0,0 +1,173 @@
+#pragma once
+#include "CollisionBatch.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//==================================
+// 一様格子の空間ハッシュ
+//==================================
+// 大きさのそろった大量の球（パーティクル、弾など）の近傍探索用。
+// 空間を cellSize の立方体に区切り、セル座標のハッシュでバケットに振り分ける。
+// Build は毎フレーム作り直す前提で、バケットごとの個数を数えて累積和を取る
+// 計数ソートで O(N) に並べる。並べた順に中心と半径もコピーするので、
+// 同じセルの球はメモリ上でも隣り合う。
+//
+// cellSize は最大半径の 2 倍程度にすると、全組判定で調べるセルが周囲 27 個に収まる。
+// 0 を指定すると Build のたびに最大半径の 2 倍を使う。
+// 異なるセルが同じバケットに入ることがあるが、距離の判定で除かれる。
+
+class SpatialHashGrid {
+
+public:
+	// 重なっている 2 つの球（Build に渡した順の番号、a < b）
+	struct Pair {
+		uint32_t a;
+		uint32_t b;
+	};
+
+	struct Settings {
+		float cellSize = 0.0f; // 0 なら最大半径の 2 倍
+	};
+
+	SpatialHashGrid() = default;
+	explicit SpatialHashGrid(const Settings& settings);
+
+	void SetSettings(const Settings& settings) { settings_ = settings; }
+	const Settings& GetSettings() const { return settings_; }
+
+	// 球の集合から作り直す
+	void Build(const SphereSoA& spheres, size_t count);
+	// 半径がすべて同じ場合（BallSystem の位置の SoA など）
+	void Build(const ConstVector3SoA& centers, float radius, size_t count);
+
+	size_t Size() const { return sortedIndex_.size(); }
+	float GetCellSize() const { return cellSize_; }
+
+	// 中心 center、半径 radius の球と重なる要素の番号を callback(index) に渡す。
+	// callback が false を返すと打ち切る。out を取る版は out に追加する
+	template <typename Callback> void QueryRadius(const Vector3& center, float radius, Callback&& callback) const;
+	void QueryRadius(const Vector3& center, float radius, std::vector<uint32_t>& out) const;
+
+	// 重なっている全ての組を求める（out は上書き）。multithreaded なら要素を塊に分けて並列に調べる
+	void FindAllPairs(std::vector<Pair>& out, bool multithreaded = false) const;
+
+private:
+	// セル座標から求めたバケットの範囲を、重複なく順に調べる
+	template <typename Visit> bool ForEachBucket(const Vector3& min, const Vector3& max, Visit&& visit) const;
+
+	void BuildSorted(size_t count);
+	int32_t CellCoordinate(float value) const;
+	uint32_t Bucket(int32_t x, int32_t y, int32_t z) const;
+	void FindPairsInRange(size_t begin, size_t end, std::vector<Pair>& out) const;
+
+	Settings settings_;
+	float cellSize_ = 1.0f;
+	float inverseCellSize_ = 1.0f;
+	float maxRadius_ = 0.0f;
+	uint32_t bucketMask_ = 0;
+
+	// 入力をそのまま受けたもの（計数ソートの作業用）
+	std::vector<float> inputX_, inputY_, inputZ_, inputRadius_;
+	std::vector<uint32_t> inputBucket_;
+
+	// バケット b の要素は sorted*_[bucketStart_[b], bucketStart_[b + 1])
+	std::vector<uint32_t> bucketStart_;
+	std::vector<uint32_t> sortedIndex_; // 並べ替え後の位置 → 入力の番号
+	std::vector<float> sortedX_, sortedY_, sortedZ_, sortedRadius_;
+};
+
+//==================================
+// テンプレート
+//==================================
+
+template <typename Visit> bool SpatialHashGrid::ForEachBucket(const Vector3& min, const Vector3& max, Visit&& visit) const {
+	if (sortedIndex_.empty()) {
+		return true;
+	}
+	const int32_t x0 = CellCoordinate(min.x);
+	const int32_t y0 = CellCoordinate(min.y);
+	const int32_t z0 = CellCoordinate(min.z);
+	const int32_t x1 = CellCoordinate(max.x);
+	const int32_t y1 = CellCoordinate(max.y);
+	const int32_t z1 = CellCoordinate(max.z);
+
+	const uint32_t bucketCount = bucketMask_ + 1;
+	const uint64_t cellCount = static_cast<uint64_t>(int64_t{x1} - x0 + 1) * static_cast<uint64_t>(int64_t{y1} - y0 + 1) * static_cast<uint64_t>(int64_t{z1} - z0 + 1);
+
+	// バケットの数より広い範囲は全バケットを 1 回ずつ調べる
+	if (cellCount >= bucketCount) {
+		for (uint32_t bucket = 0; bucket < bucketCount; ++bucket) {
+			if (!visit(bucketStart_[bucket], bucketStart_[bucket + 1])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// 広い範囲はバケット番号を集めて並べ、重複を除いてから調べる
+	constexpr uint64_t kLocalBucketCount = 64;
+	if (cellCount > kLocalBucketCount) {
+		std::vector<uint32_t> buckets;
+		buckets.reserve(static_cast<size_t>(cellCount));
+		for (int32_t z = z0; z <= z1; ++z) {
+			for (int32_t y = y0; y <= y1; ++y) {
+				for (int32_t x = x0; x <= x1; ++x) {
+					buckets.push_back(Bucket(x, y, z));
+				}
+			}
+		}
+		std::sort(buckets.begin(), buckets.end());
+		buckets.erase(std::unique(buckets.begin(), buckets.end()), buckets.end());
+		for (const uint32_t bucket : buckets) {
+			if (!visit(bucketStart_[bucket], bucketStart_[bucket + 1])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// 周囲 27 セル程度なら、訪れたバケットを配列に覚えて線形に探す。
+	// 下位 6 ビットの印が立っていなければ初めてのバケットなので、探すのを省く
+	uint32_t visited[kLocalBucketCount];
+	size_t visitedCount = 0;
+	uint64_t visitedBits = 0;
+	for (int32_t z = z0; z <= z1; ++z) {
+		for (int32_t y = y0; y <= y1; ++y) {
+			for (int32_t x = x0; x <= x1; ++x) {
+				const uint32_t bucket = Bucket(x, y, z);
+				const uint64_t bit = uint64_t{1} << (bucket & 63u);
+				if ((visitedBits & bit) != 0 && std::find(visited, visited + visitedCount, bucket) != visited + visitedCount) {
+					continue;
+				}
+				visitedBits |= bit;
+				visited[visitedCount++] = bucket;
+				if (!visit(bucketStart_[bucket], bucketStart_[bucket + 1])) {
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+template <typename Callback> void SpatialHashGrid::QueryRadius(const Vector3& center, float radius, Callback&& callback) const {
+	const float range = radius + maxRadius_;
+	const Vector3 min = {center.x - range, center.y - range, center.z - range};
+	const Vector3 max = {center.x + range, center.y + range, center.z + range};
+	ForEachBucket(min, max, [&](uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; ++i) {
+			const float dx = sortedX_[i] - center.x;
+			const float dy = sortedY_[i] - center.y;
+			const float dz = sortedZ_[i] - center.z;
+			const float radiusSum = sortedRadius_[i] + radius;
+			if (dx * dx + dy * dy + dz * dz <= radiusSum * radiusSum) {
+				if (!callback(sortedIndex_[i])) {
+					return false;
+				}
+			}
+		}
+		return true;
+	});
+}
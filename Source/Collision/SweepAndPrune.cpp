@@ -0,0 +1,292 @@
+#include "SweepAndPrune.h"
+#include "Job/ParallelFor.h"
+#include "Profiler/Profiler.h"
+#include <algorithm>
+
+namespace {
+
+// 前回の Step から追加したプロキシが全体のこの割合を超えたら、挿入ソートをやめて全体をソートし直す
+constexpr size_t kFullRebuildDivisor = 4;
+
+// この数より少なければ軸ごとのスレッド分割はしない
+constexpr size_t kParallelEndpointCount = 4096;
+
+} // namespace
+
+//==================================
+// プロキシ
+//==================================
+
+uint32_t SweepAndPrune::Add(const AABB& aabb) {
+	uint32_t proxy;
+	if (!freeProxies_.empty()) {
+		proxy = freeProxies_.back();
+		freeProxies_.pop_back();
+		alive_[proxy] = 1;
+	} else {
+		proxy = static_cast<uint32_t>(alive_.size());
+		for (int axis = 0; axis < 3; ++axis) {
+			min_[axis].push_back(0.0f);
+			max_[axis].push_back(0.0f);
+		}
+		alive_.push_back(1);
+		previousValid_.push_back(0);
+	}
+	previousValid_[proxy] = 0;
+	Update(proxy, aabb);
+
+	// 端点は末尾に置き、次の Step の挿入ソートで正しい位置まで動かす。
+	// 末尾（全ての端点より右）から左へ動く間に相手の max を越えた組が候補になる
+	for (int axis = 0; axis < 3; ++axis) {
+		endpoints_[axis].push_back({0.0f, proxy << 1});
+		endpoints_[axis].push_back({0.0f, (proxy << 1) | 1u});
+	}
+	++proxyCount_;
+	++addedSinceStep_;
+	return proxy;
+}
+
+uint32_t SweepAndPrune::Add(const Vector3& center, float radius) {
+	AABB aabb;
+	aabb.min = {center.x - radius, center.y - radius, center.z - radius};
+	aabb.max = {center.x + radius, center.y + radius, center.z + radius};
+	return Add(aabb);
+}
+
+void SweepAndPrune::Remove(uint32_t proxy) {
+	alive_[proxy] = 0;
+	removedProxies_.push_back(proxy);
+	--proxyCount_;
+}
+
+void SweepAndPrune::Update(uint32_t proxy, const AABB& aabb) {
+	min_[0][proxy] = aabb.min.x;
+	min_[1][proxy] = aabb.min.y;
+	min_[2][proxy] = aabb.min.z;
+	max_[0][proxy] = aabb.max.x;
+	max_[1][proxy] = aabb.max.y;
+	max_[2][proxy] = aabb.max.z;
+}
+
+void SweepAndPrune::Update(uint32_t proxy, const Vector3& center, float radius) {
+	min_[0][proxy] = center.x - radius;
+	min_[1][proxy] = center.y - radius;
+	min_[2][proxy] = center.z - radius;
+	max_[0][proxy] = center.x + radius;
+	max_[1][proxy] = center.y + radius;
+	max_[2][proxy] = center.z + radius;
+}
+
+void SweepAndPrune::Clear() {
+	for (int axis = 0; axis < 3; ++axis) {
+		min_[axis].clear();
+		max_[axis].clear();
+		endpoints_[axis].clear();
+		candidates_[axis].clear();
+	}
+	alive_.clear();
+	previousValid_.clear();
+	pairs_.clear();
+	addedPairs_.clear();
+	removedPairs_.clear();
+	freeProxies_.clear();
+	removedProxies_.clear();
+	proxyCount_ = 0;
+	addedSinceStep_ = 0;
+}
+
+//==================================
+// 組
+//==================================
+
+uint64_t SweepAndPrune::MakeKey(uint32_t a, uint32_t b) {
+	if (a > b) {
+		std::swap(a, b);
+	}
+	return (static_cast<uint64_t>(a) << 32) | b;
+}
+
+bool SweepAndPrune::IsOverlapping(uint32_t a, uint32_t b) const { return pairs_.count(MakeKey(a, b)) != 0; }
+
+bool SweepAndPrune::Overlaps(const std::vector<float> (&minValues)[3], const std::vector<float> (&maxValues)[3], uint32_t a, uint32_t b) {
+	for (int axis = 0; axis < 3; ++axis) {
+		if (minValues[axis][a] > maxValues[axis][b] || minValues[axis][b] > maxValues[axis][a]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//==================================
+// 更新
+//==================================
+
+void SweepAndPrune::Step() {
+	MT4_PROFILE_SCOPE("SweepAndPrune::Step");
+	addedPairs_.clear();
+	removedPairs_.clear();
+
+	RemoveDeadProxies();
+
+	if (addedSinceStep_ * kFullRebuildDivisor > proxyCount_) {
+		FindPairsFull();
+	} else {
+		FindPairsIncremental();
+	}
+	addedSinceStep_ = 0;
+
+	// 次の Step で重なりの変化を判定するために今回の境界を残す
+	for (int axis = 0; axis < 3; ++axis) {
+		previousMin_[axis] = min_[axis];
+		previousMax_[axis] = max_[axis];
+	}
+	previousValid_ = alive_;
+}
+
+// 削除したプロキシの端点と組を片付け、番号を再利用できるようにする
+void SweepAndPrune::RemoveDeadProxies() {
+	if (removedProxies_.empty()) {
+		return;
+	}
+	for (int axis = 0; axis < 3; ++axis) {
+		std::vector<Endpoint>& endpoints = endpoints_[axis];
+		endpoints.erase(std::remove_if(endpoints.begin(), endpoints.end(), [&](const Endpoint& e) { return !alive_[e.Proxy()]; }), endpoints.end());
+	}
+	for (auto it = pairs_.begin(); it != pairs_.end();) {
+		const uint32_t a = static_cast<uint32_t>(*it >> 32);
+		const uint32_t b = static_cast<uint32_t>(*it);
+		if (!alive_[a] || !alive_[b]) {
+			removedPairs_.push_back({a, b});
+			it = pairs_.erase(it);
+		} else {
+			++it;
+		}
+	}
+	freeProxies_.insert(freeProxies_.end(), removedProxies_.begin(), removedProxies_.end());
+	removedProxies_.clear();
+}
+
+// 端点の値を読み直して挿入ソートし、min と max が入れ替わった組を記録する
+void SweepAndPrune::SortAxis(int axis) {
+	std::vector<Endpoint>& endpoints = endpoints_[axis];
+	std::vector<uint64_t>& candidates = candidates_[axis];
+	const float* minValues = min_[axis].data();
+	const float* maxValues = max_[axis].data();
+	candidates.clear();
+
+	for (Endpoint& e : endpoints) {
+		e.value = e.IsMax() ? maxValues[e.Proxy()] : minValues[e.Proxy()];
+	}
+
+	const size_t count = endpoints.size();
+	for (size_t i = 1; i < count; ++i) {
+		const Endpoint key = endpoints[i];
+		size_t j = i;
+		while (j > 0 && Less(key, endpoints[j - 1])) {
+			const Endpoint& passed = endpoints[j - 1];
+			if (key.IsMax() != passed.IsMax() && key.Proxy() != passed.Proxy()) {
+				candidates.push_back(MakeKey(key.Proxy(), passed.Proxy()));
+			}
+			endpoints[j] = passed;
+			--j;
+		}
+		endpoints[j] = key;
+	}
+}
+
+void SweepAndPrune::SortAxisFull(int axis) {
+	std::vector<Endpoint>& endpoints = endpoints_[axis];
+	const float* minValues = min_[axis].data();
+	const float* maxValues = max_[axis].data();
+	for (Endpoint& e : endpoints) {
+		e.value = e.IsMax() ? maxValues[e.Proxy()] : minValues[e.Proxy()];
+	}
+	std::sort(endpoints.begin(), endpoints.end(), Less);
+	candidates_[axis].clear();
+}
+
+void SweepAndPrune::FindPairsIncremental() {
+	if (multithreaded_ && endpoints_[0].size() >= kParallelEndpointCount) {
+		ParallelFor(3, 1, [&](size_t begin, size_t end) {
+			for (size_t axis = begin; axis < end; ++axis) {
+				SortAxis(static_cast<int>(axis));
+			}
+		});
+	} else {
+		for (int axis = 0; axis < 3; ++axis) {
+			SortAxis(axis);
+		}
+	}
+
+	// 候補は前回と今回の重なりが変わった組だけ集合に出し入れする。
+	// 同じ組が複数の軸で候補になっても、集合への出し入れで重複は消える
+	for (int axis = 0; axis < 3; ++axis) {
+		for (const uint64_t key : candidates_[axis]) {
+			const uint32_t a = static_cast<uint32_t>(key >> 32);
+			const uint32_t b = static_cast<uint32_t>(key);
+			const bool overlaps = Overlaps(min_, max_, a, b);
+			const bool overlapped = previousValid_[a] && previousValid_[b] && Overlaps(previousMin_, previousMax_, a, b);
+			if (overlaps == overlapped) {
+				continue;
+			}
+			if (overlaps) {
+				if (pairs_.insert(key).second) {
+					addedPairs_.push_back({a, b});
+				}
+			} else if (pairs_.erase(key) != 0) {
+				removedPairs_.push_back({a, b});
+			}
+		}
+		candidates_[axis].clear();
+	}
+}
+
+// 全ての軸をソートし直し、x 軸の掃引で組を作り直して前回との差を出す
+void SweepAndPrune::FindPairsFull() {
+	if (multithreaded_ && endpoints_[0].size() >= kParallelEndpointCount) {
+		ParallelFor(3, 1, [&](size_t begin, size_t end) {
+			for (size_t axis = begin; axis < end; ++axis) {
+				SortAxisFull(static_cast<int>(axis));
+			}
+		});
+	} else {
+		for (int axis = 0; axis < 3; ++axis) {
+			SortAxisFull(axis);
+		}
+	}
+
+	std::unordered_set<uint64_t> pairs;
+	pairs.reserve(pairs_.size());
+	std::vector<uint32_t> active;
+	std::vector<uint32_t> activeIndex(alive_.size());
+	for (const Endpoint& e : endpoints_[0]) {
+		const uint32_t proxy = e.Proxy();
+		if (e.IsMax()) {
+			// 入れ替えで削除する
+			const uint32_t index = activeIndex[proxy];
+			active[index] = active.back();
+			activeIndex[active[index]] = index;
+			active.pop_back();
+			continue;
+		}
+		for (const uint32_t other : active) {
+			if (Overlaps(min_, max_, proxy, other)) {
+				pairs.insert(MakeKey(proxy, other));
+			}
+		}
+		activeIndex[proxy] = static_cast<uint32_t>(active.size());
+		active.push_back(proxy);
+	}
+
+	for (const uint64_t key : pairs_) {
+		if (pairs.count(key) == 0) {
+			removedPairs_.push_back({static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key)});
+		}
+	}
+	for (const uint64_t key : pairs) {
+		if (pairs_.count(key) == 0) {
+			addedPairs_.push_back({static_cast<uint32_t>(key >> 32), static_cast<uint32_t>(key)});
+		}
+	}
+	pairs_ = std::move(pairs);
+}
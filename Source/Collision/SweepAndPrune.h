@@ -0,0 +1,105 @@
+#pragma once
+#include "struct.h"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+using namespace KamataEngine;
+
+//==================================
+// 逐次更新の Sweep and Prune（ブロードフェーズ）
+//==================================
+// 各軸で AABB の端点（min / max）を並べた配列を持ち、毎回の Step で挿入ソートし直す。
+// 前回からあまり動かない物体ばかりなら並びはほとんど崩れないので、ソートはほぼ O(N) で済む。
+// ソート中に min と max が入れ替わった組だけを候補として 3 軸で判定し直し、
+// 重なり始めた組（AddedPairs）と離れた組（RemovedPairs）だけを出力する。
+//
+// 3 軸のソートは互いに独立なので、SetMultithreaded(true) で軸ごとに別スレッドで行う。
+// 候補の判定と組の集合の更新は呼び出し元のスレッドで行う。
+// まとめて大量に追加した直後など並びが大きく崩れる場合は、全体をソートし直して組を作り直す。
+// 接しているだけの組も重なりとみなす（Collision.h の IsCollision と同じ）。
+
+class SweepAndPrune {
+
+public:
+	// 重なっている 2 つのプロキシ（a < b）
+	struct Pair {
+		uint32_t a;
+		uint32_t b;
+	};
+
+	// 追加したプロキシの番号を返す。番号は Remove 後の Step を過ぎると再利用される
+	uint32_t Add(const AABB& aabb);
+	uint32_t Add(const Vector3& center, float radius);
+	void Remove(uint32_t proxy);
+
+	// 境界を書き換える（反映は次の Step）
+	void Update(uint32_t proxy, const AABB& aabb);
+	// Ball / Sphere 用（中心 ± 半径の箱）
+	void Update(uint32_t proxy, const Vector3& center, float radius);
+
+	// 端点を並べ直して重なりの変化を求める
+	void Step();
+
+	// 直近の Step で重なり始めた組と、離れた組（削除したプロキシを含む組も入る）
+	const std::vector<Pair>& AddedPairs() const { return addedPairs_; }
+	const std::vector<Pair>& RemovedPairs() const { return removedPairs_; }
+
+	// 現在重なっている組の数と、組が重なっているかどうか
+	size_t PairCount() const { return pairs_.size(); }
+	bool IsOverlapping(uint32_t a, uint32_t b) const;
+
+	size_t ProxyCount() const { return proxyCount_; }
+
+	void Clear();
+
+	void SetMultithreaded(bool enable) { multithreaded_ = enable; }
+	bool IsMultithreaded() const { return multithreaded_; }
+
+private:
+	// 端点。data は (プロキシ番号 << 1) | (max なら 1)
+	struct Endpoint {
+		float value;
+		uint32_t data;
+
+		uint32_t Proxy() const { return data >> 1; }
+		bool IsMax() const { return (data & 1u) != 0; }
+	};
+
+	static uint64_t MakeKey(uint32_t a, uint32_t b);
+
+	// 値が同じなら min を先に置く（接している組も重なりとして検出するため）
+	static bool Less(const Endpoint& lhs, const Endpoint& rhs) { return lhs.value < rhs.value || (lhs.value == rhs.value && !lhs.IsMax() && rhs.IsMax()); }
+
+	void SortAxis(int axis);
+	void SortAxisFull(int axis);
+	void RemoveDeadProxies();
+	void FindPairsIncremental();
+	void FindPairsFull();
+	static bool Overlaps(const std::vector<float> (&minValues)[3], const std::vector<float> (&maxValues)[3], uint32_t a, uint32_t b);
+
+	// プロキシごとの境界（軸ごとの配列）
+	std::vector<float> min_[3];
+	std::vector<float> max_[3];
+	std::vector<uint8_t> alive_;
+
+	// 前回の Step 時点の境界（追加したばかりのプロキシは previousValid_ が 0）
+	std::vector<float> previousMin_[3];
+	std::vector<float> previousMax_[3];
+	std::vector<uint8_t> previousValid_;
+
+	std::vector<Endpoint> endpoints_[3];
+	// 軸ごとのソート中に min と max が入れ替わった組
+	std::vector<uint64_t> candidates_[3];
+
+	std::unordered_set<uint64_t> pairs_;
+	std::vector<Pair> addedPairs_;
+	std::vector<Pair> removedPairs_;
+
+	std::vector<uint32_t> freeProxies_;    // 再利用できる番号
+	std::vector<uint32_t> removedProxies_; // 次の Step で片付ける番号
+	size_t proxyCount_ = 0;
+	size_t addedSinceStep_ = 0;
+	bool multithreaded_ = false;
+};
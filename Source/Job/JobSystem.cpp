@@ -0,0 +1,187 @@
+#include "JobSystem.h"
+#include "Profiler/Profiler.h"
+#include <algorithm>
+#include <string>
+#include <thread>
+
+namespace {
+
+// ParallelFor で 1 スレッドあたりに作る塊の数の上限
+constexpr size_t kChunksPerThread = 4;
+
+// 実行中のワーカーが属するジョブシステムと、そのキューの番号
+thread_local const JobSystem* tOwner = nullptr;
+thread_local size_t tQueueIndex = 0;
+
+} // namespace
+
+//==================================
+// 起動と終了
+//==================================
+
+JobSystem::JobSystem(size_t workerCount) {
+	for (size_t i = 0; i < workerCount + 1; ++i) {
+		queues_.push_back(std::make_unique<Queue>());
+	}
+	threads_.reserve(workerCount);
+	for (size_t i = 0; i < workerCount; ++i) {
+		threads_.emplace_back(&JobSystem::WorkerLoop, this, i);
+	}
+}
+
+JobSystem::~JobSystem() {
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex_);
+		stopping_.store(true, std::memory_order_relaxed);
+	}
+	wake_.notify_all();
+	for (std::thread& thread : threads_) {
+		thread.join();
+	}
+}
+
+bool JobSystem::IsWorkerThread() const { return tOwner == this; }
+
+size_t JobSystem::HomeQueue() const { return IsWorkerThread() ? tQueueIndex : queues_.size() - 1; }
+
+//==================================
+// ジョブの受け渡し
+//==================================
+
+void JobSystem::Submit(JobGroup& group, std::function<void()> job) {
+	group.pending_.fetch_add(1, std::memory_order_relaxed);
+	if (threads_.empty()) {
+		job();
+		group.pending_.fetch_sub(1, std::memory_order_release);
+		return;
+	}
+
+	Queue& queue = *queues_[HomeQueue()];
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		queue.jobs.push_back({std::move(job), &group});
+	}
+	queuedCount_.fetch_add(1, std::memory_order_release);
+	{
+		// 眠りに入る直前のワーカーが通知を取りこぼさないよう、ロックを通してから起こす
+		std::lock_guard<std::mutex> lock(sleepMutex_);
+	}
+	wake_.notify_one();
+}
+
+// 自分のキューは後ろから、他のキューは前から取る
+bool JobSystem::PopOrSteal(size_t home, Job& job) {
+	if (queuedCount_.load(std::memory_order_acquire) == 0) {
+		return false;
+	}
+	{
+		Queue& queue = *queues_[home];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (!queue.jobs.empty()) {
+			job = std::move(queue.jobs.back());
+			queue.jobs.pop_back();
+			queuedCount_.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	const size_t queueCount = queues_.size();
+	for (size_t offset = 1; offset < queueCount; ++offset) {
+		Queue& victim = *queues_[(home + offset) % queueCount];
+		std::lock_guard<std::mutex> lock(victim.mutex);
+		if (!victim.jobs.empty()) {
+			job = std::move(victim.jobs.front());
+			victim.jobs.pop_front();
+			queuedCount_.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	return false;
+}
+
+void JobSystem::Run(Job& job) {
+	MT4_PROFILE_SCOPE("Job");
+	job.function();
+	job.group->pending_.fetch_sub(1, std::memory_order_release);
+}
+
+void JobSystem::WorkerLoop(size_t index) {
+	tOwner = this;
+	tQueueIndex = index;
+#if MT4_PROFILE
+	Profiler::SetThreadName("Worker " + std::to_string(index));
+#endif
+	Job job;
+	while (true) {
+		if (PopOrSteal(index, job)) {
+			Run(job);
+			continue;
+		}
+		std::unique_lock<std::mutex> lock(sleepMutex_);
+		wake_.wait(lock, [&] { return stopping_.load(std::memory_order_relaxed) || queuedCount_.load(std::memory_order_acquire) != 0; });
+		if (stopping_.load(std::memory_order_relaxed)) {
+			return;
+		}
+	}
+}
+
+void JobSystem::Wait(JobGroup& group) {
+	const size_t home = HomeQueue();
+	Job job;
+	while (!group.IsDone()) {
+		if (PopOrSteal(home, job)) {
+			Run(job);
+		} else {
+			// 残りは他のスレッドが実行中
+			std::this_thread::yield();
+		}
+	}
+}
+
+//==================================
+// 並列ループ
+//==================================
+
+void JobSystem::ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& body) { ParallelFor(count, grainSize, WorkerCount() + 1, body); }
+
+void JobSystem::ParallelFor(size_t count, size_t grainSize, size_t threadCount, const std::function<void(size_t begin, size_t end)>& body) {
+	if (count == 0) {
+		return;
+	}
+	grainSize = (std::max)(grainSize, size_t{1});
+	threadCount = std::clamp(threadCount, size_t{1}, WorkerCount() + 1);
+	const size_t maxChunkCount = threadCount == 1 ? size_t{1} : threadCount * kChunksPerThread;
+	const size_t chunkCount = (std::min)((count + grainSize - 1) / grainSize, maxChunkCount);
+	if (chunkCount <= 1) {
+		body(0, count);
+		return;
+	}
+
+	// 塊は番号の順に取り合う。呼び出し元と threadCount - 1 個の手伝いのジョブだけが取るので、
+	// 同時に動くスレッドは threadCount までで、早く終わったスレッドが残りの塊を引き受ける
+	const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+	const size_t lastChunk = (count + chunkSize - 1) / chunkSize;
+	std::atomic<size_t> nextChunk{0};
+	const auto runChunks = [&] {
+		for (size_t chunk = nextChunk.fetch_add(1, std::memory_order_relaxed); chunk < lastChunk; chunk = nextChunk.fetch_add(1, std::memory_order_relaxed)) {
+			const size_t begin = chunk * chunkSize;
+			body(begin, (std::min)(begin + chunkSize, count));
+		}
+	};
+	JobGroup group;
+	const size_t helperCount = (std::min)(threadCount, lastChunk) - 1;
+	for (size_t i = 0; i < helperCount; ++i) {
+		Submit(group, runChunks);
+	}
+	runChunks();
+	Wait(group);
+}
+
+//==================================
+// 共有のジョブシステム
+//==================================
+
+JobSystem& GetJobSystem() {
+	// 最初の呼び出しで作り、終了まで作り直さない（返した参照をどのスレッドが持っていても有効なまま）
+	static JobSystem shared((std::max)(1u, std::thread::hardware_concurrency()) - 1);
+	return shared;
+}
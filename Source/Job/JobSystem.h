@@ -0,0 +1,90 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//==================================
+// ワークスティーリングのジョブシステム
+//==================================
+// ワーカースレッドを起動したまま保ち、小さな仕事（ジョブ）を配って並列に処理する。
+// ワーカーごとに両端キューを持ち、自分のキューは後ろから取り（直前に積んだものを先に）、
+// 空になったら他のキューの前から盗む。ワーカー以外のスレッドが積んだジョブは共有のキューに入る。
+//
+// ジョブは JobGroup に数えられ、Wait(group) はその数が 0 になるまで待つ。
+// 待っている間も呼び出し元でジョブを実行するので、ジョブの中から ParallelFor を呼んでも詰まらない。
+// ファイバーは使わず、ジョブは最後まで実行してから次へ進む。
+
+class JobGroup {
+
+public:
+	bool IsDone() const { return pending_.load(std::memory_order_acquire) == 0; }
+
+private:
+	friend class JobSystem;
+	std::atomic<size_t> pending_{0};
+};
+
+class JobSystem {
+
+public:
+	// workerCount が 0 ならスレッドを起動せず、全て呼び出し元で実行する
+	explicit JobSystem(size_t workerCount);
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	size_t WorkerCount() const { return threads_.size(); }
+
+	void Submit(JobGroup& group, std::function<void()> job);
+
+	// group のジョブが全て終わるまで、ジョブを実行しながら待つ
+	void Wait(JobGroup& group);
+
+	// [0, count) を grainSize 以上の塊に分けて body(begin, end) を呼ぶ。
+	// 塊の数はスレッド数の数倍までに抑え、空いたスレッドが残りを引き受けて偏りをならす
+	void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& body);
+
+	// 同時に処理するスレッドを呼び出し元を含めて threadCount 以下（ワーカー数 + 1 が上限）に抑える版
+	void ParallelFor(size_t count, size_t grainSize, size_t threadCount, const std::function<void(size_t begin, size_t end)>& body);
+
+	// 現在のスレッドがこのジョブシステムのワーカーか
+	bool IsWorkerThread() const;
+
+private:
+	struct Job {
+		std::function<void()> function;
+		JobGroup* group;
+	};
+
+	// キューごとに別のキャッシュラインに置く
+	struct alignas(64) Queue {
+		std::mutex mutex;
+		std::deque<Job> jobs;
+	};
+
+	size_t HomeQueue() const;
+	bool PopOrSteal(size_t home, Job& job);
+	static void Run(Job& job);
+	void WorkerLoop(size_t index);
+
+	// [0, ワーカー数) はワーカー用、最後はワーカー以外のスレッド用
+	std::vector<std::unique_ptr<Queue>> queues_;
+	std::vector<std::thread> threads_;
+
+	std::atomic<size_t> queuedCount_{0};
+	std::atomic<bool> stopping_{false};
+	std::mutex sleepMutex_;
+	std::condition_variable wake_;
+};
+
+// ParallelFor などが使う共有のジョブシステム。
+// ワーカー数はハードウェアのスレッド数 - 1（呼び出し元も処理に加わる）で、最初の呼び出しで作ったものを終了まで使う。
+// SetWorkerThreadCount は ParallelFor が同時に使うスレッド数を絞るだけで、これを作り直さない
+JobSystem& GetJobSystem();
@@ -0,0 +1,23 @@
+#include "ParallelFor.h"
+#include "JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace {
+
+std::atomic<size_t> gThreadCountOverride{0};
+
+} // namespace
+
+size_t GetWorkerThreadCount() {
+	const size_t overrideCount = gThreadCountOverride.load(std::memory_order_relaxed);
+	if (overrideCount != 0) {
+		return overrideCount;
+	}
+	return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+void SetWorkerThreadCount(size_t count) { gThreadCountOverride.store(count, std::memory_order_relaxed); }
+
+void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& body) { GetJobSystem().ParallelFor(count, grainSize, GetWorkerThreadCount(), body); }
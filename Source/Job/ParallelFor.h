@@ -0,0 +1,20 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+
+//==================================
+// 範囲を分割して複数スレッドで処理する
+//==================================
+// [0, count) を grainSize 以上の塊に分け、呼び出し元スレッドも含めて並列に body(begin, end) を呼ぶ。
+// 全ての塊が終わるまで戻らない。塊が 1 つしかない場合は呼び出し元でそのまま実行する。
+// 塊は共有のジョブシステム（JobSystem.h）のワーカーに配るので、呼ぶたびにスレッドを作ることはない。
+// 塊の数はスレッド数より多くなることがあり、空いたワーカーが残りを盗んで偏りをならす。
+
+// 並列処理に使うスレッド数（呼び出し元を含む）
+size_t GetWorkerThreadCount();
+
+// 0 を指定するとハードウェアのスレッド数に戻す。1 で並列化を無効にする。
+// ハードウェアのスレッド数より大きくしても、それ以上のスレッドは使わない
+void SetWorkerThreadCount(size_t count);
+
+void ParallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& body);
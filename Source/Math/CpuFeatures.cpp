@@ -0,0 +1,120 @@
+#include "CpuFeatures.h"
+#include <atomic>
+#include <cstdint>
+
+#if defined(MT4_SSE2)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+namespace {
+
+#if defined(MT4_SSE2)
+
+void Cpuid(int leaf, int subLeaf, uint32_t out[4]) {
+#if defined(_MSC_VER)
+	int regs[4];
+	__cpuidex(regs, leaf, subLeaf);
+	for (int i = 0; i < 4; ++i) {
+		out[i] = static_cast<uint32_t>(regs[i]);
+	}
+#else
+	__cpuid_count(leaf, subLeaf, out[0], out[1], out[2], out[3]);
+#endif
+}
+
+// XCR0 を読む（OS が AVX の状態保存を有効にしているかの確認用）
+uint64_t ReadXcr0() {
+#if defined(_MSC_VER)
+	return _xgetbv(0);
+#else
+	uint32_t eax = 0;
+	uint32_t edx = 0;
+	__asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+	return (static_cast<uint64_t>(edx) << 32) | eax;
+#endif
+}
+
+CpuFeatures DetectCpuFeatures() {
+	CpuFeatures features;
+
+	uint32_t regs[4] = {};
+	Cpuid(0, 0, regs);
+	const uint32_t maxLeaf = regs[0];
+
+	Cpuid(1, 0, regs);
+	const uint32_t ecx1 = regs[2];
+	const uint32_t edx1 = regs[3];
+
+	features.sse2 = (edx1 & (1u << 26)) != 0;
+	features.sse41 = (ecx1 & (1u << 19)) != 0;
+
+	const bool osxsave = (ecx1 & (1u << 27)) != 0;
+	const bool cpuAvx = (ecx1 & (1u << 28)) != 0;
+	// XMM(bit1) と YMM(bit2) の両方を OS が保存していること
+	const bool osAvx = osxsave && (ReadXcr0() & 0x6) == 0x6;
+	features.avx = cpuAvx && osAvx;
+	features.fma = features.avx && (ecx1 & (1u << 12)) != 0;
+
+	if (maxLeaf >= 7) {
+		Cpuid(7, 0, regs);
+		features.avx2 = features.avx && (regs[1] & (1u << 5)) != 0;
+	}
+
+	return features;
+}
+
+#else
+
+CpuFeatures DetectCpuFeatures() { return CpuFeatures{}; }
+
+#endif
+
+SimdLevel MaxSupportedLevel(const CpuFeatures& features) {
+	if (features.avx2) {
+		return SimdLevel::AVX2;
+	}
+	if (features.sse2) {
+		return SimdLevel::SSE2;
+	}
+	return SimdLevel::Scalar;
+}
+
+// -1 は上書き無し
+std::atomic<int> gSimdLevelOverride{-1};
+
+} // namespace
+
+const CpuFeatures& GetCpuFeatures() {
+	static const CpuFeatures features = DetectCpuFeatures();
+	return features;
+}
+
+SimdLevel GetSimdLevel() {
+	static const SimdLevel supported = MaxSupportedLevel(GetCpuFeatures());
+
+	const int forced = gSimdLevelOverride.load(std::memory_order_relaxed);
+	if (forced < 0) {
+		return supported;
+	}
+	return static_cast<int>(supported) < forced ? supported : static_cast<SimdLevel>(forced);
+}
+
+void SetSimdLevelOverride(SimdLevel level) { gSimdLevelOverride.store(static_cast<int>(level), std::memory_order_relaxed); }
+
+void ClearSimdLevelOverride() { gSimdLevelOverride.store(-1, std::memory_order_relaxed); }
+
+const char* ToString(SimdLevel level) {
+	switch (level) {
+	case SimdLevel::Scalar:
+		return "Scalar";
+	case SimdLevel::SSE2:
+		return "SSE2";
+	case SimdLevel::AVX2:
+		return "AVX2";
+	}
+	return "Unknown";
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+//==================================
+// SIMD 関連のマクロと CPU 機能の判定
+//==================================
+
+// SSE2 は x64 では必ず使えるので、コンパイル時に有効にする
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+#define MT4_SSE2 1
+#include <immintrin.h>
+#endif
+
+// AVX2 の関数は実行時に CPUID で確認してから呼ぶ。
+// MSVC は /arch 無しでも組み込み関数を使えるが、GCC/Clang は関数単位で target 指定が要る。
+#if defined(MT4_SSE2) && (defined(__GNUC__) || defined(__clang__))
+#define MT4_TARGET_AVX2 __attribute__((target("avx2")))
+#define MT4_TARGET_AVX2_FMA __attribute__((target("avx2,fma")))
+#else
+#define MT4_TARGET_AVX2
+#define MT4_TARGET_AVX2_FMA
+#endif
+
+// 使用する命令セットの段階
+enum class SimdLevel {
+	Scalar,
+	SSE2,
+	AVX2,
+};
+
+struct CpuFeatures {
+	bool sse2 = false;
+	bool sse41 = false;
+	bool avx = false;  // OS が YMM レジスタを保存する場合のみ true
+	bool avx2 = false;
+	bool fma = false;
+};
+
+// 起動後最初の呼び出しで CPUID を調べ、以降は結果を返す
+const CpuFeatures& GetCpuFeatures();
+
+// バッチ処理のカーネル選択に使う段階（上書き指定があればそちらを優先）
+SimdLevel GetSimdLevel();
+
+// ベンチマークや検証用に段階を下げる。CPU が対応していない段階は対応する最上位に丸める
+void SetSimdLevelOverride(SimdLevel level);
+
+// 上書き指定を解除して自動判定に戻す
+void ClearSimdLevelOverride();
+
+const char* ToString(SimdLevel level);
@@ -1,4 +1,6 @@
 #pragma once
+#include "MathCore.h"
+#include "MatrixKernels.h"
 #include "struct.h"
 
 using namespace KamataEngine;
@@ -6,46 +8,52 @@ using namespace KamataEngine;
 //==================================
 // Vector3 関連関数
 //==================================
+// 小さな演算は MathCore.h の inline 実装への薄いラッパー
 
 // 加算
-Vector3 Add(const Vector3 &v1, const Vector3 &v2);
+inline Vector3 Add(const Vector3 &v1, const Vector3 &v2) { return MathCore::Add(v1, v2); }
 // 減算
-Vector3 Subtract(const Vector3 &v1, const Vector3 &v2);
+inline Vector3 Subtract(const Vector3 &v1, const Vector3 &v2) { return MathCore::Subtract(v1, v2); }
 // スカラー倍
-Vector3 Multiply(const Vector3 &v1, float scalar);
+inline Vector3 Multiply(const Vector3 &v1, float scalar) { return MathCore::Multiply(v1, scalar); }
 // 内積
-float Dot(const Vector3 &v1, const Vector3 &v2);
+inline float Dot(const Vector3 &v1, const Vector3 &v2) { return MathCore::Dot(v1, v2); }
 // 長さ
-float Length(const Vector3 &v);
+inline float Length(const Vector3 &v) { return MathCore::Length(v); }
 // 正規化
-Vector3 Normalize(const Vector3 &v);
+inline Vector3 Normalize(const Vector3 &v) { return MathCore::Normalize(v); }
 // 座標変換
-Vector3 Vector3Transform(const Vector3 &vector, const Matrix4x4 &matrix);
-// 正射影ベクトル
-Vector3 project(const Vector3 &v1, const Vector3 &v2);
+inline Vector3 Vector3Transform(const Vector3 &vector, const Matrix4x4 &matrix) { return MathCore::Transform(vector, matrix); }
+// 正射影ベクトル（v2 の長さが 0 なら零ベクトル。大文字の Project はこの判定をしない）
+inline Vector3 project(const Vector3 &v1, const Vector3 &v2) {
+	if (MathCore::Dot(v2, v2) == 0.0f) {
+		return {0.0f, 0.0f, 0.0f};
+	}
+	return MathCore::Project(v1, v2);
+}
 // 最近接点
 Vector3 closestPoint(const Vector3 &point, const Segment& segment);
 // 直線の交点
-Vector3 Cross(const Vector3 &v1, const Vector3 &v2);
+inline Vector3 Cross(const Vector3 &v1, const Vector3 &v2) { return MathCore::Cross(v1, v2); }
 
-Vector3 Project(const Vector3 &v, const Vector3 &axis);
+inline Vector3 Project(const Vector3 &v, const Vector3 &axis) { return MathCore::Project(v, axis); }
 
 //==================================
 // Matrix4x4 関連関数
 //==================================
 
 // 行列の加法
-Matrix4x4 Add(const Matrix4x4 &m1, const Matrix4x4 &m2);
+inline Matrix4x4 Add(const Matrix4x4 &m1, const Matrix4x4 &m2) { return MathCore::Add(m1, m2); }
 // 行列の減法
-Matrix4x4 Subtract(const Matrix4x4 &m1, const Matrix4x4 &m2);
+inline Matrix4x4 Subtract(const Matrix4x4 &m1, const Matrix4x4 &m2) { return MathCore::Subtract(m1, m2); }
 // 行列の積
-Matrix4x4 Multiply(const Matrix4x4 &m1, const Matrix4x4 &m2);
-// 逆行列
+inline Matrix4x4 Multiply(const Matrix4x4 &m1, const Matrix4x4 &m2) { return MathCore::Multiply(m1, m2); }
+// 逆行列（特異な場合は単位行列）
 Matrix4x4 Inverse(const Matrix4x4 &m);
 // 転置行列
-Matrix4x4 Transpose(const Matrix4x4 &m);
+inline Matrix4x4 Transpose(const Matrix4x4 &m) { return MathCore::Transpose(m); }
 // 単位行列の生成
-Matrix4x4 MakeIdentity4x4();
+inline Matrix4x4 MakeIdentity4x4() { return MathCore::MakeIdentity(); }
 
 //==================================
 // 回転行列
@@ -57,13 +65,13 @@ Matrix4x4 MakeRotateMatrix(ShaftType shaft, float radian);
 // 平行移動行列
 //==================================
 
-Matrix4x4 MakeTranslateMatrix(const Vector3 &translate);
+inline Matrix4x4 MakeTranslateMatrix(const Vector3 &translate) { return MathCore::MakeTranslate(translate); }
 
 //==================================
 // 拡大縮小行列
 //==================================
 
-Matrix4x4 MakeScaleMatrix(const Vector3 &scale);
+inline Matrix4x4 MakeScaleMatrix(const Vector3 &scale) { return MathCore::MakeScale(scale); }
 
 //==================================
 // Affine関数
@@ -115,17 +123,15 @@ Vector3 Bezier(const Vector3 &p0, const Vector3 &p1, const Vector3 &p2,
 // 演算子オーバーロード
 //==================================
 
-Vector3 operator*(Vector3& v1,float s);
-
-Vector3 operator*(const Vector3 &v1, const Vector3 &v2);
+inline Vector3 operator*(const Vector3 &v1, const Vector3 &v2) { return MathCore::Multiply(v1, v2); }
 
-Vector3 operator+(const Vector3 &v1, const Vector3 &v2);
+inline Vector3 operator+(const Vector3 &v1, const Vector3 &v2) { return MathCore::Add(v1, v2); }
 
-Vector3 operator-(const Vector3 &v1, const Vector3 &v2);
+inline Vector3 operator-(const Vector3 &v1, const Vector3 &v2) { return MathCore::Subtract(v1, v2); }
 
-Vector3 operator/(Vector3 &v1, float s);
+inline Vector3 operator/(const Vector3 &v1, float s) { return MathCore::Divide(v1, s); }
 
-Matrix4x4 operator*(const Matrix4x4 &m1, const Matrix4x4 &m2);
+inline Matrix4x4 operator*(const Matrix4x4 &m1, const Matrix4x4 &m2) { return MathCore::Multiply(m1, m2); }
 
 inline Vector3 operator*(const Vector3 &vector, float scalar) {
   return {vector.x * scalar, vector.y * scalar, vector.z * scalar};
@@ -135,10 +141,10 @@ inline Vector3 operator*(float scalar, const Vector3 &vector) {
   return vector * scalar;
 }
 
-Vector3 &operator+=(Vector3 &v1, const Vector3 &v2);
-Vector3 &operator*=(Vector3 &v, float scalar);
+inline Vector3 &operator+=(Vector3 &v1, const Vector3 &v2) { return v1 = MathCore::Add(v1, v2); }
+inline Vector3 &operator*=(Vector3 &v, float scalar) { return v = MathCore::Multiply(v, scalar); }
 
-Vector3 &operator-=(Vector3 &v1, const Vector3 &v2);
+inline Vector3 &operator-=(Vector3 &v1, const Vector3 &v2) { return v1 = MathCore::Subtract(v1, v2); }
 
 //==================================
 // 円運動
@@ -170,7 +176,7 @@ void UpdateConicalPendulum(Ball &ball, ConicalPendulum &conicalPendulum);
 // 反射ベクトル
 //==================================
 
-Vector3 Reflect(const Vector3 &input, const Vector3 &normal);
+inline Vector3 Reflect(const Vector3 &input, const Vector3 &normal) { return MathCore::Reflect(input, normal); }
 
 // ==================================
 // 任意軸回転行列の作成
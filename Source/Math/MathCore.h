@@ -0,0 +1,207 @@
+#pragma once
+#include "CpuFeatures.h"
+#include "MathTypes.h"
+#include <cmath>
+#include <type_traits>
+
+//==================================
+// ヘッダーオンリーの数学コア
+//==================================
+// 小さな演算はすべて inline / constexpr にして、呼び出し側のループへ
+// 展開されるようにする。Math3D.h の自由関数はここへの薄いラッパー。
+// 演算順序は従来の Math3D.cpp と同じにしてあるので結果はビット単位で一致する。
+
+namespace MathCore {
+
+using KamataEngine::Matrix4x4;
+using KamataEngine::Vector3;
+
+//==================================
+// Vector3
+//==================================
+
+constexpr Vector3 Add(const Vector3& v1, const Vector3& v2) { return {v1.x + v2.x, v1.y + v2.y, v1.z + v2.z}; }
+
+constexpr Vector3 Subtract(const Vector3& v1, const Vector3& v2) { return {v1.x - v2.x, v1.y - v2.y, v1.z - v2.z}; }
+
+constexpr Vector3 Multiply(const Vector3& v, float scalar) { return {v.x * scalar, v.y * scalar, v.z * scalar}; }
+
+// 成分ごとの積
+constexpr Vector3 Multiply(const Vector3& v1, const Vector3& v2) { return {v1.x * v2.x, v1.y * v2.y, v1.z * v2.z}; }
+
+// 0 で割るときは零ベクトルを返す
+constexpr Vector3 Divide(const Vector3& v, float scalar) {
+	if (scalar == 0.0f) {
+		return {0.0f, 0.0f, 0.0f};
+	}
+	return {v.x / scalar, v.y / scalar, v.z / scalar};
+}
+
+constexpr float Dot(const Vector3& v1, const Vector3& v2) { return v1.x * v2.x + v1.y * v2.y + v1.z * v2.z; }
+
+constexpr Vector3 Cross(const Vector3& v1, const Vector3& v2) {
+	return {v1.y * v2.z - v1.z * v2.y, v1.z * v2.x - v1.x * v2.z, v1.x * v2.y - v1.y * v2.x};
+}
+
+constexpr float LengthSquared(const Vector3& v) { return v.x * v.x + v.y * v.y + v.z * v.z; }
+
+inline float Length(const Vector3& v) { return std::sqrt(LengthSquared(v)); }
+
+// 長さ 0 のときは零ベクトルを返す
+inline Vector3 Normalize(const Vector3& v) {
+	const float length = Length(v);
+	if (length == 0.0f) {
+		return {0.0f, 0.0f, 0.0f};
+	}
+	return {v.x / length, v.y / length, v.z / length};
+}
+
+// v を axis 上へ射影する（axis の長さが 0 なら結果は NaN。元の Math3D と同じ）
+constexpr Vector3 Project(const Vector3& v, const Vector3& axis) {
+	const float k = Dot(v, axis) / Dot(axis, axis);
+	return Multiply(axis, k);
+}
+
+// normal は単位ベクトル前提
+constexpr Vector3 Reflect(const Vector3& input, const Vector3& normal) {
+	const float d = Dot(input, normal);
+	return {input.x - 2.0f * d * normal.x, input.y - 2.0f * d * normal.y, input.z - 2.0f * d * normal.z};
+}
+
+// 点の座標変換（w 除算あり。w が 0 のときは除算しない）
+constexpr Vector3 Transform(const Vector3& v, const Matrix4x4& m) {
+	const float x = v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0] + 1.0f * m.m[3][0];
+	const float y = v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1] + 1.0f * m.m[3][1];
+	const float z = v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2] + 1.0f * m.m[3][2];
+	float w = v.x * m.m[0][3] + v.y * m.m[1][3] + v.z * m.m[2][3] + 1.0f * m.m[3][3];
+	if (w == 0.0f) {
+		w = 1.0f;
+	}
+	return {x / w, y / w, z / w};
+}
+
+//==================================
+// Matrix4x4
+//==================================
+
+constexpr Matrix4x4 Add(const Matrix4x4& m1, const Matrix4x4& m2) {
+	Matrix4x4 result{};
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = m1.m[i][j] + m2.m[i][j];
+		}
+	}
+	return result;
+}
+
+constexpr Matrix4x4 Subtract(const Matrix4x4& m1, const Matrix4x4& m2) {
+	Matrix4x4 result{};
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = m1.m[i][j] - m2.m[i][j];
+		}
+	}
+	return result;
+}
+
+#if defined(MT4_SSE2)
+// 結果の 1 行 = m1 の行の各要素 × m2 の各行 の和。
+// スカラー版と同じ順序で加算するので結果は一致する（FMA は使わない）
+inline __m128 MultiplyRowSSE2(__m128 row, __m128 b0, __m128 b1, __m128 b2, __m128 b3) {
+	__m128 r = _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_shuffle_ps(row, row, _MM_SHUFFLE(3, 3, 3, 3)), b3));
+	return r;
+}
+
+inline Matrix4x4 MultiplySSE2(const Matrix4x4& m1, const Matrix4x4& m2) {
+	const __m128 b0 = _mm_loadu_ps(m2.m[0]);
+	const __m128 b1 = _mm_loadu_ps(m2.m[1]);
+	const __m128 b2 = _mm_loadu_ps(m2.m[2]);
+	const __m128 b3 = _mm_loadu_ps(m2.m[3]);
+
+	Matrix4x4 result;
+	for (int i = 0; i < 4; ++i) {
+		_mm_storeu_ps(result.m[i], MultiplyRowSSE2(_mm_loadu_ps(m1.m[i]), b0, b1, b2, b3));
+	}
+	return result;
+}
+#endif
+
+// 実行時は SSE2 版、定数式ではスカラー版を使う
+constexpr Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2) {
+#if defined(MT4_SSE2)
+	if (!std::is_constant_evaluated()) {
+		return MultiplySSE2(m1, m2);
+	}
+#endif
+	Matrix4x4 result{};
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = m1.m[i][0] * m2.m[0][j] + m1.m[i][1] * m2.m[1][j] + m1.m[i][2] * m2.m[2][j] + m1.m[i][3] * m2.m[3][j];
+		}
+	}
+	return result;
+}
+
+constexpr Matrix4x4 Transpose(const Matrix4x4& m) {
+	Matrix4x4 result{};
+	for (int i = 0; i < 4; ++i) {
+		for (int j = 0; j < 4; ++j) {
+			result.m[i][j] = m.m[j][i];
+		}
+	}
+	return result;
+}
+
+constexpr Matrix4x4 MakeIdentity() {
+	return {{
+	    {1.0f, 0.0f, 0.0f, 0.0f},
+	    {0.0f, 1.0f, 0.0f, 0.0f},
+	    {0.0f, 0.0f, 1.0f, 0.0f},
+	    {0.0f, 0.0f, 0.0f, 1.0f},
+	}};
+}
+
+constexpr Matrix4x4 MakeTranslate(const Vector3& translate) {
+	return {{
+	    {1.0f, 0.0f, 0.0f, 0.0f},
+	    {0.0f, 1.0f, 0.0f, 0.0f},
+	    {0.0f, 0.0f, 1.0f, 0.0f},
+	    {translate.x, translate.y, translate.z, 1.0f},
+	}};
+}
+
+constexpr Matrix4x4 MakeScale(const Vector3& scale) {
+	return {{
+	    {scale.x, 0.0f, 0.0f, 0.0f},
+	    {0.0f, scale.y, 0.0f, 0.0f},
+	    {0.0f, 0.0f, scale.z, 0.0f},
+	    {0.0f, 0.0f, 0.0f, 1.0f},
+	}};
+}
+
+// W = S * (Rx * Ry * Rz) * T の閉形式。
+// 各軸の sin/cos を 1 回ずつ求め、意味のある 12 要素だけを計算する
+inline Matrix4x4 MakeAffine(const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
+	const float sx = std::sin(rotate.x);
+	const float cx = std::cos(rotate.x);
+	const float sy = std::sin(rotate.y);
+	const float cy = std::cos(rotate.y);
+	const float sz = std::sin(rotate.z);
+	const float cz = std::cos(rotate.z);
+
+	// Ry * Rz の要素に sx / cx を掛ける順にして、行列を掛け合わせる版と結果をそろえる
+	const float sycz = sy * cz;
+	const float sysz = sy * sz;
+
+	return {{
+	    {scale.x * (cy * cz), scale.x * (cy * sz), scale.x * -sy, 0.0f},
+	    {scale.y * (sx * sycz - cx * sz), scale.y * (sx * sysz + cx * cz), scale.y * (sx * cy), 0.0f},
+	    {scale.z * (cx * sycz + sx * sz), scale.z * (cx * sysz - sx * cz), scale.z * (cx * cy), 0.0f},
+	    {translate.x, translate.y, translate.z, 1.0f},
+	}};
+}
+
+} // namespace MathCore
@@ -0,0 +1,34 @@
+#pragma once
+
+//==================================
+// 数学型の定義
+//==================================
+// KamataEngine がある環境ではエンジンの Vector3 / Matrix4x4 をそのまま使い、
+// ない環境（Linux でのベンチマーク等）では同じレイアウトの型をここで定義する。
+// MT4_STANDALONE_MATH を定義するとエンジンがあっても単体版を使う。
+
+#if !defined(MT4_STANDALONE_MATH) && __has_include(<KamataEngine.h>)
+#include <KamataEngine.h>
+#else
+#ifndef MT4_STANDALONE_MATH
+#define MT4_STANDALONE_MATH
+#endif
+
+namespace KamataEngine {
+
+struct Vector3 final {
+	float x;
+	float y;
+	float z;
+};
+
+struct Matrix4x4 final {
+	float m[4][4];
+};
+
+} // namespace KamataEngine
+#endif
+
+// SIMD のロード/ストアで float 配列として扱うため、詰め物が無いことを保証する
+static_assert(sizeof(KamataEngine::Vector3) == sizeof(float) * 3, "Vector3 must be 3 packed floats");
+static_assert(sizeof(KamataEngine::Matrix4x4) == sizeof(float) * 16, "Matrix4x4 must be 16 packed floats");
@@ -0,0 +1,627 @@
+#include "MatrixKernels.h"
+#include "CpuFeatures.h"
+#include "MathCore.h"
+#include "SimdMath.h"
+#include <cmath>
+
+namespace {
+
+//==================================
+// 行列の積
+//==================================
+// bStride は b を 1 要素ずつ進めるなら 1、共通の右辺なら 0
+
+void MultiplyManyScalar(const Matrix4x4* a, const Matrix4x4* b, size_t bStride, Matrix4x4* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		const Matrix4x4& m1 = a[i];
+		const Matrix4x4& m2 = b[i * bStride];
+		Matrix4x4 result;
+		for (int r = 0; r < 4; ++r) {
+			for (int c = 0; c < 4; ++c) {
+				result.m[r][c] = m1.m[r][0] * m2.m[0][c] + m1.m[r][1] * m2.m[1][c] + m1.m[r][2] * m2.m[2][c] + m1.m[r][3] * m2.m[3][c];
+			}
+		}
+		out[i] = result;
+	}
+}
+
+#if defined(MT4_SSE2)
+
+void MultiplyManySSE2(const Matrix4x4* a, const Matrix4x4* b, size_t bStride, Matrix4x4* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		const Matrix4x4& m2 = b[i * bStride];
+		const __m128 b0 = _mm_loadu_ps(m2.m[0]);
+		const __m128 b1 = _mm_loadu_ps(m2.m[1]);
+		const __m128 b2 = _mm_loadu_ps(m2.m[2]);
+		const __m128 b3 = _mm_loadu_ps(m2.m[3]);
+
+		const float* m1 = &a[i].m[0][0];
+		float* dst = &out[i].m[0][0];
+		for (int r = 0; r < 4; ++r) {
+			_mm_storeu_ps(dst + r * 4, MathCore::MultiplyRowSSE2(_mm_loadu_ps(m1 + r * 4), b0, b1, b2, b3));
+		}
+	}
+}
+
+// 2 行分（256bit）をまとめて計算する。
+// rows の上位/下位 128bit がそれぞれ 1 行で、permute で各行の k 列目を 4 つに複製する
+MT4_TARGET_AVX2 inline __m256 MultiplyTwoRowsAVX2(__m256 rows, __m256 b0, __m256 b1, __m256 b2, __m256 b3) {
+	__m256 r = _mm256_mul_ps(_mm256_permute_ps(rows, _MM_SHUFFLE(0, 0, 0, 0)), b0);
+	r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_permute_ps(rows, _MM_SHUFFLE(1, 1, 1, 1)), b1));
+	r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_permute_ps(rows, _MM_SHUFFLE(2, 2, 2, 2)), b2));
+	r = _mm256_add_ps(r, _mm256_mul_ps(_mm256_permute_ps(rows, _MM_SHUFFLE(3, 3, 3, 3)), b3));
+	return r;
+}
+
+MT4_TARGET_AVX2 void MultiplyManyAVX2(const Matrix4x4* a, const Matrix4x4* b, size_t bStride, Matrix4x4* out, size_t n) {
+	for (size_t i = 0; i < n; ++i) {
+		// b の各行を上下両方の 128bit に複製
+		const Matrix4x4& m2 = b[i * bStride];
+		const __m256 b0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[0]));
+		const __m256 b1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[1]));
+		const __m256 b2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[2]));
+		const __m256 b3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(m2.m[3]));
+
+		const float* m1 = &a[i].m[0][0];
+		float* dst = &out[i].m[0][0];
+		_mm256_storeu_ps(dst, MultiplyTwoRowsAVX2(_mm256_loadu_ps(m1), b0, b1, b2, b3));
+		_mm256_storeu_ps(dst + 8, MultiplyTwoRowsAVX2(_mm256_loadu_ps(m1 + 8), b0, b1, b2, b3));
+	}
+}
+
+#endif
+
+void DispatchMultiplyMany(const Matrix4x4* a, const Matrix4x4* b, size_t bStride, Matrix4x4* out, size_t n) {
+	switch (GetSimdLevel()) {
+#if defined(MT4_SSE2)
+	case SimdLevel::AVX2:
+		MultiplyManyAVX2(a, b, bStride, out, n);
+		return;
+	case SimdLevel::SSE2:
+		MultiplyManySSE2(a, b, bStride, out, n);
+		return;
+#endif
+	default:
+		MultiplyManyScalar(a, b, bStride, out, n);
+		return;
+	}
+}
+
+//==================================
+// 逆行列
+//==================================
+// 行列式が行ベクトルの長さの積（Hadamard の上限）に比べて十分小さければ特異とみなす。
+// 絶対値で判定しないので、スケールの小さな行列を誤って特異扱いしない。
+// 長さの 2 乗の積と det の 2 乗は float では簡単にあふれる（スケール 1e4・平行移動 1e7 で 1e56 程度）ので double で比べる
+constexpr double kSingularEpsilon = 1.0e-6;
+
+bool IsSingular(float det, double rowLengthSqProduct) {
+	const double d = static_cast<double>(det);
+	return d * d <= kSingularEpsilon * kSingularEpsilon * rowLengthSqProduct;
+}
+
+// 各行の長さの 2 乗は float で足し（SIMD 版と同じ）、積だけ double で取る
+double RowLengthSqProduct(const Matrix4x4& m, int rows) {
+	double product = 1.0;
+	for (int r = 0; r < rows; ++r) {
+		product *= static_cast<double>(m.m[r][0] * m.m[r][0] + m.m[r][1] * m.m[r][1] + m.m[r][2] * m.m[r][2] + m.m[r][3] * m.m[r][3]);
+	}
+	return product;
+}
+
+// 4 列目が (0,0,0,1) なら行列式は左上 3x3 の行列式に等しく、平行移動の行は特異かどうかに関係しない。
+// その場合は上の 3 行だけで上限を取り、大きな平行移動を持つアフィン行列を特異扱いしない
+bool HasAffineColumn(const Matrix4x4& m) { return m.m[0][3] == 0.0f && m.m[1][3] == 0.0f && m.m[2][3] == 0.0f && m.m[3][3] == 1.0f; }
+
+// 2x2 の小行列式を使った余因子展開。1/det は 1 回だけ計算する
+bool TryInverseScalar(const Matrix4x4& in, Matrix4x4& result) {
+	const float(&a)[4][4] = in.m;
+
+	const float s0 = a[0][0] * a[1][1] - a[1][0] * a[0][1];
+	const float s1 = a[0][0] * a[1][2] - a[1][0] * a[0][2];
+	const float s2 = a[0][0] * a[1][3] - a[1][0] * a[0][3];
+	const float s3 = a[0][1] * a[1][2] - a[1][1] * a[0][2];
+	const float s4 = a[0][1] * a[1][3] - a[1][1] * a[0][3];
+	const float s5 = a[0][2] * a[1][3] - a[1][2] * a[0][3];
+
+	const float c5 = a[2][2] * a[3][3] - a[3][2] * a[2][3];
+	const float c4 = a[2][1] * a[3][3] - a[3][1] * a[2][3];
+	const float c3 = a[2][1] * a[3][2] - a[3][1] * a[2][2];
+	const float c2 = a[2][0] * a[3][3] - a[3][0] * a[2][3];
+	const float c1 = a[2][0] * a[3][2] - a[3][0] * a[2][2];
+	const float c0 = a[2][0] * a[3][1] - a[3][0] * a[2][1];
+
+	const float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+	if (IsSingular(det, RowLengthSqProduct(in, HasAffineColumn(in) ? 3 : 4))) {
+		result = MathCore::MakeIdentity();
+		return false;
+	}
+	const float inv = 1.0f / det;
+
+	Matrix4x4 b;
+	b.m[0][0] = (a[1][1] * c5 - a[1][2] * c4 + a[1][3] * c3) * inv;
+	b.m[0][1] = (-a[0][1] * c5 + a[0][2] * c4 - a[0][3] * c3) * inv;
+	b.m[0][2] = (a[3][1] * s5 - a[3][2] * s4 + a[3][3] * s3) * inv;
+	b.m[0][3] = (-a[2][1] * s5 + a[2][2] * s4 - a[2][3] * s3) * inv;
+
+	b.m[1][0] = (-a[1][0] * c5 + a[1][2] * c2 - a[1][3] * c1) * inv;
+	b.m[1][1] = (a[0][0] * c5 - a[0][2] * c2 + a[0][3] * c1) * inv;
+	b.m[1][2] = (-a[3][0] * s5 + a[3][2] * s2 - a[3][3] * s1) * inv;
+	b.m[1][3] = (a[2][0] * s5 - a[2][2] * s2 + a[2][3] * s1) * inv;
+
+	b.m[2][0] = (a[1][0] * c4 - a[1][1] * c2 + a[1][3] * c0) * inv;
+	b.m[2][1] = (-a[0][0] * c4 + a[0][1] * c2 - a[0][3] * c0) * inv;
+	b.m[2][2] = (a[3][0] * s4 - a[3][1] * s2 + a[3][3] * s0) * inv;
+	b.m[2][3] = (-a[2][0] * s4 + a[2][1] * s2 - a[2][3] * s0) * inv;
+
+	b.m[3][0] = (-a[1][0] * c3 + a[1][1] * c1 - a[1][2] * c0) * inv;
+	b.m[3][1] = (a[0][0] * c3 - a[0][1] * c1 + a[0][2] * c0) * inv;
+	b.m[3][2] = (-a[3][0] * s3 + a[3][1] * s1 - a[3][2] * s0) * inv;
+	b.m[3][3] = (a[2][0] * s3 - a[2][1] * s1 + a[2][2] * s0) * inv;
+
+	result = b;
+	return true;
+}
+
+// 3x3 部分（行 a0, a1, a2）の余因子行列の各行は a1×a2, a2×a0, a0×a1 になる。
+// 逆行列はその転置を det で割ったもの
+float Cofactor3x3(const Matrix4x4& m, float cofactor[3][3]) {
+	const Vector3 a0{m.m[0][0], m.m[0][1], m.m[0][2]};
+	const Vector3 a1{m.m[1][0], m.m[1][1], m.m[1][2]};
+	const Vector3 a2{m.m[2][0], m.m[2][1], m.m[2][2]};
+	const Vector3 rows[3] = {MathCore::Cross(a1, a2), MathCore::Cross(a2, a0), MathCore::Cross(a0, a1)};
+	for (int i = 0; i < 3; ++i) {
+		cofactor[i][0] = rows[i].x;
+		cofactor[i][1] = rows[i].y;
+		cofactor[i][2] = rows[i].z;
+	}
+	return MathCore::Dot(a0, rows[0]);
+}
+
+bool TryInverseAffineScalar(const Matrix4x4& m, Matrix4x4& result) {
+	float c[3][3];
+	const float det = Cofactor3x3(m, c);
+	if (IsSingular(det, RowLengthSqProduct(m, 3))) {
+		result = MathCore::MakeIdentity();
+		return false;
+	}
+	const float inv = 1.0f / det;
+
+	Matrix4x4 r;
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 3; ++j) {
+			r.m[i][j] = c[j][i] * inv;
+		}
+		r.m[i][3] = 0.0f;
+	}
+
+	// 平行移動 t' = -t * A^-1
+	const float tx = m.m[3][0];
+	const float ty = m.m[3][1];
+	const float tz = m.m[3][2];
+	for (int j = 0; j < 3; ++j) {
+		r.m[3][j] = -(tx * r.m[0][j] + ty * r.m[1][j] + tz * r.m[2][j]);
+	}
+	r.m[3][3] = 1.0f;
+
+	result = r;
+	return true;
+}
+
+Matrix4x4 InverseRigidScalar(const Matrix4x4& m) {
+	Matrix4x4 r;
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 3; ++j) {
+			r.m[i][j] = m.m[j][i];
+		}
+		r.m[i][3] = 0.0f;
+	}
+	const float tx = m.m[3][0];
+	const float ty = m.m[3][1];
+	const float tz = m.m[3][2];
+	for (int j = 0; j < 3; ++j) {
+		r.m[3][j] = -(tx * r.m[0][j] + ty * r.m[1][j] + tz * r.m[2][j]);
+	}
+	r.m[3][3] = 1.0f;
+	return r;
+}
+
+Matrix4x4 NormalMatrixScalar(const Matrix4x4& m) {
+	float c[3][3];
+	const float det = Cofactor3x3(m, c);
+	const float inv = IsSingular(det, RowLengthSqProduct(m, 3)) ? 0.0f : 1.0f / det;
+
+	Matrix4x4 r = MathCore::MakeIdentity();
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 3; ++j) {
+			r.m[i][j] = c[i][j] * inv;
+		}
+	}
+	return r;
+}
+
+#if defined(MT4_SSE2)
+
+using SimdMath::HorizontalSum;
+using SimdMath::Shuffle;
+using SimdMath::Swizzle;
+
+// 2x2 行列を (m00, m01, m10, m11) の順で 1 レジスタに持つ
+// A * B
+inline __m128 Mat2Mul(__m128 a, __m128 b) { return _mm_add_ps(_mm_mul_ps(a, Swizzle<0, 3, 0, 3>(b)), _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b))); }
+
+// adj(A) * B
+inline __m128 Mat2AdjMul(__m128 a, __m128 b) { return _mm_sub_ps(_mm_mul_ps(Swizzle<3, 3, 0, 0>(a), b), _mm_mul_ps(Swizzle<1, 1, 2, 2>(a), Swizzle<2, 3, 0, 1>(b))); }
+
+// A * adj(B)
+inline __m128 Mat2MulAdj(__m128 a, __m128 b) { return _mm_sub_ps(_mm_mul_ps(a, Swizzle<3, 0, 3, 0>(b)), _mm_mul_ps(Swizzle<1, 0, 3, 2>(a), Swizzle<2, 1, 2, 1>(b))); }
+
+// 4 行それぞれの長さの 2 乗の積（各行の和は float、積は double）
+inline double RowLengthSqProductSSE2(__m128 r0, __m128 r1, __m128 r2, __m128 r3) {
+	__m128 s0 = _mm_mul_ps(r0, r0);
+	__m128 s1 = _mm_mul_ps(r1, r1);
+	__m128 s2 = _mm_mul_ps(r2, r2);
+	__m128 s3 = _mm_mul_ps(r3, r3);
+	_MM_TRANSPOSE4_PS(s0, s1, s2, s3);
+	const __m128 sums = _mm_add_ps(_mm_add_ps(s0, s1), _mm_add_ps(s2, s3));
+	const __m128d low = _mm_cvtps_pd(sums);
+	const __m128d high = _mm_cvtps_pd(_mm_movehl_ps(sums, sums));
+	const __m128d pair = _mm_mul_pd(low, high);
+	return _mm_cvtsd_f64(_mm_mul_sd(pair, _mm_unpackhi_pd(pair, pair)));
+}
+
+// 2x2 ブロックに分けた余因子法による一般逆行列
+//   M = | A B |   M^-1 = 1/|M| * | X Y |
+//       | C D |                  | Z W |
+bool TryInverseSSE2(const Matrix4x4& in, Matrix4x4& result) {
+	const __m128 r0 = _mm_loadu_ps(in.m[0]);
+	const __m128 r1 = _mm_loadu_ps(in.m[1]);
+	const __m128 r2 = _mm_loadu_ps(in.m[2]);
+	const __m128 r3 = _mm_loadu_ps(in.m[3]);
+
+	const __m128 A = _mm_movelh_ps(r0, r1);
+	const __m128 B = _mm_movehl_ps(r1, r0);
+	const __m128 C = _mm_movelh_ps(r2, r3);
+	const __m128 D = _mm_movehl_ps(r3, r2);
+
+	// (|A|, |B|, |C|, |D|)
+	const __m128 detSub = _mm_sub_ps(_mm_mul_ps(Shuffle<0, 2, 0, 2>(r0, r2), Shuffle<1, 3, 1, 3>(r1, r3)), _mm_mul_ps(Shuffle<1, 3, 1, 3>(r0, r2), Shuffle<0, 2, 0, 2>(r1, r3)));
+	const __m128 detA = Swizzle<0, 0, 0, 0>(detSub);
+	const __m128 detB = Swizzle<1, 1, 1, 1>(detSub);
+	const __m128 detC = Swizzle<2, 2, 2, 2>(detSub);
+	const __m128 detD = Swizzle<3, 3, 3, 3>(detSub);
+
+	const __m128 adjDC = Mat2AdjMul(D, C);
+	const __m128 adjAB = Mat2AdjMul(A, B);
+
+	// adj(X) = |D|A - B adj(D)C,  adj(W) = |A|D - C adj(A)B
+	__m128 X = _mm_sub_ps(_mm_mul_ps(detD, A), Mat2Mul(B, adjDC));
+	__m128 W = _mm_sub_ps(_mm_mul_ps(detA, D), Mat2Mul(C, adjAB));
+	// adj(Y) = |B|C - D adj(adj(A)B),  adj(Z) = |C|B - A adj(adj(D)C)
+	__m128 Y = _mm_sub_ps(_mm_mul_ps(detB, C), Mat2MulAdj(D, adjAB));
+	__m128 Z = _mm_sub_ps(_mm_mul_ps(detC, B), Mat2MulAdj(A, adjDC));
+
+	// |M| = |A||D| + |B||C| - tr(adj(A)B adj(D)C)
+	const float trace = HorizontalSum(_mm_mul_ps(adjAB, Swizzle<0, 2, 1, 3>(adjDC)));
+	const float det = _mm_cvtss_f32(detSub) * _mm_cvtss_f32(detD) + _mm_cvtss_f32(detB) * _mm_cvtss_f32(detC) - trace;
+	const __m128 lastRow = HasAffineColumn(in) ? _mm_setr_ps(1.0f, 0.0f, 0.0f, 0.0f) : r3;
+	if (IsSingular(det, RowLengthSqProductSSE2(r0, r1, r2, lastRow))) {
+		result = MathCore::MakeIdentity();
+		return false;
+	}
+
+	// 余因子の符号をまとめて掛ける (1/|M|, -1/|M|, -1/|M|, 1/|M|)
+	const __m128 invDet = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), _mm_set1_ps(det));
+	X = _mm_mul_ps(X, invDet);
+	Y = _mm_mul_ps(Y, invDet);
+	Z = _mm_mul_ps(Z, invDet);
+	W = _mm_mul_ps(W, invDet);
+
+	// 随伴の並べ替えと格納用の並べ替えを同時に行う
+	_mm_storeu_ps(result.m[0], Shuffle<3, 1, 3, 1>(X, Y));
+	_mm_storeu_ps(result.m[1], Shuffle<2, 0, 2, 0>(X, Y));
+	_mm_storeu_ps(result.m[2], Shuffle<3, 1, 3, 1>(Z, W));
+	_mm_storeu_ps(result.m[3], Shuffle<2, 0, 2, 0>(Z, W));
+	return true;
+}
+
+// (a.y, a.z, a.x) などの並べ替えで外積を計算する（w 成分は 0 になる）
+inline __m128 CrossSSE2(__m128 a, __m128 b) {
+	const __m128 r = _mm_sub_ps(_mm_mul_ps(a, Swizzle<1, 2, 0, 3>(b)), _mm_mul_ps(Swizzle<1, 2, 0, 3>(a), b));
+	return Swizzle<1, 2, 0, 3>(r);
+}
+
+// 3 行の w を 0 にして読み込む
+inline void LoadLinear3x3(const Matrix4x4& m, __m128& a0, __m128& a1, __m128& a2) {
+	const __m128 mask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+	a0 = _mm_and_ps(_mm_loadu_ps(m.m[0]), mask);
+	a1 = _mm_and_ps(_mm_loadu_ps(m.m[1]), mask);
+	a2 = _mm_and_ps(_mm_loadu_ps(m.m[2]), mask);
+}
+
+// 行 r0..r2 を持つ線形部分と元の平行移動から t' = -t * R を計算して格納する
+inline void StoreAffine(const Matrix4x4& m, __m128 r0, __m128 r1, __m128 r2, Matrix4x4& result) {
+	__m128 t = _mm_mul_ps(_mm_set1_ps(m.m[3][0]), r0);
+	t = _mm_add_ps(t, _mm_mul_ps(_mm_set1_ps(m.m[3][1]), r1));
+	t = _mm_add_ps(t, _mm_mul_ps(_mm_set1_ps(m.m[3][2]), r2));
+	// w は 0 なので、符号反転後に 1 を足す
+	t = _mm_add_ps(_mm_sub_ps(_mm_setzero_ps(), t), _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+
+	_mm_storeu_ps(result.m[0], r0);
+	_mm_storeu_ps(result.m[1], r1);
+	_mm_storeu_ps(result.m[2], r2);
+	_mm_storeu_ps(result.m[3], t);
+}
+
+bool TryInverseAffineSSE2(const Matrix4x4& m, Matrix4x4& result) {
+	__m128 a0, a1, a2;
+	LoadLinear3x3(m, a0, a1, a2);
+
+	__m128 c0 = CrossSSE2(a1, a2);
+	__m128 c1 = CrossSSE2(a2, a0);
+	__m128 c2 = CrossSSE2(a0, a1);
+	const float det = HorizontalSum(_mm_mul_ps(a0, c0));
+	if (IsSingular(det, RowLengthSqProductSSE2(a0, a1, a2, _mm_setr_ps(1.0f, 0.0f, 0.0f, 0.0f)))) {
+		result = MathCore::MakeIdentity();
+		return false;
+	}
+
+	// 余因子行列を転置すると A^-1 * det の各行になる
+	const __m128 invDet = _mm_set1_ps(1.0f / det);
+	__m128 c3 = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+	StoreAffine(m, _mm_mul_ps(c0, invDet), _mm_mul_ps(c1, invDet), _mm_mul_ps(c2, invDet), result);
+	return true;
+}
+
+Matrix4x4 InverseRigidSSE2(const Matrix4x4& m) {
+	__m128 a0, a1, a2;
+	LoadLinear3x3(m, a0, a1, a2);
+	__m128 a3 = _mm_setzero_ps();
+	_MM_TRANSPOSE4_PS(a0, a1, a2, a3);
+
+	Matrix4x4 result;
+	StoreAffine(m, a0, a1, a2, result);
+	return result;
+}
+
+Matrix4x4 NormalMatrixSSE2(const Matrix4x4& m) {
+	__m128 a0, a1, a2;
+	LoadLinear3x3(m, a0, a1, a2);
+
+	const __m128 c0 = CrossSSE2(a1, a2);
+	const __m128 c1 = CrossSSE2(a2, a0);
+	const __m128 c2 = CrossSSE2(a0, a1);
+	const float det = HorizontalSum(_mm_mul_ps(a0, c0));
+	const __m128 invDet = _mm_set1_ps(IsSingular(det, RowLengthSqProductSSE2(a0, a1, a2, _mm_setr_ps(1.0f, 0.0f, 0.0f, 0.0f))) ? 0.0f : 1.0f / det);
+
+	Matrix4x4 result;
+	_mm_storeu_ps(result.m[0], _mm_mul_ps(c0, invDet));
+	_mm_storeu_ps(result.m[1], _mm_mul_ps(c1, invDet));
+	_mm_storeu_ps(result.m[2], _mm_mul_ps(c2, invDet));
+	_mm_storeu_ps(result.m[3], _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f));
+	return result;
+}
+
+#endif
+
+//==================================
+// アフィン行列の生成
+//==================================
+
+#if defined(MT4_SSE2)
+
+// 4 つの Transform（SoA）から 4 つのアフィン行列を作って out[0..3] に格納する
+void MakeAffine4SSE2(const __m128 scale[3], const __m128 rotate[3], const __m128 translate[3], Matrix4x4* out) {
+	__m128 sx, cx, sy, cy, sz, cz;
+	SimdMath::SinCos(rotate[0], sx, cx);
+	SimdMath::SinCos(rotate[1], sy, cy);
+	SimdMath::SinCos(rotate[2], sz, cz);
+
+	// MathCore::MakeAffine と同じく Ry * Rz の要素に sx / cx を掛ける
+	const __m128 sycz = _mm_mul_ps(sy, cz);
+	const __m128 sysz = _mm_mul_ps(sy, sz);
+
+	// 各行列の同じ要素が 1 レジスタに並んでいる
+	__m128 r00 = _mm_mul_ps(scale[0], _mm_mul_ps(cy, cz));
+	__m128 r01 = _mm_mul_ps(scale[0], _mm_mul_ps(cy, sz));
+	__m128 r02 = _mm_mul_ps(scale[0], _mm_sub_ps(_mm_setzero_ps(), sy));
+	__m128 r10 = _mm_mul_ps(scale[1], _mm_sub_ps(_mm_mul_ps(sx, sycz), _mm_mul_ps(cx, sz)));
+	__m128 r11 = _mm_mul_ps(scale[1], _mm_add_ps(_mm_mul_ps(sx, sysz), _mm_mul_ps(cx, cz)));
+	__m128 r12 = _mm_mul_ps(scale[1], _mm_mul_ps(sx, cy));
+	__m128 r20 = _mm_mul_ps(scale[2], _mm_add_ps(_mm_mul_ps(cx, sycz), _mm_mul_ps(sx, sz)));
+	__m128 r21 = _mm_mul_ps(scale[2], _mm_sub_ps(_mm_mul_ps(cx, sysz), _mm_mul_ps(sx, cz)));
+	__m128 r22 = _mm_mul_ps(scale[2], _mm_mul_ps(cx, cy));
+	__m128 tx = translate[0];
+	__m128 ty = translate[1];
+	__m128 tz = translate[2];
+
+	// SoA → AoS：転置すると行列ごとの 1 行になる
+	__m128 zero0 = _mm_setzero_ps();
+	__m128 zero1 = _mm_setzero_ps();
+	__m128 zero2 = _mm_setzero_ps();
+	__m128 one = _mm_set1_ps(1.0f);
+	_MM_TRANSPOSE4_PS(r00, r01, r02, zero0);
+	_MM_TRANSPOSE4_PS(r10, r11, r12, zero1);
+	_MM_TRANSPOSE4_PS(r20, r21, r22, zero2);
+	_MM_TRANSPOSE4_PS(tx, ty, tz, one);
+
+	const __m128 row0[4] = {r00, r01, r02, zero0};
+	const __m128 row1[4] = {r10, r11, r12, zero1};
+	const __m128 row2[4] = {r20, r21, r22, zero2};
+	const __m128 row3[4] = {tx, ty, tz, one};
+	for (int k = 0; k < 4; ++k) {
+		_mm_storeu_ps(out[k].m[0], row0[k]);
+		_mm_storeu_ps(out[k].m[1], row1[k]);
+		_mm_storeu_ps(out[k].m[2], row2[k]);
+		_mm_storeu_ps(out[k].m[3], row3[k]);
+	}
+}
+
+// AoS の Transform から 1 成分を 4 つ集める
+inline __m128 Gather4(const Transform* t, const Vector3 Transform::*member, int axis) {
+	auto component = [&](int k) {
+		const Vector3& v = t[k].*member;
+		return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+	};
+	return _mm_setr_ps(component(0), component(1), component(2), component(3));
+}
+
+#endif
+
+// バッチ版は 1 行列ずつ SIMD で処理する（要素間に依存が無いので AVX2 でも同じ経路）
+bool UseSimd() {
+#if defined(MT4_SSE2)
+	return GetSimdLevel() != SimdLevel::Scalar;
+#else
+	return false;
+#endif
+}
+
+} // namespace
+
+void MultiplyMany(const Matrix4x4* a, const Matrix4x4* b, Matrix4x4* out, size_t n) { DispatchMultiplyMany(a, b, 1, out, n); }
+
+void MultiplyMany(const Matrix4x4* a, const Matrix4x4& b, Matrix4x4* out, size_t n) { DispatchMultiplyMany(a, &b, 0, out, n); }
+
+bool TryInverse(const Matrix4x4& m, Matrix4x4& result) {
+#if defined(MT4_SSE2)
+	return TryInverseSSE2(m, result);
+#else
+	return TryInverseScalar(m, result);
+#endif
+}
+
+Matrix4x4 InverseAffine(const Matrix4x4& m) {
+	Matrix4x4 result;
+#if defined(MT4_SSE2)
+	TryInverseAffineSSE2(m, result);
+#else
+	TryInverseAffineScalar(m, result);
+#endif
+	return result;
+}
+
+Matrix4x4 InverseRigid(const Matrix4x4& m) {
+#if defined(MT4_SSE2)
+	return InverseRigidSSE2(m);
+#else
+	return InverseRigidScalar(m);
+#endif
+}
+
+Matrix4x4 MakeNormalMatrix(const Matrix4x4& world) {
+#if defined(MT4_SSE2)
+	return NormalMatrixSSE2(world);
+#else
+	return NormalMatrixScalar(world);
+#endif
+}
+
+size_t InverseMany(const Matrix4x4* in, Matrix4x4* out, size_t n) {
+	size_t singularCount = 0;
+	if (UseSimd()) {
+#if defined(MT4_SSE2)
+		for (size_t i = 0; i < n; ++i) {
+			singularCount += TryInverseSSE2(in[i], out[i]) ? 0 : 1;
+		}
+#endif
+	} else {
+		for (size_t i = 0; i < n; ++i) {
+			singularCount += TryInverseScalar(in[i], out[i]) ? 0 : 1;
+		}
+	}
+	return singularCount;
+}
+
+size_t InverseAffineMany(const Matrix4x4* in, Matrix4x4* out, size_t n) {
+	size_t singularCount = 0;
+	if (UseSimd()) {
+#if defined(MT4_SSE2)
+		for (size_t i = 0; i < n; ++i) {
+			singularCount += TryInverseAffineSSE2(in[i], out[i]) ? 0 : 1;
+		}
+#endif
+	} else {
+		for (size_t i = 0; i < n; ++i) {
+			singularCount += TryInverseAffineScalar(in[i], out[i]) ? 0 : 1;
+		}
+	}
+	return singularCount;
+}
+
+void InverseRigidMany(const Matrix4x4* in, Matrix4x4* out, size_t n) {
+	if (UseSimd()) {
+#if defined(MT4_SSE2)
+		for (size_t i = 0; i < n; ++i) {
+			out[i] = InverseRigidSSE2(in[i]);
+		}
+#endif
+	} else {
+		for (size_t i = 0; i < n; ++i) {
+			out[i] = InverseRigidScalar(in[i]);
+		}
+	}
+}
+
+void MakeNormalMatrices(const Matrix4x4* world, Matrix4x4* out, size_t n) {
+	if (UseSimd()) {
+#if defined(MT4_SSE2)
+		for (size_t i = 0; i < n; ++i) {
+			out[i] = NormalMatrixSSE2(world[i]);
+		}
+#endif
+	} else {
+		for (size_t i = 0; i < n; ++i) {
+			out[i] = NormalMatrixScalar(world[i]);
+		}
+	}
+}
+
+void MakeAffineMatrices(const Transform* transforms, Matrix4x4* out, size_t n) {
+	size_t i = 0;
+#if defined(MT4_SSE2)
+	if (UseSimd()) {
+		for (; i + 4 <= n; i += 4) {
+			const Transform* t = transforms + i;
+			__m128 scale[3], rotate[3], translate[3];
+			for (int axis = 0; axis < 3; ++axis) {
+				scale[axis] = Gather4(t, &Transform::scale, axis);
+				rotate[axis] = Gather4(t, &Transform::rotation, axis);
+				translate[axis] = Gather4(t, &Transform::translation, axis);
+			}
+			MakeAffine4SSE2(scale, rotate, translate, out + i);
+		}
+	}
+#endif
+	for (; i < n; ++i) {
+		out[i] = MathCore::MakeAffine(transforms[i].scale, transforms[i].rotation, transforms[i].translation);
+	}
+}
+
+void MakeAffineMatrices(const TransformSoA& transforms, Matrix4x4* out, size_t n) {
+	const float* const scaleSrc[3] = {transforms.scaleX, transforms.scaleY, transforms.scaleZ};
+	const float* const rotateSrc[3] = {transforms.rotationX, transforms.rotationY, transforms.rotationZ};
+	const float* const translateSrc[3] = {transforms.translationX, transforms.translationY, transforms.translationZ};
+
+	size_t i = 0;
+#if defined(MT4_SSE2)
+	if (UseSimd()) {
+		for (; i + 4 <= n; i += 4) {
+			__m128 scale[3], rotate[3], translate[3];
+			for (int axis = 0; axis < 3; ++axis) {
+				scale[axis] = _mm_loadu_ps(scaleSrc[axis] + i);
+				rotate[axis] = _mm_loadu_ps(rotateSrc[axis] + i);
+				translate[axis] = _mm_loadu_ps(translateSrc[axis] + i);
+			}
+			MakeAffine4SSE2(scale, rotate, translate, out + i);
+		}
+	}
+#endif
+	for (; i < n; ++i) {
+		const Vector3 scale{scaleSrc[0][i], scaleSrc[1][i], scaleSrc[2][i]};
+		const Vector3 rotate{rotateSrc[0][i], rotateSrc[1][i], rotateSrc[2][i]};
+		const Vector3 translate{translateSrc[0][i], translateSrc[1][i], translateSrc[2][i]};
+		out[i] = MathCore::MakeAffine(scale, rotate, translate);
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "MathTypes.h"
+#include "struct.h"
+#include <cstddef>
+
+using namespace KamataEngine;
+
+//==================================
+// 行列のバッチ処理
+//==================================
+// シーン全体の行列をまとめて処理する関数群。
+// 実装は CPUID で判定した命令セット（AVX2 / SSE2 / スカラー）から実行時に選ばれる。
+// どの実装も FMA を使わずスカラー版と同じ順序で加算するので結果は一致する。
+
+// out[i] = a[i] * b[i]
+// out は a や b と同じ配列でもよい（要素単位で読み終えてから書き込む）
+void MultiplyMany(const Matrix4x4* a, const Matrix4x4* b, Matrix4x4* out, size_t n);
+
+// out[i] = a[i] * b（world * viewProjection のように右辺が共通の場合）
+// b は out の要素と重ならないこと
+void MultiplyMany(const Matrix4x4* a, const Matrix4x4& b, Matrix4x4* out, size_t n);
+
+//==================================
+// 逆行列
+//==================================
+// 行列式が各行の長さの積に比べて十分小さい（相対 1e-6 以下）ものを特異とみなす。
+// 4 列目が (0,0,0,1) の行列は、平行移動の行を除いた上の 3 行の長さで比べる。
+// 特異な場合は result に単位行列を入れて false を返す
+
+// 一般の 4x4 逆行列（2x2 ブロックの余因子法、SIMD）
+bool TryInverse(const Matrix4x4& m, Matrix4x4& result);
+
+// アフィン行列（4 列目が (0,0,0,1)）の逆行列。特異なら単位行列
+Matrix4x4 InverseAffine(const Matrix4x4& m);
+
+// 回転と平行移動だけの行列の逆行列（回転の転置 + 平行移動の反転）。
+// 拡大縮小を含む行列には使えない
+Matrix4x4 InverseRigid(const Matrix4x4& m);
+
+// 法線変換用行列（3x3 部分の逆転置、平行移動は 0）
+Matrix4x4 MakeNormalMatrix(const Matrix4x4& world);
+
+// バッチ版。out は in と同じ配列でもよい。戻り値は特異だった行列の数
+size_t InverseMany(const Matrix4x4* in, Matrix4x4* out, size_t n);
+size_t InverseAffineMany(const Matrix4x4* in, Matrix4x4* out, size_t n);
+
+// カメラのワールド行列からビュー行列をまとめて作る用途など
+void InverseRigidMany(const Matrix4x4* in, Matrix4x4* out, size_t n);
+
+void MakeNormalMatrices(const Matrix4x4* world, Matrix4x4* out, size_t n);
+
+//==================================
+// アフィン行列の生成
+//==================================
+// MakeAffineMatrix と同じ W = S * (Rx * Ry * Rz) * T を 4 つずつ SIMD で作る。
+// sin/cos は多項式近似なので MakeAffineMatrix とは数 ulp 異なることがある
+
+// SoA 形式の Transform 列（各配列は n 要素）
+struct TransformSoA {
+	const float* scaleX;
+	const float* scaleY;
+	const float* scaleZ;
+	const float* rotationX;
+	const float* rotationY;
+	const float* rotationZ;
+	const float* translationX;
+	const float* translationY;
+	const float* translationZ;
+};
+
+void MakeAffineMatrices(const Transform* transforms, Matrix4x4* out, size_t n);
+
+void MakeAffineMatrices(const TransformSoA& transforms, Matrix4x4* out, size_t n);
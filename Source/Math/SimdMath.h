@@ -0,0 +1,195 @@
+#pragma once
+#include "CpuFeatures.h"
+
+//==================================
+// SIMD 用の補助関数と超越関数
+//==================================
+// SinCos は Cephes の sinf/cosf と同じ多項式を 4 要素まとめて評価する。
+// |x| が数千ラジアン程度までは std::sin / std::cos と 2ulp 程度で一致する。
+// Acos も Cephes の asinf の多項式を使う。
+// __m256 版は AVX2 対応の CPU でのみ呼び出すこと（MT4_TARGET_AVX2 の関数から使う）。
+
+#if defined(MT4_SSE2)
+
+namespace SimdMath {
+
+// 要素の並べ替え。Swizzle<X, Y, Z, W>(v) = (v[X], v[Y], v[Z], v[W])
+template <int X, int Y, int Z, int W> inline __m128 Swizzle(__m128 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(W, Z, Y, X)); }
+
+// Shuffle<X, Y, Z, W>(a, b) = (a[X], a[Y], b[Z], b[W])
+template <int X, int Y, int Z, int W> inline __m128 Shuffle(__m128 a, __m128 b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X)); }
+
+inline float HorizontalSum(__m128 v) {
+	const __m128 pair = _mm_add_ps(v, Swizzle<2, 3, 0, 1>(v));
+	return _mm_cvtss_f32(_mm_add_ss(pair, Swizzle<1, 0, 3, 2>(pair)));
+}
+
+// Vector3 4 つ分（float 12 個の AoS）を x, y, z の SoA に並べ替えて読み込む
+inline void LoadVector3x4(const float* p, __m128& x, __m128& y, __m128& z) {
+	const __m128 a = _mm_loadu_ps(p);     // x0 y0 z0 x1
+	const __m128 b = _mm_loadu_ps(p + 4); // y1 z1 x2 y2
+	const __m128 c = _mm_loadu_ps(p + 8); // z2 x3 y3 z3
+	x = Shuffle<0, 1, 0, 2>(Swizzle<0, 3, 0, 3>(a), Shuffle<2, 2, 1, 1>(b, c));
+	y = Shuffle<0, 2, 0, 2>(Shuffle<1, 1, 0, 0>(a, b), Shuffle<3, 3, 2, 2>(b, c));
+	z = Shuffle<0, 2, 0, 2>(Shuffle<2, 2, 1, 1>(a, b), Swizzle<0, 0, 3, 3>(c));
+}
+
+// LoadVector3x4 の逆
+inline void StoreVector3x4(float* p, __m128 x, __m128 y, __m128 z) {
+	_mm_storeu_ps(p, Shuffle<0, 2, 0, 2>(Shuffle<0, 0, 0, 0>(x, y), Shuffle<0, 0, 1, 1>(z, x)));
+	_mm_storeu_ps(p + 4, Shuffle<0, 2, 0, 2>(Shuffle<1, 1, 1, 1>(y, z), Shuffle<2, 2, 2, 2>(x, y)));
+	_mm_storeu_ps(p + 8, Shuffle<0, 2, 0, 2>(Shuffle<2, 2, 3, 3>(z, x), Shuffle<3, 3, 3, 3>(y, z)));
+}
+
+inline __m128 Abs(__m128 v) { return _mm_and_ps(v, _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF))); }
+
+// mask のビットが立っている要素は a、それ以外は b
+inline __m128 Select(__m128 mask, __m128 a, __m128 b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+
+inline void SinCos(__m128 x, __m128& outSin, __m128& outCos) {
+	const __m128 signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000u)));
+
+	__m128 signSin = _mm_and_ps(x, signMask);
+	x = Abs(x);
+
+	// π/4 単位の象限番号（偶数に切り上げ）
+	__m128i quadrant = _mm_cvttps_epi32(_mm_mul_ps(x, _mm_set1_ps(1.27323954473516f)));
+	quadrant = _mm_add_epi32(quadrant, _mm_set1_epi32(1));
+	quadrant = _mm_and_si128(quadrant, _mm_set1_epi32(~1));
+	const __m128 y = _mm_cvtepi32_ps(quadrant);
+
+	const __m128 swapSignSin = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(4)), 29));
+	const __m128 signCos = _mm_castsi128_ps(_mm_slli_epi32(_mm_andnot_si128(_mm_sub_epi32(quadrant, _mm_set1_epi32(2)), _mm_set1_epi32(4)), 29));
+	// 象限によって sin と cos の多項式を入れ替える
+	const __m128 polyMask = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(quadrant, _mm_set1_epi32(2)), _mm_setzero_si128()));
+	signSin = _mm_xor_ps(signSin, swapSignSin);
+
+	// 拡張精度で x - y*π/4
+	x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(0.78515625f)));
+	x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(2.4187564849853515625e-4f)));
+	x = _mm_sub_ps(x, _mm_mul_ps(y, _mm_set1_ps(3.77489497744594108e-8f)));
+
+	const __m128 z = _mm_mul_ps(x, x);
+
+	__m128 cosPoly = _mm_set1_ps(2.443315711809948e-5f);
+	cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, z), _mm_set1_ps(-1.388731625493765e-3f));
+	cosPoly = _mm_add_ps(_mm_mul_ps(cosPoly, z), _mm_set1_ps(4.166664568298827e-2f));
+	cosPoly = _mm_mul_ps(_mm_mul_ps(cosPoly, z), z);
+	cosPoly = _mm_sub_ps(cosPoly, _mm_mul_ps(z, _mm_set1_ps(0.5f)));
+	cosPoly = _mm_add_ps(cosPoly, _mm_set1_ps(1.0f));
+
+	__m128 sinPoly = _mm_set1_ps(-1.9515295891e-4f);
+	sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, z), _mm_set1_ps(8.3321608736e-3f));
+	sinPoly = _mm_add_ps(_mm_mul_ps(sinPoly, z), _mm_set1_ps(-1.6666654611e-1f));
+	sinPoly = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(sinPoly, z), x), x);
+
+	outSin = _mm_xor_ps(Select(polyMask, sinPoly, cosPoly), signSin);
+	outCos = _mm_xor_ps(Select(polyMask, cosPoly, sinPoly), signCos);
+}
+
+// |a| <= 0.5 での asin(a)
+inline __m128 AsinPoly(__m128 a) {
+	const __m128 z = _mm_mul_ps(a, a);
+	__m128 p = _mm_set1_ps(4.2163199048e-2f);
+	p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(2.4181311049e-2f));
+	p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(4.5470025998e-2f));
+	p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(7.4953002686e-2f));
+	p = _mm_add_ps(_mm_mul_ps(p, z), _mm_set1_ps(1.6666752422e-1f));
+	return _mm_add_ps(_mm_mul_ps(_mm_mul_ps(p, z), a), a);
+}
+
+// x は [-1, 1] にクランプ済みであること
+inline __m128 Acos(__m128 x) {
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 a = Abs(x);
+	const __m128 negative = _mm_cmplt_ps(x, _mm_setzero_ps());
+	const __m128 large = _mm_cmpgt_ps(a, half);
+
+	// |x| > 0.5 は acos(|x|) = 2 asin(sqrt((1 - |x|) / 2)) を使う
+	const __m128 s = Select(large, _mm_sqrt_ps(_mm_mul_ps(half, _mm_sub_ps(_mm_set1_ps(1.0f), a))), a);
+	const __m128 p = AsinPoly(s);
+
+	const __m128 pi = _mm_set1_ps(3.14159265358979f);
+	const __m128 halfPi = _mm_set1_ps(1.57079632679490f);
+	const __m128 twoP = _mm_add_ps(p, p);
+	const __m128 largeResult = Select(negative, _mm_sub_ps(pi, twoP), twoP);
+	const __m128 smallResult = Select(negative, _mm_add_ps(halfPi, p), _mm_sub_ps(halfPi, p));
+	return Select(large, largeResult, smallResult);
+}
+
+//==================================
+// AVX2 版（8 要素）
+//==================================
+
+MT4_TARGET_AVX2 inline __m256 Abs(__m256 v) { return _mm256_and_ps(v, _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF))); }
+
+MT4_TARGET_AVX2 inline __m256 Select(__m256 mask, __m256 a, __m256 b) { return _mm256_blendv_ps(b, a, mask); }
+
+MT4_TARGET_AVX2 inline void SinCos(__m256 x, __m256& outSin, __m256& outCos) {
+	const __m256 signMask = _mm256_castsi256_ps(_mm256_set1_epi32(static_cast<int>(0x80000000u)));
+
+	__m256 signSin = _mm256_and_ps(x, signMask);
+	x = Abs(x);
+
+	__m256i quadrant = _mm256_cvttps_epi32(_mm256_mul_ps(x, _mm256_set1_ps(1.27323954473516f)));
+	quadrant = _mm256_add_epi32(quadrant, _mm256_set1_epi32(1));
+	quadrant = _mm256_and_si256(quadrant, _mm256_set1_epi32(~1));
+	const __m256 y = _mm256_cvtepi32_ps(quadrant);
+
+	const __m256 swapSignSin = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_and_si256(quadrant, _mm256_set1_epi32(4)), 29));
+	const __m256 signCos = _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_andnot_si256(_mm256_sub_epi32(quadrant, _mm256_set1_epi32(2)), _mm256_set1_epi32(4)), 29));
+	const __m256 polyMask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_and_si256(quadrant, _mm256_set1_epi32(2)), _mm256_setzero_si256()));
+	signSin = _mm256_xor_ps(signSin, swapSignSin);
+
+	x = _mm256_sub_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(0.78515625f)));
+	x = _mm256_sub_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(2.4187564849853515625e-4f)));
+	x = _mm256_sub_ps(x, _mm256_mul_ps(y, _mm256_set1_ps(3.77489497744594108e-8f)));
+
+	const __m256 z = _mm256_mul_ps(x, x);
+
+	__m256 cosPoly = _mm256_set1_ps(2.443315711809948e-5f);
+	cosPoly = _mm256_add_ps(_mm256_mul_ps(cosPoly, z), _mm256_set1_ps(-1.388731625493765e-3f));
+	cosPoly = _mm256_add_ps(_mm256_mul_ps(cosPoly, z), _mm256_set1_ps(4.166664568298827e-2f));
+	cosPoly = _mm256_mul_ps(_mm256_mul_ps(cosPoly, z), z);
+	cosPoly = _mm256_sub_ps(cosPoly, _mm256_mul_ps(z, _mm256_set1_ps(0.5f)));
+	cosPoly = _mm256_add_ps(cosPoly, _mm256_set1_ps(1.0f));
+
+	__m256 sinPoly = _mm256_set1_ps(-1.9515295891e-4f);
+	sinPoly = _mm256_add_ps(_mm256_mul_ps(sinPoly, z), _mm256_set1_ps(8.3321608736e-3f));
+	sinPoly = _mm256_add_ps(_mm256_mul_ps(sinPoly, z), _mm256_set1_ps(-1.6666654611e-1f));
+	sinPoly = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(sinPoly, z), x), x);
+
+	outSin = _mm256_xor_ps(Select(polyMask, sinPoly, cosPoly), signSin);
+	outCos = _mm256_xor_ps(Select(polyMask, cosPoly, sinPoly), signCos);
+}
+
+MT4_TARGET_AVX2 inline __m256 AsinPoly(__m256 a) {
+	const __m256 z = _mm256_mul_ps(a, a);
+	__m256 p = _mm256_set1_ps(4.2163199048e-2f);
+	p = _mm256_add_ps(_mm256_mul_ps(p, z), _mm256_set1_ps(2.4181311049e-2f));
+	p = _mm256_add_ps(_mm256_mul_ps(p, z), _mm256_set1_ps(4.5470025998e-2f));
+	p = _mm256_add_ps(_mm256_mul_ps(p, z), _mm256_set1_ps(7.4953002686e-2f));
+	p = _mm256_add_ps(_mm256_mul_ps(p, z), _mm256_set1_ps(1.6666752422e-1f));
+	return _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(p, z), a), a);
+}
+
+MT4_TARGET_AVX2 inline __m256 Acos(__m256 x) {
+	const __m256 half = _mm256_set1_ps(0.5f);
+	const __m256 a = Abs(x);
+	const __m256 negative = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ);
+	const __m256 large = _mm256_cmp_ps(a, half, _CMP_GT_OQ);
+
+	const __m256 s = Select(large, _mm256_sqrt_ps(_mm256_mul_ps(half, _mm256_sub_ps(_mm256_set1_ps(1.0f), a))), a);
+	const __m256 p = AsinPoly(s);
+
+	const __m256 pi = _mm256_set1_ps(3.14159265358979f);
+	const __m256 halfPi = _mm256_set1_ps(1.57079632679490f);
+	const __m256 twoP = _mm256_add_ps(p, p);
+	const __m256 largeResult = Select(negative, _mm256_sub_ps(pi, twoP), twoP);
+	const __m256 smallResult = Select(negative, _mm256_add_ps(halfPi, p), _mm256_sub_ps(halfPi, p));
+	return Select(large, largeResult, smallResult);
+}
+
+} // namespace SimdMath
+
+#endif
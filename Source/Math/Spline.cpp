@@ -0,0 +1,224 @@
+#include "Spline.h"
+#include "MathCore.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// w0 * p0 + w1 * p1 + w2 * p2 + w3 * p3
+Vector3 Combine(float w0, const Vector3& p0, float w1, const Vector3& p1, float w2, const Vector3& p2, float w3, const Vector3& p3) {
+	return {
+	    w0 * p0.x + w1 * p1.x + w2 * p2.x + w3 * p3.x,
+	    w0 * p0.y + w1 * p1.y + w2 * p2.y + w3 * p3.y,
+	    w0 * p0.z + w1 * p1.z + w2 * p2.z + w3 * p3.z,
+	};
+}
+
+} // namespace
+
+//==================================
+// 3 次曲線の 1 区間
+//==================================
+
+CubicSegment CubicSegment::Bezier(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3) {
+	return {
+	    Combine(-1.0f, p0, 3.0f, p1, -3.0f, p2, 1.0f, p3),
+	    Combine(3.0f, p0, -6.0f, p1, 3.0f, p2, 0.0f, p3),
+	    Combine(-3.0f, p0, 3.0f, p1, 0.0f, p2, 0.0f, p3),
+	    p0,
+	};
+}
+
+CubicSegment CubicSegment::CatmullRom(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3) {
+	return {
+	    Combine(-0.5f, p0, 1.5f, p1, -1.5f, p2, 0.5f, p3),
+	    Combine(1.0f, p0, -2.5f, p1, 2.0f, p2, -0.5f, p3),
+	    Combine(-0.5f, p0, 0.0f, p1, 0.5f, p2, 0.0f, p3),
+	    p1,
+	};
+}
+
+CubicSegment CubicSegment::BSpline(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3) {
+	constexpr float k = 1.0f / 6.0f;
+	return {
+	    Combine(-k, p0, 3.0f * k, p1, -3.0f * k, p2, k, p3),
+	    Combine(3.0f * k, p0, -6.0f * k, p1, 3.0f * k, p2, 0.0f, p3),
+	    Combine(-3.0f * k, p0, 0.0f, p1, 3.0f * k, p2, 0.0f, p3),
+	    Combine(k, p0, 4.0f * k, p1, k, p2, 0.0f, p3),
+	};
+}
+
+Vector3 CubicSegment::Evaluate(float t) const {
+	return {
+	    ((a.x * t + b.x) * t + c.x) * t + d.x,
+	    ((a.y * t + b.y) * t + c.y) * t + d.y,
+	    ((a.z * t + b.z) * t + c.z) * t + d.z,
+	};
+}
+
+Vector3 CubicSegment::Derivative(float t) const {
+	return {
+	    (3.0f * a.x * t + 2.0f * b.x) * t + c.x,
+	    (3.0f * a.y * t + 2.0f * b.y) * t + c.y,
+	    (3.0f * a.z * t + 2.0f * b.z) * t + c.z,
+	};
+}
+
+// 刻み h の 1 階〜3 階の差分は
+//   d1 = a h^3 + b h^2 + c h,  d2 = 6 a h^3 + 2 b h^2,  d3 = 6 a h^3
+// で、p += d1, d1 += d2, d2 += d3 を繰り返すと次の点になる
+void CubicSegment::Tessellate(Vector3* out, size_t count) const {
+	if (count == 0) {
+		return;
+	}
+	out[0] = d;
+	if (count == 1) {
+		return;
+	}
+	const float h = 1.0f / static_cast<float>(count - 1);
+	const float h2 = h * h;
+	const float h3 = h2 * h;
+
+	Vector3 p = d;
+	Vector3 d1 = {a.x * h3 + b.x * h2 + c.x * h, a.y * h3 + b.y * h2 + c.y * h, a.z * h3 + b.z * h2 + c.z * h};
+	Vector3 d2 = {6.0f * a.x * h3 + 2.0f * b.x * h2, 6.0f * a.y * h3 + 2.0f * b.y * h2, 6.0f * a.z * h3 + 2.0f * b.z * h2};
+	const Vector3 d3 = {6.0f * a.x * h3, 6.0f * a.y * h3, 6.0f * a.z * h3};
+	for (size_t i = 1; i + 1 < count; ++i) {
+		p = MathCore::Add(p, d1);
+		d1 = MathCore::Add(d1, d2);
+		d2 = MathCore::Add(d2, d3);
+		out[i] = p;
+	}
+	out[count - 1] = {a.x + b.x + c.x + d.x, a.y + b.y + c.y + d.y, a.z + b.z + c.z + d.z};
+}
+
+//==================================
+// スプライン曲線
+//==================================
+
+Spline::Spline(SplineType type, const std::vector<Vector3>& points) { SetPoints(type, points); }
+
+void Spline::SetPoints(SplineType type, const std::vector<Vector3>& points) {
+	type_ = type;
+	segments_.clear();
+	distanceToParameter_.clear();
+	length_ = 0.0f;
+
+	const size_t count = points.size();
+	if (type == SplineType::Bezier) {
+		for (size_t i = 0; i + 3 < count; i += 3) {
+			segments_.push_back(CubicSegment::Bezier(points[i], points[i + 1], points[i + 2], points[i + 3]));
+		}
+		return;
+	}
+	for (size_t i = 0; i + 3 < count; ++i) {
+		if (type == SplineType::CatmullRom) {
+			segments_.push_back(CubicSegment::CatmullRom(points[i], points[i + 1], points[i + 2], points[i + 3]));
+		} else {
+			segments_.push_back(CubicSegment::BSpline(points[i], points[i + 1], points[i + 2], points[i + 3]));
+		}
+	}
+}
+
+size_t Spline::Locate(float u, float& t) const {
+	const float last = static_cast<float>(segments_.size());
+	u = std::clamp(u, 0.0f, last);
+	const size_t index = (std::min)(static_cast<size_t>(u), segments_.size() - 1);
+	t = u - static_cast<float>(index);
+	return index;
+}
+
+Vector3 Spline::Evaluate(float u) const {
+	if (segments_.empty()) {
+		return {0.0f, 0.0f, 0.0f};
+	}
+	float t;
+	const size_t index = Locate(u, t);
+	return segments_[index].Evaluate(t);
+}
+
+Vector3 Spline::Derivative(float u) const {
+	if (segments_.empty()) {
+		return {0.0f, 0.0f, 0.0f};
+	}
+	float t;
+	const size_t index = Locate(u, t);
+	return segments_[index].Derivative(t);
+}
+
+void Spline::Tessellate(size_t pointsPerSegment, std::vector<Vector3>& out) const {
+	out.clear();
+	if (segments_.empty() || pointsPerSegment < 2) {
+		return;
+	}
+	out.resize(segments_.size() * (pointsPerSegment - 1) + 1);
+	// 各区間の終点は次の区間の始点で上書きする（区間がつながる曲線では同じ点）
+	for (size_t i = 0; i < segments_.size(); ++i) {
+		segments_[i].Tessellate(out.data() + i * (pointsPerSegment - 1), pointsPerSegment);
+	}
+}
+
+//==================================
+// 弧長
+//==================================
+
+void Spline::BuildArcLengthTable(size_t samplesPerSegment, size_t tableSize) {
+	distanceToParameter_.clear();
+	length_ = 0.0f;
+	if (segments_.empty()) {
+		return;
+	}
+	samplesPerSegment = (std::max)(samplesPerSegment, size_t{1});
+
+	// 折れ線で近似した累積の長さ（パラメータ u = i / samplesPerSegment の位置まで）
+	std::vector<Vector3> points;
+	Tessellate(samplesPerSegment + 1, points);
+	const size_t sampleCount = points.size();
+	std::vector<double> cumulative(sampleCount, 0.0);
+	for (size_t i = 1; i < sampleCount; ++i) {
+		cumulative[i] = cumulative[i - 1] + MathCore::Length(MathCore::Subtract(points[i], points[i - 1]));
+	}
+	const double length = cumulative.back();
+	length_ = static_cast<float>(length);
+
+	// 距離について等間隔に引き直す（距離は単調増加なので、前から 1 回なめるだけで済む）
+	if (tableSize == 0) {
+		tableSize = sampleCount - 1;
+	}
+	tableSize = (std::max)(tableSize, size_t{1});
+	distanceToParameter_.resize(tableSize + 1);
+	const double step = 1.0 / static_cast<double>(samplesPerSegment);
+	size_t sample = 0;
+	for (size_t k = 0; k <= tableSize; ++k) {
+		const double target = length * static_cast<double>(k) / static_cast<double>(tableSize);
+		while (sample + 2 < sampleCount && cumulative[sample + 1] < target) {
+			++sample;
+		}
+		const double span = cumulative[sample + 1] - cumulative[sample];
+		const double fraction = span > 0.0 ? std::clamp((target - cumulative[sample]) / span, 0.0, 1.0) : 0.0;
+		distanceToParameter_[k] = static_cast<float>((static_cast<double>(sample) + fraction) * step);
+	}
+	distanceToParameter_.back() = static_cast<float>(segments_.size());
+}
+
+float Spline::ParameterAtDistance(float distance) const {
+	if (distanceToParameter_.empty() || length_ <= 0.0f) {
+		return 0.0f;
+	}
+	const size_t last = distanceToParameter_.size() - 1;
+	const float position = std::clamp(distance / length_, 0.0f, 1.0f) * static_cast<float>(last);
+	const size_t index = (std::min)(static_cast<size_t>(position), last - 1);
+	const float fraction = position - static_cast<float>(index);
+	return distanceToParameter_[index] + (distanceToParameter_[index + 1] - distanceToParameter_[index]) * fraction;
+}
+
+void Spline::TessellateByDistance(size_t count, std::vector<Vector3>& out) const {
+	out.resize(count);
+	if (count == 1) {
+		out[0] = Evaluate(0.0f);
+		return;
+	}
+	for (size_t i = 0; i < count; ++i) {
+		out[i] = PointAtDistance(length_ * static_cast<float>(i) / static_cast<float>(count - 1));
+	}
+}
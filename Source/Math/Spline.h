@@ -0,0 +1,110 @@
+#pragma once
+#include "MathTypes.h"
+#include <cstddef>
+#include <vector>
+
+using namespace KamataEngine;
+
+//==================================
+// 3 次曲線の 1 区間
+//==================================
+// p(t) = a t^3 + b t^2 + c t + d（t は [0, 1]）の係数で持つ。
+// ベジェ・Catmull-Rom・B スプラインはどれも 4 つの制御点からこの形に直せるので、
+// 評価は種類によらず Horner 法の 3 回の積和で済む。
+//
+// Tessellate は前進差分で等間隔の点を出す。1 点あたり加算 3 回（ベクトル）で、
+// 点ごとに多項式を評価し直さない。丸め誤差は点の数に比例して溜まるので、
+// 最後の点は p(1) を直接入れて隣の区間との継ぎ目をそろえる。
+
+struct CubicSegment {
+	Vector3 a;
+	Vector3 b;
+	Vector3 c;
+	Vector3 d;
+
+	// 3 次ベジェ（p0 と p3 を通り、p1・p2 は接線の制御点）
+	static CubicSegment Bezier(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3);
+	// 一様 Catmull-Rom（p1 から p2 までの区間。全ての制御点を通る）
+	static CubicSegment CatmullRom(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3);
+	// 一様 3 次 B スプライン（制御点は通らないが、区間の継ぎ目で 2 階微分まで連続）
+	static CubicSegment BSpline(const Vector3& p0, const Vector3& p1, const Vector3& p2, const Vector3& p3);
+
+	Vector3 Evaluate(float t) const;
+	Vector3 Derivative(float t) const;
+
+	// t = 0, 1 / (count - 1), ..., 1 の count 点を out に書く（count が 1 なら p(0) だけ）
+	void Tessellate(Vector3* out, size_t count) const;
+};
+
+//==================================
+// スプライン曲線
+//==================================
+// 制御点の列から CubicSegment を並べた曲線。パラメータ u は [0, SegmentCount()] で、
+// 整数部が区間の番号、小数部が区間内の t になる。
+//   Bezier     : 制御点は 3k + 1 個。区間 i は点 3i〜3i+3
+//   CatmullRom : 制御点は 4 個以上。区間 i は点 i〜i+3 で、点 1〜n-2 を通る
+//   BSpline    : 制御点は 4 個以上。区間 i は点 i〜i+3
+// 足りない制御点は無視する（区間が作れなければ空の曲線）。
+//
+// BuildArcLengthTable で弧長の表を作ると、ParameterAtDistance が距離から u を O(1) で引ける。
+// 曲線を細かく折れ線にして長さを積み上げ、それを距離について等間隔に引き直した表を持つので、
+// 引くときは表の位置を割り算で求めて隣の 2 つを線形補間するだけになる。
+// 等速で動かす（PointAtDistance）ときの速度のむらは、表の細かさで決まる。
+// 表の間は線形補間なので、速さが急に変わる所（制御点の置き方でできる尖った所など）では誤差が大きくなる。
+
+enum class SplineType {
+	Bezier,
+	CatmullRom,
+	BSpline,
+};
+
+class Spline {
+
+public:
+	Spline() = default;
+	Spline(SplineType type, const std::vector<Vector3>& points);
+
+	// 区間を作り直す（弧長の表は消える）
+	void SetPoints(SplineType type, const std::vector<Vector3>& points);
+
+	SplineType GetType() const { return type_; }
+	size_t SegmentCount() const { return segments_.size(); }
+	const CubicSegment& GetSegment(size_t index) const { return segments_[index]; }
+
+	// u は [0, SegmentCount()] に丸める
+	Vector3 Evaluate(float u) const;
+	Vector3 Derivative(float u) const;
+
+	// 区間ごとに pointsPerSegment 点を前進差分で出し、out に書く（上書き）。
+	// 区間の継ぎ目の点は 1 つにまとめるので、点の数は SegmentCount() * (pointsPerSegment - 1) + 1
+	void Tessellate(size_t pointsPerSegment, std::vector<Vector3>& out) const;
+
+	//==================================
+	// 弧長
+	//==================================
+
+	// samplesPerSegment: 長さを測る折れ線の区間あたりの分割数
+	// tableSize        : 距離から u を引く表の大きさ（0 なら区間数 * samplesPerSegment）
+	void BuildArcLengthTable(size_t samplesPerSegment = 64, size_t tableSize = 0);
+	bool HasArcLengthTable() const { return !distanceToParameter_.empty(); }
+
+	// 以下は BuildArcLengthTable の後に使う
+	float Length() const { return length_; }
+	// 始点からの距離 distance（[0, Length()] に丸める）の位置のパラメータ u
+	float ParameterAtDistance(float distance) const;
+	Vector3 PointAtDistance(float distance) const { return Evaluate(ParameterAtDistance(distance)); }
+
+	// 曲線上に距離が等間隔な count 点を out に書く（上書き）。始点と終点を含む
+	void TessellateByDistance(size_t count, std::vector<Vector3>& out) const;
+
+private:
+	// u を区間の番号と区間内の t に分ける
+	size_t Locate(float u, float& t) const;
+
+	SplineType type_ = SplineType::CatmullRom;
+	std::vector<CubicSegment> segments_;
+
+	// distanceToParameter_[k] は距離 k * length_ / (size - 1) の位置の u
+	std::vector<float> distanceToParameter_;
+	float length_ = 0.0f;
+};
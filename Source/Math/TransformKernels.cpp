@@ -0,0 +1,217 @@
+#include "TransformKernels.h"
+#include "CpuFeatures.h"
+#include "SimdMath.h"
+
+namespace {
+
+enum class TransformMode {
+	Point,     // 平行移動あり、w 除算なし
+	Direction, // 平行移動なし
+	Project,   // 平行移動あり、w 除算あり
+};
+
+//==================================
+// スカラー版
+//==================================
+
+template <TransformMode Mode> inline void TransformOne(const Matrix4x4& m, float x, float y, float z, float& outX, float& outY, float& outZ) {
+	float rx = x * m.m[0][0] + y * m.m[1][0] + z * m.m[2][0];
+	float ry = x * m.m[0][1] + y * m.m[1][1] + z * m.m[2][1];
+	float rz = x * m.m[0][2] + y * m.m[1][2] + z * m.m[2][2];
+	if constexpr (Mode != TransformMode::Direction) {
+		rx += m.m[3][0];
+		ry += m.m[3][1];
+		rz += m.m[3][2];
+	}
+	if constexpr (Mode == TransformMode::Project) {
+		float w = x * m.m[0][3] + y * m.m[1][3] + z * m.m[2][3] + m.m[3][3];
+		if (w == 0.0f) {
+			w = 1.0f;
+		}
+		rx /= w;
+		ry /= w;
+		rz /= w;
+	}
+	outX = rx;
+	outY = ry;
+	outZ = rz;
+}
+
+template <TransformMode Mode> void TransformSoAScalar(const Matrix4x4& m, const ConstVector3SoA& in, const Vector3SoA& out, size_t begin, size_t n) {
+	for (size_t i = begin; i < n; ++i) {
+		TransformOne<Mode>(m, in.x[i], in.y[i], in.z[i], out.x[i], out.y[i], out.z[i]);
+	}
+}
+
+template <TransformMode Mode> void TransformAoSScalar(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t begin, size_t n) {
+	for (size_t i = begin; i < n; ++i) {
+		const Vector3 v = in[i];
+		TransformOne<Mode>(m, v.x, v.y, v.z, out[i].x, out[i].y, out[i].z);
+	}
+}
+
+#if defined(MT4_SSE2)
+
+//==================================
+// SSE2 版（4 要素ずつ）
+//==================================
+
+// 行列の各要素を 4 つに複製したもの
+struct MatrixBroadcast4 {
+	__m128 e[4][4];
+
+	explicit MatrixBroadcast4(const Matrix4x4& m) {
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+				e[i][j] = _mm_set1_ps(m.m[i][j]);
+			}
+		}
+	}
+};
+
+template <TransformMode Mode> inline void Transform4(const MatrixBroadcast4& m, __m128& x, __m128& y, __m128& z) {
+	__m128 rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m.e[0][0]), _mm_mul_ps(y, m.e[1][0])), _mm_mul_ps(z, m.e[2][0]));
+	__m128 ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m.e[0][1]), _mm_mul_ps(y, m.e[1][1])), _mm_mul_ps(z, m.e[2][1]));
+	__m128 rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m.e[0][2]), _mm_mul_ps(y, m.e[1][2])), _mm_mul_ps(z, m.e[2][2]));
+	if constexpr (Mode != TransformMode::Direction) {
+		rx = _mm_add_ps(rx, m.e[3][0]);
+		ry = _mm_add_ps(ry, m.e[3][1]);
+		rz = _mm_add_ps(rz, m.e[3][2]);
+	}
+	if constexpr (Mode == TransformMode::Project) {
+		__m128 w = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, m.e[0][3]), _mm_mul_ps(y, m.e[1][3])), _mm_mul_ps(z, m.e[2][3])), m.e[3][3]);
+		const __m128 one = _mm_set1_ps(1.0f);
+		w = SimdMath::Select(_mm_cmpeq_ps(w, _mm_setzero_ps()), one, w);
+		rx = _mm_div_ps(rx, w);
+		ry = _mm_div_ps(ry, w);
+		rz = _mm_div_ps(rz, w);
+	}
+	x = rx;
+	y = ry;
+	z = rz;
+}
+
+template <TransformMode Mode> size_t TransformSoASSE2(const Matrix4x4& matrix, const ConstVector3SoA& in, const Vector3SoA& out, size_t n) {
+	const MatrixBroadcast4 m(matrix);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 x = _mm_loadu_ps(in.x + i);
+		__m128 y = _mm_loadu_ps(in.y + i);
+		__m128 z = _mm_loadu_ps(in.z + i);
+		Transform4<Mode>(m, x, y, z);
+		_mm_storeu_ps(out.x + i, x);
+		_mm_storeu_ps(out.y + i, y);
+		_mm_storeu_ps(out.z + i, z);
+	}
+	return i;
+}
+
+// AoS は 4 点ずつ SoA に並べ替えてから計算する
+template <TransformMode Mode> size_t TransformAoSSSE2(const Matrix4x4& matrix, const Vector3* in, Vector3* out, size_t n) {
+	const MatrixBroadcast4 m(matrix);
+	size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 x, y, z;
+		SimdMath::LoadVector3x4(&in[i].x, x, y, z);
+		Transform4<Mode>(m, x, y, z);
+		SimdMath::StoreVector3x4(&out[i].x, x, y, z);
+	}
+	return i;
+}
+
+//==================================
+// AVX2 版（8 要素ずつ、SoA のみ）
+//==================================
+
+template <TransformMode Mode> MT4_TARGET_AVX2 size_t TransformSoAAVX2(const Matrix4x4& matrix, const ConstVector3SoA& in, const Vector3SoA& out, size_t n) {
+	__m256 e[4][4];
+	for (int r = 0; r < 4; ++r) {
+		for (int c = 0; c < 4; ++c) {
+			e[r][c] = _mm256_set1_ps(matrix.m[r][c]);
+		}
+	}
+
+	size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		const __m256 x = _mm256_loadu_ps(in.x + i);
+		const __m256 y = _mm256_loadu_ps(in.y + i);
+		const __m256 z = _mm256_loadu_ps(in.z + i);
+		__m256 rx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, e[0][0]), _mm256_mul_ps(y, e[1][0])), _mm256_mul_ps(z, e[2][0]));
+		__m256 ry = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, e[0][1]), _mm256_mul_ps(y, e[1][1])), _mm256_mul_ps(z, e[2][1]));
+		__m256 rz = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, e[0][2]), _mm256_mul_ps(y, e[1][2])), _mm256_mul_ps(z, e[2][2]));
+		if constexpr (Mode != TransformMode::Direction) {
+			rx = _mm256_add_ps(rx, e[3][0]);
+			ry = _mm256_add_ps(ry, e[3][1]);
+			rz = _mm256_add_ps(rz, e[3][2]);
+		}
+		if constexpr (Mode == TransformMode::Project) {
+			__m256 w = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, e[0][3]), _mm256_mul_ps(y, e[1][3])), _mm256_mul_ps(z, e[2][3])), e[3][3]);
+			const __m256 isZero = _mm256_cmp_ps(w, _mm256_setzero_ps(), _CMP_EQ_OQ);
+			w = _mm256_blendv_ps(w, _mm256_set1_ps(1.0f), isZero);
+			rx = _mm256_div_ps(rx, w);
+			ry = _mm256_div_ps(ry, w);
+			rz = _mm256_div_ps(rz, w);
+		}
+		_mm256_storeu_ps(out.x + i, rx);
+		_mm256_storeu_ps(out.y + i, ry);
+		_mm256_storeu_ps(out.z + i, rz);
+	}
+	return i;
+}
+
+#endif
+
+template <TransformMode Mode> void DispatchSoA(const Matrix4x4& m, const ConstVector3SoA& in, const Vector3SoA& out, size_t n) {
+	size_t done = 0;
+	switch (GetSimdLevel()) {
+#if defined(MT4_SSE2)
+	case SimdLevel::AVX2:
+		done = TransformSoAAVX2<Mode>(m, in, out, n);
+		break;
+	case SimdLevel::SSE2:
+		done = TransformSoASSE2<Mode>(m, in, out, n);
+		break;
+#endif
+	default:
+		break;
+	}
+	TransformSoAScalar<Mode>(m, in, out, done, n);
+}
+
+template <TransformMode Mode> void DispatchAoS(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n) {
+	size_t done = 0;
+#if defined(MT4_SSE2)
+	if (GetSimdLevel() != SimdLevel::Scalar) {
+		done = TransformAoSSSE2<Mode>(m, in, out, n);
+	}
+#endif
+	TransformAoSScalar<Mode>(m, in, out, done, n);
+}
+
+} // namespace
+
+bool IsAffine(const Matrix4x4& m) { return m.m[0][3] == 0.0f && m.m[1][3] == 0.0f && m.m[2][3] == 0.0f && m.m[3][3] == 1.0f; }
+
+void TransformPoints(const Matrix4x4& m, const ConstVector3SoA& in, const Vector3SoA& out, size_t n) { DispatchSoA<TransformMode::Point>(m, in, out, n); }
+
+void TransformPoints(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n) { DispatchAoS<TransformMode::Point>(m, in, out, n); }
+
+void TransformDirections(const Matrix4x4& m, const ConstVector3SoA& in, const Vector3SoA& out, size_t n) { DispatchSoA<TransformMode::Direction>(m, in, out, n); }
+
+void TransformDirections(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n) { DispatchAoS<TransformMode::Direction>(m, in, out, n); }
+
+void ProjectPoints(const Matrix4x4& m, const ConstVector3SoA& in, const Vector3SoA& out, size_t n) {
+	if (IsAffine(m)) {
+		DispatchSoA<TransformMode::Point>(m, in, out, n);
+	} else {
+		DispatchSoA<TransformMode::Project>(m, in, out, n);
+	}
+}
+
+void ProjectPoints(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n) {
+	if (IsAffine(m)) {
+		DispatchAoS<TransformMode::Point>(m, in, out, n);
+	} else {
+		DispatchAoS<TransformMode::Project>(m, in, out, n);
+	}
+}
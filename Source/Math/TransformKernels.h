@@ -0,0 +1,45 @@
+#pragma once
+#include "MathTypes.h"
+#include <cstddef>
+
+using namespace KamataEngine;
+
+//==================================
+// 座標変換のバッチ処理
+//==================================
+// 頂点列をまとめて変換するストリーミング用カーネル。
+// SoA（x, y, z を別配列）と AoS（Vector3 の配列）の両方を受け付ける。
+// 加算の順序は Vector3Transform と同じなので、w が 1 になる行列では結果が一致する。
+// 出力は入力と同じ配列でもよい。
+
+// SoA 形式の Vector3 列（各配列は n 要素）
+struct Vector3SoA {
+	float* x;
+	float* y;
+	float* z;
+};
+
+struct ConstVector3SoA {
+	const float* x;
+	const float* y;
+	const float* z;
+
+	ConstVector3SoA(const float* inX, const float* inY, const float* inZ) : x(inX), y(inY), z(inZ) {}
+	ConstVector3SoA(const Vector3SoA& v) : x(v.x), y(v.y), z(v.z) {}
+};
+
+// 4 列目が (0,0,0,1) かどうか（w 除算が不要か）
+bool IsAffine(const Matrix4x4& m);
+
+// 点の変換（アフィン行列前提。w 除算をしない）
+void TransformPoints(const Matrix4x4& m, const ConstVector3SoA& in, const Vector3SoA& out, size_t n);
+void TransformPoints(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n);
+
+// 方向ベクトルの変換（平行移動を無視する）
+void TransformDirections(const Matrix4x4& m, const ConstVector3SoA& in, const Vector3SoA& out, size_t n);
+void TransformDirections(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n);
+
+// 射影変換（w 除算あり。w が 0 のときは Vector3Transform と同じく除算しない）。
+// m がアフィンなら自動的に TransformPoints と同じ経路になる
+void ProjectPoints(const Matrix4x4& m, const ConstVector3SoA& in, const Vector3SoA& out, size_t n);
+void ProjectPoints(const Matrix4x4& m, const Vector3* in, Vector3* out, size_t n);
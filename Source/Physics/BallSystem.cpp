@@ -0,0 +1,497 @@
+#include "BallSystem.h"
+#include "Job/ParallelFor.h"
+#include "Math/CpuFeatures.h"
+#include "Math/SimdMath.h"
+#include "Profiler/Profiler.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 1 スレッドに割り当てる最小の要素数
+constexpr size_t kGrainSize = 4096;
+
+constexpr uint32_t kMoveMask = 0xFFFFFFFFu;
+
+// deltaTime の参照先。stride が 0 なら全要素で dt[0] を使う
+struct StepTime {
+	const float* dt;
+	size_t stride;
+
+	float operator[](size_t i) const { return dt[i * stride]; }
+};
+
+inline uint32_t ToMoveMask(bool isMove) { return isMove ? kMoveMask : 0u; }
+
+//==================================
+// バネ（UpdateSpring と同じ式）
+//==================================
+
+struct SpringStreams {
+	float *px, *py, *pz, *vx, *vy, *vz, *ax, *ay, *az;
+	const float *mass, *anchorX, *anchorY, *anchorZ, *naturalLength, *stiffness, *damping;
+	const uint32_t* moveMask;
+	StepTime deltaTime;
+};
+
+void StepSpringsScalar(const SpringStreams& s, size_t begin, size_t end) {
+	for (size_t i = begin; i < end; ++i) {
+		if (s.moveMask[i] == 0) {
+			continue;
+		}
+		const float dx = s.px[i] - s.anchorX[i];
+		const float dy = s.py[i] - s.anchorY[i];
+		const float dz = s.pz[i] - s.anchorZ[i];
+		const float length = std::sqrt(dx * dx + dy * dy + dz * dz);
+		if (length != 0.0f) {
+			const float restX = s.anchorX[i] + dx / length * s.naturalLength[i];
+			const float restY = s.anchorY[i] + dy / length * s.naturalLength[i];
+			const float restZ = s.anchorZ[i] + dz / length * s.naturalLength[i];
+			const float k = -s.stiffness[i];
+			const float c = -s.damping[i];
+			const float fx = (s.px[i] - restX) * length * k + s.vx[i] * c;
+			const float fy = (s.py[i] - restY) * length * k + s.vy[i] * c;
+			const float fz = (s.pz[i] - restZ) * length * k + s.vz[i] * c;
+			// Vector3 の operator/ と同じく質量 0 なら加速度 0
+			const float m = s.mass[i];
+			s.ax[i] = m == 0.0f ? 0.0f : fx / m;
+			s.ay[i] = m == 0.0f ? 0.0f : fy / m;
+			s.az[i] = m == 0.0f ? 0.0f : fz / m;
+		}
+		const float dt = s.deltaTime[i];
+		s.vx[i] += s.ax[i] * dt;
+		s.vy[i] += s.ay[i] * dt;
+		s.vz[i] += s.az[i] * dt;
+		s.px[i] += s.vx[i] * dt;
+		s.py[i] += s.vy[i] * dt;
+		s.pz[i] += s.vz[i] * dt;
+	}
+}
+
+#if defined(MT4_SSE2)
+
+size_t StepSpringsSSE2(const SpringStreams& s, size_t begin, size_t end) {
+	using SimdMath::Select;
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 signMask = _mm_set1_ps(-0.0f);
+	size_t i = begin;
+	for (; i + 4 <= end; i += 4) {
+		const __m128 moving = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s.moveMask + i)));
+		const __m128 px = _mm_loadu_ps(s.px + i), py = _mm_loadu_ps(s.py + i), pz = _mm_loadu_ps(s.pz + i);
+		const __m128 vx = _mm_loadu_ps(s.vx + i), vy = _mm_loadu_ps(s.vy + i), vz = _mm_loadu_ps(s.vz + i);
+		const __m128 oldAx = _mm_loadu_ps(s.ax + i), oldAy = _mm_loadu_ps(s.ay + i), oldAz = _mm_loadu_ps(s.az + i);
+		const __m128 anchorX = _mm_loadu_ps(s.anchorX + i), anchorY = _mm_loadu_ps(s.anchorY + i), anchorZ = _mm_loadu_ps(s.anchorZ + i);
+		const __m128 naturalLength = _mm_loadu_ps(s.naturalLength + i);
+		const __m128 k = _mm_xor_ps(_mm_loadu_ps(s.stiffness + i), signMask);
+		const __m128 c = _mm_xor_ps(_mm_loadu_ps(s.damping + i), signMask);
+		const __m128 m = _mm_loadu_ps(s.mass + i);
+		const __m128 dt = s.deltaTime.stride == 0 ? _mm_set1_ps(s.deltaTime.dt[0]) : _mm_loadu_ps(s.deltaTime.dt + i);
+
+		const __m128 dx = _mm_sub_ps(px, anchorX), dy = _mm_sub_ps(py, anchorY), dz = _mm_sub_ps(pz, anchorZ);
+		const __m128 length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+		const __m128 restX = _mm_add_ps(anchorX, _mm_mul_ps(_mm_div_ps(dx, length), naturalLength));
+		const __m128 restY = _mm_add_ps(anchorY, _mm_mul_ps(_mm_div_ps(dy, length), naturalLength));
+		const __m128 restZ = _mm_add_ps(anchorZ, _mm_mul_ps(_mm_div_ps(dz, length), naturalLength));
+		const __m128 fx = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_sub_ps(px, restX), length), k), _mm_mul_ps(vx, c));
+		const __m128 fy = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_sub_ps(py, restY), length), k), _mm_mul_ps(vy, c));
+		const __m128 fz = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_sub_ps(pz, restZ), length), k), _mm_mul_ps(vz, c));
+
+		// 長さ 0 なら前回の加速度のまま、質量 0 なら加速度 0
+		const __m128 keepOld = _mm_cmpeq_ps(length, zero);
+		const __m128 massless = _mm_cmpeq_ps(m, zero);
+		const __m128 ax = Select(keepOld, oldAx, Select(massless, zero, _mm_div_ps(fx, m)));
+		const __m128 ay = Select(keepOld, oldAy, Select(massless, zero, _mm_div_ps(fy, m)));
+		const __m128 az = Select(keepOld, oldAz, Select(massless, zero, _mm_div_ps(fz, m)));
+
+		const __m128 newVx = _mm_add_ps(vx, _mm_mul_ps(ax, dt)), newVy = _mm_add_ps(vy, _mm_mul_ps(ay, dt)), newVz = _mm_add_ps(vz, _mm_mul_ps(az, dt));
+		_mm_storeu_ps(s.ax + i, Select(moving, ax, oldAx));
+		_mm_storeu_ps(s.ay + i, Select(moving, ay, oldAy));
+		_mm_storeu_ps(s.az + i, Select(moving, az, oldAz));
+		_mm_storeu_ps(s.vx + i, Select(moving, newVx, vx));
+		_mm_storeu_ps(s.vy + i, Select(moving, newVy, vy));
+		_mm_storeu_ps(s.vz + i, Select(moving, newVz, vz));
+		_mm_storeu_ps(s.px + i, Select(moving, _mm_add_ps(px, _mm_mul_ps(newVx, dt)), px));
+		_mm_storeu_ps(s.py + i, Select(moving, _mm_add_ps(py, _mm_mul_ps(newVy, dt)), py));
+		_mm_storeu_ps(s.pz + i, Select(moving, _mm_add_ps(pz, _mm_mul_ps(newVz, dt)), pz));
+	}
+	return i;
+}
+
+MT4_TARGET_AVX2 size_t StepSpringsAVX2(const SpringStreams& s, size_t begin, size_t end) {
+	using SimdMath::Select;
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 signMask = _mm256_set1_ps(-0.0f);
+	size_t i = begin;
+	for (; i + 8 <= end; i += 8) {
+		const __m256 moving = _mm256_castsi256_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s.moveMask + i)));
+		const __m256 px = _mm256_loadu_ps(s.px + i), py = _mm256_loadu_ps(s.py + i), pz = _mm256_loadu_ps(s.pz + i);
+		const __m256 vx = _mm256_loadu_ps(s.vx + i), vy = _mm256_loadu_ps(s.vy + i), vz = _mm256_loadu_ps(s.vz + i);
+		const __m256 oldAx = _mm256_loadu_ps(s.ax + i), oldAy = _mm256_loadu_ps(s.ay + i), oldAz = _mm256_loadu_ps(s.az + i);
+		const __m256 anchorX = _mm256_loadu_ps(s.anchorX + i), anchorY = _mm256_loadu_ps(s.anchorY + i), anchorZ = _mm256_loadu_ps(s.anchorZ + i);
+		const __m256 naturalLength = _mm256_loadu_ps(s.naturalLength + i);
+		const __m256 k = _mm256_xor_ps(_mm256_loadu_ps(s.stiffness + i), signMask);
+		const __m256 c = _mm256_xor_ps(_mm256_loadu_ps(s.damping + i), signMask);
+		const __m256 m = _mm256_loadu_ps(s.mass + i);
+		const __m256 dt = s.deltaTime.stride == 0 ? _mm256_set1_ps(s.deltaTime.dt[0]) : _mm256_loadu_ps(s.deltaTime.dt + i);
+
+		const __m256 dx = _mm256_sub_ps(px, anchorX), dy = _mm256_sub_ps(py, anchorY), dz = _mm256_sub_ps(pz, anchorZ);
+		const __m256 length = _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)), _mm256_mul_ps(dz, dz)));
+		const __m256 restX = _mm256_add_ps(anchorX, _mm256_mul_ps(_mm256_div_ps(dx, length), naturalLength));
+		const __m256 restY = _mm256_add_ps(anchorY, _mm256_mul_ps(_mm256_div_ps(dy, length), naturalLength));
+		const __m256 restZ = _mm256_add_ps(anchorZ, _mm256_mul_ps(_mm256_div_ps(dz, length), naturalLength));
+		const __m256 fx = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_sub_ps(px, restX), length), k), _mm256_mul_ps(vx, c));
+		const __m256 fy = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_sub_ps(py, restY), length), k), _mm256_mul_ps(vy, c));
+		const __m256 fz = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_sub_ps(pz, restZ), length), k), _mm256_mul_ps(vz, c));
+
+		const __m256 keepOld = _mm256_cmp_ps(length, zero, _CMP_EQ_OQ);
+		const __m256 massless = _mm256_cmp_ps(m, zero, _CMP_EQ_OQ);
+		const __m256 ax = Select(keepOld, oldAx, Select(massless, zero, _mm256_div_ps(fx, m)));
+		const __m256 ay = Select(keepOld, oldAy, Select(massless, zero, _mm256_div_ps(fy, m)));
+		const __m256 az = Select(keepOld, oldAz, Select(massless, zero, _mm256_div_ps(fz, m)));
+
+		const __m256 newVx = _mm256_add_ps(vx, _mm256_mul_ps(ax, dt)), newVy = _mm256_add_ps(vy, _mm256_mul_ps(ay, dt)), newVz = _mm256_add_ps(vz, _mm256_mul_ps(az, dt));
+		_mm256_storeu_ps(s.ax + i, Select(moving, ax, oldAx));
+		_mm256_storeu_ps(s.ay + i, Select(moving, ay, oldAy));
+		_mm256_storeu_ps(s.az + i, Select(moving, az, oldAz));
+		_mm256_storeu_ps(s.vx + i, Select(moving, newVx, vx));
+		_mm256_storeu_ps(s.vy + i, Select(moving, newVy, vy));
+		_mm256_storeu_ps(s.vz + i, Select(moving, newVz, vz));
+		_mm256_storeu_ps(s.px + i, Select(moving, _mm256_add_ps(px, _mm256_mul_ps(newVx, dt)), px));
+		_mm256_storeu_ps(s.py + i, Select(moving, _mm256_add_ps(py, _mm256_mul_ps(newVy, dt)), py));
+		_mm256_storeu_ps(s.pz + i, Select(moving, _mm256_add_ps(pz, _mm256_mul_ps(newVz, dt)), pz));
+	}
+	return i;
+}
+
+#endif
+
+} // namespace
+
+//==================================
+// BallArrays
+//==================================
+
+void BallSystem::BallArrays::Add(const Ball& ball) {
+	positionX.push_back(ball.position.x);
+	positionY.push_back(ball.position.y);
+	positionZ.push_back(ball.position.z);
+	velocityX.push_back(ball.velocity.x);
+	velocityY.push_back(ball.velocity.y);
+	velocityZ.push_back(ball.velocity.z);
+	accelerationX.push_back(ball.acceleration.x);
+	accelerationY.push_back(ball.acceleration.y);
+	accelerationZ.push_back(ball.acceleration.z);
+	mass.push_back(ball.mass);
+	angle.push_back(ball.angle);
+	cold.push_back(ball);
+}
+
+Ball BallSystem::BallArrays::Get(uint32_t index) const {
+	Ball ball = cold[index];
+	ball.position = {positionX[index], positionY[index], positionZ[index]};
+	ball.velocity = {velocityX[index], velocityY[index], velocityZ[index]};
+	ball.acceleration = {accelerationX[index], accelerationY[index], accelerationZ[index]};
+	ball.mass = mass[index];
+	ball.angle = angle[index];
+	return ball;
+}
+
+void BallSystem::BallArrays::Clear() { *this = BallArrays(); }
+
+void BallSystem::BallArrays::StorePrevious() {
+	previousX = positionX;
+	previousY = positionY;
+	previousZ = positionZ;
+}
+
+void BallSystem::BallArrays::Interpolate(float alpha) {
+	const size_t n = Size();
+	renderX.resize(n);
+	renderY.resize(n);
+	renderZ.resize(n);
+	// 前回の位置が無い要素（StorePrevious 後に追加されたもの）は現在の位置をそのまま使う
+	const size_t stored = std::min(previousX.size(), n);
+	const float beta = 1.0f - alpha;
+	for (size_t i = 0; i < stored; ++i) {
+		renderX[i] = beta * previousX[i] + alpha * positionX[i];
+		renderY[i] = beta * previousY[i] + alpha * positionY[i];
+		renderZ[i] = beta * previousZ[i] + alpha * positionZ[i];
+	}
+	std::copy(positionX.begin() + stored, positionX.end(), renderX.begin() + stored);
+	std::copy(positionY.begin() + stored, positionY.end(), renderY.begin() + stored);
+	std::copy(positionZ.begin() + stored, positionZ.end(), renderZ.begin() + stored);
+}
+
+//==================================
+// 追加・取得
+//==================================
+
+uint32_t BallSystem::AddSpring(const Ball& ball, const Spring& spring) {
+	SpringGroup& g = springs_;
+	g.balls.Add(ball);
+	g.anchorX.push_back(spring.anchor.x);
+	g.anchorY.push_back(spring.anchor.y);
+	g.anchorZ.push_back(spring.anchor.z);
+	g.naturalLength.push_back(spring.naturalLength);
+	g.stiffness.push_back(spring.stiffness);
+	g.dampingCoefficient.push_back(spring.dampingCoefficient);
+	g.deltaTime.push_back(spring.deltaTime);
+	g.moveMask.push_back(ToMoveMask(spring.isMove));
+	return static_cast<uint32_t>(g.Size() - 1);
+}
+
+uint32_t BallSystem::AddPendulum(const Ball& ball, const Pendulum& pendulum) {
+	PendulumGroup& g = pendulums_;
+	g.balls.Add(ball);
+	g.anchorX.push_back(pendulum.anchor.x);
+	g.anchorY.push_back(pendulum.anchor.y);
+	g.anchorZ.push_back(pendulum.anchor.z);
+	g.length.push_back(pendulum.length);
+	g.angle.push_back(pendulum.angle);
+	g.angularVelocity.push_back(pendulum.angularVelocity);
+	g.angularAcceleration.push_back(pendulum.angularAcceleration);
+	g.deltaTime.push_back(pendulum.deltaTime);
+	g.isMove.push_back(pendulum.isMove);
+	return static_cast<uint32_t>(g.Size() - 1);
+}
+
+uint32_t BallSystem::AddCircular(const Ball& ball, const Circular& circular) {
+	CircularGroup& g = circulars_;
+	g.balls.Add(ball);
+	g.centerX.push_back(circular.center.x);
+	g.centerY.push_back(circular.center.y);
+	g.centerZ.push_back(circular.center.z);
+	g.radius.push_back(circular.radius);
+	g.angularVelocity.push_back(circular.angularVelocity);
+	g.angle.push_back(circular.angle);
+	g.deltaTime.push_back(circular.deltaTime);
+	g.isMove.push_back(circular.isMove);
+	return static_cast<uint32_t>(g.Size() - 1);
+}
+
+uint32_t BallSystem::AddConicalPendulum(const Ball& ball, const ConicalPendulum& conicalPendulum) {
+	ConicalGroup& g = conicals_;
+	g.balls.Add(ball);
+	g.anchorX.push_back(conicalPendulum.anchor.x);
+	g.anchorY.push_back(conicalPendulum.anchor.y);
+	g.anchorZ.push_back(conicalPendulum.anchor.z);
+	g.length.push_back(conicalPendulum.length);
+	g.halfApexAngle.push_back(conicalPendulum.halfApexAngle);
+	g.angle.push_back(conicalPendulum.angle);
+	g.angularVelocity.push_back(conicalPendulum.angularVelocity);
+	g.deltaTime.push_back(conicalPendulum.deltaTime);
+	g.isMove.push_back(conicalPendulum.isMove);
+
+	// UpdateConicalPendulum が毎回求める値
+	g.radius.push_back(std::sin(conicalPendulum.halfApexAngle) * conicalPendulum.length);
+	g.height.push_back(std::cos(conicalPendulum.halfApexAngle) * conicalPendulum.length);
+	g.orbitAngularVelocity.push_back(std::sqrt(9.8f / (conicalPendulum.length * std::cos(conicalPendulum.halfApexAngle))));
+	return static_cast<uint32_t>(g.Size() - 1);
+}
+
+void BallSystem::Clear() {
+	springs_ = SpringGroup();
+	pendulums_ = PendulumGroup();
+	circulars_ = CircularGroup();
+	conicals_ = ConicalGroup();
+}
+
+void BallSystem::SetAllMoving(bool isMove) {
+	const uint32_t mask = ToMoveMask(isMove);
+	springs_.moveMask.assign(springs_.Size(), mask);
+	pendulums_.isMove.assign(pendulums_.Size(), isMove);
+	circulars_.isMove.assign(circulars_.Size(), isMove);
+	conicals_.isMove.assign(conicals_.Size(), isMove);
+}
+
+Spring BallSystem::GetSpring(uint32_t index) const {
+	const SpringGroup& g = springs_;
+	Spring spring;
+	spring.anchor = {g.anchorX[index], g.anchorY[index], g.anchorZ[index]};
+	spring.naturalLength = g.naturalLength[index];
+	spring.stiffness = g.stiffness[index];
+	spring.dampingCoefficient = g.dampingCoefficient[index];
+	spring.deltaTime = g.deltaTime[index];
+	spring.isMove = g.moveMask[index] != 0;
+	return spring;
+}
+
+Pendulum BallSystem::GetPendulum(uint32_t index) const {
+	const PendulumGroup& g = pendulums_;
+	Pendulum pendulum;
+	pendulum.anchor = {g.anchorX[index], g.anchorY[index], g.anchorZ[index]};
+	pendulum.length = g.length[index];
+	pendulum.angle = g.angle[index];
+	pendulum.angularVelocity = g.angularVelocity[index];
+	pendulum.angularAcceleration = g.angularAcceleration[index];
+	pendulum.deltaTime = g.deltaTime[index];
+	pendulum.isMove = g.isMove[index] != 0;
+	return pendulum;
+}
+
+Circular BallSystem::GetCircular(uint32_t index) const {
+	const CircularGroup& g = circulars_;
+	Circular circular;
+	circular.center = {g.centerX[index], g.centerY[index], g.centerZ[index]};
+	circular.radius = g.radius[index];
+	circular.angularVelocity = g.angularVelocity[index];
+	circular.angle = g.angle[index];
+	circular.deltaTime = g.deltaTime[index];
+	circular.isMove = g.isMove[index] != 0;
+	return circular;
+}
+
+ConicalPendulum BallSystem::GetConicalPendulum(uint32_t index) const {
+	const ConicalGroup& g = conicals_;
+	ConicalPendulum conicalPendulum;
+	conicalPendulum.anchor = {g.anchorX[index], g.anchorY[index], g.anchorZ[index]};
+	conicalPendulum.length = g.length[index];
+	conicalPendulum.halfApexAngle = g.halfApexAngle[index];
+	conicalPendulum.angle = g.angle[index];
+	conicalPendulum.angularVelocity = g.angularVelocity[index];
+	conicalPendulum.deltaTime = g.deltaTime[index];
+	conicalPendulum.isMove = g.isMove[index] != 0;
+	return conicalPendulum;
+}
+
+//==================================
+// 更新
+//==================================
+
+template <typename Group> void BallSystem::Run(Group& group, const float* deltaTime, void (*step)(Group&, const float*, size_t, size_t)) {
+	const size_t count = group.Size();
+	if (multithreaded_) {
+		ParallelFor(count, kGrainSize, [&](size_t begin, size_t end) { step(group, deltaTime, begin, end); });
+	} else {
+		step(group, deltaTime, 0, count);
+	}
+}
+
+void BallSystem::Update() {
+	MT4_PROFILE_SCOPE("BallSystem::Update");
+	UpdateSprings();
+	UpdatePendulums();
+	UpdateCirculars();
+	UpdateConicalPendulums();
+}
+
+void BallSystem::Update(float deltaTime) {
+	MT4_PROFILE_SCOPE("BallSystem::Update");
+	Run(springs_, &deltaTime, &BallSystem::StepSprings);
+	Run(pendulums_, &deltaTime, &BallSystem::StepPendulums);
+	Run(circulars_, &deltaTime, &BallSystem::StepCirculars);
+	Run(conicals_, &deltaTime, &BallSystem::StepConicalPendulums);
+}
+
+void BallSystem::UpdateSprings() { Run(springs_, nullptr, &BallSystem::StepSprings); }
+
+void BallSystem::UpdatePendulums() { Run(pendulums_, nullptr, &BallSystem::StepPendulums); }
+
+void BallSystem::UpdateCirculars() { Run(circulars_, nullptr, &BallSystem::StepCirculars); }
+
+void BallSystem::UpdateConicalPendulums() { Run(conicals_, nullptr, &BallSystem::StepConicalPendulums); }
+
+void BallSystem::StorePreviousPositions() {
+	springs_.balls.StorePrevious();
+	pendulums_.balls.StorePrevious();
+	circulars_.balls.StorePrevious();
+	conicals_.balls.StorePrevious();
+}
+
+void BallSystem::InterpolatePositions(float alpha) {
+	springs_.balls.Interpolate(alpha);
+	pendulums_.balls.Interpolate(alpha);
+	circulars_.balls.Interpolate(alpha);
+	conicals_.balls.Interpolate(alpha);
+}
+
+void BallSystem::StepSprings(SpringGroup& g, const float* deltaTime, size_t begin, size_t end) {
+	const StepTime time = deltaTime ? StepTime{deltaTime, 0} : StepTime{g.deltaTime.data(), 1};
+	BallArrays& b = g.balls;
+	const SpringStreams s{
+	    b.positionX.data(),     b.positionY.data(),     b.positionZ.data(),
+	    b.velocityX.data(),     b.velocityY.data(),     b.velocityZ.data(),
+	    b.accelerationX.data(), b.accelerationY.data(), b.accelerationZ.data(),
+	    b.mass.data(),          g.anchorX.data(),       g.anchorY.data(),
+	    g.anchorZ.data(),       g.naturalLength.data(), g.stiffness.data(),
+	    g.dampingCoefficient.data(), g.moveMask.data(), time,
+	};
+
+	size_t done = begin;
+	switch (GetSimdLevel()) {
+#if defined(MT4_SSE2)
+	case SimdLevel::AVX2:
+		done = StepSpringsAVX2(s, begin, end);
+		break;
+	case SimdLevel::SSE2:
+		done = StepSpringsSSE2(s, begin, end);
+		break;
+#endif
+	default:
+		break;
+	}
+	StepSpringsScalar(s, done, end);
+}
+
+// UpdatePendulum と同じ式
+void BallSystem::StepPendulums(PendulumGroup& g, const float* deltaTime, size_t begin, size_t end) {
+	const StepTime time = deltaTime ? StepTime{deltaTime, 0} : StepTime{g.deltaTime.data(), 1};
+	BallArrays& b = g.balls;
+	for (size_t i = begin; i < end; ++i) {
+		if (!g.isMove[i]) {
+			continue;
+		}
+		const float length = g.length[i];
+		const float dt = time[i];
+		const float angularAcceleration = -(9.8f / length) * std::sin(g.angle[i]);
+		const float angularVelocity = g.angularVelocity[i] + angularAcceleration * dt;
+		const float angle = g.angle[i] + angularVelocity * dt;
+		g.angularAcceleration[i] = angularAcceleration;
+		g.angularVelocity[i] = angularVelocity;
+		g.angle[i] = angle;
+
+		b.positionX[i] = g.anchorX[i] + std::sin(angle) * length;
+		b.positionY[i] = g.anchorY[i] - std::cos(angle) * length;
+		b.positionZ[i] = g.anchorZ[i];
+	}
+}
+
+// CircularMotion と同じ式（角度は Ball 側に持つ）
+void BallSystem::StepCirculars(CircularGroup& g, const float* deltaTime, size_t begin, size_t end) {
+	const StepTime time = deltaTime ? StepTime{deltaTime, 0} : StepTime{g.deltaTime.data(), 1};
+	BallArrays& b = g.balls;
+	for (size_t i = begin; i < end; ++i) {
+		if (!g.isMove[i]) {
+			continue;
+		}
+		float angle = b.angle[i] + g.angularVelocity[i] * time[i];
+		if (angle >= 360.0f) {
+			angle -= 360.0f;
+		}
+		b.angle[i] = angle;
+
+		b.positionX[i] = g.centerX[i] + g.radius[i] * std::cos(angle);
+		b.positionY[i] = g.centerY[i] + g.radius[i] * std::sin(angle);
+		b.positionZ[i] = g.centerZ[i];
+	}
+}
+
+// UpdateConicalPendulum と同じ式（毎回変わらない値は追加時に求めてある）
+void BallSystem::StepConicalPendulums(ConicalGroup& g, const float* deltaTime, size_t begin, size_t end) {
+	const StepTime time = deltaTime ? StepTime{deltaTime, 0} : StepTime{g.deltaTime.data(), 1};
+	BallArrays& b = g.balls;
+	for (size_t i = begin; i < end; ++i) {
+		if (!g.isMove[i]) {
+			continue;
+		}
+		const float angularVelocity = g.orbitAngularVelocity[i];
+		const float angle = g.angle[i] + angularVelocity * time[i];
+		g.angularVelocity[i] = angularVelocity;
+		g.angle[i] = angle;
+
+		const float radius = g.radius[i];
+		b.positionX[i] = g.anchorX[i] + radius * std::cos(angle) * radius;
+		b.positionY[i] = g.anchorY[i] - g.height[i];
+		b.positionZ[i] = g.anchorZ[i] - std::sin(angle) * radius;
+	}
+}
@@ -0,0 +1,154 @@
+#pragma once
+#include "Math/TransformKernels.h"
+#include "struct.h"
+#include <cstdint>
+#include <vector>
+
+//==================================
+// Ball の SoA 一括更新
+//==================================
+// UpdateSpring / UpdatePendulum / CircularMotion / UpdateConicalPendulum を
+// 大量の Ball にまとめて適用する。運動の種類ごとに位置・速度・パラメータを別配列で持ち、
+// 1 回の呼び出しで全員を 1 ステップ進める。
+// 演算の順序は元の関数と同じにしてあるので、結果は 1 つずつ呼んだ場合と一致する。
+//
+// バネは SIMD（SSE2 / AVX2）で計算する。振り子・円運動は std::sin / std::cos が大半を占め、
+// 近似多項式に置き換えると結果が変わるため、SoA のスカラーループで処理する。
+// 元の構造体と同じく isMove が false のものは更新しない。
+// SetMultithreaded(true) で要素を塊に分けて複数スレッドで処理する。
+
+class BallSystem {
+
+public:
+	// 追加した要素の番号（種類ごとの通し番号）を返す
+	uint32_t AddSpring(const Ball& ball, const Spring& spring);
+	uint32_t AddPendulum(const Ball& ball, const Pendulum& pendulum);
+	uint32_t AddCircular(const Ball& ball, const Circular& circular);
+	// InitializeConicalPendulum 済みの ball を渡す
+	uint32_t AddConicalPendulum(const Ball& ball, const ConicalPendulum& conicalPendulum);
+
+	void Clear();
+
+	// 全要素の isMove をまとめて切り替える
+	void SetAllMoving(bool isMove);
+
+	void SetMultithreaded(bool enable) { multithreaded_ = enable; }
+	bool IsMultithreaded() const { return multithreaded_; }
+
+	// 全種類を 1 ステップ進める（deltaTime は各構造体のもの）
+	void Update();
+
+	// 全要素を同じ deltaTime で進める（FixedStepScheduler から呼ぶ場合など）
+	void Update(float deltaTime);
+
+	void UpdateSprings();
+	void UpdatePendulums();
+	void UpdateCirculars();
+	void UpdateConicalPendulums();
+
+	size_t SpringCount() const { return springs_.Size(); }
+	size_t PendulumCount() const { return pendulums_.Size(); }
+	size_t CircularCount() const { return circulars_.Size(); }
+	size_t ConicalPendulumCount() const { return conicals_.Size(); }
+
+	// 補間用に現在の位置を保存する（固定ステップの直前に呼ぶ）
+	void StorePreviousPositions();
+
+	// 保存した位置と現在の位置を alpha で補間し、描画用の位置を作る
+	void InterpolatePositions(float alpha);
+
+	// InterpolatePositions の結果（SoA）
+	ConstVector3SoA SpringRenderPositions() const { return springs_.balls.RenderPositions(); }
+	ConstVector3SoA PendulumRenderPositions() const { return pendulums_.balls.RenderPositions(); }
+	ConstVector3SoA CircularRenderPositions() const { return circulars_.balls.RenderPositions(); }
+	ConstVector3SoA ConicalPendulumRenderPositions() const { return conicals_.balls.RenderPositions(); }
+
+	// シミュレーション上の現在位置（SoA）
+	ConstVector3SoA SpringPositions() const { return springs_.balls.Positions(); }
+	ConstVector3SoA PendulumPositions() const { return pendulums_.balls.Positions(); }
+	ConstVector3SoA CircularPositions() const { return circulars_.balls.Positions(); }
+	ConstVector3SoA ConicalPendulumPositions() const { return conicals_.balls.Positions(); }
+
+	// 1 つずつ取り出す（元の構造体に戻す）
+	Ball GetSpringBall(uint32_t index) const { return springs_.balls.Get(index); }
+	Spring GetSpring(uint32_t index) const;
+	Ball GetPendulumBall(uint32_t index) const { return pendulums_.balls.Get(index); }
+	Pendulum GetPendulum(uint32_t index) const;
+	Ball GetCircularBall(uint32_t index) const { return circulars_.balls.Get(index); }
+	Circular GetCircular(uint32_t index) const;
+	Ball GetConicalPendulumBall(uint32_t index) const { return conicals_.balls.Get(index); }
+	ConicalPendulum GetConicalPendulum(uint32_t index) const;
+
+private:
+	// Ball の SoA。更新で使うものと表示用のものを分けて持つ
+	struct BallArrays {
+		std::vector<float> positionX, positionY, positionZ;
+		std::vector<float> velocityX, velocityY, velocityZ;
+		std::vector<float> accelerationX, accelerationY, accelerationZ;
+		std::vector<float> mass;
+		std::vector<float> angle;
+		std::vector<Ball> cold; // deltaTime, radius, color など更新で使わないもの
+
+		// 描画の補間用
+		std::vector<float> previousX, previousY, previousZ;
+		std::vector<float> renderX, renderY, renderZ;
+
+		void Add(const Ball& ball);
+		Ball Get(uint32_t index) const;
+		void Clear();
+		size_t Size() const { return mass.size(); }
+		ConstVector3SoA Positions() const { return {positionX.data(), positionY.data(), positionZ.data()}; }
+		ConstVector3SoA RenderPositions() const { return {renderX.data(), renderY.data(), renderZ.data()}; }
+		void StorePrevious();
+		void Interpolate(float alpha);
+	};
+
+	struct SpringGroup {
+		BallArrays balls;
+		std::vector<float> anchorX, anchorY, anchorZ;
+		std::vector<float> naturalLength, stiffness, dampingCoefficient, deltaTime;
+		std::vector<uint32_t> moveMask; // isMove なら 0xFFFFFFFF（SIMD の選択マスクに使う）
+		size_t Size() const { return balls.Size(); }
+	};
+
+	struct PendulumGroup {
+		BallArrays balls;
+		std::vector<float> anchorX, anchorY, anchorZ;
+		std::vector<float> length, angle, angularVelocity, angularAcceleration, deltaTime;
+		std::vector<uint8_t> isMove; // 0 なら更新しない。スカラーのループで読むのでマスクにはせず 1 バイトで持つ
+		size_t Size() const { return balls.Size(); }
+	};
+
+	struct CircularGroup {
+		BallArrays balls;
+		std::vector<float> centerX, centerY, centerZ;
+		std::vector<float> radius, angularVelocity, angle, deltaTime;
+		std::vector<uint8_t> isMove; // PendulumGroup と同じ
+		size_t Size() const { return balls.Size(); }
+	};
+
+	// halfApexAngle と length は更新中に変わらないので、
+	// UpdateConicalPendulum が毎回求める sin / cos / sqrt の結果を追加時に求めておく
+	struct ConicalGroup {
+		BallArrays balls;
+		std::vector<float> anchorX, anchorY, anchorZ;
+		std::vector<float> length, halfApexAngle, angle, angularVelocity, deltaTime;
+		std::vector<float> radius, height, orbitAngularVelocity;
+		std::vector<uint8_t> isMove; // PendulumGroup と同じ
+		size_t Size() const { return balls.Size(); }
+	};
+
+	static void StepSprings(SpringGroup& group, const float* deltaTime, size_t begin, size_t end);
+	static void StepPendulums(PendulumGroup& group, const float* deltaTime, size_t begin, size_t end);
+	static void StepCirculars(CircularGroup& group, const float* deltaTime, size_t begin, size_t end);
+	static void StepConicalPendulums(ConicalGroup& group, const float* deltaTime, size_t begin, size_t end);
+
+	// deltaTime が nullptr なら要素ごとの deltaTime を使う
+	template <typename Group> void Run(Group& group, const float* deltaTime, void (*step)(Group&, const float*, size_t, size_t));
+
+	SpringGroup springs_;
+	PendulumGroup pendulums_;
+	CircularGroup circulars_;
+	ConicalGroup conicals_;
+	bool multithreaded_ = false;
+};
@@ -0,0 +1,72 @@
+#include "FixedStepScheduler.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+FixedStepScheduler::FixedStepScheduler(const Settings& settings) { SetSettings(settings); }
+
+void FixedStepScheduler::SetSettings(const Settings& settings) {
+	settings_ = settings;
+	settings_.stepTime = std::max(settings_.stepTime, 1.0e-6f);
+	settings_.substepCount = std::max<uint32_t>(settings_.substepCount, 1);
+	settings_.maxStepsPerFrame = std::max<uint32_t>(settings_.maxStepsPerFrame, 1);
+}
+
+uint32_t FixedStepScheduler::Register(StepFunction step, SnapshotFunction snapshot) {
+	const uint32_t id = nextId_++;
+	entries_.push_back({id, std::move(step), std::move(snapshot)});
+	return id;
+}
+
+void FixedStepScheduler::Unregister(uint32_t id) {
+	entries_.erase(std::remove_if(entries_.begin(), entries_.end(), [id](const Entry& e) { return e.id == id; }), entries_.end());
+}
+
+uint32_t FixedStepScheduler::Advance(float frameTime) {
+	if (frameTime > 0.0f) {
+		accumulator_ += frameTime;
+	}
+
+	const float stepTime = settings_.stepTime;
+	uint32_t steps = 0;
+	while (accumulator_ >= stepTime && steps < settings_.maxStepsPerFrame) {
+		Step();
+		accumulator_ -= stepTime;
+		++steps;
+	}
+
+	// 上限に達しても残っている分は捨て、端数だけ残す
+	lastDroppedStepCount_ = 0;
+	if (accumulator_ >= stepTime) {
+		const float remainder = std::fmod(accumulator_, stepTime);
+		lastDroppedStepCount_ = static_cast<uint32_t>(std::lround((accumulator_ - remainder) / stepTime));
+		accumulator_ = remainder;
+	}
+
+	lastStepCount_ = steps;
+	return steps;
+}
+
+void FixedStepScheduler::Reset() {
+	accumulator_ = 0.0f;
+	lastStepCount_ = 0;
+	lastDroppedStepCount_ = 0;
+}
+
+float FixedStepScheduler::GetInterpolationAlpha() const { return std::clamp(accumulator_ / settings_.stepTime, 0.0f, 1.0f); }
+
+void FixedStepScheduler::Step() {
+	for (const Entry& e : entries_) {
+		if (e.snapshot) {
+			e.snapshot();
+		}
+	}
+
+	// サブステップごとに全システムを進める（システム間の相互作用を同じ時間刻みで揃える）
+	const float substepTime = settings_.stepTime / static_cast<float>(settings_.substepCount);
+	for (uint32_t substep = 0; substep < settings_.substepCount; ++substep) {
+		for (const Entry& e : entries_) {
+			e.step(substepTime);
+		}
+	}
+}
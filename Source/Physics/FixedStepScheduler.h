@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+//==================================
+// 固定ステップの更新スケジューラ
+//==================================
+// 実際のフレーム時間を積算し、stepTime ごとに登録された全システムを進める。
+// 1 ステップは substepCount 回のサブステップに分かれ、各サブステップで全システムを順に呼ぶ。
+// 1 フレームで進めるステップ数は maxStepsPerFrame までで、追いつけない分は捨てる
+// （処理落ちでステップ数が増え続けるのを防ぐ）。
+// 描画は GetInterpolationAlpha() で前回と今回のステップの間を補間する。
+
+class FixedStepScheduler {
+
+public:
+	// deltaTime はサブステップ 1 回ぶんの時間
+	using StepFunction = std::function<void(float deltaTime)>;
+	// 各ステップの直前に呼ばれる（補間用に前回の状態を保存する）
+	using SnapshotFunction = std::function<void()>;
+
+	struct Settings {
+		float stepTime = 1.0f / 60.0f;
+		uint32_t substepCount = 1;
+		uint32_t maxStepsPerFrame = 5;
+	};
+
+	FixedStepScheduler() = default;
+	explicit FixedStepScheduler(const Settings& settings);
+
+	void SetSettings(const Settings& settings);
+	const Settings& GetSettings() const { return settings_; }
+
+	// 登録した番号を返す（Unregister に使う）。システムは登録順に呼ばれる
+	uint32_t Register(StepFunction step, SnapshotFunction snapshot = nullptr);
+	void Unregister(uint32_t id);
+
+	// フレーム時間を積算して必要な数だけステップを進め、実行したステップ数を返す
+	uint32_t Advance(float frameTime);
+
+	// 積算時間を 0 に戻す
+	void Reset();
+
+	// 前回のステップから次のステップまでの割合 [0, 1]（割り算の丸めで 1 ちょうどになることがある）
+	float GetInterpolationAlpha() const;
+
+	// 直近の Advance で実行したステップ数と、上限のために捨てたステップ数
+	uint32_t GetLastStepCount() const { return lastStepCount_; }
+	uint32_t GetLastDroppedStepCount() const { return lastDroppedStepCount_; }
+
+private:
+	struct Entry {
+		uint32_t id;
+		StepFunction step;
+		SnapshotFunction snapshot;
+	};
+
+	void Step();
+
+	Settings settings_;
+	std::vector<Entry> entries_;
+	uint32_t nextId_ = 0;
+	float accumulator_ = 0.0f;
+	uint32_t lastStepCount_ = 0;
+	uint32_t lastDroppedStepCount_ = 0;
+};
@@ -0,0 +1,350 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+
+namespace {
+
+constexpr uint64_t kRingMask = Profiler::kRingCapacity - 1;
+static_assert((Profiler::kRingCapacity & kRingMask) == 0, "ring capacity must be a power of two");
+
+// 周波数を測るのに最低限待つ時間
+constexpr auto kMinCalibration = std::chrono::milliseconds(10);
+
+// 読む側と書く側が同時に触るので、スロットの中身も atomic にする（x86 ではただの mov）
+struct Slot {
+	std::atomic<const char*> name{nullptr};
+	std::atomic<uint64_t> begin{0};
+	std::atomic<uint64_t> end{0};
+	std::atomic<uint32_t> depth{0};
+};
+
+struct ThreadBuffer {
+	uint32_t id = 0;
+	std::string name; // Registry::mutex で守る
+	bool inUse = true; // Registry::mutex で守る
+	uint32_t depth = 0; // 持ち主のスレッドだけが触る
+	std::atomic<uint64_t> head{0}; // これまでに書いた件数
+	std::array<Slot, Profiler::kRingCapacity> slots;
+};
+
+struct Registry {
+	std::mutex mutex;
+	std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+};
+
+// ワーカースレッドは静的オブジェクトの破棄中に終わることがあるので、登録簿は破棄しない
+Registry& GetRegistry() {
+	static Registry* registry = new Registry;
+	return *registry;
+}
+
+// スレッドの終了時にバッファを手放し、後から起動したスレッドが使い回せるようにする
+struct BufferHolder {
+	ThreadBuffer* buffer = nullptr;
+
+	~BufferHolder() {
+		if (buffer) {
+			Registry& registry = GetRegistry();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+			buffer->inUse = false;
+		}
+	}
+};
+
+thread_local BufferHolder tHolder;
+
+struct Clock {
+	uint64_t ticks;
+	std::chrono::steady_clock::time_point time;
+};
+
+// 時刻 0 の基準で、周波数の測定の起点も兼ねる
+const Clock& Origin() {
+	static const Clock origin{Profiler::Now(), std::chrono::steady_clock::now()};
+	return origin;
+}
+
+ThreadBuffer& LocalBuffer() {
+	if (tHolder.buffer) {
+		return *tHolder.buffer;
+	}
+	Origin();
+	Registry& registry = GetRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	for (const std::unique_ptr<ThreadBuffer>& buffer : registry.buffers) {
+		if (!buffer->inUse) {
+			buffer->inUse = true;
+			buffer->name.clear();
+			buffer->depth = 0;
+			tHolder.buffer = buffer.get();
+			return *buffer;
+		}
+	}
+	registry.buffers.push_back(std::make_unique<ThreadBuffer>());
+	ThreadBuffer& buffer = *registry.buffers.back();
+	buffer.id = static_cast<uint32_t>(registry.buffers.size());
+	tHolder.buffer = &buffer;
+	return buffer;
+}
+
+// 残っている記録のうち filter を満たすものを out に足す。
+// 読んでいる間に書き手が一周して上書きしたかもしれない分は捨てる
+template <typename Filter> void ReadRing(const ThreadBuffer& buffer, std::vector<ProfileEvent>& out, Filter filter) {
+	const uint64_t head = buffer.head.load(std::memory_order_acquire);
+	const uint64_t first = head > Profiler::kRingCapacity ? head - Profiler::kRingCapacity : 0;
+	const size_t start = out.size();
+	std::vector<uint64_t> indices;
+	for (uint64_t i = first; i < head; ++i) {
+		const Slot& slot = buffer.slots[i & kRingMask];
+		const ProfileEvent event = {
+		    slot.name.load(std::memory_order_relaxed),
+		    slot.begin.load(std::memory_order_relaxed),
+		    slot.end.load(std::memory_order_relaxed),
+		    slot.depth.load(std::memory_order_relaxed),
+		};
+		if (filter(event)) {
+			out.push_back(event);
+			indices.push_back(i);
+		}
+	}
+
+	// 書き手は head を進めてからでないと次のスロットを書かないので、
+	// 読み終えた後の head から、上書きが始まっていた可能性のある位置が分かる
+	std::atomic_thread_fence(std::memory_order_acquire);
+	const uint64_t after = buffer.head.load(std::memory_order_relaxed);
+	const uint64_t valid = after + 1 > Profiler::kRingCapacity ? after + 1 - Profiler::kRingCapacity : 0;
+	size_t kept = start;
+	for (size_t k = 0; k < indices.size(); ++k) {
+		if (indices[k] >= valid) {
+			out[kept++] = out[start + k];
+		}
+	}
+	out.resize(kept);
+
+	// 記録は終了の順に並んでいるので、開始の順（同時なら外側が先）に並べ直す
+	std::sort(out.begin() + static_cast<std::ptrdiff_t>(start), out.end(), [](const ProfileEvent& a, const ProfileEvent& b) {
+		return a.begin != b.begin ? a.begin < b.begin : a.depth < b.depth;
+	});
+}
+
+// 登録されている全スレッドのバッファと名前を取り出す（バッファは破棄されないので、ロックの外で読んでよい）
+std::vector<std::pair<const ThreadBuffer*, std::string>> SnapshotBuffers() {
+	Registry& registry = GetRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	std::vector<std::pair<const ThreadBuffer*, std::string>> result;
+	result.reserve(registry.buffers.size());
+	for (const std::unique_ptr<ThreadBuffer>& buffer : registry.buffers) {
+		result.emplace_back(buffer.get(), buffer->name);
+	}
+	return result;
+}
+
+std::atomic<bool> gEnabled{true};
+std::atomic<double> gTicksPerSecond{0.0};
+
+// フレームの境界の時刻（リングに最新 kFrameHistory 個）
+std::mutex gFrameMutex;
+std::array<uint64_t, Profiler::kFrameHistory> gFrameBoundaries{};
+uint64_t gFrameBoundaryCount = 0;
+
+double MeasureTicksPerSecond() {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+	const Clock& origin = Origin();
+	auto now = std::chrono::steady_clock::now();
+	while (now - origin.time < kMinCalibration) {
+		now = std::chrono::steady_clock::now();
+	}
+	const uint64_t ticks = Profiler::Now();
+	const double seconds = std::chrono::duration<double>(now - origin.time).count();
+	return static_cast<double>(ticks - origin.ticks) / seconds;
+#else
+	return static_cast<double>(std::chrono::steady_clock::period::den) / static_cast<double>(std::chrono::steady_clock::period::num);
+#endif
+}
+
+// JSON の文字列として書けるよう、引用符と制御文字をエスケープする
+void WriteJsonString(std::FILE* file, const char* text) {
+	std::fputc('"', file);
+	for (const char* c = text; *c; ++c) {
+		const unsigned char ch = static_cast<unsigned char>(*c);
+		if (ch == '"' || ch == '\\') {
+			std::fputc('\\', file);
+			std::fputc(ch, file);
+		} else if (ch < 0x20) {
+			std::fprintf(file, "\\u%04x", ch);
+		} else {
+			std::fputc(ch, file);
+		}
+	}
+	std::fputc('"', file);
+}
+
+} // namespace
+
+//==================================
+// 設定
+//==================================
+
+void Profiler::SetEnabled(bool enabled) { gEnabled.store(enabled, std::memory_order_relaxed); }
+
+bool Profiler::IsEnabled() { return gEnabled.load(std::memory_order_relaxed); }
+
+void Profiler::SetThreadName(const std::string& name) {
+	ThreadBuffer& buffer = LocalBuffer();
+	Registry& registry = GetRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+	buffer.name = name;
+}
+
+double Profiler::TicksPerSecond() {
+	const double cached = gTicksPerSecond.load(std::memory_order_relaxed);
+	return cached > 0.0 ? cached : MeasureTicksPerSecond();
+}
+
+//==================================
+// 記録
+//==================================
+
+uint32_t Profiler::EnterScope() { return LocalBuffer().depth++; }
+
+void Profiler::LeaveScope(const char* name, uint64_t begin, uint32_t depth) {
+	const uint64_t end = Now();
+	ThreadBuffer& buffer = *tHolder.buffer;
+	buffer.depth = depth;
+
+	const uint64_t index = buffer.head.load(std::memory_order_relaxed);
+	// 一周前の記録を上書きしたと読む側に分かるよう、前回進めた head をスロットより先に見せる
+	std::atomic_thread_fence(std::memory_order_release);
+	Slot& slot = buffer.slots[index & kRingMask];
+	slot.name.store(name, std::memory_order_relaxed);
+	slot.begin.store(begin, std::memory_order_relaxed);
+	slot.end.store(end, std::memory_order_relaxed);
+	slot.depth.store(depth, std::memory_order_relaxed);
+	buffer.head.store(index + 1, std::memory_order_release);
+}
+
+//==================================
+// フレーム
+//==================================
+
+void Profiler::BeginFrame() {
+	Origin();
+	const uint64_t now = Now();
+	gTicksPerSecond.store(MeasureTicksPerSecond(), std::memory_order_relaxed);
+	std::lock_guard<std::mutex> lock(gFrameMutex);
+	gFrameBoundaries[gFrameBoundaryCount % kFrameHistory] = now;
+	++gFrameBoundaryCount;
+}
+
+size_t Profiler::FrameCount() {
+	std::lock_guard<std::mutex> lock(gFrameMutex);
+	if (gFrameBoundaryCount < 2) {
+		return 0;
+	}
+	return static_cast<size_t>((std::min)(gFrameBoundaryCount - 1, uint64_t{kFrameHistory - 1}));
+}
+
+bool Profiler::CollectFrame(ProfileFrame& out, size_t ago) {
+	out.threads.clear();
+	{
+		std::lock_guard<std::mutex> lock(gFrameMutex);
+		const uint64_t available = gFrameBoundaryCount < 2 ? 0 : (std::min)(gFrameBoundaryCount - 1, uint64_t{kFrameHistory - 1});
+		if (ago >= available) {
+			return false;
+		}
+		const uint64_t last = gFrameBoundaryCount - 1 - ago;
+		out.begin = gFrameBoundaries[(last - 1) % kFrameHistory];
+		out.end = gFrameBoundaries[last % kFrameHistory];
+	}
+
+	// フレームと重なる記録を全て拾う（ジョブなどフレームをまたぐものも含む）
+	const uint64_t begin = out.begin;
+	const uint64_t end = out.end;
+	for (const auto& [buffer, name] : SnapshotBuffers()) {
+		ProfileThread thread = {buffer->id, name, {}};
+		ReadRing(*buffer, thread.events, [begin, end](const ProfileEvent& event) { return event.end > begin && event.begin < end; });
+		if (!thread.events.empty()) {
+			out.threads.push_back(std::move(thread));
+		}
+	}
+	return true;
+}
+
+void Profiler::FrameTimes(std::vector<float>& out, size_t count) {
+	out.clear();
+	const double ticksPerMillisecond = TicksPerSecond() / 1000.0;
+	std::lock_guard<std::mutex> lock(gFrameMutex);
+	if (gFrameBoundaryCount < 2) {
+		return;
+	}
+	const uint64_t available = (std::min)(gFrameBoundaryCount - 1, uint64_t{kFrameHistory - 1});
+	const uint64_t taken = (std::min)(available, uint64_t{count});
+	for (uint64_t last = gFrameBoundaryCount - taken; last < gFrameBoundaryCount; ++last) {
+		const uint64_t ticks = gFrameBoundaries[last % kFrameHistory] - gFrameBoundaries[(last - 1) % kFrameHistory];
+		out.push_back(static_cast<float>(static_cast<double>(ticks) / ticksPerMillisecond));
+	}
+}
+
+//==================================
+// Chrome trace の書き出し
+//==================================
+
+// "X"（開始と長さを持つ完了イベント）で全ての記録を、"i" でフレームの境界を、
+// "M" でスレッドの名前を書く。時刻は Origin() からのマイクロ秒
+bool Profiler::WriteChromeTrace(const std::string& path) {
+	std::FILE* file = std::fopen(path.c_str(), "wb");
+	if (!file) {
+		return false;
+	}
+	const uint64_t origin = Origin().ticks;
+	const double ticksPerMicrosecond = TicksPerSecond() / 1.0e6;
+	auto ToMicroseconds = [&](uint64_t ticks) { return ticks >= origin ? static_cast<double>(ticks - origin) / ticksPerMicrosecond : 0.0; };
+
+	std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+	bool first = true;
+	auto Separator = [&] {
+		if (!first) {
+			std::fputs(",\n", file);
+		}
+		first = false;
+	};
+
+	std::vector<ProfileEvent> events;
+	for (const auto& [buffer, name] : SnapshotBuffers()) {
+		Separator();
+		std::fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", buffer->id);
+		const std::string threadName = name.empty() ? "Thread " + std::to_string(buffer->id) : name;
+		WriteJsonString(file, threadName.c_str());
+		std::fputs("}}", file);
+
+		events.clear();
+		ReadRing(*buffer, events, [](const ProfileEvent&) { return true; });
+		for (const ProfileEvent& event : events) {
+			Separator();
+			std::fputs("{\"name\":", file);
+			WriteJsonString(file, event.name);
+			const double ts = ToMicroseconds(event.begin);
+			std::fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", buffer->id, ts, (std::max)(ToMicroseconds(event.end) - ts, 0.0));
+		}
+	}
+
+	std::vector<uint64_t> boundaries;
+	{
+		std::lock_guard<std::mutex> lock(gFrameMutex);
+		const uint64_t available = (std::min)(gFrameBoundaryCount, uint64_t{kFrameHistory});
+		for (uint64_t i = gFrameBoundaryCount - available; i < gFrameBoundaryCount; ++i) {
+			boundaries.push_back(gFrameBoundaries[i % kFrameHistory]);
+		}
+	}
+	for (uint64_t boundary : boundaries) {
+		Separator();
+		std::fprintf(file, "{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":%.3f}", ToMicroseconds(boundary));
+	}
+
+	std::fputs("\n]}\n", file);
+	return std::fclose(file) == 0;
+}
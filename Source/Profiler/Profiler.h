@@ -0,0 +1,140 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+//==================================
+// スコープ単位のプロファイラ
+//==================================
+// MT4_PROFILE_SCOPE("名前") を置いたブロックの開始と終了の時刻を記録する。
+// 時刻はタイムスタンプカウンタ（rdtsc。無い環境では steady_clock）で取り、
+// 表示や書き出しのときに steady_clock と比べて求めた周波数でマイクロ秒に直す。
+//
+// 記録はスレッドごとのリングバッファに書く。書くのはそのスレッドだけなので、
+// 1 件あたりの記録はロック無しで、スロットへの書き込みと書き込み位置の更新だけで済む。
+// 古い記録は上書きされるので、残るのはスレッドごとに直近 kRingCapacity 件まで。
+// 読む側（パネルや書き出し）は書き込み位置を読み直し、読んでいる間に上書きされた分を捨てる。
+//
+// 1 つのスコープの計測には数十 ns（rdtsc 2 回と記録 1 件）かかるので、要素ごとではなく一括処理の単位に置く。
+// MT4_PROFILE を 0 にするとマクロは何も生成せず、計測のコストは無くなる。
+// 名前は文字列リテラルなど、プログラムの終了まで残る文字列を渡すこと（ポインタだけを記録する）。
+
+#ifndef MT4_PROFILE
+#define MT4_PROFILE 1
+#endif
+
+// 記録 1 件（時刻はタイムスタンプのカウント）
+struct ProfileEvent {
+	const char* name;
+	uint64_t begin;
+	uint64_t end;
+	uint32_t depth; // 同じスレッドで入れ子になっているスコープの深さ（一番外が 0）
+};
+
+// 1 スレッド分の記録
+struct ProfileThread {
+	uint32_t id;
+	std::string name;
+	std::vector<ProfileEvent> events; // 開始時刻の順
+};
+
+// 1 フレーム分の記録
+struct ProfileFrame {
+	uint64_t begin = 0;
+	uint64_t end = 0;
+	std::vector<ProfileThread> threads;
+};
+
+class Profiler {
+
+public:
+	// スレッドごとのリングバッファの大きさ（2 の累乗）
+	static constexpr size_t kRingCapacity = size_t{1} << 14;
+	// 覚えておくフレームの境界の数
+	static constexpr size_t kFrameHistory = 256;
+
+	static uint64_t Now() {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+	}
+
+	// 実行中に記録を止める（止めている間のスコープは何も書かない）
+	static void SetEnabled(bool enabled);
+	static bool IsEnabled();
+
+	// 呼び出したスレッドに名前を付ける（パネルと書き出しに出る）
+	static void SetThreadName(const std::string& name);
+
+	// フレームの始まりに 1 回呼ぶ。直前のフレームの終わりも兼ねる
+	static void BeginFrame();
+
+	// 記録し終えたフレームの数
+	static size_t FrameCount();
+	// ago = 0 が直前に終わったフレーム。記録が上書きされたスレッドは途中から欠ける
+	static bool CollectFrame(ProfileFrame& out, size_t ago = 0);
+	// 直近のフレームの長さ（ミリ秒）を古い順に最大 count 個
+	static void FrameTimes(std::vector<float>& out, size_t count);
+
+	// カウント数と時間の変換
+	static double TicksPerSecond();
+	static double TicksToMilliseconds(uint64_t ticks) { return static_cast<double>(ticks) * 1000.0 / TicksPerSecond(); }
+
+	// リングバッファに残っている全ての記録を Chrome の trace_event 形式の JSON で書く。
+	// chrome://tracing や Perfetto で開ける。失敗したら false
+	static bool WriteChromeTrace(const std::string& path);
+
+	// ProfileScope から呼ぶ
+	static uint32_t EnterScope();
+	static void LeaveScope(const char* name, uint64_t begin, uint32_t depth);
+};
+
+//==================================
+// RAII のスコープ
+//==================================
+
+class ProfileScope {
+
+public:
+	explicit ProfileScope(const char* name) {
+		if (Profiler::IsEnabled()) {
+			name_ = name;
+			depth_ = Profiler::EnterScope();
+			begin_ = Profiler::Now();
+		}
+	}
+
+	~ProfileScope() {
+		if (name_) {
+			Profiler::LeaveScope(name_, begin_, depth_);
+		}
+	}
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+	const char* name_ = nullptr;
+	uint64_t begin_ = 0;
+	uint32_t depth_ = 0;
+};
+
+#if MT4_PROFILE
+#define MT4_PROFILE_CONCAT_INNER(a, b) a##b
+#define MT4_PROFILE_CONCAT(a, b) MT4_PROFILE_CONCAT_INNER(a, b)
+#define MT4_PROFILE_SCOPE(name) ProfileScope MT4_PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#define MT4_PROFILE_FUNCTION() MT4_PROFILE_SCOPE(__FUNCTION__)
+#else
+#define MT4_PROFILE_SCOPE(name) ((void)0)
+#define MT4_PROFILE_FUNCTION() ((void)0)
+#endif
@@ -0,0 +1,201 @@
+#include "ProfilerPanel.h"
+
+#if defined(USE_IMGUI) && __has_include(<imgui.h>)
+#include "Profiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <imgui.h>
+
+namespace {
+
+// フレーム時間のグラフに出すフレーム数
+constexpr size_t kFrameGraphLength = 120;
+// 書き出し先（作業ディレクトリからの相対パス）
+constexpr const char* kTracePath = "profile_trace.json";
+
+struct PanelState {
+	bool paused = false;
+	float zoom = 1.0f;
+	ProfileFrame frame;
+	std::vector<float> frameTimes;
+	std::string message;
+};
+
+PanelState& GetState() {
+	static PanelState state;
+	return state;
+}
+
+// 名前から決まる色（同じスコープは毎フレーム同じ色になる）
+ImU32 ScopeColor(const char* name) {
+	uint32_t hash = 2166136261u;
+	for (const char* c = name; *c; ++c) {
+		hash = (hash ^ static_cast<unsigned char>(*c)) * 16777619u;
+	}
+	const float hue = static_cast<float>(hash % 360u) / 360.0f;
+	float r;
+	float g;
+	float b;
+	ImGui::ColorConvertHSVtoRGB(hue, 0.55f, 0.85f, r, g, b);
+	return ImGui::GetColorU32(ImVec4(r, g, b, 1.0f));
+}
+
+// スコープごとの合計
+struct ScopeTotal {
+	std::string name;
+	uint32_t calls = 0;
+	double totalMs = 0.0;
+	double maxMs = 0.0;
+};
+
+void DrawTimeline(const ProfileFrame& frame, float zoom) {
+	const double frameTicks = static_cast<double>(frame.end - frame.begin);
+	if (frameTicks <= 0.0) {
+		return;
+	}
+	const float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+	float height = 0.0f;
+	for (const ProfileThread& thread : frame.threads) {
+		uint32_t maxDepth = 0;
+		for (const ProfileEvent& event : thread.events) {
+			maxDepth = (std::max)(maxDepth, event.depth);
+		}
+		height += ImGui::GetTextLineHeightWithSpacing() + static_cast<float>(maxDepth + 1) * rowHeight + ImGui::GetStyle().ItemSpacing.y;
+	}
+
+	ImGui::BeginChild("Timeline", ImVec2(0.0f, (std::min)(height + ImGui::GetStyle().ScrollbarSize, 400.0f)), true, ImGuiWindowFlags_HorizontalScrollbar);
+	const float width = ImGui::GetContentRegionAvail().x * zoom;
+	ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+	for (const ProfileThread& thread : frame.threads) {
+		if (thread.name.empty()) {
+			ImGui::Text("Thread %u", thread.id);
+		} else {
+			ImGui::TextUnformatted(thread.name.c_str());
+		}
+
+		const ImVec2 origin = ImGui::GetCursorScreenPos();
+		uint32_t maxDepth = 0;
+		for (const ProfileEvent& event : thread.events) {
+			maxDepth = (std::max)(maxDepth, event.depth);
+			// フレームの外にはみ出した部分は端で切る
+			const double begin = std::clamp(static_cast<double>(event.begin) - static_cast<double>(frame.begin), 0.0, frameTicks);
+			const double end = std::clamp(static_cast<double>(event.end) - static_cast<double>(frame.begin), 0.0, frameTicks);
+			const float x0 = origin.x + static_cast<float>(begin / frameTicks) * width;
+			const float x1 = (std::max)(origin.x + static_cast<float>(end / frameTicks) * width, x0 + 1.0f);
+			const float y0 = origin.y + static_cast<float>(event.depth) * rowHeight;
+			const ImVec2 rectMin(x0, y0);
+			const ImVec2 rectMax(x1, y0 + rowHeight - 1.0f);
+
+			drawList->AddRectFilled(rectMin, rectMax, ScopeColor(event.name));
+			if (x1 - x0 > 8.0f) {
+				drawList->PushClipRect(rectMin, rectMax, true);
+				drawList->AddText(ImVec2(x0 + 2.0f, y0 + 2.0f), IM_COL32(0, 0, 0, 255), event.name);
+				drawList->PopClipRect();
+			}
+			if (ImGui::IsMouseHoveringRect(rectMin, rectMax)) {
+				ImGui::SetTooltip("%s\n%.3f ms", event.name, Profiler::TicksToMilliseconds(event.end - event.begin));
+			}
+		}
+		ImGui::Dummy(ImVec2(width, static_cast<float>(maxDepth + 1) * rowHeight));
+	}
+	ImGui::EndChild();
+}
+
+void DrawTotals(const ProfileFrame& frame) {
+	std::vector<ScopeTotal> totals;
+	std::unordered_map<std::string, size_t> lookup;
+	for (const ProfileThread& thread : frame.threads) {
+		for (const ProfileEvent& event : thread.events) {
+			auto [it, inserted] = lookup.try_emplace(event.name, totals.size());
+			if (inserted) {
+				totals.push_back({event.name});
+			}
+			ScopeTotal& total = totals[it->second];
+			const double ms = Profiler::TicksToMilliseconds(event.end - event.begin);
+			++total.calls;
+			total.totalMs += ms;
+			total.maxMs = (std::max)(total.maxMs, ms);
+		}
+	}
+	std::sort(totals.begin(), totals.end(), [](const ScopeTotal& a, const ScopeTotal& b) { return a.totalMs > b.totalMs; });
+
+	const ImGuiTableFlags flags = ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg;
+	if (ImGui::BeginTable("ProfilerTotals", 4, flags)) {
+		ImGui::TableSetupColumn("Scope", ImGuiTableColumnFlags_WidthStretch);
+		ImGui::TableSetupColumn("Calls");
+		ImGui::TableSetupColumn("Total (ms)");
+		ImGui::TableSetupColumn("Max (ms)");
+		ImGui::TableHeadersRow();
+		for (const ScopeTotal& total : totals) {
+			ImGui::TableNextRow();
+			ImGui::TableSetColumnIndex(0);
+			ImGui::TextUnformatted(total.name.c_str());
+			ImGui::TableSetColumnIndex(1);
+			ImGui::Text("%u", total.calls);
+			ImGui::TableSetColumnIndex(2);
+			ImGui::Text("%.3f", total.totalMs);
+			ImGui::TableSetColumnIndex(3);
+			ImGui::Text("%.3f", total.maxMs);
+		}
+		ImGui::EndTable();
+	}
+}
+
+} // namespace
+
+void DrawProfilerPanel() {
+	PanelState& state = GetState();
+	ImGui::Begin("Profiler");
+
+#if !MT4_PROFILE
+	ImGui::TextUnformatted("MT4_PROFILE is 0: scopes are compiled out");
+#endif
+
+	bool enabled = Profiler::IsEnabled();
+	if (ImGui::Checkbox("Record", &enabled)) {
+		Profiler::SetEnabled(enabled);
+	}
+	ImGui::SameLine();
+	ImGui::Checkbox("Pause", &state.paused);
+	ImGui::SameLine();
+	if (ImGui::Button("Export Chrome trace")) {
+		state.message = Profiler::WriteChromeTrace(kTracePath) ? std::string("Wrote ") + kTracePath : std::string("Failed to write ") + kTracePath;
+	}
+	if (!state.message.empty()) {
+		ImGui::SameLine();
+		ImGui::TextUnformatted(state.message.c_str());
+	}
+
+	// 一時停止中は最後に取ったフレームを表示したままにする（記録は続く）
+	if (!state.paused) {
+		Profiler::FrameTimes(state.frameTimes, kFrameGraphLength);
+		Profiler::CollectFrame(state.frame, 0);
+	}
+
+	if (!state.frameTimes.empty()) {
+		const float maxTime = *std::max_element(state.frameTimes.begin(), state.frameTimes.end());
+		char overlay[32];
+		std::snprintf(overlay, sizeof(overlay), "%.2f ms", state.frameTimes.back());
+		ImGui::PlotLines("Frame", state.frameTimes.data(), static_cast<int>(state.frameTimes.size()), 0, overlay, 0.0f, maxTime * 1.2f, ImVec2(0.0f, 50.0f));
+	}
+
+	if (state.frame.end > state.frame.begin) {
+		ImGui::Text("Frame: %.3f ms", Profiler::TicksToMilliseconds(state.frame.end - state.frame.begin));
+		ImGui::SliderFloat("Zoom", &state.zoom, 1.0f, 20.0f, "%.1fx");
+		DrawTimeline(state.frame, state.zoom);
+		DrawTotals(state.frame);
+	}
+
+	ImGui::End();
+}
+
+#else
+
+void DrawProfilerPanel() {}
+
+#endif
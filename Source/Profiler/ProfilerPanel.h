@@ -0,0 +1,11 @@
+#pragma once
+
+//==================================
+// プロファイラの ImGui パネル
+//==================================
+// 直前のフレームの記録をスレッドごとのタイムライン（入れ子の深さを段に積んだフレームグラフ）で表示し、
+// フレーム時間のグラフとスコープごとの合計時間の表、Chrome trace の書き出しボタンを並べる。
+// ImGui のフレームの中（ImGuiManager::Begin と End の間）で毎フレーム呼ぶ。
+// USE_IMGUI が無い構成では何もしない。
+
+void DrawProfilerPanel();
@@ -0,0 +1,84 @@
+#include "DualQuaternion.h"
+#include <cmath>
+
+DualQuaternion::DualQuaternion() : real(0.0f, 0.0f, 0.0f, 1.0f), dual(0.0f, 0.0f, 0.0f, 0.0f) {}
+
+DualQuaternion::DualQuaternion(const Quaternion& real, const Quaternion& dual) : real(real), dual(dual) {}
+
+DualQuaternion DualQuaternion::Identity() { return DualQuaternion(); }
+
+DualQuaternion DualQuaternion::FromRotationTranslation(const Quaternion& rotation, const Vector3& translate) {
+	// dual = 0.5 * t * r
+	const Quaternion t(translate.x * 0.5f, translate.y * 0.5f, translate.z * 0.5f, 0.0f);
+	return DualQuaternion(rotation, Quaternion::Muyltiply(t, rotation));
+}
+
+// (lr + ε ld)(rr + ε rd) = lr rr + ε (lr rd + ld rr)
+DualQuaternion DualQuaternion::Multiply(const DualQuaternion& lhs, const DualQuaternion& rhs) {
+	const Quaternion a = Quaternion::Muyltiply(lhs.real, rhs.dual);
+	const Quaternion b = Quaternion::Muyltiply(lhs.dual, rhs.real);
+	return DualQuaternion(Quaternion::Muyltiply(lhs.real, rhs.real), Quaternion(a.x + b.x, a.y + b.y, a.z + b.z, a.w + b.w));
+}
+
+DualQuaternion DualQuaternion::Normalize(const DualQuaternion& dq) {
+	constexpr float kEps = 1.0e-6f;
+	const float n = Quaternion::Norm(dq.real);
+	if (n < kEps) {
+		return Identity();
+	}
+
+	const float inv = 1.0f / n;
+	const Quaternion r(dq.real.x * inv, dq.real.y * inv, dq.real.z * inv, dq.real.w * inv);
+	Quaternion d(dq.dual.x * inv, dq.dual.y * inv, dq.dual.z * inv, dq.dual.w * inv);
+
+	// real と dual が直交するように dual を補正する（単位双対Quaternionの条件）
+	const float rd = r.x * d.x + r.y * d.y + r.z * d.z + r.w * d.w;
+	d = Quaternion(d.x - r.x * rd, d.y - r.y * rd, d.z - r.z * rd, d.w - r.w * rd);
+	return DualQuaternion(r, d);
+}
+
+DualQuaternion DualQuaternion::Conjugate(const DualQuaternion& dq) { return DualQuaternion(Quaternion::Conjugate(dq.real), Quaternion::Conjugate(dq.dual)); }
+
+DualQuaternion DualQuaternion::Blend(const DualQuaternion* dqs, const float* weights, size_t count) {
+	if (count == 0) {
+		return Identity();
+	}
+
+	const Quaternion& pivot = dqs[0].real;
+	DualQuaternion sum(Quaternion(0.0f, 0.0f, 0.0f, 0.0f), Quaternion(0.0f, 0.0f, 0.0f, 0.0f));
+	for (size_t i = 0; i < count; ++i) {
+		const DualQuaternion& dq = dqs[i];
+		// q と -q は同じ回転なので、逆向きのものは重みを反転して短い経路で足す
+		const float dot = pivot.x * dq.real.x + pivot.y * dq.real.y + pivot.z * dq.real.z + pivot.w * dq.real.w;
+		const float w = dot < 0.0f ? -weights[i] : weights[i];
+		sum.real = Quaternion(sum.real.x + w * dq.real.x, sum.real.y + w * dq.real.y, sum.real.z + w * dq.real.z, sum.real.w + w * dq.real.w);
+		sum.dual = Quaternion(sum.dual.x + w * dq.dual.x, sum.dual.y + w * dq.dual.y, sum.dual.z + w * dq.dual.z, sum.dual.w + w * dq.dual.w);
+	}
+	return Normalize(sum);
+}
+
+// t = 2 * dual * conj(real) のベクトル部
+Vector3 DualQuaternion::GetTranslate(const DualQuaternion& dq) {
+	const Quaternion& r = dq.real;
+	const Quaternion& d = dq.dual;
+	return Vector3(
+	    2.0f * (r.w * d.x - d.w * r.x + (r.y * d.z - r.z * d.y)), 2.0f * (r.w * d.y - d.w * r.y + (r.z * d.x - r.x * d.z)),
+	    2.0f * (r.w * d.z - d.w * r.z + (r.x * d.y - r.y * d.x)));
+}
+
+Vector3 DualQuaternion::TransformPoint(const DualQuaternion& dq, const Vector3& point) {
+	const Vector3 rotated = Quaternion::RotateVectorNormalized(point, dq.real);
+	const Vector3 t = GetTranslate(dq);
+	return Vector3(rotated.x + t.x, rotated.y + t.y, rotated.z + t.z);
+}
+
+Vector3 DualQuaternion::TransformDirection(const DualQuaternion& dq, const Vector3& direction) { return Quaternion::RotateVectorNormalized(direction, dq.real); }
+
+Matrix4x4 DualQuaternion::MakeMatrix(const DualQuaternion& dq) {
+	Matrix4x4 m = Quaternion::MakeRotateMatrix(dq.real);
+	const Vector3 t = GetTranslate(dq);
+	m.m[3][0] = t.x;
+	m.m[3][1] = t.y;
+	m.m[3][2] = t.z;
+	return m;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "Quaternion.h"
+
+//==================================
+// 双対Quaternion（回転 + 平行移動）
+//==================================
+// real が回転、dual が 0.5 * t * real（t は平行移動を純Quaternionにしたもの）。
+// 行列 16 個の代わりに float 8 個で剛体変換を表し、スキニングのブレンドでも体積が潰れない。
+
+class DualQuaternion {
+
+public:
+	Quaternion real;
+	Quaternion dual;
+
+	// デフォルトは恒等変換
+	DualQuaternion();
+	DualQuaternion(const Quaternion& real, const Quaternion& dual);
+
+	static DualQuaternion Identity();
+
+	// 回転してから平行移動する変換（rotation は単位Quaternion）
+	static DualQuaternion FromRotationTranslation(const Quaternion& rotation, const Vector3& translate);
+
+	// 変換の合成。Quaternion::Muyltiply と同じく rhs を先に適用する
+	static DualQuaternion Multiply(const DualQuaternion& lhs, const DualQuaternion& rhs);
+
+	// 単位双対Quaternionにする（real の norm が 0 に近い場合は恒等変換）
+	static DualQuaternion Normalize(const DualQuaternion& dq);
+
+	// 共役（単位双対Quaternionなら逆変換）
+	static DualQuaternion Conjugate(const DualQuaternion& dq);
+
+	// 重み付き線形ブレンド（DLB）。real の向きを dqs[0] に揃えてから足し、正規化する
+	static DualQuaternion Blend(const DualQuaternion* dqs, const float* weights, size_t count);
+
+	// 平行移動成分を取り出す
+	static Vector3 GetTranslate(const DualQuaternion& dq);
+
+	// 単位双対Quaternionで点・方向ベクトルを変換
+	static Vector3 TransformPoint(const DualQuaternion& dq, const Vector3& point);
+	static Vector3 TransformDirection(const DualQuaternion& dq, const Vector3& direction);
+
+	static Matrix4x4 MakeMatrix(const DualQuaternion& dq);
+};
+
+static_assert(sizeof(DualQuaternion) == sizeof(float) * 8, "DualQuaternion must be 8 packed floats");
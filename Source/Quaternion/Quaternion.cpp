@@ -1,4 +1,6 @@
 #include "Quaternion.h"
+#include "Math/CpuFeatures.h"
+#include "Math/SimdMath.h"
 #include <cmath>
 #include <algorithm>
 
@@ -83,17 +85,48 @@ Quaternion Quaternion::MakeRotateAxisAngleQuaternion(const Vector3& axis, float
 // ベクトルをQuaternionで回転（q * v * q^-1）
 Vector3 Quaternion::RottateVector(const Vector3& vector, const Quaternion& quaternion) {
 	// 安全のため正規化（回転として使うなら本来は単位Quaternion想定）
-	const Quaternion q = Normalize(quaternion);
+	return RotateVectorNormalized(vector, Normalize(quaternion));
+}
+
+// 単位Quaternionなら q * v * q^-1 = v + w * t + u × t（u = (x, y, z), t = 2 * u × v）
+// Inverse と 2 回の積を展開するより乗算が少ない
+Vector3 Quaternion::RotateVectorNormalized(const Vector3& vector, const Quaternion& q) {
+	const float tx = 2.0f * (q.y * vector.z - q.z * vector.y);
+	const float ty = 2.0f * (q.z * vector.x - q.x * vector.z);
+	const float tz = 2.0f * (q.x * vector.y - q.y * vector.x);
 
-	// ベクトルを純Quaternion化（w=0）
-	const Quaternion p(vector.x, vector.y, vector.z, 0.0f);
+	return Vector3(vector.x + q.w * tx + (q.y * tz - q.z * ty), vector.y + q.w * ty + (q.z * tx - q.x * tz), vector.z + q.w * tz + (q.x * ty - q.y * tx));
+}
 
-	// r = q * p * q^{-1}
-	const Quaternion qInv = Inverse(q);
-	const Quaternion qp = Muyltiply(q, p);
-	const Quaternion r = Muyltiply(qp, qInv);
+void Quaternion::RotateVectors(const Quaternion& quaternion, const Vector3* in, Vector3* out, size_t n) {
+	const Quaternion q = Normalize(quaternion);
+	size_t i = 0;
+
+#if defined(MT4_SSE2)
+	// 4 つずつ SoA に並べ替えて RotateVectorNormalized と同じ順序で計算する
+	if (GetSimdLevel() != SimdLevel::Scalar) {
+		const __m128 qx = _mm_set1_ps(q.x);
+		const __m128 qy = _mm_set1_ps(q.y);
+		const __m128 qz = _mm_set1_ps(q.z);
+		const __m128 qw = _mm_set1_ps(q.w);
+		const __m128 two = _mm_set1_ps(2.0f);
+		for (; i + 4 <= n; i += 4) {
+			__m128 x, y, z;
+			SimdMath::LoadVector3x4(&in[i].x, x, y, z);
+			const __m128 tx = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qy, z), _mm_mul_ps(qz, y)));
+			const __m128 ty = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qz, x), _mm_mul_ps(qx, z)));
+			const __m128 tz = _mm_mul_ps(two, _mm_sub_ps(_mm_mul_ps(qx, y), _mm_mul_ps(qy, x)));
+			x = _mm_add_ps(_mm_add_ps(x, _mm_mul_ps(qw, tx)), _mm_sub_ps(_mm_mul_ps(qy, tz), _mm_mul_ps(qz, ty)));
+			y = _mm_add_ps(_mm_add_ps(y, _mm_mul_ps(qw, ty)), _mm_sub_ps(_mm_mul_ps(qz, tx), _mm_mul_ps(qx, tz)));
+			z = _mm_add_ps(_mm_add_ps(z, _mm_mul_ps(qw, tz)), _mm_sub_ps(_mm_mul_ps(qx, ty), _mm_mul_ps(qy, tx)));
+			SimdMath::StoreVector3x4(&out[i].x, x, y, z);
+		}
+	}
+#endif
 
-	return Vector3(r.x, r.y, r.z);
+	for (; i < n; ++i) {
+		out[i] = RotateVectorNormalized(in[i], q);
+	}
 }
 
 Matrix4x4 Quaternion::MakeRotateMatrix(const Quaternion& quaternion) {
@@ -139,6 +172,209 @@ Matrix4x4 Quaternion::MakeRotateMatrix(const Quaternion& quaternion) {
 	return m;
 }
 
+// 対角成分の大小で w, x, y, z のうち最も大きい成分を選び、その成分で割る（Day の方法）。
+// 分岐は 2 段だけで、どの回転でも平方根の中が 1 以上になる
+Quaternion Quaternion::FromRotationMatrix(const Matrix4x4& matrix) {
+	const float m00 = matrix.m[0][0], m01 = matrix.m[0][1], m02 = matrix.m[0][2];
+	const float m10 = matrix.m[1][0], m11 = matrix.m[1][1], m12 = matrix.m[1][2];
+	const float m20 = matrix.m[2][0], m21 = matrix.m[2][1], m22 = matrix.m[2][2];
+
+	float t;
+	Quaternion q;
+	if (m22 < 0.0f) {
+		if (m00 > m11) {
+			t = 1.0f + m00 - m11 - m22;
+			q = Quaternion(t, m01 + m10, m20 + m02, m12 - m21);
+		} else {
+			t = 1.0f - m00 + m11 - m22;
+			q = Quaternion(m01 + m10, t, m12 + m21, m20 - m02);
+		}
+	} else {
+		if (m00 < -m11) {
+			t = 1.0f - m00 - m11 + m22;
+			q = Quaternion(m20 + m02, m12 + m21, t, m01 - m10);
+		} else {
+			t = 1.0f + m00 + m11 + m22;
+			q = Quaternion(m12 - m21, m20 - m02, m01 - m10, t);
+		}
+	}
+
+	const float s = 0.5f / std::sqrt(t);
+	return Quaternion(q.x * s, q.y * s, q.z * s, q.w * s);
+}
+
+bool Quaternion::Decompose(const Matrix4x4& matrix, Vector3& scale, Quaternion& rotation, Vector3& translate) {
+	constexpr float kEps = 1.0e-6f;
+	const float(*m)[4] = matrix.m;
+
+	translate = Vector3(m[3][0], m[3][1], m[3][2]);
+
+	// 各行の長さが拡大縮小
+	scale.x = std::sqrt(m[0][0] * m[0][0] + m[0][1] * m[0][1] + m[0][2] * m[0][2]);
+	scale.y = std::sqrt(m[1][0] * m[1][0] + m[1][1] * m[1][1] + m[1][2] * m[1][2]);
+	scale.z = std::sqrt(m[2][0] * m[2][0] + m[2][1] * m[2][1] + m[2][2] * m[2][2]);
+
+	if (scale.x < kEps || scale.y < kEps || scale.z < kEps) {
+		rotation = IdentityQuaternion();
+		return false;
+	}
+
+	// 鏡映を含む場合は x 軸を反転した回転とみなす
+	const float det = m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1]) + m[0][1] * (m[1][2] * m[2][0] - m[1][0] * m[2][2]) + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+	if (det < 0.0f) {
+		scale.x = -scale.x;
+	}
+
+	const float inv[3] = {1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z};
+	Matrix4x4 r{};
+	for (int i = 0; i < 3; ++i) {
+		for (int j = 0; j < 3; ++j) {
+			r.m[i][j] = m[i][j] * inv[i];
+		}
+	}
+	rotation = FromRotationMatrix(r);
+	return true;
+}
+
+#if defined(MT4_SSE2)
+
+namespace {
+
+// 4 つの行列の左上 3x3 を要素ごとに並べたもの（e[i][j] の各レーンが 1 つの行列）
+struct Matrix3x3x4 {
+	__m128 e[3][3];
+};
+
+Matrix3x3x4 LoadMatrix3x3x4(const Matrix4x4* matrices) {
+	Matrix3x3x4 r;
+	for (int i = 0; i < 3; ++i) {
+		__m128 c0 = _mm_loadu_ps(matrices[0].m[i]);
+		__m128 c1 = _mm_loadu_ps(matrices[1].m[i]);
+		__m128 c2 = _mm_loadu_ps(matrices[2].m[i]);
+		__m128 c3 = _mm_loadu_ps(matrices[3].m[i]);
+		_MM_TRANSPOSE4_PS(c0, c1, c2, c3);
+		r.e[i][0] = c0;
+		r.e[i][1] = c1;
+		r.e[i][2] = c2;
+	}
+	return r;
+}
+
+// FromRotationMatrix の 4 つの場合をすべて計算して選ぶ
+void FromRotationMatrix4(const Matrix3x3x4& m, Quaternion* out) {
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 m00 = m.e[0][0], m01 = m.e[0][1], m02 = m.e[0][2];
+	const __m128 m10 = m.e[1][0], m11 = m.e[1][1], m12 = m.e[1][2];
+	const __m128 m20 = m.e[2][0], m21 = m.e[2][1], m22 = m.e[2][2];
+
+	const __m128 s01 = _mm_add_ps(m01, m10);
+	const __m128 s20 = _mm_add_ps(m20, m02);
+	const __m128 s12 = _mm_add_ps(m12, m21);
+	const __m128 d12 = _mm_sub_ps(m12, m21);
+	const __m128 d20 = _mm_sub_ps(m20, m02);
+	const __m128 d01 = _mm_sub_ps(m01, m10);
+
+	const __m128 tx = _mm_sub_ps(_mm_sub_ps(_mm_add_ps(one, m00), m11), m22);
+	const __m128 ty = _mm_sub_ps(_mm_add_ps(_mm_sub_ps(one, m00), m11), m22);
+	const __m128 tz = _mm_add_ps(_mm_sub_ps(_mm_sub_ps(one, m00), m11), m22);
+	const __m128 tw = _mm_add_ps(_mm_add_ps(_mm_add_ps(one, m00), m11), m22);
+
+	const __m128 negZ = _mm_cmplt_ps(m22, zero);
+	const __m128 pickX = _mm_cmpgt_ps(m00, m11);
+	const __m128 pickZ = _mm_cmplt_ps(m00, _mm_sub_ps(zero, m11));
+
+	using SimdMath::Select;
+	const __m128 t = Select(negZ, Select(pickX, tx, ty), Select(pickZ, tz, tw));
+	__m128 x = Select(negZ, Select(pickX, tx, s01), Select(pickZ, s20, d12));
+	__m128 y = Select(negZ, Select(pickX, s01, ty), Select(pickZ, s12, d20));
+	__m128 z = Select(negZ, Select(pickX, s20, s12), Select(pickZ, tz, d01));
+	__m128 w = Select(negZ, Select(pickX, d12, d20), Select(pickZ, d01, tw));
+
+	const __m128 s = _mm_div_ps(_mm_set1_ps(0.5f), _mm_sqrt_ps(t));
+	x = _mm_mul_ps(x, s);
+	y = _mm_mul_ps(y, s);
+	z = _mm_mul_ps(z, s);
+	w = _mm_mul_ps(w, s);
+	_MM_TRANSPOSE4_PS(x, y, z, w);
+	_mm_storeu_ps(&out[0].x, x);
+	_mm_storeu_ps(&out[1].x, y);
+	_mm_storeu_ps(&out[2].x, z);
+	_mm_storeu_ps(&out[3].x, w);
+}
+
+} // namespace
+
+#endif
+
+void Quaternion::FromRotationMatrices(const Matrix4x4* matrices, Quaternion* out, size_t n) {
+	size_t i = 0;
+#if defined(MT4_SSE2)
+	if (GetSimdLevel() != SimdLevel::Scalar) {
+		for (; i + 4 <= n; i += 4) {
+			FromRotationMatrix4(LoadMatrix3x3x4(matrices + i), out + i);
+		}
+	}
+#endif
+	for (; i < n; ++i) {
+		out[i] = FromRotationMatrix(matrices[i]);
+	}
+}
+
+void Quaternion::DecomposeMany(const Matrix4x4* matrices, Vector3* scales, Quaternion* rotations, Vector3* translates, size_t n) {
+	size_t i = 0;
+#if defined(MT4_SSE2)
+	if (GetSimdLevel() != SimdLevel::Scalar) {
+		const __m128 eps = _mm_set1_ps(1.0e-6f);
+		const __m128 one = _mm_set1_ps(1.0f);
+		for (; i + 4 <= n; i += 4) {
+			Matrix3x3x4 m = LoadMatrix3x3x4(matrices + i);
+			__m128 s[3];
+			for (int r = 0; r < 3; ++r) {
+				s[r] = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m.e[r][0], m.e[r][0]), _mm_mul_ps(m.e[r][1], m.e[r][1])), _mm_mul_ps(m.e[r][2], m.e[r][2])));
+			}
+			// 拡大縮小が 0 に近いものがあれば 1 つずつの版で処理する
+			const __m128 degenerate = _mm_or_ps(_mm_or_ps(_mm_cmplt_ps(s[0], eps), _mm_cmplt_ps(s[1], eps)), _mm_cmplt_ps(s[2], eps));
+			if (_mm_movemask_ps(degenerate) != 0) {
+				for (size_t k = i; k < i + 4; ++k) {
+					Decompose(matrices[k], scales[k], rotations[k], translates[k]);
+				}
+				continue;
+			}
+
+			const __m128 det = _mm_add_ps(
+			    _mm_add_ps(
+			        _mm_mul_ps(m.e[0][0], _mm_sub_ps(_mm_mul_ps(m.e[1][1], m.e[2][2]), _mm_mul_ps(m.e[1][2], m.e[2][1]))),
+			        _mm_mul_ps(m.e[0][1], _mm_sub_ps(_mm_mul_ps(m.e[1][2], m.e[2][0]), _mm_mul_ps(m.e[1][0], m.e[2][2])))),
+			    _mm_mul_ps(m.e[0][2], _mm_sub_ps(_mm_mul_ps(m.e[1][0], m.e[2][1]), _mm_mul_ps(m.e[1][1], m.e[2][0]))));
+			const __m128 mirror = _mm_and_ps(_mm_cmplt_ps(det, _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+			s[0] = _mm_xor_ps(s[0], mirror);
+
+			for (int r = 0; r < 3; ++r) {
+				const __m128 inv = _mm_div_ps(one, s[r]);
+				for (int c = 0; c < 3; ++c) {
+					m.e[r][c] = _mm_mul_ps(m.e[r][c], inv);
+				}
+			}
+			FromRotationMatrix4(m, rotations + i);
+
+			alignas(16) float sx[4], sy[4], sz[4];
+			_mm_store_ps(sx, s[0]);
+			_mm_store_ps(sy, s[1]);
+			_mm_store_ps(sz, s[2]);
+			for (size_t k = 0; k < 4; ++k) {
+				scales[i + k] = Vector3(sx[k], sy[k], sz[k]);
+				const float* row = matrices[i + k].m[3];
+				translates[i + k] = Vector3(row[0], row[1], row[2]);
+			}
+		}
+	}
+#endif
+	for (; i < n; ++i) {
+		Decompose(matrices[i], scales[i], rotations[i], translates[i]);
+	}
+}
+
 Quaternion Quaternion::Slerp(const Quaternion& q0In, const Quaternion& q1In, float t) {
 	// q0,q1 は単位Quaternion
 	Quaternion q0 = q0In;
@@ -185,3 +421,29 @@ Quaternion Quaternion::Slerp(const Quaternion& q0In, const Quaternion& q1In, flo
 	// ------------------------------
 	return Quaternion(scale0 * q0.x + scale1 * q1.x, scale0 * q0.y + scale1 * q1.y, scale0 * q0.z + scale1 * q1.z, scale0 * q0.w + scale1 * q1.w);
 }
+
+Quaternion Quaternion::SlerpFast(const Quaternion& q0, const Quaternion& q1, float t) {
+	const float dot = q0.x * q1.x + q0.y * q1.y + q0.z * q1.z + q0.w * q1.w;
+	const float d = std::fabs(dot);
+
+	// Nlerp は両端に近いほど進みが遅く中央で速いので、
+	// θ（= |dot|）に応じた 3 次式で t を補正して角速度を一定に近づける
+	const float ka = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+	const float kb = 0.848013f + d * (-1.06021f + d * 0.215638f);
+	const float u = t - 0.5f;
+	const float k = ka * u * u + kb;
+	const float ct = t + t * u * (t - 1.0f) * k;
+
+	// Slerp と同じく dot < 0 なら q0 を反転
+	const float scale0 = dot < 0.0f ? -(1.0f - ct) : 1.0f - ct;
+	const float scale1 = ct;
+
+	return Normalize(Quaternion(scale0 * q0.x + scale1 * q1.x, scale0 * q0.y + scale1 * q1.y, scale0 * q0.z + scale1 * q1.z, scale0 * q0.w + scale1 * q1.w));
+}
+
+Quaternion Quaternion::Slerp(const Quaternion& q0, const Quaternion& q1, float t, SlerpMode mode) {
+	if (mode == SlerpMode::Fast) {
+		return SlerpFast(q0, q1, t);
+	}
+	return Slerp(q0, q1, t);
+}
@@ -1,8 +1,15 @@
 #pragma once
-#include <KamataEngine.h>
+#include "Math/MathTypes.h"
+#include <cstddef>
 
 using namespace KamataEngine;
 
+// Slerp の計算方法
+enum class SlerpMode {
+	Exact, // acos / sin を使う
+	Fast,  // 補正付き Nlerp（三角関数なし、最大誤差は SlerpFast を参照）
+};
+
 class Quaternion {
 
 public:
@@ -38,8 +45,34 @@ public:
 	// ベクトルをQuaternionで回転させた結果を返す
 	static Vector3 RottateVector(const Vector3& vector, const Quaternion& quaternion);
 
+	// quaternion が正規化済みの場合の回転（Normalize を省略する）
+	static Vector3 RotateVectorNormalized(const Vector3& vector, const Quaternion& quaternion);
+
+	// 頂点・法線の配列をまとめて回転（quaternion は最初に 1 回だけ正規化する）。
+	// 結果は RotateVectorNormalized(in[i], Normalize(quaternion)) と一致する。out は in と同じ配列でもよい
+	static void RotateVectors(const Quaternion& quaternion, const Vector3* in, Vector3* out, size_t n);
+
 	// Quaternionから回転行列を求める
 	static Matrix4x4 MakeRotateMatrix(const Quaternion& quaternion);
 
+	// 回転行列（左上 3x3）からQuaternionを求める（MakeRotateMatrix の逆）
+	static Quaternion FromRotationMatrix(const Matrix4x4& matrix);
+
+	// MakeAffineMatrix で作った行列を拡大縮小・回転・平行移動に分解する。
+	// 行列式が負なら scale.x を負にする。拡大縮小が 0 に近い場合は rotation を単位Quaternionにして false を返す
+	static bool Decompose(const Matrix4x4& matrix, Vector3& scale, Quaternion& rotation, Vector3& translate);
+
+	// バッチ版（SSE2 で 4 つずつ処理し、結果は 1 つずつの版と一致する）
+	static void FromRotationMatrices(const Matrix4x4* matrices, Quaternion* out, size_t n);
+	static void DecomposeMany(const Matrix4x4* matrices, Vector3* scales, Quaternion* rotations, Vector3* translates, size_t n);
+
 	static Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t);
+
+	// 三角関数を使わない近似 Slerp（t を 3 次多項式で補正した Nlerp）。
+	// 単位Quaternion同士なら Slerp との回転角の差は 1e-3 rad（約 0.06 度）以下、
+	// 2 つの回転の差が 90 度以内なら 1e-4 rad 以下（実測の最大はそれぞれ 7.8e-4 rad と 7.3e-5 rad）。結果は正規化される。
+	// 上限は MathAccuracyBenchmark の --filter Quaternion/SlerpFast で確かめる
+	static Quaternion SlerpFast(const Quaternion& q0, const Quaternion& q1, float t);
+
+	static Quaternion Slerp(const Quaternion& q0, const Quaternion& q1, float t, SlerpMode mode);
 };
@@ -0,0 +1,608 @@
+#include "QuaternionBatch.h"
+#include "Math/CpuFeatures.h"
+#include "Math/SimdMath.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <new>
+#include <utility>
+
+namespace {
+
+constexpr float kEps = 1.0e-6f;
+
+enum class Interpolation {
+	Nlerp,
+	Slerp,
+	FastSlerp,
+};
+
+struct ConstStreams {
+	const float* x;
+	const float* y;
+	const float* z;
+	const float* w;
+
+	explicit ConstStreams(const QuaternionBatch& q) : x(q.X()), y(q.Y()), z(q.Z()), w(q.W()) {}
+};
+
+struct Streams {
+	float* x;
+	float* y;
+	float* z;
+	float* w;
+
+	explicit Streams(QuaternionBatch& q) : x(q.X()), y(q.Y()), z(q.Z()), w(q.W()) {}
+};
+
+//==================================
+// スカラー版
+//==================================
+// SIMD 版と同じ演算順序にしてあるので、Multiply / Conjugate / Normalize / Nlerp / 高速 Slerp は結果が一致する
+
+inline void NormalizeOne(float& x, float& y, float& z, float& w) {
+	const float n = std::sqrt(w * w + x * x + y * y + z * z);
+	if (n < kEps) {
+		x = 0.0f;
+		y = 0.0f;
+		z = 0.0f;
+		w = 1.0f;
+		return;
+	}
+	const float inv = 1.0f / n;
+	x *= inv;
+	y *= inv;
+	z *= inv;
+	w *= inv;
+}
+
+void MultiplyScalar(const ConstStreams& a, const ConstStreams& b, const Streams& out, size_t begin, size_t n) {
+	for (size_t i = begin; i < n; ++i) {
+		const Quaternion r = Quaternion::Muyltiply({a.x[i], a.y[i], a.z[i], a.w[i]}, {b.x[i], b.y[i], b.z[i], b.w[i]});
+		out.x[i] = r.x;
+		out.y[i] = r.y;
+		out.z[i] = r.z;
+		out.w[i] = r.w;
+	}
+}
+
+void NormalizeScalar(const ConstStreams& in, const Streams& out, size_t begin, size_t n) {
+	for (size_t i = begin; i < n; ++i) {
+		float x = in.x[i], y = in.y[i], z = in.z[i], w = in.w[i];
+		NormalizeOne(x, y, z, w);
+		out.x[i] = x;
+		out.y[i] = y;
+		out.z[i] = z;
+		out.w[i] = w;
+	}
+}
+
+// tStride が 0 なら全要素で t[0] を使う
+void NlerpScalar(const ConstStreams& a, const ConstStreams& b, const float* t, size_t tStride, const Streams& out, size_t begin, size_t n) {
+	for (size_t i = begin; i < n; ++i) {
+		const float ti = t[i * tStride];
+		const float dot = a.x[i] * b.x[i] + a.y[i] * b.y[i] + a.z[i] * b.z[i] + a.w[i] * b.w[i];
+		// dot < 0 なら q1 を反転して短い経路にする
+		const float s1 = dot < 0.0f ? -ti : ti;
+		const float s0 = 1.0f - ti;
+		float x = s0 * a.x[i] + s1 * b.x[i];
+		float y = s0 * a.y[i] + s1 * b.y[i];
+		float z = s0 * a.z[i] + s1 * b.z[i];
+		float w = s0 * a.w[i] + s1 * b.w[i];
+		NormalizeOne(x, y, z, w);
+		out.x[i] = x;
+		out.y[i] = y;
+		out.z[i] = z;
+		out.w[i] = w;
+	}
+}
+
+void SlerpScalar(const ConstStreams& a, const ConstStreams& b, const float* t, size_t tStride, const Streams& out, size_t begin, size_t n) {
+	for (size_t i = begin; i < n; ++i) {
+		const Quaternion r = Quaternion::Slerp({a.x[i], a.y[i], a.z[i], a.w[i]}, {b.x[i], b.y[i], b.z[i], b.w[i]}, t[i * tStride]);
+		out.x[i] = r.x;
+		out.y[i] = r.y;
+		out.z[i] = r.z;
+		out.w[i] = r.w;
+	}
+}
+
+void FastSlerpScalar(const ConstStreams& a, const ConstStreams& b, const float* t, size_t tStride, const Streams& out, size_t begin, size_t n) {
+	for (size_t i = begin; i < n; ++i) {
+		const Quaternion r = Quaternion::SlerpFast({a.x[i], a.y[i], a.z[i], a.w[i]}, {b.x[i], b.y[i], b.z[i], b.w[i]}, t[i * tStride]);
+		out.x[i] = r.x;
+		out.y[i] = r.y;
+		out.z[i] = r.z;
+		out.w[i] = r.w;
+	}
+}
+
+#if defined(MT4_SSE2)
+
+//==================================
+// SSE2 版（4 要素ずつ）
+//==================================
+
+struct Quat4 {
+	__m128 x, y, z, w;
+};
+
+inline Quat4 Load4(const ConstStreams& s, size_t i) { return {_mm_load_ps(s.x + i), _mm_load_ps(s.y + i), _mm_load_ps(s.z + i), _mm_load_ps(s.w + i)}; }
+
+inline void Store4(const Streams& s, size_t i, const Quat4& q) {
+	_mm_store_ps(s.x + i, q.x);
+	_mm_store_ps(s.y + i, q.y);
+	_mm_store_ps(s.z + i, q.z);
+	_mm_store_ps(s.w + i, q.w);
+}
+
+inline Quat4 Normalize4(const Quat4& q) {
+	const __m128 n = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(q.w, q.w), _mm_mul_ps(q.x, q.x)), _mm_mul_ps(q.y, q.y)), _mm_mul_ps(q.z, q.z)));
+	const __m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), n);
+	const __m128 degenerate = _mm_cmplt_ps(n, _mm_set1_ps(kEps));
+	const __m128 zero = _mm_setzero_ps();
+	return {
+	    SimdMath::Select(degenerate, zero, _mm_mul_ps(q.x, inv)),
+	    SimdMath::Select(degenerate, zero, _mm_mul_ps(q.y, inv)),
+	    SimdMath::Select(degenerate, zero, _mm_mul_ps(q.z, inv)),
+	    SimdMath::Select(degenerate, _mm_set1_ps(1.0f), _mm_mul_ps(q.w, inv)),
+	};
+}
+
+inline __m128 Dot4(const Quat4& a, const Quat4& b) {
+	return _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a.x, b.x), _mm_mul_ps(a.y, b.y)), _mm_mul_ps(a.z, b.z)), _mm_mul_ps(a.w, b.w));
+}
+
+// s0 * a + s1 * b
+inline Quat4 Combine4(const Quat4& a, const Quat4& b, __m128 s0, __m128 s1) {
+	return {
+	    _mm_add_ps(_mm_mul_ps(s0, a.x), _mm_mul_ps(s1, b.x)),
+	    _mm_add_ps(_mm_mul_ps(s0, a.y), _mm_mul_ps(s1, b.y)),
+	    _mm_add_ps(_mm_mul_ps(s0, a.z), _mm_mul_ps(s1, b.z)),
+	    _mm_add_ps(_mm_mul_ps(s0, a.w), _mm_mul_ps(s1, b.w)),
+	};
+}
+
+void MultiplySSE2(const ConstStreams& a, const ConstStreams& b, const Streams& out, size_t n) {
+	for (size_t i = 0; i < n; i += 4) {
+		const Quat4 l = Load4(a, i);
+		const Quat4 r = Load4(b, i);
+		Quat4 q;
+		q.w = _mm_sub_ps(_mm_sub_ps(_mm_sub_ps(_mm_mul_ps(l.w, r.w), _mm_mul_ps(l.x, r.x)), _mm_mul_ps(l.y, r.y)), _mm_mul_ps(l.z, r.z));
+		q.x = _mm_sub_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(l.w, r.x), _mm_mul_ps(l.x, r.w)), _mm_mul_ps(l.y, r.z)), _mm_mul_ps(l.z, r.y));
+		q.y = _mm_add_ps(_mm_add_ps(_mm_sub_ps(_mm_mul_ps(l.w, r.y), _mm_mul_ps(l.x, r.z)), _mm_mul_ps(l.y, r.w)), _mm_mul_ps(l.z, r.x));
+		q.z = _mm_add_ps(_mm_sub_ps(_mm_add_ps(_mm_mul_ps(l.w, r.z), _mm_mul_ps(l.x, r.y)), _mm_mul_ps(l.y, r.x)), _mm_mul_ps(l.z, r.w));
+		Store4(out, i, q);
+	}
+}
+
+void NormalizeSSE2(const ConstStreams& in, const Streams& out, size_t n) {
+	for (size_t i = 0; i < n; i += 4) {
+		Store4(out, i, Normalize4(Load4(in, i)));
+	}
+}
+
+inline Quat4 Nlerp4(const Quat4& a, const Quat4& b, __m128 t) {
+	// dot < 0 なら q1 を反転する（t の符号を反転するのと同じ）
+	const __m128 negative = _mm_cmplt_ps(Dot4(a, b), _mm_setzero_ps());
+	const __m128 s0 = _mm_sub_ps(_mm_set1_ps(1.0f), t);
+	const __m128 s1 = _mm_xor_ps(t, _mm_and_ps(negative, _mm_set1_ps(-0.0f)));
+	return Normalize4(Combine4(a, b, s0, s1));
+}
+
+inline Quat4 Slerp4(const Quat4& a, const Quat4& b, __m128 t) {
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 dot = Dot4(a, b);
+	// dot < 0 のときは q0 を反転する代わりに s0 の符号を反転する
+	const __m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+	const __m128 cosTheta = _mm_min_ps(SimdMath::Abs(dot), one);
+
+	const __m128 theta = SimdMath::Acos(cosTheta);
+	const __m128 sinTheta = _mm_sqrt_ps(_mm_sub_ps(one, _mm_mul_ps(cosTheta, cosTheta)));
+	const __m128 invT = _mm_sub_ps(one, t);
+
+	__m128 sin0, sin1, unused;
+	SimdMath::SinCos(_mm_mul_ps(invT, theta), sin0, unused);
+	SimdMath::SinCos(_mm_mul_ps(t, theta), sin1, unused);
+
+	// sinθ が 0 に近いときは Lerp
+	const __m128 nearlyParallel = _mm_cmplt_ps(sinTheta, _mm_set1_ps(kEps));
+	const __m128 s0 = SimdMath::Select(nearlyParallel, invT, _mm_div_ps(sin0, sinTheta));
+	const __m128 s1 = SimdMath::Select(nearlyParallel, t, _mm_div_ps(sin1, sinTheta));
+	return Combine4(a, b, _mm_xor_ps(s0, flip), s1);
+}
+
+// Quaternion::SlerpFast と同じ演算順序
+inline Quat4 FastSlerp4(const Quat4& a, const Quat4& b, __m128 t) {
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+	const __m128 dot = Dot4(a, b);
+	const __m128 d = SimdMath::Abs(dot);
+
+	__m128 ka = _mm_sub_ps(_mm_set1_ps(3.55645f), _mm_mul_ps(d, _mm_set1_ps(1.43519f)));
+	ka = _mm_add_ps(_mm_set1_ps(-3.2452f), _mm_mul_ps(d, ka));
+	ka = _mm_add_ps(_mm_set1_ps(1.0904f), _mm_mul_ps(d, ka));
+	__m128 kb = _mm_add_ps(_mm_set1_ps(-1.06021f), _mm_mul_ps(d, _mm_set1_ps(0.215638f)));
+	kb = _mm_add_ps(_mm_set1_ps(0.848013f), _mm_mul_ps(d, kb));
+
+	const __m128 u = _mm_sub_ps(t, half);
+	const __m128 k = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(ka, u), u), kb);
+	const __m128 ct = _mm_add_ps(t, _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, u), _mm_sub_ps(t, one)), k));
+
+	const __m128 flip = _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+	const __m128 s0 = _mm_xor_ps(_mm_sub_ps(one, ct), flip);
+	return Normalize4(Combine4(a, b, s0, ct));
+}
+
+template <Interpolation Mode> inline Quat4 Interpolate4(const Quat4& a, const Quat4& b, __m128 t) {
+	if constexpr (Mode == Interpolation::Slerp) {
+		return Slerp4(a, b, t);
+	} else if constexpr (Mode == Interpolation::FastSlerp) {
+		return FastSlerp4(a, b, t);
+	} else {
+		return Nlerp4(a, b, t);
+	}
+}
+
+template <Interpolation Mode> void InterpolateSSE2(const ConstStreams& a, const ConstStreams& b, const float* t, size_t tStride, const Streams& out, size_t size, size_t n) {
+	alignas(16) float tail[4] = {};
+	const __m128 uniformT = _mm_set1_ps(t[0]);
+	for (size_t i = 0; i < n; i += 4) {
+		__m128 ti = uniformT;
+		if (tStride != 0) {
+			if (i + 4 <= size) {
+				ti = _mm_loadu_ps(t + i);
+			} else {
+				// 末尾は Size() を超えて t を読まないよう退避してから読む
+				std::fill(tail, tail + 4, 0.0f);
+				std::copy(t + std::min(i, size), t + size, tail);
+				ti = _mm_load_ps(tail);
+			}
+		}
+		const Quat4 qa = Load4(a, i);
+		const Quat4 qb = Load4(b, i);
+		Store4(out, i, Interpolate4<Mode>(qa, qb, ti));
+	}
+}
+
+//==================================
+// AVX2 版（8 要素ずつ）
+//==================================
+
+struct Quat8 {
+	__m256 x, y, z, w;
+};
+
+MT4_TARGET_AVX2 inline Quat8 Load8(const ConstStreams& s, size_t i) {
+	return {_mm256_load_ps(s.x + i), _mm256_load_ps(s.y + i), _mm256_load_ps(s.z + i), _mm256_load_ps(s.w + i)};
+}
+
+MT4_TARGET_AVX2 inline void Store8(const Streams& s, size_t i, const Quat8& q) {
+	_mm256_store_ps(s.x + i, q.x);
+	_mm256_store_ps(s.y + i, q.y);
+	_mm256_store_ps(s.z + i, q.z);
+	_mm256_store_ps(s.w + i, q.w);
+}
+
+MT4_TARGET_AVX2 inline Quat8 Normalize8(const Quat8& q) {
+	const __m256 n =
+	    _mm256_sqrt_ps(_mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(q.w, q.w), _mm256_mul_ps(q.x, q.x)), _mm256_mul_ps(q.y, q.y)), _mm256_mul_ps(q.z, q.z)));
+	const __m256 inv = _mm256_div_ps(_mm256_set1_ps(1.0f), n);
+	const __m256 degenerate = _mm256_cmp_ps(n, _mm256_set1_ps(kEps), _CMP_LT_OQ);
+	const __m256 zero = _mm256_setzero_ps();
+	return {
+	    SimdMath::Select(degenerate, zero, _mm256_mul_ps(q.x, inv)),
+	    SimdMath::Select(degenerate, zero, _mm256_mul_ps(q.y, inv)),
+	    SimdMath::Select(degenerate, zero, _mm256_mul_ps(q.z, inv)),
+	    SimdMath::Select(degenerate, _mm256_set1_ps(1.0f), _mm256_mul_ps(q.w, inv)),
+	};
+}
+
+MT4_TARGET_AVX2 inline __m256 Dot8(const Quat8& a, const Quat8& b) {
+	return _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a.x, b.x), _mm256_mul_ps(a.y, b.y)), _mm256_mul_ps(a.z, b.z)), _mm256_mul_ps(a.w, b.w));
+}
+
+MT4_TARGET_AVX2 inline Quat8 Combine8(const Quat8& a, const Quat8& b, __m256 s0, __m256 s1) {
+	return {
+	    _mm256_add_ps(_mm256_mul_ps(s0, a.x), _mm256_mul_ps(s1, b.x)),
+	    _mm256_add_ps(_mm256_mul_ps(s0, a.y), _mm256_mul_ps(s1, b.y)),
+	    _mm256_add_ps(_mm256_mul_ps(s0, a.z), _mm256_mul_ps(s1, b.z)),
+	    _mm256_add_ps(_mm256_mul_ps(s0, a.w), _mm256_mul_ps(s1, b.w)),
+	};
+}
+
+MT4_TARGET_AVX2 void MultiplyAVX2(const ConstStreams& a, const ConstStreams& b, const Streams& out, size_t n) {
+	for (size_t i = 0; i < n; i += 8) {
+		const Quat8 l = Load8(a, i);
+		const Quat8 r = Load8(b, i);
+		Quat8 q;
+		q.w = _mm256_sub_ps(_mm256_sub_ps(_mm256_sub_ps(_mm256_mul_ps(l.w, r.w), _mm256_mul_ps(l.x, r.x)), _mm256_mul_ps(l.y, r.y)), _mm256_mul_ps(l.z, r.z));
+		q.x = _mm256_sub_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(l.w, r.x), _mm256_mul_ps(l.x, r.w)), _mm256_mul_ps(l.y, r.z)), _mm256_mul_ps(l.z, r.y));
+		q.y = _mm256_add_ps(_mm256_add_ps(_mm256_sub_ps(_mm256_mul_ps(l.w, r.y), _mm256_mul_ps(l.x, r.z)), _mm256_mul_ps(l.y, r.w)), _mm256_mul_ps(l.z, r.x));
+		q.z = _mm256_add_ps(_mm256_sub_ps(_mm256_add_ps(_mm256_mul_ps(l.w, r.z), _mm256_mul_ps(l.x, r.y)), _mm256_mul_ps(l.y, r.x)), _mm256_mul_ps(l.z, r.w));
+		Store8(out, i, q);
+	}
+}
+
+MT4_TARGET_AVX2 void NormalizeAVX2(const ConstStreams& in, const Streams& out, size_t n) {
+	for (size_t i = 0; i < n; i += 8) {
+		Store8(out, i, Normalize8(Load8(in, i)));
+	}
+}
+
+MT4_TARGET_AVX2 inline Quat8 Nlerp8(const Quat8& a, const Quat8& b, __m256 t) {
+	const __m256 dot = Dot8(a, b);
+	const __m256 negative = _mm256_cmp_ps(dot, _mm256_setzero_ps(), _CMP_LT_OQ);
+	const __m256 s0 = _mm256_sub_ps(_mm256_set1_ps(1.0f), t);
+	const __m256 s1 = _mm256_xor_ps(t, _mm256_and_ps(negative, _mm256_set1_ps(-0.0f)));
+	return Normalize8(Combine8(a, b, s0, s1));
+}
+
+MT4_TARGET_AVX2 inline Quat8 Slerp8(const Quat8& a, const Quat8& b, __m256 t) {
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 dot = Dot8(a, b);
+	const __m256 flip = _mm256_and_ps(_mm256_cmp_ps(dot, _mm256_setzero_ps(), _CMP_LT_OQ), _mm256_set1_ps(-0.0f));
+	const __m256 cosTheta = _mm256_min_ps(SimdMath::Abs(dot), one);
+
+	const __m256 theta = SimdMath::Acos(cosTheta);
+	const __m256 sinTheta = _mm256_sqrt_ps(_mm256_sub_ps(one, _mm256_mul_ps(cosTheta, cosTheta)));
+	const __m256 invT = _mm256_sub_ps(one, t);
+
+	__m256 sin0, sin1, unused;
+	SimdMath::SinCos(_mm256_mul_ps(invT, theta), sin0, unused);
+	SimdMath::SinCos(_mm256_mul_ps(t, theta), sin1, unused);
+
+	const __m256 nearlyParallel = _mm256_cmp_ps(sinTheta, _mm256_set1_ps(kEps), _CMP_LT_OQ);
+	const __m256 s0 = SimdMath::Select(nearlyParallel, invT, _mm256_div_ps(sin0, sinTheta));
+	const __m256 s1 = SimdMath::Select(nearlyParallel, t, _mm256_div_ps(sin1, sinTheta));
+	return Combine8(a, b, _mm256_xor_ps(s0, flip), s1);
+}
+
+MT4_TARGET_AVX2 inline Quat8 FastSlerp8(const Quat8& a, const Quat8& b, __m256 t) {
+	const __m256 one = _mm256_set1_ps(1.0f);
+	const __m256 half = _mm256_set1_ps(0.5f);
+	const __m256 dot = Dot8(a, b);
+	const __m256 d = SimdMath::Abs(dot);
+
+	__m256 ka = _mm256_sub_ps(_mm256_set1_ps(3.55645f), _mm256_mul_ps(d, _mm256_set1_ps(1.43519f)));
+	ka = _mm256_add_ps(_mm256_set1_ps(-3.2452f), _mm256_mul_ps(d, ka));
+	ka = _mm256_add_ps(_mm256_set1_ps(1.0904f), _mm256_mul_ps(d, ka));
+	__m256 kb = _mm256_add_ps(_mm256_set1_ps(-1.06021f), _mm256_mul_ps(d, _mm256_set1_ps(0.215638f)));
+	kb = _mm256_add_ps(_mm256_set1_ps(0.848013f), _mm256_mul_ps(d, kb));
+
+	const __m256 u = _mm256_sub_ps(t, half);
+	const __m256 k = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(ka, u), u), kb);
+	const __m256 ct = _mm256_add_ps(t, _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(t, u), _mm256_sub_ps(t, one)), k));
+
+	const __m256 flip = _mm256_and_ps(_mm256_cmp_ps(dot, _mm256_setzero_ps(), _CMP_LT_OQ), _mm256_set1_ps(-0.0f));
+	const __m256 s0 = _mm256_xor_ps(_mm256_sub_ps(one, ct), flip);
+	return Normalize8(Combine8(a, b, s0, ct));
+}
+
+template <Interpolation Mode> MT4_TARGET_AVX2 inline Quat8 Interpolate8(const Quat8& a, const Quat8& b, __m256 t) {
+	if constexpr (Mode == Interpolation::Slerp) {
+		return Slerp8(a, b, t);
+	} else if constexpr (Mode == Interpolation::FastSlerp) {
+		return FastSlerp8(a, b, t);
+	} else {
+		return Nlerp8(a, b, t);
+	}
+}
+
+template <Interpolation Mode>
+MT4_TARGET_AVX2 void InterpolateAVX2(const ConstStreams& a, const ConstStreams& b, const float* t, size_t tStride, const Streams& out, size_t size, size_t n) {
+	alignas(32) float tail[8] = {};
+	const __m256 uniformT = _mm256_set1_ps(t[0]);
+	for (size_t i = 0; i < n; i += 8) {
+		__m256 ti = uniformT;
+		if (tStride != 0) {
+			if (i + 8 <= size) {
+				ti = _mm256_loadu_ps(t + i);
+			} else {
+				std::fill(tail, tail + 8, 0.0f);
+				std::copy(t + std::min(i, size), t + size, tail);
+				ti = _mm256_load_ps(tail);
+			}
+		}
+		const Quat8 qa = Load8(a, i);
+		const Quat8 qb = Load8(b, i);
+		Store8(out, i, Interpolate8<Mode>(qa, qb, ti));
+	}
+}
+
+#endif
+
+template <Interpolation Mode> void Interpolate(const QuaternionBatch& q0, const QuaternionBatch& q1, const float* t, size_t tStride, QuaternionBatch& out) {
+	assert(q0.Size() == q1.Size());
+	out.Resize(q0.Size());
+	if (q0.Size() == 0) {
+		return;
+	}
+	const ConstStreams a(q0), b(q1);
+	const Streams o(out);
+	switch (GetSimdLevel()) {
+#if defined(MT4_SSE2)
+	case SimdLevel::AVX2:
+		InterpolateAVX2<Mode>(a, b, t, tStride, o, q0.Size(), q0.PaddedSize());
+		return;
+	case SimdLevel::SSE2:
+		InterpolateSSE2<Mode>(a, b, t, tStride, o, q0.Size(), q0.PaddedSize());
+		return;
+#endif
+	default:
+		break;
+	}
+	if constexpr (Mode == Interpolation::Slerp) {
+		SlerpScalar(a, b, t, tStride, o, 0, q0.Size());
+	} else if constexpr (Mode == Interpolation::FastSlerp) {
+		FastSlerpScalar(a, b, t, tStride, o, 0, q0.Size());
+	} else {
+		NlerpScalar(a, b, t, tStride, o, 0, q0.Size());
+	}
+}
+
+} // namespace
+
+QuaternionBatch::QuaternionBatch(size_t count) { Resize(count); }
+
+QuaternionBatch::QuaternionBatch(const QuaternionBatch& other) { *this = other; }
+
+QuaternionBatch::QuaternionBatch(QuaternionBatch&& other) noexcept { *this = std::move(other); }
+
+QuaternionBatch& QuaternionBatch::operator=(const QuaternionBatch& other) {
+	if (this == &other) {
+		return *this;
+	}
+	if (capacity_ != other.capacity_) {
+		Release();
+		Allocate(other.capacity_);
+	}
+	size_ = other.size_;
+	if (capacity_ > 0) {
+		std::copy(other.data_, other.data_ + capacity_ * 4, data_);
+	}
+	return *this;
+}
+
+QuaternionBatch& QuaternionBatch::operator=(QuaternionBatch&& other) noexcept {
+	if (this == &other) {
+		return *this;
+	}
+	Release();
+	data_ = std::exchange(other.data_, nullptr);
+	x_ = std::exchange(other.x_, nullptr);
+	y_ = std::exchange(other.y_, nullptr);
+	z_ = std::exchange(other.z_, nullptr);
+	w_ = std::exchange(other.w_, nullptr);
+	size_ = std::exchange(other.size_, 0);
+	capacity_ = std::exchange(other.capacity_, 0);
+	return *this;
+}
+
+QuaternionBatch::~QuaternionBatch() { Release(); }
+
+void QuaternionBatch::Allocate(size_t capacity) {
+	capacity_ = capacity;
+	if (capacity == 0) {
+		return;
+	}
+	data_ = static_cast<float*>(::operator new[](sizeof(float) * capacity * 4, std::align_val_t(kAlignment)));
+	x_ = data_;
+	y_ = data_ + capacity;
+	z_ = data_ + capacity * 2;
+	w_ = data_ + capacity * 3;
+}
+
+void QuaternionBatch::Release() {
+	if (data_) {
+		::operator delete[](data_, std::align_val_t(kAlignment));
+	}
+	data_ = x_ = y_ = z_ = w_ = nullptr;
+	size_ = 0;
+	capacity_ = 0;
+}
+
+void QuaternionBatch::Resize(size_t count) {
+	const size_t capacity = (count + kLaneCount - 1) / kLaneCount * kLaneCount;
+	size_t keep = std::min(size_, count);
+
+	if (capacity > capacity_) {
+		QuaternionBatch old = std::move(*this);
+		Allocate(capacity);
+		std::copy(old.x_, old.x_ + keep, x_);
+		std::copy(old.y_, old.y_ + keep, y_);
+		std::copy(old.z_, old.z_ + keep, z_);
+		std::copy(old.w_, old.w_ + keep, w_);
+	}
+
+	// 増えた要素と余りの要素は単位 Quaternion
+	std::fill(x_ + keep, x_ + capacity_, 0.0f);
+	std::fill(y_ + keep, y_ + capacity_, 0.0f);
+	std::fill(z_ + keep, z_ + capacity_, 0.0f);
+	std::fill(w_ + keep, w_ + capacity_, 1.0f);
+	size_ = count;
+}
+
+void QuaternionBatch::Set(size_t index, const Quaternion& q) {
+	assert(index < size_);
+	x_[index] = q.x;
+	y_[index] = q.y;
+	z_[index] = q.z;
+	w_[index] = q.w;
+}
+
+Quaternion QuaternionBatch::Get(size_t index) const {
+	assert(index < size_);
+	return Quaternion(x_[index], y_[index], z_[index], w_[index]);
+}
+
+void QuaternionBatch::Multiply(const QuaternionBatch& lhs, const QuaternionBatch& rhs, QuaternionBatch& out) {
+	assert(lhs.Size() == rhs.Size());
+	out.Resize(lhs.Size());
+	const ConstStreams a(lhs), b(rhs);
+	const Streams o(out);
+	switch (GetSimdLevel()) {
+#if defined(MT4_SSE2)
+	case SimdLevel::AVX2:
+		MultiplyAVX2(a, b, o, lhs.PaddedSize());
+		return;
+	case SimdLevel::SSE2:
+		MultiplySSE2(a, b, o, lhs.PaddedSize());
+		return;
+#endif
+	default:
+		MultiplyScalar(a, b, o, 0, lhs.Size());
+		return;
+	}
+}
+
+void QuaternionBatch::Conjugate(const QuaternionBatch& in, QuaternionBatch& out) {
+	out.Resize(in.Size());
+	// 符号反転だけなのでコンパイラの自動ベクトル化に任せる
+	const size_t n = in.PaddedSize();
+	for (size_t i = 0; i < n; ++i) {
+		out.x_[i] = -in.x_[i];
+		out.y_[i] = -in.y_[i];
+		out.z_[i] = -in.z_[i];
+		out.w_[i] = in.w_[i];
+	}
+}
+
+void QuaternionBatch::Normalize(const QuaternionBatch& in, QuaternionBatch& out) {
+	out.Resize(in.Size());
+	const ConstStreams a(in);
+	const Streams o(out);
+	switch (GetSimdLevel()) {
+#if defined(MT4_SSE2)
+	case SimdLevel::AVX2:
+		NormalizeAVX2(a, o, in.PaddedSize());
+		return;
+	case SimdLevel::SSE2:
+		NormalizeSSE2(a, o, in.PaddedSize());
+		return;
+#endif
+	default:
+		NormalizeScalar(a, o, 0, in.Size());
+		return;
+	}
+}
+
+void QuaternionBatch::Nlerp(const QuaternionBatch& q0, const QuaternionBatch& q1, float t, QuaternionBatch& out) { Interpolate<Interpolation::Nlerp>(q0, q1, &t, 0, out); }
+
+void QuaternionBatch::Nlerp(const QuaternionBatch& q0, const QuaternionBatch& q1, const float* t, QuaternionBatch& out) { Interpolate<Interpolation::Nlerp>(q0, q1, t, 1, out); }
+
+void QuaternionBatch::Slerp(const QuaternionBatch& q0, const QuaternionBatch& q1, float t, QuaternionBatch& out, SlerpMode mode) {
+	if (mode == SlerpMode::Fast) {
+		Interpolate<Interpolation::FastSlerp>(q0, q1, &t, 0, out);
+	} else {
+		Interpolate<Interpolation::Slerp>(q0, q1, &t, 0, out);
+	}
+}
+
+void QuaternionBatch::Slerp(const QuaternionBatch& q0, const QuaternionBatch& q1, const float* t, QuaternionBatch& out, SlerpMode mode) {
+	if (mode == SlerpMode::Fast) {
+		Interpolate<Interpolation::FastSlerp>(q0, q1, t, 1, out);
+	} else {
+		Interpolate<Interpolation::Slerp>(q0, q1, t, 1, out);
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "Quaternion.h"
+#include <cstddef>
+
+//==================================
+// Quaternion の SoA バッチ
+//==================================
+// x, y, z, w をそれぞれ 32byte 境界に揃えた別配列で持ち、
+// スケルトンの全ジョイントなど大量の Quaternion を 4 / 8 個ずつ SIMD で処理する。
+// 配列は kLaneCount の倍数に切り上げて確保し、余りの要素は単位 Quaternion で埋める。
+// 演算の出力先は入力と同じバッチでもよい。
+
+class QuaternionBatch {
+
+public:
+	static constexpr size_t kAlignment = 32;
+	static constexpr size_t kLaneCount = 8;
+
+	QuaternionBatch() = default;
+	explicit QuaternionBatch(size_t count);
+	QuaternionBatch(const QuaternionBatch& other);
+	QuaternionBatch(QuaternionBatch&& other) noexcept;
+	QuaternionBatch& operator=(const QuaternionBatch& other);
+	QuaternionBatch& operator=(QuaternionBatch&& other) noexcept;
+	~QuaternionBatch();
+
+	// 既存の要素は保持し、増えた要素は単位 Quaternion にする
+	void Resize(size_t count);
+
+	size_t Size() const { return size_; }
+
+	// Size() を kLaneCount の倍数に切り上げた数（SIMD 版が処理する範囲）。
+	// Resize で縮めても確保数は減らないので、確保数とは一致しないことがある
+	size_t PaddedSize() const { return (size_ + kLaneCount - 1) / kLaneCount * kLaneCount; }
+
+	void Set(size_t index, const Quaternion& q);
+	Quaternion Get(size_t index) const;
+
+	float* X() { return x_; }
+	float* Y() { return y_; }
+	float* Z() { return z_; }
+	float* W() { return w_; }
+	const float* X() const { return x_; }
+	const float* Y() const { return y_; }
+	const float* Z() const { return z_; }
+	const float* W() const { return w_; }
+
+	// Quaternionの積 out[i] = lhs[i] * rhs[i]
+	static void Multiply(const QuaternionBatch& lhs, const QuaternionBatch& rhs, QuaternionBatch& out);
+
+	// 共役Quaternion
+	static void Conjugate(const QuaternionBatch& in, QuaternionBatch& out);
+
+	// 正規化（norm が 0 に近いものは単位 Quaternion）
+	static void Normalize(const QuaternionBatch& in, QuaternionBatch& out);
+
+	// 短い経路側へ線形補間して正規化
+	static void Nlerp(const QuaternionBatch& q0, const QuaternionBatch& q1, float t, QuaternionBatch& out);
+	static void Nlerp(const QuaternionBatch& q0, const QuaternionBatch& q1, const float* t, QuaternionBatch& out);
+
+	// 球面線形補間（Quaternion::Slerp と同じ規則。acos / sin は多項式近似）
+	// SlerpMode::Fast は Quaternion::SlerpFast と同じ近似で、結果も一致する。
+	// t を配列で渡す版は要素ごとに補間係数を変える（Size() 個）
+	static void Slerp(const QuaternionBatch& q0, const QuaternionBatch& q1, float t, QuaternionBatch& out, SlerpMode mode = SlerpMode::Exact);
+	static void Slerp(const QuaternionBatch& q0, const QuaternionBatch& q1, const float* t, QuaternionBatch& out, SlerpMode mode = SlerpMode::Exact);
+
+private:
+	void Allocate(size_t capacity);
+	void Release();
+
+	float* data_ = nullptr;
+	float* x_ = nullptr;
+	float* y_ = nullptr;
+	float* z_ = nullptr;
+	float* w_ = nullptr;
+	size_t size_ = 0;
+	size_t capacity_ = 0;
+};
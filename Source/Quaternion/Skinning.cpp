@@ -0,0 +1,126 @@
+#include "Skinning.h"
+#include "Job/ParallelFor.h"
+#include "Math/CpuFeatures.h"
+#include "Profiler/Profiler.h"
+#include <cassert>
+#include <cmath>
+
+namespace {
+
+// 1 頂点ぶんのブレンド結果（正規化済み）
+struct BlendedBone {
+	float r[4]; // real の x, y, z, w
+	float d[4]; // dual の x, y, z, w
+};
+
+// DualQuaternion::Blend と同じ規則（最初のボーンに向きを揃えて足し、|real| で割る）。
+// 重みの合計が 1 に近い前提なので dual の直交補正は省く
+inline BlendedBone BlendInfluences(const DualQuaternion* bones, const SkinInfluences& influences, size_t vertex) {
+	BlendedBone b{};
+	const float* pivot = &bones[influences.boneIndex[0][vertex]].real.x;
+
+#if defined(MT4_SSE2)
+	const __m128 p = _mm_loadu_ps(pivot);
+	__m128 real = _mm_setzero_ps();
+	__m128 dual = _mm_setzero_ps();
+	for (uint32_t k = 0; k < influences.influenceCount; ++k) {
+		const float* bone = &bones[influences.boneIndex[k][vertex]].real.x;
+		const __m128 br = _mm_loadu_ps(bone);
+		const __m128 bd = _mm_loadu_ps(bone + 4);
+		// 内積の符号で重みを反転する
+		__m128 dot = _mm_mul_ps(p, br);
+		dot = _mm_add_ps(dot, _mm_shuffle_ps(dot, dot, _MM_SHUFFLE(2, 3, 0, 1)));
+		dot = _mm_add_ps(dot, _mm_shuffle_ps(dot, dot, _MM_SHUFFLE(1, 0, 3, 2)));
+		const __m128 sign = _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), _mm_set1_ps(-0.0f));
+		const __m128 w = _mm_xor_ps(_mm_set1_ps(influences.weight[k][vertex]), sign);
+		real = _mm_add_ps(real, _mm_mul_ps(w, br));
+		dual = _mm_add_ps(dual, _mm_mul_ps(w, bd));
+	}
+	__m128 lengthSq = _mm_mul_ps(real, real);
+	lengthSq = _mm_add_ps(lengthSq, _mm_shuffle_ps(lengthSq, lengthSq, _MM_SHUFFLE(2, 3, 0, 1)));
+	lengthSq = _mm_add_ps(lengthSq, _mm_shuffle_ps(lengthSq, lengthSq, _MM_SHUFFLE(1, 0, 3, 2)));
+	const __m128 inv = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSq));
+	_mm_storeu_ps(b.r, _mm_mul_ps(real, inv));
+	_mm_storeu_ps(b.d, _mm_mul_ps(dual, inv));
+#else
+	for (uint32_t k = 0; k < influences.influenceCount; ++k) {
+		const float* bone = &bones[influences.boneIndex[k][vertex]].real.x;
+		const float dot = pivot[0] * bone[0] + pivot[1] * bone[1] + pivot[2] * bone[2] + pivot[3] * bone[3];
+		const float w = dot < 0.0f ? -influences.weight[k][vertex] : influences.weight[k][vertex];
+		for (int c = 0; c < 4; ++c) {
+			b.r[c] += w * bone[c];
+			b.d[c] += w * bone[c + 4];
+		}
+	}
+	const float inv = 1.0f / std::sqrt(b.r[0] * b.r[0] + b.r[1] * b.r[1] + b.r[2] * b.r[2] + b.r[3] * b.r[3]);
+	for (int c = 0; c < 4; ++c) {
+		b.r[c] *= inv;
+		b.d[c] *= inv;
+	}
+#endif
+	return b;
+}
+
+// DualQuaternion::TransformPoint / TransformDirection と同じ式
+inline void Rotate(const float* r, float& x, float& y, float& z) {
+	const float tx = 2.0f * (r[1] * z - r[2] * y);
+	const float ty = 2.0f * (r[2] * x - r[0] * z);
+	const float tz = 2.0f * (r[0] * y - r[1] * x);
+	const float rx = x + r[3] * tx + (r[1] * tz - r[2] * ty);
+	const float ry = y + r[3] * ty + (r[2] * tx - r[0] * tz);
+	const float rz = z + r[3] * tz + (r[0] * ty - r[1] * tx);
+	x = rx;
+	y = ry;
+	z = rz;
+}
+
+inline void Translate(const BlendedBone& b, float& x, float& y, float& z) {
+	const float* r = b.r;
+	const float* d = b.d;
+	x += 2.0f * (r[3] * d[0] - d[3] * r[0] + (r[1] * d[2] - r[2] * d[1]));
+	y += 2.0f * (r[3] * d[1] - d[3] * r[1] + (r[2] * d[0] - r[0] * d[2]));
+	z += 2.0f * (r[3] * d[2] - d[3] * r[2] + (r[0] * d[1] - r[1] * d[0]));
+}
+
+void SkinRange(
+    const DualQuaternion* bones, const SkinInfluences& influences, const ConstVector3SoA& positions, const ConstVector3SoA* normals, const Vector3SoA& outPositions,
+    const Vector3SoA* outNormals, size_t begin, size_t end) {
+	for (size_t i = begin; i < end; ++i) {
+		const BlendedBone b = BlendInfluences(bones, influences, i);
+
+		float x = positions.x[i], y = positions.y[i], z = positions.z[i];
+		Rotate(b.r, x, y, z);
+		Translate(b, x, y, z);
+		outPositions.x[i] = x;
+		outPositions.y[i] = y;
+		outPositions.z[i] = z;
+
+		if (normals) {
+			float nx = normals->x[i], ny = normals->y[i], nz = normals->z[i];
+			Rotate(b.r, nx, ny, nz);
+			outNormals->x[i] = nx;
+			outNormals->y[i] = ny;
+			outNormals->z[i] = nz;
+		}
+	}
+}
+
+void Skin(
+    const DualQuaternion* bones, const SkinInfluences& influences, const ConstVector3SoA& positions, const ConstVector3SoA* normals, const Vector3SoA& outPositions,
+    const Vector3SoA* outNormals, size_t vertexCount) {
+	MT4_PROFILE_SCOPE("SkinVertices");
+	assert(influences.influenceCount >= 1 && influences.influenceCount <= kMaxSkinInfluences);
+	ParallelFor(vertexCount, kSkinningGrainSize, [&](size_t begin, size_t end) { SkinRange(bones, influences, positions, normals, outPositions, outNormals, begin, end); });
+}
+
+} // namespace
+
+void SkinVertices(const DualQuaternion* bones, const SkinInfluences& influences, const ConstVector3SoA& positions, const Vector3SoA& outPositions, size_t vertexCount) {
+	Skin(bones, influences, positions, nullptr, outPositions, nullptr, vertexCount);
+}
+
+void SkinVertices(
+    const DualQuaternion* bones, const SkinInfluences& influences, const ConstVector3SoA& positions, const ConstVector3SoA& normals, const Vector3SoA& outPositions,
+    const Vector3SoA& outNormals, size_t vertexCount) {
+	Skin(bones, influences, positions, &normals, outPositions, &outNormals, vertexCount);
+}
@@ -0,0 +1,29 @@
+#pragma once
+#include "DualQuaternion.h"
+#include "Math/TransformKernels.h"
+#include <cstdint>
+
+//==================================
+// 双対Quaternionによる CPU スキニング
+//==================================
+// 頂点ごとに最大 4 本のボーンの DualQuaternion をブレンドし（DLB）、位置と法線を変換する。
+// 頂点は kSkinningGrainSize 個以上の塊に分けて複数スレッドで処理する。
+
+constexpr uint32_t kMaxSkinInfluences = 4;
+constexpr size_t kSkinningGrainSize = 1024;
+
+// 頂点ごとのボーン番号と重み（SoA、各配列は頂点数ぶん）。
+// 重みの合計は 1 にし、使わない枠は重み 0 にする（ボーン番号は範囲内であれば何でもよい）
+struct SkinInfluences {
+	const uint16_t* boneIndex[kMaxSkinInfluences];
+	const float* weight[kMaxSkinInfluences];
+	uint32_t influenceCount; // 1 ～ kMaxSkinInfluences
+};
+
+// 位置のみ。outPositions は positions と同じ配列でもよい
+void SkinVertices(const DualQuaternion* bones, const SkinInfluences& influences, const ConstVector3SoA& positions, const Vector3SoA& outPositions, size_t vertexCount);
+
+// 位置と法線
+void SkinVertices(
+    const DualQuaternion* bones, const SkinInfluences& influences, const ConstVector3SoA& positions, const ConstVector3SoA& normals, const Vector3SoA& outPositions,
+    const Vector3SoA& outNormals, size_t vertexCount);
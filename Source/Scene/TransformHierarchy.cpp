@@ -0,0 +1,340 @@
+#include "TransformHierarchy.h"
+#include "Math/Math3D.h"
+#include "Job/ParallelFor.h"
+#include "Math/MatrixKernels.h"
+#include "Profiler/Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <type_traits>
+
+//==================================
+// ノードの追加と削除
+//==================================
+
+TransformHierarchy::Handle TransformHierarchy::Create(const Transform& local, Handle parent) {
+	Handle handle;
+	if (!freeHandles_.empty()) {
+		handle = freeHandles_.back();
+		freeHandles_.pop_back();
+	} else {
+		handle = static_cast<Handle>(handleToIndex_.size());
+		handleToIndex_.push_back(kInvalidIndex);
+	}
+
+	const uint32_t index = static_cast<uint32_t>(handles_.size());
+	const uint32_t parentIndex = parent == kInvalidHandle ? kInvalidIndex : handleToIndex_[parent];
+	const uint32_t depth = parentIndex == kInvalidIndex ? 0 : depths_[parentIndex] + 1;
+
+	// 末尾の深さ以上なら深さ順のまま足せる。浅ければ次の Update で並べ直す
+	if (!orderDirty_ && (depths_.empty() || depth >= depths_.back())) {
+		if (levelStart_.empty()) {
+			levelStart_.push_back(0);
+		}
+		if (depth == LevelCount()) {
+			levelStart_.push_back(index + 1);
+		} else {
+			levelStart_.back() = index + 1;
+		}
+	} else {
+		orderDirty_ = true;
+	}
+
+	handleToIndex_[handle] = index;
+	handles_.push_back(handle);
+	parentHandles_.push_back(parent);
+	parentIndices_.push_back(parentIndex);
+	depths_.push_back(depth);
+	locals_.push_back(local);
+	localMatrices_.push_back(MakeIdentity4x4());
+	worldMatrices_.push_back(MakeIdentity4x4());
+	flags_.push_back(kLocalDirty);
+	++dirtyCount_;
+	return handle;
+}
+
+// 深さ順に並んでいれば、親が消えるノードは親より後ろにあるので 1 回の走査で見つかる
+void TransformHierarchy::Destroy(Handle handle) {
+	if (orderDirty_) {
+		Reorder();
+	}
+
+	const size_t count = handles_.size();
+	std::vector<uint8_t> removed(count, 0);
+	removed[handleToIndex_[handle]] = 1;
+	for (size_t i = handleToIndex_[handle] + 1; i < count; ++i) {
+		const uint32_t parent = parentIndices_[i];
+		removed[i] = parent != kInvalidIndex && removed[parent] ? 1 : 0;
+	}
+
+	// 残すノードを前に詰める（順番は保つので深さ順のまま）
+	size_t write = 0;
+	dirtyCount_ = 0;
+	for (size_t read = 0; read < count; ++read) {
+		if (removed[read]) {
+			handleToIndex_[handles_[read]] = kInvalidIndex;
+			freeHandles_.push_back(handles_[read]);
+			continue;
+		}
+		handles_[write] = handles_[read];
+		parentHandles_[write] = parentHandles_[read];
+		depths_[write] = depths_[read];
+		locals_[write] = locals_[read];
+		localMatrices_[write] = localMatrices_[read];
+		worldMatrices_[write] = worldMatrices_[read];
+		flags_[write] = flags_[read];
+		dirtyCount_ += flags_[write] != 0 ? 1 : 0;
+		handleToIndex_[handles_[write]] = static_cast<uint32_t>(write);
+		++write;
+	}
+	for (std::vector<uint32_t>* v : {&handles_, &parentHandles_, &depths_}) {
+		v->resize(write);
+	}
+	locals_.resize(write);
+	localMatrices_.resize(write);
+	worldMatrices_.resize(write);
+	flags_.resize(write);
+
+	parentIndices_.resize(write);
+	for (size_t i = 0; i < write; ++i) {
+		parentIndices_[i] = parentHandles_[i] == kInvalidHandle ? kInvalidIndex : handleToIndex_[parentHandles_[i]];
+	}
+
+	// 深さごとの範囲を数え直す
+	levelStart_.clear();
+	for (size_t i = 0; i < write; ++i) {
+		while (levelStart_.size() <= depths_[i]) {
+			levelStart_.push_back(static_cast<uint32_t>(i));
+		}
+	}
+	if (!levelStart_.empty()) {
+		levelStart_.push_back(static_cast<uint32_t>(write));
+	}
+}
+
+void TransformHierarchy::Clear() {
+	handles_.clear();
+	parentHandles_.clear();
+	parentIndices_.clear();
+	depths_.clear();
+	locals_.clear();
+	localMatrices_.clear();
+	worldMatrices_.clear();
+	flags_.clear();
+	levelStart_.clear();
+	handleToIndex_.clear();
+	freeHandles_.clear();
+	dirtyCount_ = 0;
+	updatedCount_ = 0;
+	orderDirty_ = false;
+}
+
+//==================================
+// 親子関係
+//==================================
+
+bool TransformHierarchy::SetParent(Handle handle, Handle parent) {
+	// 新しい親から根までたどり、自分が出てきたら循環になる
+	for (Handle ancestor = parent; ancestor != kInvalidHandle; ancestor = parentHandles_[handleToIndex_[ancestor]]) {
+		if (ancestor == handle) {
+			return false;
+		}
+	}
+	const uint32_t index = handleToIndex_[handle];
+	parentHandles_[index] = parent;
+	parentIndices_[index] = parent == kInvalidHandle ? kInvalidIndex : handleToIndex_[parent];
+	if (flags_[index] == 0) {
+		++dirtyCount_;
+	}
+	flags_[index] |= kWorldDirty;
+	// 部分木の深さが変わるので並べ直す
+	orderDirty_ = true;
+	return true;
+}
+
+TransformHierarchy::Handle TransformHierarchy::GetParent(Handle handle) const { return parentHandles_[handleToIndex_[handle]]; }
+
+// 深さを求め直し、深さごとに数えて安定に並べ替える（計数ソート）
+void TransformHierarchy::Reorder() {
+	const size_t count = handles_.size();
+
+	// 親を付け替えた後は親が後ろにいることがあるので、根までたどって深さを決める
+	constexpr uint32_t kUnknown = UINT32_MAX;
+	std::vector<uint32_t> depths(count, kUnknown);
+	std::vector<uint32_t> chain;
+	for (size_t i = 0; i < count; ++i) {
+		uint32_t node = static_cast<uint32_t>(i);
+		while (node != kInvalidIndex && depths[node] == kUnknown) {
+			chain.push_back(node);
+			node = parentIndices_[node];
+		}
+		uint32_t depth = node == kInvalidIndex ? 0 : depths[node] + 1;
+		while (!chain.empty()) {
+			depths[chain.back()] = depth++;
+			chain.pop_back();
+		}
+	}
+
+	levelStart_.clear();
+	for (const uint32_t depth : depths) {
+		if (levelStart_.size() <= depth + 1) {
+			levelStart_.resize(depth + 2, 0);
+		}
+		++levelStart_[depth + 1];
+	}
+	for (size_t level = 1; level < levelStart_.size(); ++level) {
+		levelStart_[level] += levelStart_[level - 1];
+	}
+
+	std::vector<uint32_t> order(count);
+	std::vector<uint32_t> cursor(levelStart_.begin(), levelStart_.end());
+	for (size_t i = 0; i < count; ++i) {
+		order[cursor[depths[i]]++] = static_cast<uint32_t>(i);
+	}
+
+	auto permute = [&](auto& values) {
+		std::remove_reference_t<decltype(values)> sorted(count);
+		for (size_t i = 0; i < count; ++i) {
+			sorted[i] = values[order[i]];
+		}
+		values.swap(sorted);
+	};
+	permute(handles_);
+	permute(parentHandles_);
+	permute(locals_);
+	permute(localMatrices_);
+	permute(worldMatrices_);
+	permute(flags_);
+	permute(depths);
+	depths_.swap(depths);
+
+	for (size_t i = 0; i < count; ++i) {
+		handleToIndex_[handles_[i]] = static_cast<uint32_t>(i);
+	}
+	for (size_t i = 0; i < count; ++i) {
+		parentIndices_[i] = parentHandles_[i] == kInvalidHandle ? kInvalidIndex : handleToIndex_[parentHandles_[i]];
+	}
+	orderDirty_ = false;
+}
+
+//==================================
+// ローカルの値
+//==================================
+
+void TransformHierarchy::MarkLocalDirty(uint32_t index) {
+	if (flags_[index] == 0) {
+		++dirtyCount_;
+	}
+	flags_[index] |= kLocalDirty;
+}
+
+void TransformHierarchy::SetLocal(Handle handle, const Transform& local) {
+	const uint32_t index = handleToIndex_[handle];
+	locals_[index] = local;
+	MarkLocalDirty(index);
+}
+
+void TransformHierarchy::SetScale(Handle handle, const Vector3& scale) {
+	const uint32_t index = handleToIndex_[handle];
+	locals_[index].scale = scale;
+	MarkLocalDirty(index);
+}
+
+void TransformHierarchy::SetRotation(Handle handle, const Vector3& rotation) {
+	const uint32_t index = handleToIndex_[handle];
+	locals_[index].rotation = rotation;
+	MarkLocalDirty(index);
+}
+
+void TransformHierarchy::SetTranslation(Handle handle, const Vector3& translation) {
+	const uint32_t index = handleToIndex_[handle];
+	locals_[index].translation = translation;
+	MarkLocalDirty(index);
+}
+
+//==================================
+// 更新
+//==================================
+
+void TransformHierarchy::Update() {
+	MT4_PROFILE_SCOPE("TransformHierarchy::Update");
+	if (orderDirty_) {
+		Reorder();
+	}
+	updatedCount_ = 0;
+	if (dirtyCount_ == 0) {
+		return;
+	}
+	const size_t count = handles_.size();
+	if (multithreaded_) {
+		// ローカル行列は互いに独立なので塊ごとに作る。端数は最後の塊に含め、塊の境界を 4 の倍数に揃える
+		const size_t blockCount = (std::max)(count / kLocalBlockSize, size_t{1});
+		ParallelFor(blockCount, 1, [&](size_t blockBegin, size_t blockEnd) {
+			for (size_t block = blockBegin; block < blockEnd; ++block) {
+				const size_t end = block + 1 == blockCount ? count : (block + 1) * kLocalBlockSize;
+				UpdateLocalMatrices(block * kLocalBlockSize, end);
+			}
+		});
+
+		// ワールド行列は深さごとに並列に作る。同じ深さのノードは互いに依存しない
+		std::atomic<size_t> updated{0};
+		for (size_t level = 0; level < LevelCount(); ++level) {
+			const size_t levelBegin = levelStart_[level];
+			ParallelFor(levelStart_[level + 1] - levelBegin, kWorldGrainSize, [&](size_t begin, size_t end) {
+				updated.fetch_add(UpdateWorldMatrices(levelBegin + begin, levelBegin + end), std::memory_order_relaxed);
+			});
+		}
+		updatedCount_ = updated.load(std::memory_order_relaxed);
+	} else {
+		UpdateLocalMatrices(0, count);
+		updatedCount_ = UpdateWorldMatrices(0, count);
+	}
+	std::fill(flags_.begin(), flags_.end(), uint8_t{0});
+	dirtyCount_ = 0;
+}
+
+// 印の付いたノードが続く範囲ごとにまとめて作る。
+// MakeAffineMatrices は 4 個ずつ SIMD、端数をスカラーで作り、両者は数 ulp 異なる。
+// どのノードも常に同じ経路で作られるよう、範囲を 4 の倍数の位置に揃え（印のないノードを作り直しても値は変わらない）、
+// 配列末尾の端数は末尾 4 個を SIMD で作り直す。ノードが 4 個未満なら全てスカラーになる。
+// rangeBegin は 4 の倍数で、rangeEnd は 4 の倍数か配列の末尾であること
+void TransformHierarchy::UpdateLocalMatrices(size_t rangeBegin, size_t rangeEnd) {
+	constexpr size_t kWidth = 4;
+	size_t i = rangeBegin;
+	while (i < rangeEnd) {
+		if ((flags_[i] & kLocalDirty) == 0) {
+			++i;
+			continue;
+		}
+		const size_t begin = i / kWidth * kWidth;
+		while (i < rangeEnd && (flags_[i] & kLocalDirty) != 0) {
+			++i;
+		}
+		const size_t end = (i + kWidth - 1) / kWidth * kWidth;
+		if (end <= rangeEnd) {
+			MakeAffineMatrices(locals_.data() + begin, localMatrices_.data() + begin, end - begin);
+		} else if (rangeEnd - rangeBegin >= kWidth) {
+			const size_t alignedEnd = rangeEnd / kWidth * kWidth;
+			MakeAffineMatrices(locals_.data() + begin, localMatrices_.data() + begin, alignedEnd - begin);
+			MakeAffineMatrices(locals_.data() + rangeEnd - kWidth, localMatrices_.data() + rangeEnd - kWidth, kWidth);
+		} else {
+			MakeAffineMatrices(locals_.data() + begin, localMatrices_.data() + begin, rangeEnd - begin);
+		}
+		i = (std::max)(i, end);
+	}
+}
+
+// 親は必ず前（浅い深さ）にあるので、親のワールド行列を作り直したかどうかは子より先に決まっている
+size_t TransformHierarchy::UpdateWorldMatrices(size_t begin, size_t end) {
+	size_t updated = 0;
+	for (size_t i = begin; i < end; ++i) {
+		const uint32_t parent = parentIndices_[i];
+		const bool parentChanged = parent != kInvalidIndex && (flags_[parent] & kWorldDirty) != 0;
+		if (flags_[i] == 0 && !parentChanged) {
+			continue;
+		}
+		flags_[i] |= kWorldDirty;
+		worldMatrices_[i] = parent == kInvalidIndex ? localMatrices_[i] : Multiply(localMatrices_[i], worldMatrices_[parent]);
+		++updated;
+	}
+	return updated;
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include "Math/MathTypes.h"
+#include "struct.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using namespace KamataEngine;
+
+//==================================
+// 親子関係を持つ Transform の集合（平坦なシーングラフ）
+//==================================
+// ノードは配列に親が子より前に来る順で並べ、深さごとにまとめて持つ。
+// Update は配列を先頭から 1 回なめるだけで、親のワールド行列を読んでから子を計算できる。
+//
+// SetLocal などで変えたノードにだけ印を付け、Update ではそのノードのローカル行列と、
+// そのノード以下（部分木）のワールド行列だけを計算し直す。変更がなければ何もしない。
+// ローカル行列は MakeAffineMatrices（SIMD）で連続した範囲ごとにまとめて作る。
+//
+// ハンドルは Destroy するまで変わらない。配列の位置は並べ替えで変わるが、
+// ハンドルから位置への表を持つので GetWorldMatrix はポインタをたどらずに引ける。
+// 親を付け替えたり、親より浅い位置にノードを作ったりすると、次の Update で深さ順に並べ直す。
+//
+// SetMultithreaded(true) ならローカル行列を塊ごとに、ワールド行列を深さごとに並列に作る。
+// 同じ深さのノードは互いに依存しないので、深さを 1 段ずつ進めながら段の中を分ける。結果は 1 スレッドと同じ。
+//
+// 行列は行ベクトル右掛けなので、ワールド行列は local * parentWorld。
+
+class TransformHierarchy {
+
+public:
+	using Handle = uint32_t;
+	static constexpr Handle kInvalidHandle = UINT32_MAX;
+
+	// parent が kInvalidHandle なら根になる
+	Handle Create(const Transform& local, Handle parent = kInvalidHandle);
+
+	// ノードと子孫をまとめて削除する
+	void Destroy(Handle handle);
+
+	// 親を付け替える（ローカルの値はそのまま）。parent が自分の子孫なら何もせず false を返す
+	bool SetParent(Handle handle, Handle parent);
+	Handle GetParent(Handle handle) const;
+
+	void SetLocal(Handle handle, const Transform& local);
+	void SetScale(Handle handle, const Vector3& scale);
+	void SetRotation(Handle handle, const Vector3& rotation);
+	void SetTranslation(Handle handle, const Vector3& translation);
+	const Transform& GetLocal(Handle handle) const { return locals_[handleToIndex_[handle]]; }
+
+	// 変更のあったノードの行列を計算し直す
+	void Update();
+
+	void SetMultithreaded(bool enable) { multithreaded_ = enable; }
+	bool IsMultithreaded() const { return multithreaded_; }
+
+	// 直近の Update 時点の行列
+	const Matrix4x4& GetLocalMatrix(Handle handle) const { return localMatrices_[handleToIndex_[handle]]; }
+	const Matrix4x4& GetWorldMatrix(Handle handle) const { return worldMatrices_[handleToIndex_[handle]]; }
+
+	bool IsValid(Handle handle) const { return handle < handleToIndex_.size() && handleToIndex_[handle] != kInvalidIndex; }
+	size_t Size() const { return handles_.size(); }
+
+	void Clear();
+
+	//==================================
+	// 配列の直接参照（描画や並列更新用）
+	//==================================
+	// 位置 i のノードは Handles()[i]、親の位置は ParentIndices()[i]（根は kInvalidIndex）。
+	// 深さ d のノードは [LevelBegin(d), LevelBegin(d + 1)) に並ぶ。Update の後に使うこと
+
+	static constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+	const Handle* Handles() const { return handles_.data(); }
+	const uint32_t* ParentIndices() const { return parentIndices_.data(); }
+	const Matrix4x4* WorldMatrices() const { return worldMatrices_.data(); }
+	size_t LevelCount() const { return levelStart_.empty() ? 0 : levelStart_.size() - 1; }
+	size_t LevelBegin(size_t level) const { return levelStart_[level]; }
+
+	// 直近の Update でワールド行列を計算し直したノードの数
+	size_t UpdatedCount() const { return updatedCount_; }
+
+private:
+	// flags_ のビット
+	static constexpr uint8_t kLocalDirty = 1; // ローカル行列を作り直す
+	static constexpr uint8_t kWorldDirty = 2; // ワールド行列を作り直す（親が変わった場合など）
+
+	void MarkLocalDirty(uint32_t index);
+	void Reorder();
+	void UpdateLocalMatrices(size_t rangeBegin, size_t rangeEnd);
+	size_t UpdateWorldMatrices(size_t begin, size_t end);
+
+	// 並列更新の塊の大きさ（ローカル行列の塊は 4 の倍数）
+	static constexpr size_t kLocalBlockSize = 1024;
+	static constexpr size_t kWorldGrainSize = 512;
+
+	// 位置ごとの配列（深さ順）
+	std::vector<Handle> handles_;
+	std::vector<Handle> parentHandles_;
+	std::vector<uint32_t> parentIndices_;
+	std::vector<uint32_t> depths_;
+	std::vector<Transform> locals_;
+	std::vector<Matrix4x4> localMatrices_;
+	std::vector<Matrix4x4> worldMatrices_;
+	std::vector<uint8_t> flags_;
+
+	// levelStart_[d] は深さ d の先頭の位置（末尾に Size() を置く）
+	std::vector<uint32_t> levelStart_;
+
+	std::vector<uint32_t> handleToIndex_;
+	std::vector<Handle> freeHandles_;
+
+	size_t dirtyCount_ = 0;
+	size_t updatedCount_ = 0;
+	bool orderDirty_ = false;
+	bool multithreaded_ = false;
+};
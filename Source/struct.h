@@ -1,6 +1,6 @@
 #pragma once
 #include <cstdint>
-#include <KamataEngine.h>
+#include "Math/MathTypes.h"
 
 // クライアント領域のサイズ
 const int32_t kClientWidth = 1280;
@@ -1,4 +1,6 @@
 #include "Math/Math3D.h"
+#include "Profiler/Profiler.h"
+#include "Profiler/ProfilerPanel.h"
 #include "Quaternion/Quaternion.h"
 #include "struct.h"
 #include <KamataEngine.h>
@@ -16,6 +18,9 @@ int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int) {
 	// ImGuiインスタンスの取得
 	ImGuiManager* imguiManager = ImGuiManager::GetInstance();
 
+	// プロファイラに出すメインスレッドの名前
+	Profiler::SetThreadName("Main");
+
 #ifdef _DEBUG
 
 	// ImGuiのフォント設定
@@ -42,8 +47,16 @@ int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int) {
 	// ゲームループ
 	//==============================
 	while (true) {
+		// プロファイラのフレームの区切り
+		Profiler::BeginFrame();
+
 		// エンジンの更新
-		if (KamataEngine::Update()) {
+		bool quit;
+		{
+			MT4_PROFILE_SCOPE("KamataEngine::Update");
+			quit = KamataEngine::Update();
+		}
+		if (quit) {
 			break; // ゲームループを抜ける
 		}
 
@@ -54,50 +67,57 @@ int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int) {
 		// 更新処理開始
 		//==============================
 
+		{
+			MT4_PROFILE_SCOPE("Update");
+
 #ifdef _DEBUG
+
+			// プロファイラの表示
+			DrawProfilerPanel();
 		
-		ImGui::Begin("Quaternion Test");
-
-		auto RowQuatSlerp = [](const char* name, const Quaternion& q, float t) {
-			ImGui::TableNextRow();
-			ImGui::TableSetColumnIndex(0);
-			ImGui::Text("%5.2f  %5.2f  %5.2f  %5.2f", q.x, q.y, q.z, q.w);
-			ImGui::TableSetColumnIndex(1);
-			ImGui::Text(": %s, Slerp(q0, q1, %.1ff)", name, t);
-		};
-
-		ImGuiTableFlags flags = ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg;
-
-		if (ImGui::BeginTable("SlerpTable", 2, flags)) {
-			// 左列幅固定：コロン位置が綺麗に揃う
-			ImGui::TableSetupColumn("Value", ImGuiTableColumnFlags_WidthFixed, 280.0f);
-			ImGui::TableSetupColumn("Label", ImGuiTableColumnFlags_WidthStretch);
-
-			// 例：t を変えたSlerp結果を表示
-			struct Item {
-				const char* name;
-				float t;
-			};
-			const Item items[] = {
-			    {"interpolate1", 0.0f},
-                {"interpolate1", 0.3f},
-                {"interpolate2", 0.5f},
-                {"interpolate3", 0.7f},
-                {"interpolate4", 1.0f},
+			ImGui::Begin("Quaternion Test");
+
+			auto RowQuatSlerp = [](const char* name, const Quaternion& q, float t) {
+				ImGui::TableNextRow();
+				ImGui::TableSetColumnIndex(0);
+				ImGui::Text("%5.2f  %5.2f  %5.2f  %5.2f", q.x, q.y, q.z, q.w);
+				ImGui::TableSetColumnIndex(1);
+				ImGui::Text(": %s, Slerp(q0, q1, %.1ff)", name, t);
 			};
 
-			for (const auto& it : items) {
-				Quaternion qi = Quaternion::Slerp(rotation0, rotation1, it.t); // ←Slerp実装済み前提
-				RowQuatSlerp(it.name, qi, it.t);
+			ImGuiTableFlags flags = ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg;
+
+			if (ImGui::BeginTable("SlerpTable", 2, flags)) {
+				// 左列幅固定：コロン位置が綺麗に揃う
+				ImGui::TableSetupColumn("Value", ImGuiTableColumnFlags_WidthFixed, 280.0f);
+				ImGui::TableSetupColumn("Label", ImGuiTableColumnFlags_WidthStretch);
+
+				// 例：t を変えたSlerp結果を表示
+				struct Item {
+					const char* name;
+					float t;
+				};
+				const Item items[] = {
+				    {"interpolate1", 0.0f},
+	                {"interpolate1", 0.3f},
+	                {"interpolate2", 0.5f},
+	                {"interpolate3", 0.7f},
+	                {"interpolate4", 1.0f},
+				};
+
+				for (const auto& it : items) {
+					Quaternion qi = Quaternion::Slerp(rotation0, rotation1, it.t); // ←Slerp実装済み前提
+					RowQuatSlerp(it.name, qi, it.t);
+				}
+
+				ImGui::EndTable();
 			}
 
-			ImGui::EndTable();
-		}
-
-		ImGui::End();
+			ImGui::End();
 
 
 #endif
+		}
 
 		//==============================
 		// 更新処理終了
@@ -109,12 +129,20 @@ int WINAPI WinMain(_In_ HINSTANCE, _In_opt_ HINSTANCE, _In_ LPSTR, _In_ int) {
 		//==============================
 		// 描画処理開始
 		//==============================
-		dxCommonInstance->PreDraw();
+		{
+			MT4_PROFILE_SCOPE("Draw");
 
-		// ImGuiの描画
-		imguiManager->Draw();
+			dxCommonInstance->PreDraw();
 
-		dxCommonInstance->PostDraw();
+			// ImGuiの描画
+			imguiManager->Draw();
+
+			{
+				// GPU の完了待ちと Present を含む
+				MT4_PROFILE_SCOPE("PostDraw");
+				dxCommonInstance->PostDraw();
+			}
+		}
 		//==============================
 		// 描画処理終了
 		//==============================